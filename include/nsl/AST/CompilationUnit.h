@@ -13,6 +13,7 @@
 #include "nsl/AST/ASTNode.h"
 #include "nsl/AST/Decl.h"
 
+#include <cstdint>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -22,19 +23,27 @@ namespace nsl::ast {
 /// AST root: zero or more top-level items in declaration order.
 class CompilationUnit final : public ASTNode {
 public:
-  CompilationUnit(SourceRange range, std::vector<std::unique_ptr<Decl>> items)
-      : ASTNode(NodeKind::NK_CompilationUnit, range), items_(std::move(items)) {
-  }
+  CompilationUnit(SourceRange range, std::vector<std::unique_ptr<Decl>> items,
+                  uint32_t numExprOrdinals = 1)
+      : ASTNode(NodeKind::NK_CompilationUnit, range), items_(std::move(items)),
+        numExprOrdinals_(numExprOrdinals) {}
 
   [[nodiscard]] const std::vector<std::unique_ptr<Decl>> &
   items() const noexcept {
     return items_;
   }
 
+  /// One past the largest `Expr::ordinal()` stamped by the parser;
+  /// a side table of this size covers every parsed expression.
+  [[nodiscard]] uint32_t numExprOrdinals() const noexcept {
+    return numExprOrdinals_;
+  }
+
   NSL_AST_NODE_BOILERPLATE(CompilationUnit)
 
 private:
   std::vector<std::unique_ptr<Decl>> items_;
+  uint32_t numExprOrdinals_;
 };
 
 } // namespace nsl::ast
@@ -11,6 +11,11 @@
 // data-model §1.1): nullptr at M2; M3 Sema fills it during name-
 // resolution + width-inference. The setter is intentionally NOT
 // `const` — Sema mutates it post-construction.
+//
+// Every parsed `Expr` also carries a dense ordinal, stamped by the
+// parser in construction order (1, 2, 3, ...; 0 means "not yet
+// numbered"). Sema's per-run side tables index a flat array by it
+// instead of hashing the node pointer.
 
 #ifndef NSL_AST_EXPR_H
 #define NSL_AST_EXPR_H
@@ -18,6 +23,8 @@
 #include "nsl/AST/ASTNode.h"
 #include "nsl/AST/Type.h"
 
+#include <cstdint>
+
 namespace nsl::ast {
 
 /// Abstract mid-level base for expression AST nodes.
@@ -33,11 +40,23 @@ public:
   /// enforce this — that's a Sema-level invariant.
   void setInferredType(TypeRef t) noexcept { inferredType_ = t; }
 
+  /// Dense per-unit ordinal; `kNoOrdinal` for a node built outside
+  /// the parser. Ordinals are unique within one `CompilationUnit`
+  /// and bounded by its `numExprOrdinals()`.
+  [[nodiscard]] uint32_t ordinal() const noexcept { return ordinal_; }
+
+  /// Stamp the ordinal. The parser numbers every node it builds;
+  /// Sema numbers the hand-built ones it meets past the parsed range.
+  void setOrdinal(uint32_t n) noexcept { ordinal_ = n; }
+
+  static constexpr uint32_t kNoOrdinal = 0;
+
 protected:
   using ASTNode::ASTNode;
 
 private:
   TypeRef inferredType_ = nullptr;
+  uint32_t ordinal_ = kNoOrdinal;
 };
 
 } // namespace nsl::ast
@@ -30,6 +30,10 @@
 
 #include "nsl/Basic/SourceLocation.h"
 
+#include "llvm/ADT/STLFunctionalExtras.h"
+
+#include <cstdint>
+
 namespace llvm {
 class raw_ostream;
 } // namespace llvm
@@ -50,10 +54,11 @@ class Expr;
 /// or an invalid range if the name is unresolved.
 ///
 /// The callback type is opaque — `nsl-ast` does not depend on
-/// `nsl-sema`. Phase 3 wires the callback in `nsl::sema` to a
-/// thread-local resolution map; tooling layers (M3+ LSP) MAY wire
-/// their own callbacks for incremental introspection.
-using DeclLocLookupFn = SourceRange (*)(const Expr *) noexcept;
+/// `nsl-sema`. The driver binds it to the run's
+/// `sema::ResolutionTable` (held by `SemaResult`); tooling layers
+/// (M3+ LSP) MAY wire their own callbacks for incremental
+/// introspection. Non-owning: the callee must outlive the print.
+using DeclLocLookupFn = llvm::function_ref<SourceRange(const Expr *)>;
 
 /// Walk `cu` in declaration order and write its text-only
 /// S-expression-style dump to `os`. Resolves every `SourceLocation`
@@ -78,6 +83,50 @@ void print(const CompilationUnit &cu, const SourceManager &sm,
 void print(const CompilationUnit &cu, const SourceManager &sm,
            llvm::raw_ostream &os, DeclLocLookupFn decl_lookup);
 
+// ---------- Binary dump ----------
+//
+// A compact machine-readable encoding of the same record stream the
+// text printer renders, for tools that parse the AST rather than
+// read it. Layout (all integers ULEB128):
+//
+//   dump    := "NSLAST" version record End
+//   record  := Node kind str(path) [line col endLine endCol]
+//                item* Close
+//            | Synthetic str(tag) item* Close
+//   item    := Type str(type) | DeclLoc str(path) line col
+//            | StrField str(name) str(value)
+//            | UIntField str(name) value
+//            | ListField str(name) count str*
+//            | record
+//
+// `kind` is the `NodeKind` enumerator value; an invalid range is
+// encoded as the empty path with no coordinates. `str` is interned:
+// `0 len bytes` introduces a new string (ids count up from 0 in
+// order of first use) and `id + 1` repeats an earlier one. A
+// `ScopedName` field is a `ListField` of its parts. The encoding is
+// a pure function of the AST and `SourceManager`, like the text.
+
+inline constexpr char kBinaryDumpMagic[] = "NSLAST";
+inline constexpr uint64_t kBinaryDumpVersion = 1;
+
+/// One-byte record / item tags of the binary dump.
+enum class BinaryDumpTag : uint8_t {
+  End = 0,
+  Node = 1,
+  Synthetic = 2,
+  Close = 3,
+  Type = 4,
+  DeclLoc = 5,
+  StrField = 6,
+  UIntField = 7,
+  ListField = 8,
+};
+
+/// Walk `cu` like `print()` and write the binary dump to `os`.
+/// `decl_lookup` plays the same role as in the post-Sema `print()`.
+void dumpBinary(const CompilationUnit &cu, const SourceManager &sm,
+                llvm::raw_ostream &os, DeclLocLookupFn decl_lookup = nullptr);
+
 } // namespace nsl::ast
 
 #endif // NSL_AST_PRINTER_H
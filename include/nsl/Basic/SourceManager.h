@@ -79,6 +79,12 @@ public:
   /// the trailing newline).
   [[nodiscard]] llvm::StringRef getLine(SourceLocation loc) const;
 
+  /// Build the line-offset table of every registered buffer now.
+  /// Position queries otherwise build it lazily on first use, which
+  /// writes through `const`; call this before sharing the manager
+  /// read-only across threads.
+  void buildLineTables() const;
+
   // ------------------ Virtual location queries (post-#line) ------------------
 
   struct VirtualLoc {
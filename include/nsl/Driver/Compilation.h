@@ -33,6 +33,13 @@
 #include "mlir/IR/OwningOpRef.h"
 #include "mlir/Support/LogicalResult.h"
 
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/raw_ostream.h"
+
+namespace mlir {
+class PassManager;
+} // namespace mlir
+
 namespace nsl {
 class DiagnosticEngine;
 } // namespace nsl
@@ -47,6 +54,23 @@ struct SemaResult;
 
 namespace nsl::driver {
 
+/// MLIR pass-manager reports `runNSLPasses` / `lowerToCIRCT` print
+/// while they run. Populated from the `nslc` `-mlir-*` flags; all
+/// off by default, so the passes run on a bare `mlir::PassManager`.
+struct PassReportOptions {
+  /// Per-pass wall-clock times (`-mlir-timing`). MLIR prints the
+  /// table to stderr when each pipeline finishes.
+  bool timing = false;
+
+  /// Each pass's `mlir::Statistic` counters (`-mlir-pass-statistics`).
+  /// MLIR prints them to stderr when each pipeline finishes.
+  bool statistics = false;
+
+  /// The number of ops in the IR after each pass (`-mlir-op-counts`),
+  /// written to the stream given to `setPassReports`.
+  bool op_counts = false;
+};
+
 /// Pipeline orchestration owned by the M4+ driver. At M4 this is a
 /// stub-bearing scaffold (see FR-004); the full per-stage pipeline
 /// lands at M5+.
@@ -98,13 +122,27 @@ public:
   /// §4 + `circt-lowering.contract.md` §1 (per-op mapping freeze).
   mlir::LogicalResult lowerToCIRCT(mlir::ModuleOp module);
 
+  /// Enable the reports in `opts` for every later `runNSLPasses` /
+  /// `lowerToCIRCT` call. The op-count report goes to `os`, which
+  /// must outlive this `Compilation`.
+  void setPassReports(const PassReportOptions &opts, llvm::raw_ostream &os) {
+    reports_ = opts;
+    report_os_ = &os;
+  }
+
   /// Read-only accessor for the embedded MLIR context. M5 lowering
   /// passes consume this when constructing ops.
   mlir::MLIRContext &context() noexcept { return mlir_ctx_; }
 
 private:
+  /// Apply `reports_` to `pm`, which runs the `stage` pipeline
+  /// (`PassReports.cpp`).
+  void configurePassManager(mlir::PassManager &pm, llvm::StringRef stage);
+
   DiagnosticEngine &diag_;
   mlir::MLIRContext mlir_ctx_;
+  PassReportOptions reports_;
+  llvm::raw_ostream *report_os_ = nullptr;
 };
 
 } // namespace nsl::driver
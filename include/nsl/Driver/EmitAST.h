@@ -18,25 +18,36 @@
 
 namespace nsl::driver {
 
+/// `-emit=ast` output encoding. `Interface` writes, instead of the
+/// tree, the summaries of the unit's `declare` blocks as an interface
+/// index (`-emit=interface`; see `sema::InterfaceIndex`).
+enum class ASTFormat { Text, Binary, Interface };
+
 /// Run `-emit=ast` over `input_path`. Loads the file, runs the M1
 /// preprocessor, lexes the post-preprocess buffer, parses into a
 /// `CompilationUnit`, and prints the AST in the canonical text-only
 /// S-expression format (per `nslc-emit-ast.contract.md`).
 ///
-/// The AST output is buffered in-memory until completion; on a
-/// diagnostic-bearing run nothing is written to `os` (the contract's
-/// "no partial output on error" rule).
+/// The AST is written only once every stage has run clean, streaming
+/// into `os`; on a diagnostic-bearing run nothing is written to `os`
+/// (the contract's "no partial output on error" rule).
+///
+/// `format` selects the text dump, the compact binary dump
+/// (`-emit=ast-bin`, layout in `nsl/AST/Printer.h`) or the interface
+/// index (`-emit=interface`).
 ///
 /// Exit codes per the contract:
 ///   - 0: success.
 ///   - 1: at least one error-severity diagnostic at any pipeline stage
 ///        (preprocess / lex / parse).
-///   - 3: input file could not be opened.
+///   - 3: input file (or an `--interface-index` file) could not be
+///        opened or read.
 ///
 /// The flag set is identical to `EmitTokensOptions` (FR-023: M2 adds
 /// only the `-emit=ast` flag itself; all other flags inherit from M1).
 int emitAST(llvm::StringRef input_path, const EmitTokensOptions &opts,
-            llvm::raw_ostream &os, llvm::raw_ostream &err);
+            llvm::raw_ostream &os, llvm::raw_ostream &err,
+            ASTFormat format = ASTFormat::Text);
 
 } // namespace nsl::driver
 
@@ -38,6 +38,26 @@ struct EmitTokensOptions {
   /// Emit diagnostics in JSON (NDJSON, smoke-only at M1) rather than
   /// the canonical text format. Set by `--diagnostic-format=json`.
   bool diagnostic_json = false;
+
+  /// Interface index files (`--interface-index=<file>`, repeatable),
+  /// as written by `-emit=interface`. Sema takes `declare` blocks
+  /// the input lacks from them; later files win on a name clash.
+  std::vector<std::string> interface_indexes;
+
+  /// Write Sema's time report to the error stream once Sema has run
+  /// (`-ftime-report`), as JSON rather than text with
+  /// `-ftime-report=json`.
+  bool time_report = false;
+  bool time_report_json = false;
+
+  /// MLIR pass-manager reports for `-emit=mlir` / `-emit=hw`, written
+  /// to the error stream: per-pass timings (`-mlir-timing`), each
+  /// pass's statistics (`-mlir-pass-statistics`) and the op count
+  /// after each pass (`-mlir-op-counts`). Ignored by the earlier
+  /// stages, which run no passes.
+  bool mlir_timing = false;
+  bool mlir_pass_statistics = false;
+  bool mlir_op_counts = false;
 };
 
 /// Run `-emit=tokens` over `input_path`. Loads the file via the
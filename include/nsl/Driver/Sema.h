@@ -14,6 +14,14 @@
 
 #include "nsl/Sema/Sema.h"
 
+#include "llvm/ADT/ArrayRef.h"
+
+#include <string>
+
+namespace llvm {
+class raw_ostream;
+} // namespace llvm
+
 namespace nsl {
 class DiagnosticEngine;
 } // namespace nsl
@@ -33,7 +41,38 @@ namespace nsl::driver {
 /// `Sema::run()`'s responsibility. Existing for API symmetry with
 /// `emitAST(...)` and `emitTokens(...)` so the M3+ driver code can
 /// invoke Sema without manually constructing a `Sema` instance.
-sema::SemaResult runSema(ast::CompilationUnit &unit, DiagnosticEngine &diag);
+///
+/// `cache`, when given, carries unchanged modules' constraint results
+/// from one run to the next (the LSP re-analyses a document on every
+/// edit); see `sema::SemaCache`. `interfaces` supplies `declare`
+/// blocks defined in other files; see `sema::InterfaceIndex`.
+/// `stats`, when given, receives the run's timings and counters; see
+/// `sema::SemaStatistics`.
+sema::SemaResult runSema(ast::CompilationUnit &unit, DiagnosticEngine &diag,
+                         sema::SemaCache *cache = nullptr,
+                         const sema::InterfaceIndex *interfaces = nullptr,
+                         sema::SemaStatistics *stats = nullptr);
+
+/// Write `stats` to `os` for `-ftime-report`: the text table, or one
+/// line of JSON when `json` is set.
+void writeTimeReport(const sema::SemaStatistics &stats, bool json,
+                     llvm::raw_ostream &os);
+
+/// Read every `--interface-index` file in `paths`, in order, into
+/// `index`. On an unreadable or malformed file, writes a message
+/// naming it to `err` and returns false.
+bool loadInterfaceIndexes(llvm::ArrayRef<std::string> paths,
+                          sema::InterfaceIndex &index,
+                          llvm::raw_ostream &err);
+
+/// Report an error on every `module` of `unit` whose `declare` is
+/// not in `unit` but was imported from `index`. Sema resolves such a
+/// module's ports from the summary, but lowering builds ports from
+/// the `declare` block itself, so `-emit=mlir` / `-emit=hw` would
+/// emit a module with none. Returns true if any was reported.
+bool reportIndexOnlyDeclares(const ast::CompilationUnit &unit,
+                             const sema::InterfaceIndex &index,
+                             DiagnosticEngine &diag);
 
 } // namespace nsl::driver
 
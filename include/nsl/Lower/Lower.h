@@ -73,10 +73,11 @@ mlir::OwningOpRef<mlir::ModuleOp> astToMLIR(mlir::MLIRContext &ctx,
 // Pass constructors (FR-011, lower-api.contract.md §2.2)
 // -------------------------------------------------------------------
 //
-// Each pass is `mlir::OperationPass<nsl::dialect::ModuleOp>` and
-// registers under a stable command-line flag for `nsl-opt` standalone
-// invocation. Pipeline order is FROZEN per FR-012 +
-// `pass-pipeline.contract.md` §1.
+// Slots 2–6 are op-agnostic `mlir::OperationPass<>`s that schedule on
+// either the builtin `module` or an `nsl.module`; slot 1 runs on the
+// builtin `module`. Each registers under a stable command-line flag
+// for `nsl-opt` standalone invocation. Pipeline order is FROZEN per
+// FR-012 + `pass-pipeline.contract.md` §1.
 
 /// Slot 1 — substitute every `nsl.param_int` / `nsl.param_str`
 /// operand reference with the constant value from the M3 Sema
@@ -93,29 +94,55 @@ std::unique_ptr<mlir::Pass> createNSLExpandGeneratePass();
 /// decomposition for struct-typed variables (FR-015).
 std::unique_ptr<mlir::Pass> createNSLExpandVariablesPass();
 
+/// Slot 3b — fold and canonicalize the Pure `nsl` expression ops
+/// (constant folding, algebraic identities, concat / extract
+/// simplification) so the later slots and the nsl→CIRCT conversion
+/// work on simplified IR. Registered as `nsl-canonicalize`. Must run
+/// after slot 3: an identity fold forwards its operand to every use,
+/// which is wrong for an `nsl.variable` written in between.
+std::unique_ptr<mlir::Pass> createNSLCanonicalizePass();
+
 /// Slot 4 — replace array-form `nsl.submodule` (`SUB[3]`) with N
-/// independent ops named `SUB[0]` … `SUB[N-1]`; rewrite cross-IR
-/// port references (FR-016).
+/// independent ops named `inst_0` … `inst_<N-1>`; rewrite cross-IR
+/// port references (FR-016). Registered for `nsl-opt` only:
+/// `runNSLPasses` keeps array-form ops intact and
+/// `createNSLToCIRCTPass` instantiates each element directly.
 std::unique_ptr<mlir::Pass> createNSLExplodeSubmodArrayPass();
 
-/// Slot 5 — registered no-op slot at M5 per Clarifications Q3 →
-/// Option B. Reserves the pipeline ABI for a future PR to fill in
-/// functional `func_self` inlining (FR-017).
+/// Slot 5 — inline `func_self` functions into their call sites and
+/// erase them, under a size × call-count cost model (`max-growth`
+/// option); single-call functions are always inlined when legal.
+/// Reports `inlined-calls` / `inlined-funcs` / `kept-funcs`
+/// statistics (FR-017).
 std::unique_ptr<mlir::Pass> createNSLInlineInternalFuncPass();
 
+/// Slot 5b — merge equivalent Pure `nsl` ops, hoisting duplicates
+/// out of `alt` / `any` / `if` arms first so the arms share one op.
+/// Transfers, calls and probes are effects and never merged.
+/// Registered as `nsl-cse`.
+std::unique_ptr<mlir::Pass> createNSLCSEPass();
+
 /// Slot 6 — final correctness gate. Detects post-expansion `%IDENT%`
-/// residue via regex over `mlir::StringAttr` values; re-checks the
+/// residue by scanning `mlir::StringAttr` values; re-checks the
 /// six post-expansion-sensitive `Sn` constraints (S6/S10/S15/S16/S20/S25
 /// per `pass-pipeline.contract.md` §3) (FR-018).
 std::unique_ptr<mlir::Pass> createNSLCheckSemanticsPass();
 
+/// Erase write-only `nsl.wire` / `nsl.reg` signals with their
+/// transfers, and unused Pure ops. Not a slot of `runNSLPasses`:
+/// `Compilation::lowerToCIRCT` runs it ahead of the nsl→CIRCT
+/// conversion, so `-emit=mlir` still shows every declared signal.
+/// Registered as `nsl-eliminate-dead-signals`.
+std::unique_ptr<mlir::Pass> createNSLEliminateDeadSignalsPass();
+
 // -------------------------------------------------------------------
 // Pass registration (lower-api.contract.md §2.3)
 // -------------------------------------------------------------------
 
-/// Register all six M5 passes plus the M6 nsl→CIRCT conversion
-/// pass with MLIR's pass-registry so they are discoverable by name
-/// from `nsl-opt -<flag>`. Idempotent: the underlying
+/// Register the six M5 passes, `nsl-canonicalize`, `nsl-cse`,
+/// `nsl-eliminate-dead-signals` and the M6
+/// nsl→CIRCT conversion pass with MLIR's pass-registry so they are
+/// discoverable by name from `nsl-opt -<flag>`. Idempotent: the underlying
 /// `mlir::registerPass` is idempotent by design.
 ///
 /// Called from `tools/nsl-opt/main.cpp` after
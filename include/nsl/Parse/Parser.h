@@ -32,6 +32,7 @@
 
 #include "llvm/ADT/StringRef.h"
 
+#include <cstddef>
 #include <memory>
 
 namespace nsl {
@@ -76,12 +77,19 @@ parseCompilationUnit(Lexer &lex, DiagnosticEngine &diag);
 // II layer-table rule); `nsl-parse` neither knows nor depends on any
 // upper-layer type.
 //
-// At T2, only `parseCompilationUnit` instruments the sink at the
-// production boundary level (single top-level beginNode/endNode);
-// every consumed token routes through `recordToken`. Phase 3+
-// extends sink coverage to internal productions (`parseModuleItem`,
-// `parseAltBlock`, etc.) as the LayoutPlanner requires structural
-// context for layout decisions.
+// Every grammar production is instrumented: each `parseFoo()` site
+// brackets its body with one beginNode/endNode pair (properly nested,
+// so the calls form a pre-order walk of the concrete syntax tree) and
+// every consumed token routes through `recordToken`. A production
+// whose kind is only known after its first child is parsed (`a + b`,
+// `x[3]`, `f(y)`) is opened retroactively with `beginNodeAt` at a
+// `checkpoint` taken before that child, so expressions form a tree
+// of binary / unary / postfix nodes. Dispatch-only
+// rules (`parseActionStatement`, `parseModuleItem`) open no node of
+// their own. The instrumentation is a compile-time policy on the
+// private parser template: the 2-arg overload instantiates the
+// no-op policy, so the AST-only hot path carries neither a sink
+// pointer nor a per-token branch.
 //
 // **Spec / contract anchors**:
 //   - `specs/010-t2-formatter-v0/research.md` §2 (CST-mode parser
@@ -91,6 +99,14 @@ parseCompilationUnit(Lexer &lex, DiagnosticEngine &diag);
 //     (per-production wrapping; tokens routed through recordToken).
 //   - Constitution Principle II — single public header retained.
 
+/// A position in a sink's event stream, taken by
+/// `CSTSink::checkpoint()` and handed back to `beginNodeAt`. Only the
+/// sink that issued it interprets the fields.
+struct CSTCheckpoint {
+  std::size_t tokenIndex = 0;
+  std::size_t nodeIndex = 0;
+};
+
 /// Abstract sink for CST-mode parsing. Implementations live above
 /// the `nsl-parse` layer (e.g., `nsl::fmt::CSTBuilder`). Methods
 /// are virtual; expect them to be invoked once per token (heavy
@@ -112,8 +128,21 @@ public:
 
   /// Called when a production's last token has been consumed.
   /// `end` is the source location one-past the production's last
-  /// byte (i.e., the begin of the next token, or EOF for the last).
+  /// byte (i.e., the end of its last consumed token; a production
+  /// that consumed no token reports its `start`). The top-level
+  /// `"CompilationUnit"` node closes at EOF.
   virtual void endNode(const ::nsl::SourceLocation &end) = 0;
+
+  /// The current position inside the innermost open production.
+  virtual CSTCheckpoint checkpoint() = 0;
+
+  /// Like `beginNode`, but the new production starts at `cp`: every
+  /// token and node recorded in the innermost open production since
+  /// `cp` was taken becomes a child of the new one. `cp` must come
+  /// from this sink while the same production was innermost. Closed
+  /// by the usual `endNode`.
+  virtual void beginNodeAt(const CSTCheckpoint &cp, llvm::StringRef kindName,
+                           const ::nsl::SourceLocation &start) = 0;
 };
 
 /// CST-mode overload: when `sink` is non-null, the parser invokes
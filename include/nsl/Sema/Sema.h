@@ -15,17 +15,35 @@
 #ifndef NSL_SEMA_SEMA_H
 #define NSL_SEMA_SEMA_H
 
+#include "nsl/Basic/SourceLocation.h"
 #include "nsl/Sema/SymbolTable.h"
 #include "nsl/Sema/TypeSystem.h"
 
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace llvm {
+class raw_ostream;
+} // namespace llvm
 
 namespace nsl {
+struct Diagnostic;
 class DiagnosticEngine;
 } // namespace nsl
 
 namespace nsl::ast {
 class CompilationUnit;
+class DeclareBlock;
+class Expr;
 class IdentifierExpr;
 } // namespace nsl::ast
 
@@ -46,6 +64,234 @@ enum class ClassifierKind : uint8_t {
   ControlTerminalTap,
 };
 
+/// Per-run side table mapping each resolved name-reference
+/// (`IdentifierExpr`, `FieldAccessExpr` head, `ScopedName` head) to
+/// its declaring `Symbol*`. Filled by the resolution pass; read by
+/// the constraint checkers and the post-Sema `-emit=ast` printer.
+///
+/// Dense: slot `i` belongs to the `Expr` whose `ordinal()` is `i`
+/// (stamped by the parser), so a lookup is a bounds check and one
+/// load rather than a pointer hash. The table is owned by the run's
+/// `SemaResult`; two runs — on one thread or several — never share
+/// one.
+class ResolutionTable {
+public:
+  /// Resolved declaration of `e`, or null when `e` is not a name-
+  /// reference this run resolved (the printer then prints
+  /// `Unresolved` and omits the decl-loc suffix).
+  [[nodiscard]] const Symbol *lookup(const ast::Expr &e) const noexcept;
+
+  /// Declaration range `e` resolves to; invalid when unresolved.
+  /// Shaped for `ast::DeclLocLookupFn`.
+  [[nodiscard]] SourceRange declLoc(const ast::Expr *e) const noexcept;
+
+  /// Record that `e` resolves to `sym` (no-op for a null `sym`; the
+  /// first recording for `e` wins). `e` must carry an ordinal; the
+  /// table grows to fit it.
+  void record(const ast::Expr &e, const Symbol *sym);
+
+  /// Size the table for `n` ordinals up front (a unit's
+  /// `numExprOrdinals()`).
+  void resize(uint32_t n) { bySlot_.resize(n, nullptr); }
+
+  /// Number of slots — one past the largest ordinal seen. The
+  /// resolution pass numbers hand-built (un-parsed) expressions
+  /// from here.
+  [[nodiscard]] uint32_t size() const noexcept {
+    return static_cast<uint32_t>(bySlot_.size());
+  }
+
+  /// Number of resolved references recorded.
+  [[nodiscard]] std::size_t numResolved() const noexcept {
+    return numResolved_;
+  }
+
+private:
+  std::vector<const Symbol *> bySlot_;
+  std::size_t numResolved_ = 0;
+};
+
+/// Per-run side table of the expressions the resolution pass folded
+/// to a constant: width and depth expressions, repeat counts, slice
+/// bounds, `param_int` initialisers and every sub-expression of
+/// those that folded. Values are unsigned and trimmed to their
+/// active bits (at least one). Lowering reads widths from here rather
+/// than re-deriving them from the AST.
+///
+/// Sparse: only a small fraction of a unit's expressions are
+/// constant-folded, so the table is keyed by node address rather
+/// than sized to the unit's ordinals like `ResolutionTable`.
+class ConstantTable {
+public:
+  /// Folded value of `e`, or null when `e` did not fold.
+  [[nodiscard]] const llvm::APInt *lookup(const ast::Expr &e) const;
+
+  /// `e`'s value as a width or depth: set iff `e` folded to a
+  /// non-zero value that fits in 64 bits.
+  [[nodiscard]] std::optional<uint64_t> width(const ast::Expr *e) const;
+
+  /// Record that `e` folds to `value` (the first recording wins).
+  void record(const ast::Expr &e, const llvm::APInt &value);
+
+  /// Number of folded expressions recorded.
+  [[nodiscard]] std::size_t size() const noexcept { return values_.size(); }
+
+private:
+  llvm::DenseMap<const ast::Expr *, llvm::APInt> values_;
+};
+
+/// What a `module` or `submodule` needs to know about a `declare`
+/// block, without its AST: the terminals with their folded widths,
+/// the `interface` clock/reset names and the header parameters. Owns
+/// its strings, so it outlives the unit it was built from and can be
+/// written to and read back from an `InterfaceIndex` file.
+struct InterfaceSummary {
+  enum class Modifier : uint8_t { None, Interface, Simulation };
+  /// Mirrors `ast::PortDecl::Direction`.
+  enum class Direction : uint8_t {
+    Input,
+    Output,
+    Inout,
+    FuncIn,
+    FuncOut,
+    Wire,
+    FuncSelf,
+  };
+
+  struct Param {
+    std::string name;
+    bool isString = false;
+    /// Decimal value of a `param_int` whose initialiser folded, or
+    /// the literal spelling of a `param_str`; empty otherwise.
+    std::string value;
+  };
+
+  struct Port {
+    std::string name;
+    Direction direction = Direction::Input;
+    /// Folded declared width; 0 when absent or not constant (the
+    /// terminal is then one bit wide).
+    uint64_t width = 0;
+    /// Dummy arguments of a control terminal, in order.
+    std::vector<std::string> dummyArgs;
+    /// Return terminal of a control terminal; empty when none.
+    std::string returnTerminal;
+  };
+
+  std::string name;
+  Modifier modifier = Modifier::None;
+  std::string clock;
+  std::string reset;
+  std::vector<Param> params;
+  std::vector<Port> ports;
+
+  /// The port named `port`, or null.
+  [[nodiscard]] const Port *port(llvm::StringRef port) const;
+
+  /// Summary of `declare`, with widths and parameter values taken
+  /// from the run's `constants`.
+  static InterfaceSummary fromDeclare(const ast::DeclareBlock &declare,
+                                      const ConstantTable &constants);
+};
+
+/// `InterfaceSummary`s by `declare` name. Sema resolves a `module`
+/// whose `declare` is not in the unit, and `submodule`s of such a
+/// template, against the index it was given, so a design split over
+/// several files needs only each file's summaries rather than the
+/// other files' source. `SemaResult::interfaces` holds the summaries
+/// of the unit's own `declare` blocks, which `writeJSON` saves for
+/// the next compilation.
+class InterfaceIndex {
+public:
+  /// Format version written by `writeJSON` and accepted by
+  /// `readJSON`.
+  static constexpr int64_t kVersion = 1;
+
+  /// Add `summary`, replacing any summary of the same name.
+  void add(InterfaceSummary summary);
+
+  /// The summary of `declare <name>`, or null.
+  [[nodiscard]] const InterfaceSummary *lookup(llvm::StringRef name) const;
+
+  [[nodiscard]] std::size_t size() const noexcept { return byName_.size(); }
+  [[nodiscard]] bool empty() const noexcept { return byName_.empty(); }
+
+  /// Write every summary as one JSON document, ordered by name.
+  void writeJSON(llvm::raw_ostream &os) const;
+
+  /// Add every summary in `text`, a document `writeJSON` produced.
+  /// On malformed input, returns false with a description in `error`
+  /// and leaves the index unchanged.
+  bool readJSON(llvm::StringRef text, std::string &error);
+
+  /// Hash of every summary's contents; equal indexes hash equal.
+  [[nodiscard]] std::size_t fingerprint() const;
+
+  /// Summaries of every named `declare` block in `unit`.
+  static InterfaceIndex fromUnit(const ast::CompilationUnit &unit,
+                                 const ConstantTable &constants);
+
+private:
+  llvm::StringMap<InterfaceSummary> byName_;
+};
+
+/// Where one `Sema` run spent its time, and how much work it did.
+/// Filled by `run()` when the engine was handed one
+/// (`Sema::setStatistics`); an engine without one reads no clocks.
+/// Times are wall-clock seconds.
+struct SemaStatistics {
+  /// One sub-step of the resolution pass: the `declare` pre-pass, or
+  /// the walk of every top-level item of one kind.
+  struct Step {
+    std::string name;
+    double seconds = 0;
+    uint64_t items = 0;
+  };
+
+  /// One `Sn` rule: every checker registered under `sn`. With the
+  /// constraint walk split over several threads, `seconds` is summed
+  /// over them and can exceed the stage's wall time.
+  struct Constraint {
+    unsigned sn = 0;
+    double seconds = 0;
+    uint64_t diagnostics = 0;
+  };
+
+  double resolutionSeconds = 0;
+  double constraintSeconds = 0;
+  std::vector<Step> resolutionSteps;
+  /// Every registered rule, in `Sn` order.
+  std::vector<Constraint> constraints;
+
+  /// Symbols the resolution pass declared.
+  uint64_t symbols = 0;
+  /// Declarations rejected as duplicates.
+  uint64_t duplicates = 0;
+  /// Scopes opened.
+  uint64_t scopes = 0;
+  /// Name lookups, and those that found nothing.
+  uint64_t lookups = 0;
+  uint64_t failedLookups = 0;
+  /// Distinct identifiers interned.
+  uint64_t identifiers = 0;
+  /// Expressions resolved to a symbol.
+  uint64_t resolvedExprs = 0;
+  /// Expressions folded to a constant.
+  uint64_t foldedConstants = 0;
+  /// Modules whose constraint results came from a `SemaCache`, and
+  /// modules the checkers had to walk with one.
+  uint64_t cachedModules = 0;
+  uint64_t checkedModules = 0;
+
+  /// Entry for `sn`, added in `Sn` order if missing.
+  Constraint &constraint(unsigned sn);
+
+  /// Human-readable report, `-ftime-report` style.
+  void writeText(llvm::raw_ostream &os) const;
+  /// The same report as one JSON document.
+  void writeJSON(llvm::raw_ostream &os) const;
+};
+
 /// The output of `Sema::run()` — owns the symbol table and type
 /// system that downstream stages (`-emit=ast` post-Sema printer at
 /// M3; `-emit=mlir` at M5+) consume.
@@ -68,6 +314,16 @@ struct SemaResult {
   /// Owned type system — non-null on success.
   std::unique_ptr<TypeSystem> types;
 
+  /// This run's name resolutions. `Symbol*` values point into
+  /// `symbols`, so the table is valid exactly as long as it is.
+  ResolutionTable resolutions;
+
+  /// This run's folded constants; widths lowering must agree with.
+  ConstantTable constants;
+
+  /// Summaries of the unit's own named `declare` blocks.
+  InterfaceIndex interfaces;
+
   /// Mirror of `DiagnosticEngine::hasError()` at the end of the
   /// run. `true` if any error-severity diagnostic was emitted
   /// (warnings do NOT set this flag — they're advisory). The
@@ -78,6 +334,55 @@ struct SemaResult {
   bool hasErrors = false;
 };
 
+struct ConstraintContext;
+
+/// Constraint-stage output of earlier `Sema` runs, kept per `module`
+/// block so that a run over an edited unit re-checks only the
+/// modules that changed (the LSP re-runs Sema on every edit).
+///
+/// A module's entry is keyed by its exact source text and is only
+/// reused while the rest of the unit looks the same to the checkers:
+/// the text of every non-module item, the unit-wide (`Global`-scope)
+/// bindings, and any cross-module state a checker reads (S11's
+/// state_name owners). Any change there drops every entry; names
+/// local to a module are not part of it. Modules whose diagnostics
+/// point outside their own text are not cached. The resolution pass
+/// itself always re-runs: its symbols and types belong to the run's
+/// `SemaResult` (Invariant 8).
+///
+/// Threading: one `Sema` run at a time may use a cache.
+class SemaCache {
+public:
+  SemaCache();
+  ~SemaCache();
+  SemaCache(const SemaCache &) = delete;
+  SemaCache &operator=(const SemaCache &) = delete;
+  SemaCache(SemaCache &&) = delete;
+  SemaCache &operator=(SemaCache &&) = delete;
+
+  /// Modules the latest run took from the cache.
+  [[nodiscard]] std::size_t lastHits() const noexcept;
+  /// Modules the latest run had to check.
+  [[nodiscard]] std::size_t lastMisses() const noexcept;
+  /// Number of cached modules. Entries the latest run did not use
+  /// are evicted at its end.
+  [[nodiscard]] std::size_t size() const noexcept;
+  /// Drop every entry.
+  void clear();
+
+private:
+  friend class Sema;
+  struct Impl;
+
+  /// Run the constraint checkers on `ctx`, reusing what it can.
+  /// `interfaces` is the index the resolution pass imported from, if
+  /// any; it is part of what every module's diagnostics depend on.
+  void runConstraints(const ConstraintContext &ctx,
+                      const InterfaceIndex *interfaces = nullptr);
+
+  std::unique_ptr<Impl> impl_;
+};
+
 /// Sema engine (data-model §4.2). Single-shot: construct, call
 /// `run()` exactly once, consume the `SemaResult`. Re-using a
 /// `Sema` instance for a second run is an error (asserted in debug
@@ -89,8 +394,13 @@ class Sema {
 public:
   /// Construct a Sema engine bound to `diag` (the only diagnostic
   /// surface per `sema-api.contract.md` Invariant 7). Lifetime of
-  /// `diag` MUST exceed the lifetime of `*this`.
-  explicit Sema(DiagnosticEngine &diag);
+  /// `diag` MUST exceed the lifetime of `*this`. With a `cache`, the
+  /// constraint stage reuses the output of unchanged modules from
+  /// earlier runs and records this run's for later ones. With
+  /// `interfaces`, `declare` blocks missing from the unit are taken
+  /// from it; it must outlive `run()`.
+  explicit Sema(DiagnosticEngine &diag, SemaCache *cache = nullptr,
+                const InterfaceIndex *interfaces = nullptr);
 
   /// Out-of-line destructor (anchored in `Sema.cpp`).
   ~Sema();
@@ -103,14 +413,14 @@ public:
   /// Run Sema on `unit`. Executes the resolution pass first
   /// (single top-down `ASTVisitor` walk: open/close scopes,
   /// declare symbols, resolve names, infer widths), then the
-  /// constraint passes (one fan-out walk per `Sn` family). On the
+  /// constraint passes (one fused walk shared by the `Sn` checkers). On the
   /// first stage's failure it still proceeds to the second so
   /// multi-error reporting works (FR-016).
   ///
-  /// Returns a `SemaResult` whose `symbols` / `types` move-own the
-  /// internal state. After this call, the `Sema` instance's
-  /// internal state is empty; calling `run()` a second time
-  /// asserts in debug builds.
+  /// Returns a `SemaResult` whose `symbols` / `types` /
+  /// `resolutions` move-own the internal state. After this call,
+  /// the `Sema` instance's internal state is empty; calling `run()`
+  /// a second time asserts in debug builds.
   ///
   /// **Phase 2 status**: scaffolding only. The two stage
   /// invocations (`runResolutionPass` / `runConstraintPasses`)
@@ -127,31 +437,117 @@ public:
   /// identifier resolving to a `FuncInSymbol` / `FuncOutSymbol` /
   /// `FuncSelfSymbol` / `ProcSymbol`; `Value` otherwise.
   ///
+  /// Reads this instance's own tables, so it sees resolutions only
+  /// until `run()` hands them to the `SemaResult`; afterwards, look
+  /// the expression up in `SemaResult::resolutions` directly.
+  ///
   /// **Phase 2 status**: signature stub only — returns `Value`
   /// unconditionally. Concrete behavior lands at Phase 4 (T070,
   /// `S27_ControlTerminalAs1Bit.cpp`).
   [[nodiscard]] ClassifierKind
   classifyIdentifierExpr(const ast::IdentifierExpr &expr) const;
 
+  /// Have `run()` time each stage, resolution sub-step and `Sn` rule
+  /// and count the work done into `*stats`, which it resets first.
+  /// Null (the default) turns the instrumentation off.
+  void setStatistics(SemaStatistics *stats) noexcept { stats_ = stats; }
+
 private:
   /// Resolution pass: opens/closes scopes, declares symbols,
   /// resolves names, infers widths. Phase 2 stub: no-op. Phase 3
   /// fills.
   void runResolutionPass(ast::CompilationUnit &unit);
 
-  /// Constraint passes: fan-out of N independent walkers, one per
-  /// `Sn` family. Each walker is registered at static-init time
+  /// Constraint passes: one fused traversal dispatching to the
+  /// per-`Sn` checkers, plus the few that keep their own walk. Each
+  /// checker is registered at static-init time
   /// via `NSL_REGISTER_CONSTRAINT(N, ...)`. Phase 2 stub: no-op.
   /// Phase 4 fills (each `Sn` adds one source file under
   /// `lib/Sema/Constraints/`).
   void runConstraintPasses(ast::CompilationUnit &unit);
 
   DiagnosticEngine &diag_;
+  SemaCache *cache_;
+  const InterfaceIndex *interfaces_;
+  SemaStatistics *stats_ = nullptr;
   std::unique_ptr<SymbolTable> symbols_;
   std::unique_ptr<TypeSystem> types_;
+  ResolutionTable resolutions_;
+  ConstantTable constants_;
   bool hasRun_ = false;
 };
 
+/// Demand-driven Sema over one unit, for consumers that need only
+/// part of the answer — the LSP asking about the module in view.
+///
+/// Nothing is analysed up front. Asking about an expression resolves
+/// the unit's top-level items up to the one holding it, in source
+/// order, so every answer is the one `Sema::run()` gives; the items
+/// after it are left alone. Asking for an item's diagnostics resolves
+/// through that item and checks it alone. Every answer is kept.
+///
+/// `finish()` completes whatever is left, reports every diagnostic to
+/// the engine in `Sema::run()`'s order and hands over the same
+/// `SemaResult`; nothing is reported to it before then.
+///
+/// With `stats`, the work is timed and counted into it as
+/// `Sema::setStatistics` has `run()` do; the totals are complete once
+/// `finish()` returns.
+///
+/// Threading: not thread-safe. `unit`, `diag`, `interfaces` and
+/// `stats` must outlive the object.
+class LazySema {
+public:
+  explicit LazySema(ast::CompilationUnit &unit, DiagnosticEngine &diag,
+                    const InterfaceIndex *interfaces = nullptr,
+                    SemaStatistics *stats = nullptr);
+  ~LazySema();
+
+  LazySema(const LazySema &) = delete;
+  LazySema &operator=(const LazySema &) = delete;
+  LazySema(LazySema &&) = delete;
+  LazySema &operator=(LazySema &&) = delete;
+
+  /// Index of the top-level item whose source range holds `loc`, or
+  /// nullopt when none does.
+  [[nodiscard]] std::optional<std::size_t> itemAt(SourceLocation loc) const;
+
+  /// Resolve every top-level item up to and including `index`.
+  void resolveThrough(std::size_t index);
+
+  /// The symbol `e` resolves to, or null. `e` must belong to the
+  /// unit.
+  const Symbol *resolve(const ast::Expr &e);
+
+  /// The inferred type of `e`, or null when `e` lies outside every
+  /// top-level item.
+  TypeRef typeOf(const ast::Expr &e);
+
+  /// The innermost expression whose range holds `loc`, resolving up
+  /// to the item that holds it; null when no resolved expression
+  /// does. Drives the LSP's hover and go-to-definition.
+  const ast::Expr *exprAt(SourceLocation loc);
+
+  /// What item `index` reports: its resolution diagnostics, then its
+  /// constraint diagnostics in `Sn` order. Empty past the last item.
+  const std::vector<Diagnostic> &diagnosticsFor(std::size_t index);
+
+  /// Number of leading top-level items resolved so far.
+  [[nodiscard]] std::size_t resolvedItems() const noexcept;
+
+  /// Number of top-level items whose constraints have been checked.
+  [[nodiscard]] std::size_t checkedItems() const noexcept;
+
+  /// Resolve and check the rest, report everything to the engine and
+  /// return what `Sema::run()` would have. Call at most once; every
+  /// other member is off limits afterwards.
+  SemaResult finish();
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 } // namespace nsl::sema
 
 #endif // NSL_SEMA_SEMA_H
@@ -25,10 +25,15 @@
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Allocator.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
+#include <utility>
 #include <vector>
 
 namespace nsl::ast {
@@ -84,8 +89,9 @@ llvm::StringRef toString(SymbolKind k);
 /// non-empty `SourceRange` so post-Sema `-emit=ast` can render the
 /// `→ decl@<file>:<line>:<col>` decoration deterministically.
 ///
-/// Lifetime: `Symbol`s are owned by their declaring `Scope` via
-/// `std::unique_ptr<Symbol>` inside `SymbolTable::declare()`. Cross-
+/// Lifetime: `Symbol`s are owned by the `SymbolTable` — allocated in
+/// its arena by `SymbolTable::create<T>()`, or adopted from a
+/// `std::unique_ptr<Symbol>` by `SymbolTable::declare()`. Cross-
 /// references between symbols are non-owning raw pointers (see
 /// `FuncInSymbol::args` etc.); these point into the same
 /// `SymbolTable` instance and have its lifetime.
@@ -394,11 +400,44 @@ enum class ScopeKind : uint8_t {
   Function,      ///< `FuncDefn`
 };
 
-/// Single frame on the lexical-scope stack. Contains the symbol
-/// table for this scope and a pointer back to the parent. Owned by
-/// the surrounding `SymbolTable` via `std::unique_ptr<Scope>` (per
-/// research §2: avoids the recursive-iterator-invalidation pitfalls
-/// of a flat vector under nested scope creation).
+/// Dense integer handle of an interned identifier spelling.
+using IdentID = uint32_t;
+
+/// Identifier interner: maps each distinct spelling to a dense
+/// `IdentID` (first-seen order, from 0). `SymbolTable` keys every
+/// per-name side table by these IDs.
+class IdentifierTable {
+public:
+  /// The ID of `name`, allocating the next one on first sight.
+  IdentID intern(ast::Identifier name);
+
+  /// The ID of `name` if it was ever interned. Never allocates, so
+  /// it is safe on a table shared read-only across threads.
+  [[nodiscard]] std::optional<IdentID> find(ast::Identifier name) const;
+
+  /// Spelling of `id`. Views the interner's own copy of the bytes.
+  [[nodiscard]] ast::Identifier spelling(IdentID id) const {
+    return spellings_[id];
+  }
+
+  /// Number of distinct identifiers interned so far.
+  [[nodiscard]] std::size_t size() const noexcept {
+    return spellings_.size();
+  }
+
+private:
+  llvm::StringMap<IdentID> ids_;
+  std::vector<llvm::StringRef> spellings_;
+};
+
+/// Single frame on the lexical-scope stack: the scope's kind, parent
+/// and owner plus the symbols it declares, in declaration order. The
+/// name -> symbol index itself lives in the surrounding `SymbolTable`
+/// (one shadow chain per identifier), so a scope is just a record of
+/// what it bound. Owned by the `SymbolTable` via
+/// `std::unique_ptr<Scope>` (per research §2: avoids the
+/// recursive-iterator-invalidation pitfalls of a flat vector under
+/// nested scope creation).
 class Scope {
 public:
   Scope(ScopeKind k, Scope *parent, Symbol *owner) noexcept
@@ -417,30 +456,26 @@ public:
   [[nodiscard]] Symbol *owner() const noexcept { return owner_; }
 
   /// Look up `name` in this scope only (no outward walk). Returns
-  /// null if not present. O(1) via `DenseMap`.
+  /// null if not present. Linear in the scope's size; name
+  /// resolution goes through `SymbolTable::lookup`, which is O(1).
   [[nodiscard]] Symbol *lookupLocal(ast::Identifier name) const;
 
-  /// Insert a `Symbol` into this scope. Returns false if a symbol
-  /// with the same name already exists (caller's responsibility to
-  /// emit any "duplicate name" diagnostic — `Scope::insert` itself
-  /// is silent). Otherwise transfers ownership and appends to
-  /// `declOrder` (insertion order, for deterministic iteration).
-  bool insert(std::unique_ptr<Symbol> sym);
-
   /// Iteration-ordered view of every `Symbol` declared in this
   /// scope. Order matches insertion (FR-030 / Invariant 2). The
-  /// pointers are non-owning; ownership lives in `ownedSymbols_`.
+  /// pointers are non-owning; ownership lives in the `SymbolTable`.
   [[nodiscard]] llvm::ArrayRef<Symbol *> declOrder() const noexcept {
     return declOrder_;
   }
 
 private:
+  friend class SymbolTable;
+
   ScopeKind kind_;
   Scope *parent_;
   Symbol *owner_;
-  llvm::DenseMap<llvm::StringRef, Symbol *> table_;
-  std::vector<std::unique_ptr<Symbol>> ownedSymbols_;
   std::vector<Symbol *> declOrder_;
+  /// `IdentID` of each `declOrder_` entry, for unwinding on leave.
+  std::vector<IdentID> ids_;
 };
 
 // -----------------------------------------------------------------
@@ -453,6 +488,13 @@ private:
 /// stages; the T-track tooling libraries) read through this surface
 /// and never mutate it.
 ///
+/// Representation: names are interned to `IdentID`s, and each ID
+/// heads a shadow chain of its live bindings, innermost first (the
+/// Clang `IdentifierInfo` scheme). `lookup` is one hash probe plus
+/// the chain head, however deep the scope stack. Symbols made with
+/// `create<T>()` and the chain links live in a bump arena that is
+/// released with the table.
+///
 /// Construction: `SymbolTable` starts empty. `enterScope(Global,
 /// nullptr)` is the conventional first call (`ResolutionPass` does
 /// this when it visits `CompilationUnit`).
@@ -466,6 +508,14 @@ public:
   SymbolTable(SymbolTable &&) = delete;
   SymbolTable &operator=(SymbolTable &&) = delete;
 
+  /// Allocate a `T` in the table's arena. The table owns it (and
+  /// runs its destructor) whether or not it is ever declared.
+  template <typename T, typename... Args> T *create(Args &&...args) {
+    T *sym = new (arena_.Allocate<T>()) T(std::forward<Args>(args)...);
+    arenaSymbols_.push_back(sym);
+    return sym;
+  }
+
   /// Push a new scope onto the stack. `owner` is the `Symbol*` that
   /// "opened" this scope (e.g., the `ProcSymbol` for a `Proc`
   /// scope; null for `Global` / `Module`). The caller is responsible
@@ -477,15 +527,18 @@ public:
   /// the stack is non-empty.
   void leaveScope();
 
-  /// Declare a new `Symbol` in the current scope. Returns `false`
-  /// if the name is already declared in the *current* scope (no
-  /// outward walk — shadowing across scopes is permitted; same-
-  /// scope duplicates are not). On success, ownership transfers
-  /// into the scope and a non-owning `Symbol*` is the return
-  /// value's complement (extracted via `lookup` if needed).
+  /// Declare a `create<T>()`-allocated `Symbol` in the current
+  /// scope. Returns `false` if the name is already declared in the
+  /// *current* scope (no outward walk — shadowing across scopes is
+  /// permitted; same-scope duplicates are not).
   ///
   /// The caller emits any "duplicate name" diagnostic on the false
   /// return; `declare` itself is silent.
+  bool declare(Symbol *sym);
+
+  /// As above for a heap-allocated `Symbol`: on success ownership
+  /// transfers into the table; on the false path the rejected symbol
+  /// is destroyed.
   bool declare(std::unique_ptr<Symbol> sym);
 
   /// Look up `name` starting in the current scope and walking
@@ -524,6 +577,11 @@ public:
   /// may use it for incremental introspection.
   [[nodiscard]] const Scope *currentScope() const noexcept;
 
+  /// The `Global` root scope, live or retired. Null before the first
+  /// `enterScope(Global)`. Post-Sema consumers read the unit-wide
+  /// bindings (declares, structs, modules, globals) through it.
+  [[nodiscard]] const Scope *globalScope() const noexcept;
+
   /// Declare `sym` into the nearest enclosing scope of the given
   /// `kind` walking outward from the current scope, instead of
   /// the innermost scope (which is what `declare` targets).
@@ -534,6 +592,7 @@ public:
   /// resolve from sibling `func`/`proc`/module-action positions;
   /// the per-`Sn` checker S11 then enforces that uses occur only
   /// inside the declaring proc body.
+  bool declareInScope(ScopeKind kind, Symbol *sym);
   bool declareInScope(ScopeKind kind, std::unique_ptr<Symbol> sym);
 
   /// Number of scopes currently on the stack. 0 before the first
@@ -543,13 +602,36 @@ public:
     return scopes_.size();
   }
 
+  /// The table's identifier interner.
+  [[nodiscard]] const IdentifierTable &identifiers() const noexcept {
+    return idents_;
+  }
+
+  /// `name` viewed through the interner's own copy, so a symbol can
+  /// be named from a buffer that does not outlive the table.
+  ast::Identifier internName(ast::Identifier name) {
+    return idents_.spelling(idents_.intern(name));
+  }
+
 private:
+  /// One live declaration of an identifier: a link in that
+  /// identifier's shadow chain. `depth` is the declaring scope's
+  /// index in `scopes_`; chains are ordered by decreasing depth.
+  struct Binding {
+    Symbol *sym;
+    unsigned depth;
+    Binding *shadowed;
+  };
+
+  /// Bind `sym` in `scopes_[depth]`; false on a same-scope duplicate.
+  bool bind(unsigned depth, Symbol *sym);
+
   std::vector<std::unique_ptr<Scope>> scopes_;
 
   /// Retired scopes — `leaveScope`'d but still alive so the
   /// `Symbol`s they own outlive their declaring Scope. The
   /// `ResolutionPass` (Phase 3 T028) records `Symbol*` cross-
-  /// references in a side `ResolutionMap` for the post-Sema printer
+  /// references in a side `ResolutionTable` for the post-Sema printer
   /// to consume; those pointers MUST remain valid for the lifetime
   /// of the surrounding `SymbolTable` (per
   /// `sema-stability.contract.md` Invariant 8). Retired scopes are
@@ -562,6 +644,20 @@ private:
   /// Phase 3 swaps to a "retire" semantic: leaveScope moves the
   /// unique_ptr from `scopes_` into `retiredScopes_`.
   std::vector<std::unique_ptr<Scope>> retiredScopes_;
+
+  IdentifierTable idents_;
+  /// Per `IdentID`: head of the live shadow chain (null when no
+  /// scope on the stack binds it).
+  std::vector<Binding *> live_;
+  /// Per `IdentID`: the symbol of the most recently retired scope
+  /// that bound it — the post-Sema fallback of `lookup`.
+  std::vector<Symbol *> retired_;
+
+  llvm::BumpPtrAllocator arena_;
+  /// Everything `create<T>()` built, destroyed with the table.
+  std::vector<Symbol *> arenaSymbols_;
+  /// Symbols adopted through the `unique_ptr` overloads.
+  std::vector<std::unique_ptr<Symbol>> ownedSymbols_;
 };
 
 } // namespace nsl::sema
@@ -22,6 +22,7 @@
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/StringRef.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <utility>
@@ -60,13 +61,14 @@ enum class TypeKind : uint8_t {
 // -----------------------------------------------------------------
 
 /// Abstract base of every concrete `Type` kind. Every `Type`
-/// instance is owned by a `TypeSystem` and shared via interning;
-/// pointer equality implies type equality (`sema-api.contract.md`
-/// Invariant 5; design §6.x line 846).
+/// instance is owned by a `TypeSystem` or its `SharedTypeInterner`
+/// and shared via interning; pointer equality implies type equality
+/// (`sema-api.contract.md` Invariant 5; design §6.x line 846).
 ///
-/// Lifetime: `Type`s are never copied or moved; they live for the
-/// lifetime of the surrounding `TypeSystem` (which is in turn
-/// owned by `SemaResult::types`).
+/// Lifetime: `Type`s are never copied or moved. Struct types, and
+/// memories of them, live as long as the `TypeSystem` that made
+/// them (owned by `SemaResult::types`); every other type lives as
+/// long as the shared interner — for the default one, the process.
 class Type {
 public:
   Type() = delete;
@@ -197,20 +199,87 @@ public:
   static bool classof(const Type *t) noexcept { return t->kind() == kKind; }
 };
 
+// -----------------------------------------------------------------
+// SharedTypeInterner — types shared across runs and threads
+// -----------------------------------------------------------------
+
+/// Thread-safe interner for the types that mean the same thing in
+/// every unit: `bit`, the unresolved sentinel, `bit[N]` and memories
+/// of those. Every `TypeSystem` draws them from one of these (by
+/// default `global()`), so Sema runs over different files, on any
+/// thread, hand out the same `TypeRef` for the same `bit[N]` and
+/// allocate it once.
+///
+/// Entries are immutable once published and never freed before the
+/// interner. `bit[N]` up to `kDirectWidths` sits in a fixed table
+/// filled by compare-and-swap, so the common widths are found
+/// without taking a lock; wider vectors and memories live in hash
+/// maps split over `kShards` independently locked shards.
+///
+/// Struct types are not shared: their names are unique only within
+/// a unit and their field names point into that unit's source.
+class SharedTypeInterner {
+public:
+  /// `bit[N]` for `N <= kDirectWidths` never takes a lock.
+  static constexpr uint64_t kDirectWidths = 512;
+  /// Independently locked maps for everything else.
+  static constexpr std::size_t kShards = 16;
+
+  SharedTypeInterner();
+  ~SharedTypeInterner();
+
+  SharedTypeInterner(const SharedTypeInterner &) = delete;
+  SharedTypeInterner &operator=(const SharedTypeInterner &) = delete;
+  SharedTypeInterner(SharedTypeInterner &&) = delete;
+  SharedTypeInterner &operator=(SharedTypeInterner &&) = delete;
+
+  /// The process-wide interner every default-constructed
+  /// `TypeSystem` uses.
+  static SharedTypeInterner &global();
+
+  [[nodiscard]] TypeRef bit() const noexcept;
+  [[nodiscard]] TypeRef unresolved() const noexcept;
+
+  /// Interned `bit[N]`, `N >= 1`.
+  [[nodiscard]] TypeRef bitVector(uint64_t width);
+
+  /// Interned memory of `depth` words of `element`, which must
+  /// itself come from this interner (not a struct).
+  [[nodiscard]] TypeRef memory(uint64_t depth, TypeRef element);
+
+  /// Number of `bit[N]` and memory types interned so far.
+  [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
 // -----------------------------------------------------------------
 // TypeSystem — interner
 // -----------------------------------------------------------------
 
-/// Owns and interns every `Type` instance produced during a Sema
-/// run. After `Sema::run()` returns, ownership is moved into
-/// `SemaResult::types` (`sema-api.contract.md` Invariant 6).
+/// Interns every `Type` instance produced during a Sema run. It owns
+/// the run's struct types and memories of them; the rest come from
+/// its `SharedTypeInterner`. After `Sema::run()` returns, ownership
+/// is moved into `SemaResult::types` (`sema-api.contract.md`
+/// Invariant 6).
 ///
 /// Interning contract (Invariant 5; design §6.x line 799):
 ///   For any two `TypeRef a, b` returned from the same
 ///   `TypeSystem` instance, `a == b ⟺ structurally_equal(a, b)`.
+///   The same holds across `TypeSystem`s sharing an interner for
+///   every type that does not involve a struct.
+///
+/// A `TypeSystem` itself is used by one thread at a time; only the
+/// shared interner behind it is safe to call concurrently.
 class TypeSystem {
 public:
+  /// Draws the shared types from `SharedTypeInterner::global()`.
   TypeSystem();
+  /// Draws the shared types from `shared`, which must outlive every
+  /// `TypeRef` this instance hands out.
+  explicit TypeSystem(SharedTypeInterner &shared);
   ~TypeSystem();
 
   TypeSystem(const TypeSystem &) = delete;
@@ -219,7 +288,8 @@ public:
   TypeSystem &operator=(TypeSystem &&) = delete;
 
   /// Singleton 1-bit type. Always returns the same `TypeRef` for
-  /// the lifetime of `*this`.
+  /// the lifetime of `*this` (and of every `TypeSystem` sharing its
+  /// interner).
   [[nodiscard]] TypeRef bit() const noexcept;
 
   /// Singleton "unresolved" sentinel (per FR-017 no-cascade).
@@ -240,7 +310,8 @@ public:
                                    std::vector<FieldInfo> fields,
                                    uint64_t totalWidth);
 
-  /// Interned memory type. Key is `(depth, element)`.
+  /// Interned memory type. Key is `(depth, element)`. Shared when
+  /// `element` is; a memory of a struct belongs to `*this`.
   [[nodiscard]] TypeRef memory(uint64_t depth, TypeRef element);
 
   /// Type equality — exactly pointer equality per Invariant 5.
@@ -0,0 +1,506 @@
+//===- SyntaxTree.h - Lossless green/red syntax tree -------------*- C++ -*-=//
+//
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+//===----------------------------------------------------------------------===//
+//
+// Public header of `libNslSyntax.a` — the lossless concrete syntax
+// tree shared by the tooling track (`nsl-fmt`, `nsl-lsp`) and built
+// from the parser's CST-mode event stream (`nsl::parse::CSTSink`).
+//
+// Two layers, after Roslyn / rust-analyzer:
+//
+//   * **Green** (`GreenToken`, `GreenNode`) — immutable, position-
+//     independent, hash-consed through a `GreenCache`. A token owns
+//     its bytes plus the whitespace / comment trivia attached to it;
+//     a node owns only its kind and an array of children. Identical
+//     subtrees are one object, so an edit rebuilds only the spine
+//     from the edited element to the root and shares every sibling
+//     (`GreenCache::replaceChild`, `SyntaxNode::replaceWith`).
+//
+//   * **Red** (`SyntaxNode`, `SyntaxToken`) — thin cursors that add
+//     a parent pointer and an absolute byte offset, materialised on
+//     demand while walking down from `SyntaxTree::root()`.
+//
+// Losslessness: concatenating `fullText()` over the tokens of a tree
+// reproduces the source buffer byte-for-byte (cst-shape contract §8).
+// Trivia attachment follows Roslyn: a token's trailing trivia runs
+// to the end of its line (inclusive of the newline); everything else
+// before the next token is that token's leading trivia. Bytes the
+// lexer produced no consumed token for (e.g. tokens skipped without
+// being consumed during recovery) are kept as `Skipped` trivia. The
+// final bytes after the last token hang off a zero-width `tk_eof`.
+//
+// Threading: a `GreenCache` is NOT thread-safe; build and edit a tree
+// on one thread. Finished green nodes are immutable and may be read
+// from any thread while the cache is alive.
+//
+// **Spec / contract anchors**:
+//   - `specs/010-t2-formatter-v0/contracts/cst-shape.contract.md`
+//     §3 (no-byte-loss), §4 (trivia attachment), §8 (round-trip).
+//   - `include/nsl/Parse/Parser.h` (CSTSink event stream).
+//   - Constitution Principle II — tool library outside the layer
+//     table; depends downward on nsl-parse only for `CSTSink`.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef NSL_SYNTAX_SYNTAXTREE_H
+#define NSL_SYNTAX_SYNTAXTREE_H
+
+#include "nsl/Basic/SourceLocation.h"
+#include "nsl/Lex/Token.h"
+#include "nsl/Parse/Parser.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/Allocator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace nsl::syntax {
+
+// -----------------------------------------------------------------------------
+// Trivia
+// -----------------------------------------------------------------------------
+
+/// Kind of one trivia piece attached to a token.
+enum class TriviaKind : std::uint8_t {
+  Whitespace,   // run of ' ' / '\t'
+  Newline,      // "\n" or "\r\n"
+  LineComment,  // `// ...` up to (not including) the newline
+  BlockComment, // `/* ... */` (may span lines)
+  Skipped,      // bytes the parser consumed no token for
+};
+
+/// One trivia piece. Text is recovered by slicing the owning token's
+/// `fullText()`; only the length is stored.
+struct TriviaPiece {
+  TriviaKind kind;
+  std::uint32_t length;
+};
+
+/// Split `text` (the bytes between two tokens) into trivia pieces.
+/// Every byte lands in exactly one piece.
+void lexTrivia(llvm::StringRef text, llvm::SmallVectorImpl<TriviaPiece> &out);
+
+// -----------------------------------------------------------------------------
+// Green layer
+// -----------------------------------------------------------------------------
+
+class GreenToken;
+class GreenNode;
+
+/// A green child — either a token or a node. One pointer wide: the
+/// low bit tags tokens (green elements are arena-allocated with at
+/// least pointer alignment).
+class GreenElement {
+public:
+  GreenElement() = default;
+  GreenElement(const GreenToken *tok)
+      : bits_(reinterpret_cast<std::uintptr_t>(tok) | kTokenTag) {}
+  GreenElement(const GreenNode *node)
+      : bits_(reinterpret_cast<std::uintptr_t>(node)) {}
+
+  [[nodiscard]] bool isNull() const noexcept {
+    return (bits_ & ~kTokenTag) == 0;
+  }
+  [[nodiscard]] bool isToken() const noexcept {
+    return (bits_ & kTokenTag) != 0;
+  }
+  [[nodiscard]] const GreenToken *asToken() const noexcept {
+    return isToken() ? reinterpret_cast<const GreenToken *>(bits_ & ~kTokenTag)
+                     : nullptr;
+  }
+  [[nodiscard]] const GreenNode *asNode() const noexcept {
+    return isToken() ? nullptr : reinterpret_cast<const GreenNode *>(bits_);
+  }
+
+  /// Byte width including all trivia.
+  [[nodiscard]] std::uint32_t fullWidth() const noexcept;
+
+  /// Identity for hash-consing (children are already interned, so
+  /// pointer identity is structural identity).
+  [[nodiscard]] std::uintptr_t opaque() const noexcept { return bits_; }
+
+  friend bool operator==(GreenElement a, GreenElement b) noexcept {
+    return a.bits_ == b.bits_;
+  }
+  friend bool operator!=(GreenElement a, GreenElement b) noexcept {
+    return !(a == b);
+  }
+
+private:
+  static constexpr std::uintptr_t kTokenTag = 1;
+  std::uintptr_t bits_ = 0;
+};
+
+/// Immutable, interned token plus its attached trivia. Created only
+/// by `GreenCache::token`.
+class GreenToken : public llvm::FoldingSetNode {
+public:
+  [[nodiscard]] TokenKind kind() const noexcept { return kind_; }
+
+  /// Leading trivia + token bytes + trailing trivia.
+  [[nodiscard]] llvm::StringRef fullText() const noexcept { return full_; }
+  /// Token bytes only.
+  [[nodiscard]] llvm::StringRef text() const noexcept {
+    return full_.substr(leadingWidth_,
+                        full_.size() - leadingWidth_ - trailingWidth_);
+  }
+  [[nodiscard]] llvm::StringRef leadingText() const noexcept {
+    return full_.take_front(leadingWidth_);
+  }
+  [[nodiscard]] llvm::StringRef trailingText() const noexcept {
+    return full_.take_back(trailingWidth_);
+  }
+  [[nodiscard]] llvm::ArrayRef<TriviaPiece> leadingTrivia() const noexcept {
+    return leading_;
+  }
+  [[nodiscard]] llvm::ArrayRef<TriviaPiece> trailingTrivia() const noexcept {
+    return trailing_;
+  }
+  [[nodiscard]] std::uint32_t fullWidth() const noexcept {
+    return static_cast<std::uint32_t>(full_.size());
+  }
+  [[nodiscard]] std::uint32_t leadingWidth() const noexcept {
+    return leadingWidth_;
+  }
+  [[nodiscard]] std::uint32_t trailingWidth() const noexcept {
+    return trailingWidth_;
+  }
+
+  /// FoldingSet profile: kind, trivia split and the full bytes.
+  void Profile(llvm::FoldingSetNodeID &id) const;
+  static void Profile(llvm::FoldingSetNodeID &id, TokenKind kind,
+                      llvm::StringRef full, std::uint32_t leadingWidth,
+                      std::uint32_t trailingWidth);
+
+private:
+  friend class GreenCache;
+  GreenToken(TokenKind kind, llvm::StringRef full,
+             llvm::ArrayRef<TriviaPiece> leading,
+             llvm::ArrayRef<TriviaPiece> trailing,
+             std::uint32_t leadingWidth,
+             std::uint32_t trailingWidth) noexcept
+      : kind_(kind), leadingWidth_(leadingWidth),
+        trailingWidth_(trailingWidth), full_(full), leading_(leading),
+        trailing_(trailing) {}
+
+  TokenKind kind_;
+  std::uint32_t leadingWidth_;
+  std::uint32_t trailingWidth_;
+  llvm::StringRef full_;                 // arena-owned
+  llvm::ArrayRef<TriviaPiece> leading_;  // arena-owned
+  llvm::ArrayRef<TriviaPiece> trailing_; // arena-owned
+};
+
+/// Immutable, interned interior node. `kind()` is the production
+/// name reported through `CSTSink::beginNode` (e.g. `"ModuleBlock"`);
+/// it is interned so equal kinds compare equal by pointer.
+class GreenNode : public llvm::FoldingSetNode {
+public:
+  [[nodiscard]] llvm::StringRef kind() const noexcept { return kind_; }
+  [[nodiscard]] llvm::ArrayRef<GreenElement> children() const noexcept {
+    return children_;
+  }
+  [[nodiscard]] std::uint32_t fullWidth() const noexcept { return width_; }
+
+  /// Reconstruct the node's bytes (all trivia included).
+  [[nodiscard]] std::string text() const;
+
+  void Profile(llvm::FoldingSetNodeID &id) const;
+  static void Profile(llvm::FoldingSetNodeID &id, llvm::StringRef kind,
+                      llvm::ArrayRef<GreenElement> children);
+
+private:
+  friend class GreenCache;
+  GreenNode(llvm::StringRef kind, llvm::ArrayRef<GreenElement> children,
+            std::uint32_t width) noexcept
+      : kind_(kind), width_(width), children_(children) {}
+
+  llvm::StringRef kind_; // interned in the owning cache
+  std::uint32_t width_;
+  llvm::ArrayRef<GreenElement> children_; // arena-owned
+};
+
+inline std::uint32_t GreenElement::fullWidth() const noexcept {
+  if (const GreenToken *t = asToken()) {
+    return t->fullWidth();
+  }
+  if (const GreenNode *n = asNode()) {
+    return n->fullWidth();
+  }
+  return 0;
+}
+
+/// Interner and arena for green elements. Every element handed out
+/// lives as long as the cache; equal requests return the same
+/// pointer. Share one cache across re-parses of a document to share
+/// unchanged subtrees between versions.
+class GreenCache {
+public:
+  GreenCache() = default;
+  GreenCache(const GreenCache &) = delete;
+  GreenCache &operator=(const GreenCache &) = delete;
+
+  /// Intern a token. `full` is leading trivia + token bytes +
+  /// trailing trivia; the widths split it. Trivia pieces are lexed
+  /// from the bytes on first insertion.
+  const GreenToken *token(TokenKind kind, llvm::StringRef full,
+                          std::uint32_t leadingWidth,
+                          std::uint32_t trailingWidth);
+
+  /// Intern an interior node over already-interned children.
+  const GreenNode *node(llvm::StringRef kind,
+                        llvm::ArrayRef<GreenElement> children);
+
+  /// Return `parent` with child `index` replaced by `child` — every
+  /// other child is shared with `parent`.
+  const GreenNode *replaceChild(const GreenNode *parent, std::size_t index,
+                                GreenElement child);
+
+  /// Intern a production name; equal names return the same storage.
+  llvm::StringRef internKind(llvm::StringRef kind);
+
+  /// Interning statistics: distinct elements allocated, and requests
+  /// answered from the cache.
+  [[nodiscard]] std::size_t tokenCount() const noexcept {
+    return tokenCount_;
+  }
+  [[nodiscard]] std::size_t nodeCount() const noexcept { return nodeCount_; }
+  [[nodiscard]] std::size_t hitCount() const noexcept { return hits_; }
+
+private:
+  llvm::BumpPtrAllocator arena_;
+  llvm::StringSet<> kinds_;
+  llvm::FoldingSet<GreenToken> tokens_;
+  llvm::FoldingSet<GreenNode> nodes_;
+  std::size_t tokenCount_ = 0;
+  std::size_t nodeCount_ = 0;
+  std::size_t hits_ = 0;
+};
+
+// -----------------------------------------------------------------------------
+// Red layer
+// -----------------------------------------------------------------------------
+
+class SyntaxToken;
+
+/// Positioned view of a `GreenNode`. Cheap to copy (one shared
+/// pointer); parents are kept alive by their children.
+class SyntaxNode {
+public:
+  SyntaxNode() = default;
+
+  /// Root cursor over `green` starting at byte `offset`.
+  static SyntaxNode makeRoot(const GreenNode *green, std::uint32_t offset = 0);
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return data_ != nullptr;
+  }
+  [[nodiscard]] const GreenNode *green() const noexcept {
+    return data_->green;
+  }
+  [[nodiscard]] llvm::StringRef kind() const noexcept {
+    return data_->green->kind();
+  }
+  [[nodiscard]] std::optional<SyntaxNode> parent() const;
+  /// Position within the parent's children (0 for the root).
+  [[nodiscard]] std::size_t indexInParent() const noexcept {
+    return data_->index;
+  }
+
+  /// Byte offset of the first byte, leading trivia included.
+  [[nodiscard]] std::uint32_t fullOffset() const noexcept {
+    return data_->offset;
+  }
+  [[nodiscard]] std::uint32_t fullWidth() const noexcept {
+    return data_->green->fullWidth();
+  }
+  /// `[begin, end)` of the node's bytes without the leading trivia of
+  /// its first token and the trailing trivia of its last token.
+  [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> textRange() const;
+
+  [[nodiscard]] std::size_t childCount() const noexcept {
+    return data_->green->children().size();
+  }
+  /// Child `i` if it is a node.
+  [[nodiscard]] std::optional<SyntaxNode> childNode(std::size_t i) const;
+  /// Child `i` if it is a token.
+  [[nodiscard]] std::optional<SyntaxToken> childToken(std::size_t i) const;
+  /// All child nodes, in source order.
+  [[nodiscard]] std::vector<SyntaxNode> childNodes() const;
+
+  [[nodiscard]] std::optional<SyntaxToken> firstToken() const;
+  [[nodiscard]] std::optional<SyntaxToken> lastToken() const;
+
+  /// Token whose full range (trivia included) contains `offset`.
+  [[nodiscard]] std::optional<SyntaxToken>
+  tokenAtOffset(std::uint32_t offset) const;
+
+  /// Deepest node whose full range covers `[begin, end)`.
+  [[nodiscard]] SyntaxNode coveringNode(std::uint32_t begin,
+                                        std::uint32_t end) const;
+
+  /// Replace this node's green with `replacement` and rebuild the
+  /// spine up to the root. Returns the new root green; every
+  /// subtree off the spine is shared with the old tree.
+  const GreenNode *replaceWith(GreenCache &cache,
+                               GreenElement replacement) const;
+
+  friend bool operator==(const SyntaxNode &a, const SyntaxNode &b) noexcept {
+    return a.data_ == b.data_ ||
+           (a.data_ && b.data_ && a.data_->green == b.data_->green &&
+            a.data_->offset == b.data_->offset);
+  }
+
+private:
+  friend class SyntaxToken;
+  struct Data {
+    const GreenNode *green;
+    std::uint32_t offset;
+    std::size_t index;
+    std::shared_ptr<const Data> parent;
+  };
+  explicit SyntaxNode(std::shared_ptr<const Data> d) : data_(std::move(d)) {}
+  /// Absolute offset of child `i`.
+  std::uint32_t childOffset(std::size_t i) const noexcept;
+
+  std::shared_ptr<const Data> data_;
+};
+
+/// Positioned view of a `GreenToken`.
+class SyntaxToken {
+public:
+  [[nodiscard]] const GreenToken *green() const noexcept { return green_; }
+  [[nodiscard]] TokenKind kind() const noexcept { return green_->kind(); }
+  [[nodiscard]] llvm::StringRef text() const noexcept {
+    return green_->text();
+  }
+  [[nodiscard]] const SyntaxNode &parent() const noexcept { return parent_; }
+  [[nodiscard]] std::size_t indexInParent() const noexcept { return index_; }
+
+  /// Byte offset of the first leading-trivia byte.
+  [[nodiscard]] std::uint32_t fullOffset() const noexcept { return offset_; }
+  /// `[begin, end)` of the token bytes proper.
+  [[nodiscard]] std::pair<std::uint32_t, std::uint32_t> textRange() const
+      noexcept {
+    std::uint32_t b = offset_ + green_->leadingWidth();
+    return {b, b + static_cast<std::uint32_t>(green_->text().size())};
+  }
+
+private:
+  friend class SyntaxNode;
+  SyntaxToken(const GreenToken *green, SyntaxNode parent, std::size_t index,
+              std::uint32_t offset)
+      : green_(green), parent_(std::move(parent)), index_(index),
+        offset_(offset) {}
+
+  const GreenToken *green_;
+  SyntaxNode parent_;
+  std::size_t index_;
+  std::uint32_t offset_;
+};
+
+// -----------------------------------------------------------------------------
+// Tree + builder
+// -----------------------------------------------------------------------------
+
+/// One comment found in the tree's trivia, in absolute offsets.
+struct CommentTrivia {
+  TriviaKind kind; // LineComment or BlockComment
+  std::uint32_t begin;
+  std::uint32_t end; // exclusive
+};
+
+/// A parsed document: root green node plus the cache that owns it.
+/// The comment index is built once at construction so consumers
+/// query comments by range instead of rescanning the source.
+class SyntaxTree {
+public:
+  SyntaxTree(std::shared_ptr<GreenCache> cache, const GreenNode *root);
+
+  [[nodiscard]] SyntaxNode root() const { return SyntaxNode::makeRoot(root_); }
+  [[nodiscard]] const GreenNode *greenRoot() const noexcept { return root_; }
+  [[nodiscard]] const std::shared_ptr<GreenCache> &cache() const noexcept {
+    return cache_;
+  }
+
+  /// Lossless reconstruction of the source buffer.
+  [[nodiscard]] std::string text() const { return root_->text(); }
+
+  /// Every comment in source order.
+  [[nodiscard]] llvm::ArrayRef<CommentTrivia> comments() const noexcept {
+    return comments_;
+  }
+  /// Comments starting in `[begin, end)`, in source order.
+  [[nodiscard]] llvm::ArrayRef<CommentTrivia>
+  commentsIn(std::uint32_t begin, std::uint32_t end) const;
+
+private:
+  std::shared_ptr<GreenCache> cache_;
+  const GreenNode *root_;
+  std::vector<CommentTrivia> comments_;
+};
+
+/// `CSTSink` that builds a green tree while the parser runs. Token
+/// bytes and trivia are sliced from `source`, which must be the
+/// buffer the lexer reads (offsets are taken from token ranges).
+///
+/// Usage:
+///   GreenTreeBuilder b(src);
+///   auto cu = parse::parseCompilationUnit(lex, diag, &b);
+///   SyntaxTree tree = b.finish();
+class GreenTreeBuilder : public ::nsl::parse::CSTSink {
+public:
+  explicit GreenTreeBuilder(llvm::StringRef source,
+                            std::shared_ptr<GreenCache> cache = nullptr);
+
+  void beginNode(llvm::StringRef kindName,
+                 const ::nsl::SourceLocation &start) override;
+  void recordToken(const ::nsl::Token &tok) override;
+  void endNode(const ::nsl::SourceLocation &end) override;
+  ::nsl::parse::CSTCheckpoint checkpoint() override;
+  void beginNodeAt(const ::nsl::parse::CSTCheckpoint &cp,
+                   llvm::StringRef kindName,
+                   const ::nsl::SourceLocation &start) override;
+
+  /// Close any frames left open by an error path, attach the rest
+  /// of the buffer to a `tk_eof` token and return the tree. The
+  /// builder is spent afterwards.
+  SyntaxTree finish();
+
+private:
+  struct Frame {
+    llvm::StringRef kind;
+    llvm::SmallVector<GreenElement, 8> children;
+  };
+
+  /// End of the trailing trivia starting at `from`: same-line
+  /// whitespace and comments plus the terminating newline.
+  std::uint32_t scanTrailing(std::uint32_t from) const;
+  /// Hang the unattached tail of the buffer off a `tk_eof` token in
+  /// the innermost open frame.
+  void appendEof();
+  void closeFrame();
+
+  llvm::StringRef src_;
+  std::shared_ptr<GreenCache> cache_;
+  llvm::SmallVector<Frame, 16> stack_;
+  const GreenNode *root_ = nullptr;
+  /// First source byte not yet attached to any token.
+  std::uint32_t cursor_ = 0;
+  bool eofAttached_ = false;
+};
+
+} // namespace nsl::syntax
+
+#endif // NSL_SYNTAX_SYNTAXTREE_H
@@ -35,6 +35,11 @@
 //     as printer-synthetic. M3+ may promote any of them to a real
 //     `NodeKind` (with the goldens re-cut in the same patch per
 //     Invariant 7 additivity).
+//
+// Output path: the walker emits events into a `DumpWriter`; the text
+// writer renders the S-expression form and the binary writer the
+// compact `dumpBinary()` form, both streaming into the caller's
+// `raw_ostream` with no per-node staging.
 
 #include "nsl/AST/Printer.h"
 
@@ -99,10 +104,16 @@
 #include "nsl/Basic/SourceLocation.h"
 #include "nsl/Basic/SourceManager.h"
 
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/LEB128.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace nsl::ast {
@@ -378,13 +389,267 @@ void renderTypeSuffix(const ::nsl::sema::Type *t, llvm::raw_ostream &os) {
   os << "Unresolved";
 }
 
+// ---------- Output writers ----------
+//
+// The walker below reports each node as a flat event stream — open a
+// record, attach fields, open / separate / close a child list — and a
+// `DumpWriter` turns the events into bytes. Both writers stream
+// straight into the caller's `raw_ostream`: nothing is staged per
+// node, so peak memory is the AST plus the stream's own buffer no
+// matter how large the dump is.
+
+class DumpWriter {
+public:
+  explicit DumpWriter(const SourceManager &sm) noexcept : sm_(sm) {}
+  virtual ~DumpWriter() = default;
+
+  DumpWriter(const DumpWriter &) = delete;
+  DumpWriter &operator=(const DumpWriter &) = delete;
+
+  /// Open a record for a real node (`NodeKind` + source range).
+  virtual void openNode(NodeKind k, SourceRange r) = 0;
+  /// Open a printer-synthetic wrapper record (`<StructMember>`, ...).
+  virtual void openSynthetic(llvm::StringRef tag) = 0;
+  /// Post-Sema type of the record just opened.
+  virtual void type(const ::nsl::sema::Type *t) = 0;
+  /// Post-Sema decl-loc of the name-ref record just opened.
+  virtual void declLoc(SourceLocation loc) = 0;
+  virtual void field(llvm::StringRef name, llvm::StringRef value) = 0;
+  virtual void field(llvm::StringRef name, unsigned value) = 0;
+  /// `name=a.b.c`.
+  virtual void scopedField(llvm::StringRef name, const ScopedName &sn) = 0;
+  /// `name=[a,b,c]`.
+  virtual void listField(llvm::StringRef name,
+                         const std::vector<Identifier> &names) = 0;
+  /// The open record has children; the next event opens the first.
+  virtual void beginChildren() = 0;
+  /// Between two children of the same record.
+  virtual void separator() = 0;
+  /// Close the record whose child list `beginChildren()` opened.
+  virtual void endChildren() = 0;
+  /// Close a record that has no children.
+  virtual void close() = 0;
+  /// After the root record closes.
+  virtual void finish() = 0;
+
+protected:
+  const SourceManager &sm_;
+};
+
+/// The `-emit=ast` S-expression text (`nslc-emit-ast.contract.md`).
+class TextWriter final : public DumpWriter {
+public:
+  TextWriter(const SourceManager &sm, llvm::raw_ostream &os) noexcept
+      : DumpWriter(sm), os_(os) {}
+
+  void openNode(NodeKind k, SourceRange r) override {
+    os_.indent(2 * indent_);
+    os_ << '(' << toString(k) << "  loc=";
+    emitRange(r);
+  }
+
+  void openSynthetic(llvm::StringRef tag) override {
+    os_.indent(2 * indent_);
+    os_ << "(<" << tag << '>';
+  }
+
+  void type(const ::nsl::sema::Type *t) override { renderTypeSuffix(t, os_); }
+
+  void declLoc(SourceLocation loc) override {
+    auto begin = sm_.resolveVirtual(loc);
+    os_ << " -> decl@" << begin.path << ':' << begin.line << ':' << begin.col;
+  }
+
+  /// Identifier values are emitted verbatim (no quoting); the
+  /// `Identifier` is a `StringRef` with no embedded whitespace by
+  /// construction (lexer guarantee).
+  void field(llvm::StringRef name, llvm::StringRef value) override {
+    os_ << "  " << name << '=' << value;
+  }
+
+  void field(llvm::StringRef name, unsigned value) override {
+    os_ << "  " << name << '=' << value;
+  }
+
+  void scopedField(llvm::StringRef name, const ScopedName &sn) override {
+    os_ << "  " << name << '=';
+    for (std::size_t i = 0, e = sn.parts.size(); i < e; ++i) {
+      if (i != 0) {
+        os_ << '.';
+      }
+      os_ << sn.parts[i];
+    }
+  }
+
+  void listField(llvm::StringRef name,
+                 const std::vector<Identifier> &names) override {
+    os_ << "  " << name << '=' << '[';
+    for (std::size_t i = 0, e = names.size(); i < e; ++i) {
+      if (i != 0) {
+        os_ << ',';
+      }
+      os_ << names[i];
+    }
+    os_ << ']';
+  }
+
+  void beginChildren() override {
+    os_ << '\n';
+    ++indent_;
+  }
+
+  void separator() override { os_ << '\n'; }
+
+  void endChildren() override {
+    --indent_;
+    os_ << ')';
+  }
+
+  void close() override { os_ << ')'; }
+
+  void finish() override { os_ << '\n'; }
+
+private:
+  /// Emit `path:line:col-line:col` in virtual coordinates.
+  void emitRange(SourceRange r) {
+    if (!r.isValid()) {
+      os_ << "<invalid>";
+      return;
+    }
+    auto begin = sm_.resolveVirtual(r.begin());
+    auto end = sm_.resolveVirtual(r.end());
+    os_ << begin.path << ':' << begin.line << ':' << begin.col << '-'
+        << end.line << ':' << end.col;
+  }
+
+  llvm::raw_ostream &os_;
+  unsigned indent_ = 0;
+};
+
+/// The compact binary dump (layout in `Printer.h`). Strings are
+/// interned on first use, so each path / identifier / field name
+/// costs its bytes once per dump.
+class BinaryWriter final : public DumpWriter {
+public:
+  BinaryWriter(const SourceManager &sm, llvm::raw_ostream &os)
+      : DumpWriter(sm), os_(os) {
+    os_ << kBinaryDumpMagic;
+    uleb(kBinaryDumpVersion);
+  }
+
+  void openNode(NodeKind k, SourceRange r) override {
+    tag(BinaryDumpTag::Node);
+    uleb(static_cast<uint64_t>(k));
+    if (!r.isValid()) {
+      str("");
+      return;
+    }
+    auto begin = sm_.resolveVirtual(r.begin());
+    auto end = sm_.resolveVirtual(r.end());
+    str(begin.path);
+    uleb(begin.line);
+    uleb(begin.col);
+    uleb(end.line);
+    uleb(end.col);
+  }
+
+  void openSynthetic(llvm::StringRef t) override {
+    tag(BinaryDumpTag::Synthetic);
+    str(t);
+  }
+
+  void type(const ::nsl::sema::Type *t) override {
+    if (t == nullptr) {
+      return;
+    }
+    scratch_.clear();
+    llvm::raw_svector_ostream ss(scratch_);
+    renderTypeSuffix(t, ss);
+    tag(BinaryDumpTag::Type);
+    // Drop the text form's leading " : ".
+    str(llvm::StringRef(scratch_).drop_front(3));
+  }
+
+  void declLoc(SourceLocation loc) override {
+    auto begin = sm_.resolveVirtual(loc);
+    tag(BinaryDumpTag::DeclLoc);
+    str(begin.path);
+    uleb(begin.line);
+    uleb(begin.col);
+  }
+
+  void field(llvm::StringRef name, llvm::StringRef value) override {
+    tag(BinaryDumpTag::StrField);
+    str(name);
+    str(value);
+  }
+
+  void field(llvm::StringRef name, unsigned value) override {
+    tag(BinaryDumpTag::UIntField);
+    str(name);
+    uleb(value);
+  }
+
+  void scopedField(llvm::StringRef name, const ScopedName &sn) override {
+    tag(BinaryDumpTag::ListField);
+    str(name);
+    uleb(sn.parts.size());
+    for (Identifier part : sn.parts) {
+      str(part);
+    }
+  }
+
+  void listField(llvm::StringRef name,
+                 const std::vector<Identifier> &names) override {
+    tag(BinaryDumpTag::ListField);
+    str(name);
+    uleb(names.size());
+    for (Identifier id : names) {
+      str(id);
+    }
+  }
+
+  // Nesting is implicit in the open / close pairing.
+  void beginChildren() override {}
+  void separator() override {}
+  void endChildren() override { tag(BinaryDumpTag::Close); }
+  void close() override { tag(BinaryDumpTag::Close); }
+  void finish() override { tag(BinaryDumpTag::End); }
+
+private:
+  void tag(BinaryDumpTag t) { os_ << static_cast<char>(t); }
+
+  void uleb(uint64_t v) {
+    uint8_t buf[10];
+    unsigned n = llvm::encodeULEB128(v, buf);
+    os_.write(reinterpret_cast<const char *>(buf), n);
+  }
+
+  /// Interned string: `ULEB(id + 1)` for a string already sent, or
+  /// `0, ULEB(len), bytes` for a new one (which takes the next id).
+  void str(llvm::StringRef s) {
+    auto [it, inserted] = strings_.try_emplace(s, strings_.size());
+    if (!inserted) {
+      uleb(it->second + 1);
+      return;
+    }
+    uleb(0);
+    uleb(s.size());
+    os_ << s;
+  }
+
+  llvm::raw_ostream &os_;
+  llvm::StringMap<uint64_t> strings_;
+  llvm::SmallString<32> scratch_;
+};
+
 // ---------- The walker ----------
 
 class PrinterVisitor final : public ASTVisitor {
 public:
-  PrinterVisitor(const SourceManager &sm, llvm::raw_ostream &os,
-                 DeclLocLookupFn decl_lookup = nullptr) noexcept
-      : sm_(sm), os_(os), decl_lookup_(decl_lookup) {}
+  explicit PrinterVisitor(DumpWriter &w,
+                          DeclLocLookupFn decl_lookup = nullptr) noexcept
+      : w_(w), decl_lookup_(decl_lookup) {}
 
   void visit(const CompilationUnit &n) override;
   void visit(const StructDecl &n) override;
@@ -446,14 +711,8 @@ public:
 private:
   // ---------- Output helpers ----------
 
-  void emitIndent() const {
-    for (int i = 0; i < indent_; ++i) {
-      os_ << "  ";
-    }
-  }
-
-  /// Emit `(NodeKind  loc=<range>` ready for kind-specific
-  /// fields/children. No trailing space; callers add their own.
+  /// Open the record for `n`, ready for kind-specific fields and
+  /// children.
   ///
   /// Post-Sema mode (Phase 3 T031-T033): when `n` is an `Expr`
   /// whose `inferredType() != nullptr`, append the additive
@@ -462,26 +721,22 @@ private:
   /// ` → decl@<file>:<line>:<col>` suffix per Invariant 3. Pre-
   /// Sema mode (Invariant 4) emits the M2 format unchanged.
   void emitOpen(const ASTNode &n) {
-    emitIndent();
-    os_ << '(' << toString(n.kind()) << "  loc=";
-    emitRange(n.loc());
+    w_.openNode(n.kind(), n.loc());
     // Detect post-Sema mode by checking `inferredType()` on Expr
     // nodes. Non-Expr nodes are unaffected.
     if (isExprKind(n.kind())) {
       const Expr &e = static_cast<const Expr &>(n);
       if (e.inferredType() != nullptr) {
-        renderTypeSuffix(e.inferredType(), os_);
+        w_.type(e.inferredType());
         // Decl-loc suffix (Invariant 3): only for name-refs whose
         // resolved Symbol* is non-null, AND only when the type is
         // not Unresolved.
-        if (decl_lookup_ != nullptr &&
+        if (decl_lookup_ &&
             e.inferredType()->kind() != ::nsl::sema::TypeKind::Unresolved &&
             isNameRefKind(n.kind())) {
           SourceRange decl_range = decl_lookup_(&e);
           if (decl_range.isValid()) {
-            auto begin = sm_.resolveVirtual(decl_range.begin());
-            os_ << " -> decl@" << begin.path << ':' << begin.line << ':'
-                << begin.col;
+            w_.declLoc(decl_range.begin());
           }
         }
       }
@@ -519,57 +774,29 @@ private:
            k == NodeKind::NK_FieldAccessExpr;
   }
 
-  /// Emit `path:line:col-line:col` in virtual coordinates.
-  void emitRange(SourceRange r) const {
-    if (!r.isValid()) {
-      os_ << "<invalid>";
-      return;
-    }
-    auto begin = sm_.resolveVirtual(r.begin());
-    auto end = sm_.resolveVirtual(r.end());
-    os_ << begin.path << ':' << begin.line << ':' << begin.col << '-'
-        << end.line << ':' << end.col;
-  }
-
   /// Emit `  name=<value>` — leading two-space separator built in.
-  /// Identifier values are emitted verbatim (no quoting); the
-  /// `Identifier` is a `StringRef` with no embedded whitespace by
-  /// construction (lexer guarantee).
-  void emitField(llvm::StringRef name, llvm::StringRef value) const {
-    os_ << "  " << name << '=' << value;
+  void emitField(llvm::StringRef name, llvm::StringRef value) {
+    w_.field(name, value);
   }
 
-  void emitField(llvm::StringRef name, unsigned value) const {
-    os_ << "  " << name << '=' << value;
+  void emitField(llvm::StringRef name, unsigned value) {
+    w_.field(name, value);
   }
 
   /// Emit a `ScopedName` as `a.b.c`.
-  void emitScopedName(llvm::StringRef name, const ScopedName &sn) const {
-    os_ << "  " << name << '=';
-    for (std::size_t i = 0, e = sn.parts.size(); i < e; ++i) {
-      if (i != 0) {
-        os_ << '.';
-      }
-      os_ << sn.parts[i];
-    }
+  void emitScopedName(llvm::StringRef name, const ScopedName &sn) {
+    w_.scopedField(name, sn);
   }
 
   /// Emit a list-of-identifiers as `name=[a,b,c]` with no spaces
   /// between elements.
   void emitNameList(llvm::StringRef field,
-                    const std::vector<Identifier> &names) const {
-    os_ << "  " << field << '=' << '[';
-    for (std::size_t i = 0, e = names.size(); i < e; ++i) {
-      if (i != 0) {
-        os_ << ',';
-      }
-      os_ << names[i];
-    }
-    os_ << ']';
+                    const std::vector<Identifier> &names) {
+    w_.listField(field, names);
   }
 
   /// Close `(...)` for a node with no children — same line.
-  void closeNoChildren() const { os_ << ')'; }
+  void closeNoChildren() { w_.close(); }
 
   /// Emit children, each as a recursive `accept` call. Newlines
   /// separate siblings; the last child's last line absorbs the
@@ -579,17 +806,15 @@ private:
   ///
   /// Empty `children` is a programming error at this site —
   /// callers should use `closeNoChildren()` for childless nodes.
-  void emitChildren(const std::vector<const ASTNode *> &children) {
-    os_ << '\n';
-    ++indent_;
+  void emitChildren(llvm::ArrayRef<const ASTNode *> children) {
+    w_.beginChildren();
     for (std::size_t i = 0, e = children.size(); i < e; ++i) {
       if (i != 0) {
-        os_ << '\n';
+        w_.separator();
       }
       children[i]->accept(*this);
     }
-    --indent_;
-    os_ << ')';
+    w_.endChildren();
   }
 
   /// Emit a synthetic wrapper line for an aggregate sub-record
@@ -598,15 +823,10 @@ private:
   /// for printer roundtrip purposes. The angle brackets in the tag
   /// flag the line as printer-synthetic (Invariant 6 — these are
   /// not `NodeKind` enumerators).
-  void emitSyntheticIndent(llvm::StringRef tag) const {
-    emitIndent();
-    os_ << "(<" << tag << '>';
-  }
+  void emitSyntheticIndent(llvm::StringRef tag) { w_.openSynthetic(tag); }
 
-  const SourceManager &sm_;
-  llvm::raw_ostream &os_;
+  DumpWriter &w_;
   DeclLocLookupFn decl_lookup_;
-  int indent_ = 0;
 };
 
 // ---------- visit() implementations ----------
@@ -617,7 +837,7 @@ void PrinterVisitor::visit(const CompilationUnit &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.items().size());
   for (const auto &item : n.items()) {
     kids.push_back(item.get());
@@ -634,27 +854,23 @@ void PrinterVisitor::visit(const StructDecl &n) {
   }
   // Synthetic wrapper per member: `(<StructMember> name=<id>` with
   // optional width Expr as a child.
-  os_ << '\n';
-  ++indent_;
+  w_.beginChildren();
   for (std::size_t i = 0, e = n.members().size(); i < e; ++i) {
     const StructMember &m = n.members()[i];
     if (i != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("StructMember");
     emitField("name", m.name);
     if (m.width) {
-      os_ << '\n';
-      ++indent_;
+      w_.beginChildren();
       m.width->accept(*this);
-      --indent_;
-      os_ << ')';
+      w_.endChildren();
     } else {
-      os_ << ')';
+      w_.close();
     }
   }
-  --indent_;
-  os_ << ')';
+  w_.endChildren();
 }
 
 void PrinterVisitor::visit(const TopLevelParamDecl &n) {
@@ -674,7 +890,7 @@ void PrinterVisitor::visit(const DeclareBlock &n) {
     emitField("name", n.name());
   }
   emitField("modifier", toString(n.modifier()));
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.headerParams().size() + n.ports().size());
   for (const auto &p : n.headerParams()) {
     kids.push_back(p.get());
@@ -709,7 +925,7 @@ void PrinterVisitor::visit(const PortDecl &n) {
 void PrinterVisitor::visit(const ModuleBlock &n) {
   emitOpen(n);
   emitField("name", n.name());
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.internals().size() + n.actions().size() + n.funcs().size() +
                n.procs().size());
   for (const auto &p : n.internals()) {
@@ -734,7 +950,7 @@ void PrinterVisitor::visit(const ModuleBlock &n) {
 void PrinterVisitor::visit(const RegDecl &n) {
   emitOpen(n);
   emitField("name", n.name());
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.width() != nullptr) {
     kids.push_back(n.width());
   }
@@ -777,7 +993,7 @@ void PrinterVisitor::visit(const IntegerDecl &n) {
 void PrinterVisitor::visit(const MemDecl &n) {
   emitOpen(n);
   emitField("name", n.name());
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.depth() != nullptr) {
     kids.push_back(n.depth());
   }
@@ -834,45 +1050,39 @@ void PrinterVisitor::visit(const SubmoduleDecl &n) {
     closeNoChildren();
     return;
   }
-  os_ << '\n';
-  ++indent_;
+  w_.beginChildren();
   std::size_t emitted = 0;
   for (const auto &inst : n.instances()) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("Instance");
     emitField("name", inst.name);
     if (inst.arraySize) {
-      os_ << '\n';
-      ++indent_;
+      w_.beginChildren();
       inst.arraySize->accept(*this);
-      --indent_;
-      os_ << ')';
+      w_.endChildren();
     } else {
-      os_ << ')';
+      w_.close();
     }
     ++emitted;
   }
   for (const auto &pa : n.paramAssigns()) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("ParamAssign");
     emitField("name", pa.name);
     if (pa.value) {
-      os_ << '\n';
-      ++indent_;
+      w_.beginChildren();
       pa.value->accept(*this);
-      --indent_;
-      os_ << ')';
+      w_.endChildren();
     } else {
-      os_ << ')';
+      w_.close();
     }
     ++emitted;
   }
-  --indent_;
-  os_ << ')';
+  w_.endChildren();
 }
 
 void PrinterVisitor::visit(const StructInstDecl &n) {
@@ -880,7 +1090,7 @@ void PrinterVisitor::visit(const StructInstDecl &n) {
   emitField("typeName", n.typeName());
   emitField("instanceName", n.instanceName());
   emitField("storage", toString(n.storageKind()));
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.arraySize() != nullptr) {
     kids.push_back(n.arraySize());
   }
@@ -929,7 +1139,7 @@ void PrinterVisitor::visit(const StateDefn &n) {
 void PrinterVisitor::visit(const TransferStmt &n) {
   emitOpen(n);
   emitField("op", toString(n.op()));
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.lhs() != nullptr) {
     kids.push_back(n.lhs());
   }
@@ -961,7 +1171,7 @@ void PrinterVisitor::visit(const ControlCallStmt &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.args().size());
   for (const auto &a : n.args()) {
     kids.push_back(a.get());
@@ -981,7 +1191,7 @@ void PrinterVisitor::visit(const SystemTaskStmt &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.args().size());
   for (const auto &a : n.args()) {
     kids.push_back(a.get());
@@ -1025,7 +1235,7 @@ void PrinterVisitor::visit(const InitBlockStmt &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.items().size());
   for (const auto &p : n.items()) {
     kids.push_back(p.get());
@@ -1048,7 +1258,7 @@ void PrinterVisitor::visit(const ParallelBlock &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.items().size() + n.decls().size());
   for (const auto &p : n.decls()) {
     kids.push_back(p.get());
@@ -1068,40 +1278,34 @@ void PrinterVisitor::visit(const AltBlock &n) {
     closeNoChildren();
     return;
   }
-  os_ << '\n';
-  ++indent_;
+  w_.beginChildren();
   std::size_t emitted = 0;
   for (const auto &c : n.cases()) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("CondCase");
-    os_ << '\n';
-    ++indent_;
+    w_.beginChildren();
     if (c.cond) {
       c.cond->accept(*this);
-      os_ << '\n';
+      w_.separator();
     }
     if (c.body) {
       c.body->accept(*this);
     }
-    --indent_;
-    os_ << ')';
+    w_.endChildren();
     ++emitted;
   }
   if (n.elseCase() != nullptr) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("ElseCase");
-    os_ << '\n';
-    ++indent_;
+    w_.beginChildren();
     n.elseCase()->accept(*this);
-    --indent_;
-    os_ << ')';
+    w_.endChildren();
   }
-  --indent_;
-  os_ << ')';
+  w_.endChildren();
 }
 
 void PrinterVisitor::visit(const AnyBlock &n) {
@@ -1111,40 +1315,34 @@ void PrinterVisitor::visit(const AnyBlock &n) {
     closeNoChildren();
     return;
   }
-  os_ << '\n';
-  ++indent_;
+  w_.beginChildren();
   std::size_t emitted = 0;
   for (const auto &c : n.cases()) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("CondCase");
-    os_ << '\n';
-    ++indent_;
+    w_.beginChildren();
     if (c.cond) {
       c.cond->accept(*this);
-      os_ << '\n';
+      w_.separator();
     }
     if (c.body) {
       c.body->accept(*this);
     }
-    --indent_;
-    os_ << ')';
+    w_.endChildren();
     ++emitted;
   }
   if (n.elseCase() != nullptr) {
     if (emitted != 0) {
-      os_ << '\n';
+      w_.separator();
     }
     emitSyntheticIndent("ElseCase");
-    os_ << '\n';
-    ++indent_;
+    w_.beginChildren();
     n.elseCase()->accept(*this);
-    --indent_;
-    os_ << ')';
+    w_.endChildren();
   }
-  --indent_;
-  os_ << ')';
+  w_.endChildren();
 }
 
 void PrinterVisitor::visit(const SeqBlock &n) {
@@ -1153,7 +1351,7 @@ void PrinterVisitor::visit(const SeqBlock &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.items().size() + n.decls().size());
   for (const auto &p : n.decls()) {
     kids.push_back(p.get());
@@ -1166,7 +1364,7 @@ void PrinterVisitor::visit(const SeqBlock &n) {
 
 void PrinterVisitor::visit(const WhileBlock &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.cond() != nullptr) {
     kids.push_back(n.cond());
   }
@@ -1182,7 +1380,7 @@ void PrinterVisitor::visit(const WhileBlock &n) {
 
 void PrinterVisitor::visit(const ForBlock &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.form().init) {
     kids.push_back(n.form().init.get());
   }
@@ -1204,7 +1402,7 @@ void PrinterVisitor::visit(const ForBlock &n) {
 
 void PrinterVisitor::visit(const IfStmt &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.cond() != nullptr) {
     kids.push_back(n.cond());
   }
@@ -1224,7 +1422,7 @@ void PrinterVisitor::visit(const IfStmt &n) {
 void PrinterVisitor::visit(const StructuralGenerate &n) {
   emitOpen(n);
   emitField("init", n.init());
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.initValue() != nullptr) {
     kids.push_back(n.initValue());
   }
@@ -1281,7 +1479,7 @@ void PrinterVisitor::visit(const UnaryExpr &n) {
 void PrinterVisitor::visit(const BinaryExpr &n) {
   emitOpen(n);
   emitField("op", toString(n.op()));
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.lhs() != nullptr) {
     kids.push_back(n.lhs());
   }
@@ -1297,7 +1495,7 @@ void PrinterVisitor::visit(const BinaryExpr &n) {
 
 void PrinterVisitor::visit(const ConditionalExpr &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.cond() != nullptr) {
     kids.push_back(n.cond());
   }
@@ -1320,7 +1518,7 @@ void PrinterVisitor::visit(const ConcatExpr &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.parts().size());
   for (const auto &p : n.parts()) {
     kids.push_back(p.get());
@@ -1330,7 +1528,7 @@ void PrinterVisitor::visit(const ConcatExpr &n) {
 
 void PrinterVisitor::visit(const RepeatExpr &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.count() != nullptr) {
     kids.push_back(n.count());
   }
@@ -1346,7 +1544,7 @@ void PrinterVisitor::visit(const RepeatExpr &n) {
 
 void PrinterVisitor::visit(const SignExtendExpr &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.width() != nullptr) {
     kids.push_back(n.width());
   }
@@ -1362,7 +1560,7 @@ void PrinterVisitor::visit(const SignExtendExpr &n) {
 
 void PrinterVisitor::visit(const ZeroExtendExpr &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.width() != nullptr) {
     kids.push_back(n.width());
   }
@@ -1378,7 +1576,7 @@ void PrinterVisitor::visit(const ZeroExtendExpr &n) {
 
 void PrinterVisitor::visit(const SliceExpr &n) {
   emitOpen(n);
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   if (n.sub() != nullptr) {
     kids.push_back(n.sub());
   }
@@ -1412,7 +1610,7 @@ void PrinterVisitor::visit(const CallExpr &n) {
     closeNoChildren();
     return;
   }
-  std::vector<const ASTNode *> kids;
+  llvm::SmallVector<const ASTNode *, 8> kids;
   kids.reserve(n.args().size());
   for (const auto &a : n.args()) {
     kids.push_back(a.get());
@@ -1450,16 +1648,23 @@ void PrinterVisitor::visit(const IncDecExpr &n) {
 
 void print(const CompilationUnit &cu, const SourceManager &sm,
            llvm::raw_ostream &os) {
-  PrinterVisitor v(sm, os, /*decl_lookup=*/nullptr);
-  cu.accept(v);
-  os << '\n';
+  print(cu, sm, os, /*decl_lookup=*/nullptr);
 }
 
 void print(const CompilationUnit &cu, const SourceManager &sm,
            llvm::raw_ostream &os, DeclLocLookupFn decl_lookup) {
-  PrinterVisitor v(sm, os, decl_lookup);
+  TextWriter w(sm, os);
+  PrinterVisitor v(w, decl_lookup);
+  cu.accept(v);
+  w.finish();
+}
+
+void dumpBinary(const CompilationUnit &cu, const SourceManager &sm,
+                llvm::raw_ostream &os, DeclLocLookupFn decl_lookup) {
+  BinaryWriter w(sm, os);
+  PrinterVisitor v(w, decl_lookup);
   cu.accept(v);
-  os << '\n';
+  w.finish();
 }
 
 } // namespace nsl::ast
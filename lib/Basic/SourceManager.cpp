@@ -221,6 +221,15 @@ llvm::StringRef SourceManager::getLine(SourceLocation loc) const {
   return {b.bytes.data() + line_start, line_end - line_start};
 }
 
+void SourceManager::buildLineTables() const {
+  // Skip the index-0 sentinel.
+  for (size_t i = 1; i < impl_->buffers.size(); ++i) {
+    if (impl_->buffers[i]) {
+      buildLineOffsetsIfNeeded(*impl_->buffers[i]);
+    }
+  }
+}
+
 SourceManager::VirtualLoc
 SourceManager::resolveVirtual(SourceLocation loc) const {
   Buffer &b = impl_->buffer(loc.file());
@@ -0,0 +1,634 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Dialect/NSL/IR/NSLFolds.cpp — folders, canonicalization
+// patterns and the constant materializer for the Pure expression ops
+// (M4 dialect, layer 7).
+//
+// Every fold works on `!nsl.bits<N>` values as `llvm::APInt`s of
+// width N, with the unsigned modulo-2^N semantics the op
+// descriptions in `NSLOps.td` spell out. A folded constant must be
+// expressible as an `nsl.constant`, so constant folding only fires
+// when the result is at most 64 bits wide (the `I64Attr` limit). The
+// identity folds (`x + 0`, `~~x`, a full-width `nsl.extract`, ...)
+// only forward an existing value, so they have no such limit.
+//
+// Folded constants are `IntegerAttr`s of type `i64` holding the
+// zero-extended bit pattern — the same form `nsl.constant` stores —
+// so `NSLDialect::materializeConstant` rebuilds them unchanged.
+//
+// Commutative ops (`Commutative` trait) only test their RHS for a
+// constant. MLIR runs the op's own fold hook first; only when that
+// fails does the trait fold move a constant operand to the right,
+// and the greedy driver then folds the reordered op on its next
+// visit. So `0 + x` folds too, one iteration later than `x + 0`.
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
+#include "mlir/IR/BuiltinTypes.h"
+#include "mlir/IR/PatternMatch.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+
+#include <cstdint>
+#include <optional>
+
+namespace nsl::dialect {
+
+namespace {
+
+/// Width of `type` if it is a bits type an `nsl.constant` can hold.
+std::optional<unsigned> foldableWidth(mlir::Type type) {
+  auto bits = mlir::dyn_cast<BitsType>(type);
+  if (!bits || bits.getWidth() > 64) {
+    return std::nullopt;
+  }
+  return bits.getWidth();
+}
+
+/// Width of a bits-typed value.
+unsigned widthOf(mlir::Value v) {
+  return mlir::cast<BitsType>(v.getType()).getWidth();
+}
+
+/// `attr` as a value of `type`, if it is a folded `nsl.constant`.
+std::optional<llvm::APInt> constantBits(mlir::Attribute attr,
+                                        mlir::Type type) {
+  auto intAttr = mlir::dyn_cast_or_null<mlir::IntegerAttr>(attr);
+  std::optional<unsigned> width = foldableWidth(type);
+  if (!intAttr || !width) {
+    return std::nullopt;
+  }
+  uint64_t raw = static_cast<uint64_t>(intAttr.getInt());
+  if (*width < 64) {
+    raw &= (uint64_t{1} << *width) - 1;
+  }
+  return llvm::APInt(*width, raw);
+}
+
+/// The folded-constant attribute for `v`.
+mlir::Attribute bitsAttr(mlir::MLIRContext *ctx, const llvm::APInt &v) {
+  return mlir::IntegerAttr::get(mlir::IntegerType::get(ctx, 64),
+                                static_cast<int64_t>(v.getZExtValue()));
+}
+
+/// All-zeros of `type`, or null if `type` is too wide to fold.
+mlir::Attribute zeroOf(mlir::MLIRContext *ctx, mlir::Type type) {
+  std::optional<unsigned> width = foldableWidth(type);
+  if (!width) {
+    return {};
+  }
+  return bitsAttr(ctx, llvm::APInt(*width, 0));
+}
+
+/// A width-1 truth value.
+mlir::Attribute boolAttr(mlir::MLIRContext *ctx, bool v) {
+  return bitsAttr(ctx, llvm::APInt(1, v ? 1 : 0));
+}
+
+/// Folds `op(lhs, rhs)` when both operands are constant; `fn` maps
+/// the two operand values to the result.
+template <typename Fn>
+mlir::Attribute foldConstants(mlir::Operation *op, mlir::Attribute lhs,
+                              mlir::Attribute rhs, Fn fn) {
+  mlir::Type type = op->getOperand(0).getType();
+  std::optional<llvm::APInt> a = constantBits(lhs, type);
+  std::optional<llvm::APInt> b = constantBits(rhs, type);
+  if (!a || !b) {
+    return {};
+  }
+  return fn(*a, *b);
+}
+
+/// Folds a same-width binary op whose operands are both constant.
+template <typename Fn>
+mlir::Attribute foldArith(mlir::Operation *op, mlir::Attribute lhs,
+                          mlir::Attribute rhs, Fn fn) {
+  return foldConstants(op, lhs, rhs,
+                       [&](const llvm::APInt &a, const llvm::APInt &b) {
+                         return bitsAttr(op->getContext(), fn(a, b));
+                       });
+}
+
+/// Folds a comparison whose operands are both constant.
+template <typename Fn>
+mlir::Attribute foldCompare(mlir::Operation *op, mlir::Attribute lhs,
+                            mlir::Attribute rhs, Fn fn) {
+  return foldConstants(op, lhs, rhs,
+                       [&](const llvm::APInt &a, const llvm::APInt &b) {
+                         return boolAttr(op->getContext(), fn(a, b));
+                       });
+}
+
+/// `a` shifted by the amount `b`; a shift by the width or more
+/// clears every bit.
+llvm::APInt shiftLeft(const llvm::APInt &a, const llvm::APInt &b) {
+  uint64_t amount = b.getLimitedValue();
+  if (amount >= a.getBitWidth()) {
+    return llvm::APInt(a.getBitWidth(), 0);
+  }
+  return a.shl(static_cast<unsigned>(amount));
+}
+
+llvm::APInt shiftRight(const llvm::APInt &a, const llvm::APInt &b) {
+  uint64_t amount = b.getLimitedValue();
+  if (amount >= a.getBitWidth()) {
+    return llvm::APInt(a.getBitWidth(), 0);
+  }
+  return a.lshr(static_cast<unsigned>(amount));
+}
+
+/// The constant value of `rhs` when it is a folded `nsl.constant`.
+std::optional<llvm::APInt> rhsConstant(mlir::Operation *op,
+                                       mlir::Attribute rhs) {
+  return constantBits(rhs, op->getOperand(1).getType());
+}
+
+/// Shared body of the three reductions: a width-1 operand is its own
+/// reduction, and a constant operand folds through `fn`. Zero-width
+/// operands are left alone.
+template <typename Fn>
+mlir::OpFoldResult foldReduce(mlir::Operation *op, mlir::Attribute operand,
+                              Fn fn) {
+  mlir::Value v = op->getOperand(0);
+  if (widthOf(v) == 1) {
+    return v;
+  }
+  std::optional<llvm::APInt> a = constantBits(operand, v.getType());
+  if (!a || a->getBitWidth() == 0) {
+    return {};
+  }
+  return boolAttr(op->getContext(), fn(*a));
+}
+
+/// `nsl.concat` with nested `nsl.concat` or zero-width operands:
+/// splice the nested operands in and drop the zero-width ones. A
+/// concat left with no operands is the zero-width constant.
+struct SimplifyConcat : public mlir::OpRewritePattern<ConcatOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(ConcatOp op, mlir::PatternRewriter &rewriter) const final {
+    llvm::SmallVector<mlir::Value, 4> operands;
+    bool changed = false;
+    for (mlir::Value v : op.getOperands()) {
+      if (auto inner = v.getDefiningOp<ConcatOp>()) {
+        llvm::append_range(operands, inner.getOperands());
+        changed = true;
+      } else if (widthOf(v) == 0) {
+        changed = true;
+      } else {
+        operands.push_back(v);
+      }
+    }
+    if (!changed) {
+      return mlir::failure();
+    }
+    mlir::Type type = op.getResult().getType();
+    if (operands.empty()) {
+      auto zero = ConstantOp::create(rewriter, op.getLoc(), type,
+                                     rewriter.getI64IntegerAttr(0));
+      rewriter.replaceOp(op, zero.getResult());
+      return mlir::success();
+    }
+    auto concat = ConcatOp::create(rewriter, op.getLoc(), type, operands);
+    rewriter.replaceOp(op, concat.getResult());
+    return mlir::success();
+  }
+};
+
+/// `nsl.extract` of an `nsl.concat` whose slice lies inside one
+/// concat operand: extract from that operand directly.
+struct ExtractFromConcat : public mlir::OpRewritePattern<ExtractOp> {
+  using OpRewritePattern::OpRewritePattern;
+
+  mlir::LogicalResult
+  matchAndRewrite(ExtractOp op, mlir::PatternRewriter &rewriter) const final {
+    auto concat = op.getOperand().getDefiningOp<ConcatOp>();
+    if (!concat) {
+      return mlir::failure();
+    }
+    const uint64_t low = op.getLowBit();
+    const uint64_t width = widthOf(op.getResult());
+    // Operands are MSB-first, so the last one holds bit 0.
+    uint64_t offset = 0;
+    for (mlir::Value v : llvm::reverse(concat.getOperands())) {
+      const uint64_t w = widthOf(v);
+      if (w > 0 && low >= offset && low + width <= offset + w) {
+        auto slice = ExtractOp::create(
+            rewriter, op.getLoc(), op.getResult().getType(), v,
+            rewriter.getI64IntegerAttr(static_cast<int64_t>(low - offset)));
+        rewriter.replaceOp(op, slice.getResult());
+        return mlir::success();
+      }
+      offset += w;
+    }
+    return mlir::failure();
+  }
+};
+
+} // namespace
+
+mlir::Operation *NSLDialect::materializeConstant(mlir::OpBuilder &builder,
+                                                 mlir::Attribute value,
+                                                 mlir::Type type,
+                                                 mlir::Location loc) {
+  auto intAttr = mlir::dyn_cast<mlir::IntegerAttr>(value);
+  if (!intAttr || !foldableWidth(type)) {
+    return nullptr;
+  }
+  return ConstantOp::create(builder, loc, type, intAttr);
+}
+
+mlir::OpFoldResult ConstantOp::fold(FoldAdaptor) { return getValueAttr(); }
+
+// ---------------------------------------------------------------------------
+// Binary arithmetic / bitwise / shift.
+// ---------------------------------------------------------------------------
+
+mlir::OpFoldResult AddOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs()); b && b->isZero()) {
+    return getLhs();
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a + b;
+                   });
+}
+
+mlir::OpFoldResult SubOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs()); b && b->isZero()) {
+    return getLhs();
+  }
+  if (getLhs() == getRhs()) {
+    return zeroOf(getContext(), getType());
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a - b;
+                   });
+}
+
+mlir::OpFoldResult MulOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs())) {
+    if (b->isZero()) {
+      return adaptor.getRhs();
+    }
+    if (b->isOne()) {
+      return getLhs();
+    }
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a * b;
+                   });
+}
+
+mlir::OpFoldResult AndOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs())) {
+    if (b->isZero()) {
+      return adaptor.getRhs();
+    }
+    if (b->isAllOnes()) {
+      return getLhs();
+    }
+  }
+  if (getLhs() == getRhs()) {
+    return getLhs();
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a & b;
+                   });
+}
+
+mlir::OpFoldResult OrOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs())) {
+    if (b->isZero()) {
+      return getLhs();
+    }
+    if (b->isAllOnes()) {
+      return adaptor.getRhs();
+    }
+  }
+  if (getLhs() == getRhs()) {
+    return getLhs();
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a | b;
+                   });
+}
+
+mlir::OpFoldResult XorOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs()); b && b->isZero()) {
+    return getLhs();
+  }
+  if (getLhs() == getRhs()) {
+    return zeroOf(getContext(), getType());
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(),
+                   [](const llvm::APInt &a, const llvm::APInt &b) {
+                     return a ^ b;
+                   });
+}
+
+mlir::OpFoldResult ShlOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs()); b && b->isZero()) {
+    return getLhs();
+  }
+  if (auto a = constantBits(adaptor.getLhs(), getType()); a && a->isZero()) {
+    return adaptor.getLhs();
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(), shiftLeft);
+}
+
+mlir::OpFoldResult ShrOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs()); b && b->isZero()) {
+    return getLhs();
+  }
+  if (auto a = constantBits(adaptor.getLhs(), getType()); a && a->isZero()) {
+    return adaptor.getLhs();
+  }
+  return foldArith(*this, adaptor.getLhs(), adaptor.getRhs(), shiftRight);
+}
+
+// ---------------------------------------------------------------------------
+// Comparisons and logical AND / OR. A comparison of a value with
+// itself is decided without knowing the value.
+// ---------------------------------------------------------------------------
+
+mlir::OpFoldResult EqOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), true);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a == b;
+                     });
+}
+
+mlir::OpFoldResult NeOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), false);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a != b;
+                     });
+}
+
+mlir::OpFoldResult LtOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), false);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a.ult(b);
+                     });
+}
+
+mlir::OpFoldResult LeOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), true);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a.ule(b);
+                     });
+}
+
+mlir::OpFoldResult GtOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), false);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a.ugt(b);
+                     });
+}
+
+mlir::OpFoldResult GeOp::fold(FoldAdaptor adaptor) {
+  if (getLhs() == getRhs()) {
+    return boolAttr(getContext(), true);
+  }
+  return foldCompare(*this, adaptor.getLhs(), adaptor.getRhs(),
+                     [](const llvm::APInt &a, const llvm::APInt &b) {
+                       return a.uge(b);
+                     });
+}
+
+// The verifier pins `nsl.land` / `nsl.lor` operands to width 1, so
+// forwarding an operand keeps the result type.
+mlir::OpFoldResult LandOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs())) {
+    return b->isZero() ? mlir::OpFoldResult(adaptor.getRhs())
+                       : mlir::OpFoldResult(getLhs());
+  }
+  if (getLhs() == getRhs()) {
+    return getLhs();
+  }
+  return {};
+}
+
+mlir::OpFoldResult LorOp::fold(FoldAdaptor adaptor) {
+  if (auto b = rhsConstant(*this, adaptor.getRhs())) {
+    return b->isZero() ? mlir::OpFoldResult(getLhs())
+                       : mlir::OpFoldResult(adaptor.getRhs());
+  }
+  if (getLhs() == getRhs()) {
+    return getLhs();
+  }
+  return {};
+}
+
+// ---------------------------------------------------------------------------
+// Unary ops. `~~x`, `--x` and `!!x` are `x`; a reduction of a single
+// bit is that bit.
+// ---------------------------------------------------------------------------
+
+mlir::OpFoldResult NotOp::fold(FoldAdaptor adaptor) {
+  if (auto inner = getOperand().getDefiningOp<NotOp>()) {
+    return inner.getOperand();
+  }
+  if (auto a = constantBits(adaptor.getOperand(), getType())) {
+    return bitsAttr(getContext(), ~*a);
+  }
+  return {};
+}
+
+mlir::OpFoldResult NegOp::fold(FoldAdaptor adaptor) {
+  if (auto inner = getOperand().getDefiningOp<NegOp>()) {
+    return inner.getOperand();
+  }
+  if (auto a = constantBits(adaptor.getOperand(), getType())) {
+    return bitsAttr(getContext(), -*a);
+  }
+  return {};
+}
+
+mlir::OpFoldResult LnotOp::fold(FoldAdaptor adaptor) {
+  if (auto inner = getOperand().getDefiningOp<LnotOp>()) {
+    return inner.getOperand();
+  }
+  if (auto a = constantBits(adaptor.getOperand(), getOperand().getType())) {
+    return boolAttr(getContext(), a->isZero());
+  }
+  return {};
+}
+
+mlir::OpFoldResult ReduceAndOp::fold(FoldAdaptor adaptor) {
+  return foldReduce(*this, adaptor.getOperand(),
+                    [](const llvm::APInt &a) { return a.isAllOnes(); });
+}
+
+mlir::OpFoldResult ReduceOrOp::fold(FoldAdaptor adaptor) {
+  return foldReduce(*this, adaptor.getOperand(),
+                    [](const llvm::APInt &a) { return !a.isZero(); });
+}
+
+mlir::OpFoldResult ReduceXorOp::fold(FoldAdaptor adaptor) {
+  return foldReduce(*this, adaptor.getOperand(), [](const llvm::APInt &a) {
+    return (a.popcount() & 1) != 0;
+  });
+}
+
+// ---------------------------------------------------------------------------
+// Extends. An extend to the operand's own width is the operand; an
+// extend of the same kind of extend extends the inner operand
+// directly (updated in place).
+// ---------------------------------------------------------------------------
+
+mlir::OpFoldResult SignExtendOp::fold(FoldAdaptor adaptor) {
+  if (getOperand().getType() == getType()) {
+    return getOperand();
+  }
+  if (auto inner = getOperand().getDefiningOp<SignExtendOp>()) {
+    getOperation()->setOperand(0, inner.getOperand());
+    return getResult();
+  }
+  std::optional<llvm::APInt> a =
+      constantBits(adaptor.getOperand(), getOperand().getType());
+  std::optional<unsigned> width = foldableWidth(getType());
+  if (!a || !width || a->getBitWidth() == 0) {
+    return {};
+  }
+  return bitsAttr(getContext(), a->sext(*width));
+}
+
+mlir::OpFoldResult ZeroExtendOp::fold(FoldAdaptor adaptor) {
+  if (getOperand().getType() == getType()) {
+    return getOperand();
+  }
+  if (auto inner = getOperand().getDefiningOp<ZeroExtendOp>()) {
+    getOperation()->setOperand(0, inner.getOperand());
+    return getResult();
+  }
+  if (widthOf(getOperand()) == 0) {
+    return zeroOf(getContext(), getType());
+  }
+  std::optional<llvm::APInt> a =
+      constantBits(adaptor.getOperand(), getOperand().getType());
+  std::optional<unsigned> width = foldableWidth(getType());
+  if (!a || !width) {
+    return {};
+  }
+  return bitsAttr(getContext(), a->zext(*width));
+}
+
+// ---------------------------------------------------------------------------
+// Mux, concat, extract, repeat.
+// ---------------------------------------------------------------------------
+
+mlir::OpFoldResult MuxOp::fold(FoldAdaptor adaptor) {
+  if (auto c = constantBits(adaptor.getCond(), getCond().getType())) {
+    return c->isZero() ? getElseValue() : getThenValue();
+  }
+  if (getThenValue() == getElseValue()) {
+    return getThenValue();
+  }
+  // `c ? 1 : 0` on one bit is `c`.
+  if (getType() == getCond().getType()) {
+    auto t = constantBits(adaptor.getThenValue(), getType());
+    auto e = constantBits(adaptor.getElseValue(), getType());
+    if (t && e && t->isOne() && e->isZero()) {
+      return getCond();
+    }
+  }
+  return {};
+}
+
+mlir::OpFoldResult ConcatOp::fold(FoldAdaptor adaptor) {
+  if (getOperands().size() == 1) {
+    return getOperands().front();
+  }
+  if (!foldableWidth(getType())) {
+    return {};
+  }
+  std::optional<llvm::APInt> acc;
+  for (auto [v, attr] : llvm::zip(getOperands(), adaptor.getOperands())) {
+    std::optional<llvm::APInt> a = constantBits(attr, v.getType());
+    if (!a) {
+      return {};
+    }
+    if (a->getBitWidth() != 0) {
+      acc = acc ? acc->concat(*a) : *a;
+    }
+  }
+  return bitsAttr(getContext(), acc.value_or(llvm::APInt(0, 0)));
+}
+
+void ConcatOp::getCanonicalizationPatterns(mlir::RewritePatternSet &results,
+                                           mlir::MLIRContext *context) {
+  results.add<SimplifyConcat>(context);
+}
+
+mlir::OpFoldResult ExtractOp::fold(FoldAdaptor adaptor) {
+  if (getLowBit() == 0 && getOperand().getType() == getType()) {
+    return getOperand();
+  }
+  // A slice of a slice is one slice of the inner operand.
+  if (auto inner = getOperand().getDefiningOp<ExtractOp>()) {
+    getOperation()->setOperand(0, inner.getOperand());
+    setLowBitAttr(mlir::IntegerAttr::get(
+        mlir::IntegerType::get(getContext(), 64),
+        static_cast<int64_t>(getLowBit() + inner.getLowBit())));
+    return getResult();
+  }
+  std::optional<llvm::APInt> a =
+      constantBits(adaptor.getOperand(), getOperand().getType());
+  if (!a) {
+    return {};
+  }
+  const unsigned width = widthOf(getResult());
+  if (width == 0) {
+    return zeroOf(getContext(), getType());
+  }
+  return bitsAttr(getContext(),
+                  a->extractBits(width, static_cast<unsigned>(getLowBit())));
+}
+
+void ExtractOp::getCanonicalizationPatterns(mlir::RewritePatternSet &results,
+                                            mlir::MLIRContext *context) {
+  results.add<ExtractFromConcat>(context);
+}
+
+mlir::OpFoldResult RepeatOp::fold(FoldAdaptor adaptor) {
+  if (getCount() == 1) {
+    return getOperand();
+  }
+  std::optional<unsigned> width = foldableWidth(getType());
+  std::optional<llvm::APInt> a =
+      constantBits(adaptor.getOperand(), getOperand().getType());
+  if (!a || !width) {
+    return {};
+  }
+  if (a->getBitWidth() == 0) {
+    return zeroOf(getContext(), getType());
+  }
+  return bitsAttr(getContext(), llvm::APInt::getSplat(*width, *a));
+}
+
+} // namespace nsl::dialect
@@ -23,11 +23,14 @@
 // MLIR's TableGen-emitted trait verifiers and keep `success()` stubs
 // or no `verify()` declaration at all.
 
+#include "mlir/IR/BuiltinTypes.h"
 #include "mlir/IR/SymbolTable.h"
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 
 #include "llvm/ADT/SmallPtrSet.h"
 
+#include <optional>
+
 // Op-class definitions (constructors / accessors / parser / printer
 // emitted by TableGen via `GET_OP_CLASSES`) MOVED to
 // `NSLDialect.cpp` so `addOperations<>()` has them complete in the
@@ -345,6 +348,29 @@ mlir::LogicalResult RegOp::verify() {
                             "'!nsl.struct<@T>', got "
                          << t;
   }
+  // Structured name: `name_parts` and `name_indices` come together,
+  // and every part is a literal or an in-range operand position.
+  std::optional<mlir::ArrayAttr> parts = getNameParts();
+  if (getNameIndices().empty() != !parts.has_value()) {
+    return emitOpError() << "'name_parts' and index operands must be "
+                            "given together";
+  }
+  if (!parts) {
+    return mlir::success();
+  }
+  const int64_t numIndices =
+      static_cast<int64_t>(getNameIndices().size());
+  for (mlir::Attribute part : *parts) {
+    if (mlir::isa<mlir::StringAttr>(part)) {
+      continue;
+    }
+    auto ref = mlir::dyn_cast<mlir::IntegerAttr>(part);
+    if (!ref || ref.getInt() < 0 || ref.getInt() >= numIndices) {
+      return emitOpError() << "'name_parts' element " << part
+                           << " is neither a string nor an index "
+                              "operand position";
+    }
+  }
   return mlir::success();
 }
 
@@ -1105,6 +1131,15 @@ mlir::LogicalResult StructuralGenerateOp::verify() {
                             "(loop-bound shape requires a "
                             "terminating expansion)";
   }
+  // The body takes no argument (splice-only form) or the induction
+  // variable as a single `index`.
+  mlir::Block &body = getBody().front();
+  if (body.getNumArguments() > 1 ||
+      (body.getNumArguments() == 1 &&
+       !mlir::isa<mlir::IndexType>(body.getArgument(0).getType()))) {
+    return emitOpError() << "body must take no argument or a single "
+                            "'index' induction variable";
+  }
   return mlir::success();
 }
 
@@ -15,9 +15,10 @@
 //        ▼                                          ▼
 //   SourceManager (post-#line virtual coords)   AST printer
 //
-// The AST text is BUFFERED in a `std::string` via `raw_string_ostream`
+// The AST is printed only after every stage has finished reporting,
 // so partial output can never reach `os` on a diagnostic-bearing run
-// (FR-022 "no partial output on error").
+// (FR-022 "no partial output on error"); the dump itself streams
+// straight into `os` rather than through an in-memory copy.
 
 #include "nsl/Driver/EmitAST.h"
 
@@ -44,27 +45,6 @@
 #include <utility>
 #include <vector>
 
-// Phase 3 (T035, FR-019): forward-declare `nsl::sema::lookupDeclLoc`
-// — a free function defined in `lib/Sema/ResolutionPass.cpp` that
-// queries the current `ResolutionMap` (TLS-stored by `Sema::run`)
-// and returns the resolved declaration's `SourceRange`. Returning
-// an invalid `SourceRange` means "unresolved" — the printer skips
-// the `→ decl@…` suffix in that case.
-//
-// We forward-declare here (rather than including a private
-// `lib/Sema/ResolutionPass.h`) because the driver layer is not on
-// the lib/Sema/ include path. The linker resolves the symbol via
-// `nsl-sema`'s exported translation units.
-namespace nsl::sema {
-class Symbol;
-} // namespace nsl::sema
-namespace nsl::ast {
-class Expr;
-} // namespace nsl::ast
-namespace nsl::sema {
-::nsl::SourceRange lookupDeclLoc(const ::nsl::ast::Expr *e) noexcept;
-} // namespace nsl::sema
-
 namespace nsl::driver {
 
 namespace {
@@ -135,7 +115,7 @@ void replayLineDirectives(SourceManager &sm, FileID synth_fid) {
 } // namespace
 
 int emitAST(llvm::StringRef input_path, const EmitTokensOptions &opts,
-            llvm::raw_ostream &os, llvm::raw_ostream &err) {
+            llvm::raw_ostream &os, llvm::raw_ostream &err, ASTFormat format) {
   SourceManager sm;
   DiagnosticEngine diag(sm);
 
@@ -147,6 +127,11 @@ int emitAST(llvm::StringRef input_path, const EmitTokensOptions &opts,
   }
   FileID const input_fid = *fid_or;
 
+  sema::InterfaceIndex interfaces;
+  if (!loadInterfaceIndexes(opts.interface_indexes, interfaces, err)) {
+    return 3;
+  }
+
   // Construct the include-search path. Quote-form from `-I`; angle-form
   // from NSL_INCLUDE.
   preprocess::IncludeSearchPath search;
@@ -194,27 +179,19 @@ int emitAST(llvm::StringRef input_path, const EmitTokensOptions &opts,
   // parse-failure path below). At Phase 2 the `runSema` body is a
   // no-op stub — `result.hasErrors` is false on every well-parsed
   // input — so this call is observable but inert.
-  sema::SemaResult sema_result;
-  if (cu) {
-    sema_result = driver::runSema(*cu, diag);
-  }
-
-  // Buffer the AST text BEFORE checking for errors — we want to
-  // generate the bytes in a deterministic memory order, then either
-  // commit (on no-errors) or discard (on error). The buffering
-  // implements FR-022's "no partial output on error".
   //
-  // Phase 3 (T035, FR-020): when Sema produces post-Sema enrichments
-  // on the AST (every `Expr::inferredType()` non-null), the printer
-  // detects post-Sema mode automatically. The decl-loc lookup
-  // callback is supplied so `→ decl@<file>:<line>:<col>` decoration
-  // can be rendered for resolved name-refs (per
-  // `emit-ast-format.contract.md` Invariants 2 + 3).
-  std::string buf;
+  // The unit is analysed through `LazySema`: `finish()` hands over
+  // exactly what `Sema::run()` would, and every dump stays a check
+  // that the demand-driven path agrees with the eager one.
+  sema::SemaResult sema_result;
+  sema::SemaStatistics stats;
   if (cu) {
-    llvm::raw_string_ostream rs(buf);
-    ast::print(*cu, sm, rs, &::nsl::sema::lookupDeclLoc);
-    rs.flush();
+    sema::LazySema lazy(*cu, diag, &interfaces,
+                        opts.time_report ? &stats : nullptr);
+    sema_result = lazy.finish();
+    if (opts.time_report) {
+      driver::writeTimeReport(stats, opts.time_report_json, err);
+    }
   }
 
   if (diag.hasError() || !cu || sema_result.hasErrors) {
@@ -223,9 +200,31 @@ int emitAST(llvm::StringRef input_path, const EmitTokensOptions &opts,
     return 1;
   }
 
-  // Success: commit AST to stdout, then render any non-error diagnostics
-  // (warnings / notes) to stderr.
-  os << buf;
+  // Success: every diagnostic is already in the engine (printing
+  // reports none), so FR-022's "no partial output on error" holds
+  // without staging the dump — stream it straight into `os`.
+  //
+  // Phase 3 (T035, FR-020): when Sema produces post-Sema enrichments
+  // on the AST (every `Expr::inferredType()` non-null), the printer
+  // detects post-Sema mode automatically. The decl-loc lookup
+  // callback reads this run's `ResolutionTable` so the
+  // `→ decl@<file>:<line>:<col>` decoration can be rendered for
+  // resolved name-refs (per `emit-ast-format.contract.md`
+  // Invariants 2 + 3).
+  const sema::ResolutionTable &resolutions = sema_result.resolutions;
+  auto decl_lookup = [&resolutions](const ast::Expr *e) {
+    return resolutions.declLoc(e);
+  };
+  if (format == ASTFormat::Interface) {
+    sema_result.interfaces.writeJSON(os);
+  } else if (format == ASTFormat::Binary) {
+    ast::dumpBinary(*cu, sm, os, decl_lookup);
+  } else {
+    ast::print(*cu, sm, os, decl_lookup);
+  }
+
+  // Then render any non-error diagnostics (warnings / notes) to
+  // stderr.
   if (diag.numWarnings() > 0) {
     diag.renderAll(err, opts.diagnostic_json ? DiagnosticEngine::Format::JSON
                                              : DiagnosticEngine::Format::Text);
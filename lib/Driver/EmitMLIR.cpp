@@ -140,6 +140,11 @@ int emitMLIR(llvm::StringRef input_path, const EmitTokensOptions &opts,
   }
   FileID const input_fid = *fid_or;
 
+  sema::InterfaceIndex interfaces;
+  if (!loadInterfaceIndexes(opts.interface_indexes, interfaces, err)) {
+    return 3;
+  }
+
   // ---------- Preprocess ----------
   preprocess::IncludeSearchPath search;
   for (const auto &dir : opts.include_paths) {
@@ -174,8 +179,14 @@ int emitMLIR(llvm::StringRef input_path, const EmitTokensOptions &opts,
   // ---------- Parse + Sema ----------
   auto cu = parse::parseCompilationUnit(lexer, diag);
   sema::SemaResult sema_result;
+  sema::SemaStatistics stats;
   if (cu) {
-    sema_result = driver::runSema(*cu, diag);
+    sema_result = driver::runSema(*cu, diag, nullptr, &interfaces,
+                                  opts.time_report ? &stats : nullptr);
+    if (opts.time_report) {
+      driver::writeTimeReport(stats, opts.time_report_json, err);
+    }
+    driver::reportIndexOnlyDeclares(*cu, interfaces, diag);
   }
 
   if (diag.hasError() || !cu || sema_result.hasErrors) {
@@ -186,6 +197,9 @@ int emitMLIR(llvm::StringRef input_path, const EmitTokensOptions &opts,
 
   // ---------- M5 AST → nsl + structural-expansion pipeline ----------
   Compilation comp(diag);
+  comp.setPassReports({opts.mlir_timing, opts.mlir_pass_statistics,
+                       opts.mlir_op_counts},
+                      err);
   auto module = comp.lowerToNSL(*cu, sema_result);
   if (!module || diag.hasError()) {
     diag.renderAll(err, opts.diagnostic_json ? DiagnosticEngine::Format::JSON
@@ -12,16 +12,21 @@
 //   - `specs/010-m6-circt-lowering/research.md` §10 — implementation
 //     mirror of M5's `Compilation::runNSLPasses`.
 //
-// The body assembles a single-pass `mlir::PassManager` rooted at
-// the supplied `mlir::ModuleOp`, registers `NSLToCIRCTPass`, and
-// runs it. Diagnostics route through the shared `DiagnosticBridge`
-// (Constitution Principle IV).
+// The body assembles an `mlir::PassManager` rooted at the supplied
+// `mlir::ModuleOp`, nests `nsl-eliminate-dead-signals` on each
+// `nsl.module` so write-only wires / regs never reach `hw`, then
+// registers `NSLToCIRCTPass`, and runs both. Dead-signal elimination
+// lives here rather than in `runNSLPasses` because `-emit=mlir`
+// shows every declared signal as written. Diagnostics route through
+// the shared `DiagnosticBridge` (Constitution Principle IV), and
+// `configurePassManager` adds the `nslc -mlir-*` reports.
 
 #include "../Lower/Pass/Common/DiagnosticBridge.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Support/LogicalResult.h"
 #include "nsl/Basic/Diagnostic.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Driver/Compilation.h"
 #include "nsl/Lower/Lower.h"
 
@@ -39,8 +44,11 @@ mlir::LogicalResult Compilation::lowerToCIRCT(mlir::ModuleOp module) {
   nsl::lower::DiagnosticBridge bridge(diag_, mlir_ctx_);
 
   mlir::PassManager pm(&mlir_ctx_, mlir::ModuleOp::getOperationName());
+  pm.nest<nsl::dialect::ModuleOp>().addPass(
+      nsl::lower::createNSLEliminateDeadSignalsPass());
   pm.addPass(nsl::lower::createNSLToCIRCTPass());
 
+  configurePassManager(pm, "lowerToCIRCT");
   return pm.run(module);
 }
 
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Driver/PassReports.cpp — `Compilation::configurePassManager`,
+// the `nslc -mlir-*` pass-manager reports.
+//
+// `runNSLPasses` and `lowerToCIRCT` each build one `mlir::PassManager`
+// and hand it here before running it. Depending on the
+// `PassReportOptions` set by `setPassReports`:
+//   - `-mlir-timing` enables MLIR's pass timing;
+//   - `-mlir-pass-statistics` enables MLIR's statistics report, which
+//     prints every `Statistic` the `nsl-*` passes define (generates
+//     expanded, wires created, variables split, modules lowered, …);
+//   - `-mlir-op-counts` adds `OpCountInstrumentation` below.
+// MLIR prints the first two to stderr when the pass manager is
+// destroyed, i.e. at the end of each stage.
+//
+// The op-count report must not depend on the thread schedule
+// (Constitution Principle V). Passes nested on `nsl.module` run on
+// many modules at once, so their counts are summed over all modules
+// and printed, in pipeline order, after the nested pipeline
+// finishes. A sum does not depend on the order it is taken in, and
+// every thread runs the nested passes in pipeline order, so the
+// first time a pass is seen on any thread still follows that order.
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Pass/PassInstrumentation.h"
+#include "mlir/Pass/PassManager.h"
+#include "nsl/Driver/Compilation.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nsl::driver {
+
+namespace {
+
+/// Ops in `op`, `op` included.
+uint64_t countOps(mlir::Operation *op) {
+  uint64_t n = 0;
+  op->walk([&](mlir::Operation *) { ++n; });
+  return n;
+}
+
+/// The label a pass's row is printed under: its command-line
+/// argument, or its name for a pass without one (a nested pipeline).
+llvm::StringRef passLabel(mlir::Pass *pass) {
+  llvm::StringRef arg = pass->getArgument();
+  return arg.empty() ? pass->getName() : arg;
+}
+
+/// Prints the op count of the whole IR before the first pass and
+/// after each top-level pass, and the summed op count of the
+/// `nsl.module` bodies after each nested pass.
+class OpCountInstrumentation : public mlir::PassInstrumentation {
+public:
+  OpCountInstrumentation(llvm::raw_ostream &os, llvm::StringRef stage)
+      : os_(os), stage_(stage.str()) {}
+
+  void runBeforePass(mlir::Pass *, mlir::Operation *op) final {
+    if (started_ || !mlir::isa<mlir::ModuleOp>(op)) {
+      return;
+    }
+    started_ = true;
+    os_ << "===- " << stage_ << " op counts -===\n";
+    printRow(countOps(op), "input", 0);
+  }
+
+  void runAfterPass(mlir::Pass *pass, mlir::Operation *op) final {
+    if (!mlir::isa<mlir::ModuleOp>(op)) {
+      // Passes nested on `nsl.module`; may run on several threads.
+      uint64_t n = countOps(op);
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto [it, inserted] = nested_.try_emplace(passLabel(pass), 0);
+      if (inserted) {
+        nestedOrder_.push_back(it->getKey());
+      }
+      it->second += n;
+      return;
+    }
+    for (llvm::StringRef label : nestedOrder_) {
+      printRow(nested_.lookup(label), label, 2);
+    }
+    nestedOrder_.clear();
+    nested_.clear();
+    printRow(countOps(op), passLabel(pass), 0);
+  }
+
+private:
+  void printRow(uint64_t count, llvm::StringRef label, unsigned indent) {
+    os_ << llvm::format("%10llu", static_cast<unsigned long long>(count))
+        << "  ";
+    os_.indent(indent) << label << "\n";
+  }
+
+  llvm::raw_ostream &os_;
+  std::string stage_;
+  bool started_ = false;
+  std::mutex mutex_;
+  llvm::StringMap<uint64_t> nested_;
+  llvm::SmallVector<llvm::StringRef, 8> nestedOrder_;
+};
+
+} // namespace
+
+void Compilation::configurePassManager(mlir::PassManager &pm,
+                                       llvm::StringRef stage) {
+  if (reports_.timing) {
+    pm.enableTiming();
+  }
+  if (reports_.statistics) {
+    pm.enableStatistics();
+  }
+  if (reports_.op_counts && report_os_ != nullptr) {
+    pm.addInstrumentation(
+        std::make_unique<OpCountInstrumentation>(*report_os_, stage));
+  }
+}
+
+} // namespace nsl::driver
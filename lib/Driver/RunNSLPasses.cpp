@@ -15,12 +15,32 @@
 // supplied `mlir::ModuleOp`, registers the six structural-expansion
 // passes in the FR-012 frozen order, and runs them. Diagnostics
 // route through the shared `DiagnosticBridge` (FR-019).
+//
+// Slot 4 (`nsl-explode-submod-array`) is left out: array-form
+// `nsl.submodule` ops stay intact through the pipeline and the
+// nsl→CIRCT conversion emits one `hw.instance` per element, so a
+// `SUB[4096]` array costs one symbol, not 4096, in every pass here.
+//
+// Slots 2-5 (with `nsl-canonicalize`, slot 3b, after variable
+// expansion, and `nsl-cse`, slot 5b, after inlining) only
+// rewrite module bodies and `nsl.module` is `IsolatedFromAbove`, so
+// they are nested on `nsl.module`. The pass manager then runs each
+// module through all of them at once, with the
+// modules spread across the context's thread pool. Slot 1 stays on
+// the builtin module because it reads the top-level `nsl.param_int`
+// table. Slot 6 stays there because it must report every module's
+// violations in one deterministic run (`NSLCheckSemanticsPass.cpp`).
+// Nested diagnostics are replayed in IR order by the pass manager's
+// parallel diagnostic handler, so the output is the same as with one
+// thread. `configurePassManager` adds the `nslc -mlir-*` reports
+// (`PassReports.cpp`).
 
 #include "../Lower/Pass/Common/DiagnosticBridge.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/PassManager.h"
 #include "mlir/Support/LogicalResult.h"
 #include "nsl/Basic/Diagnostic.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Driver/Compilation.h"
 #include "nsl/Lower/Lower.h"
 
@@ -40,14 +60,17 @@ mlir::LogicalResult Compilation::runNSLPasses(mlir::ModuleOp module) {
 
   // Pipeline order frozen by `pass-pipeline.contract.md` §1 (FR-012).
   // Reordering changes semantics; reordering = contract amendment.
-  pm.addPass(nsl::lower::createNSLResolveParamsPass());      // slot 1
-  pm.addPass(nsl::lower::createNSLExpandGeneratePass());     // slot 2
-  pm.addPass(nsl::lower::createNSLExpandVariablesPass());    // slot 3
-  pm.addPass(nsl::lower::createNSLExplodeSubmodArrayPass()); // slot 4
-  pm.addPass(
-      nsl::lower::createNSLInlineInternalFuncPass());    // slot 5 (no-op at M5)
-  pm.addPass(nsl::lower::createNSLCheckSemanticsPass()); // slot 6
+  pm.addPass(nsl::lower::createNSLResolveParamsPass()); // slot 1
+  mlir::OpPassManager &body = pm.nest<nsl::dialect::ModuleOp>();
+  body.addPass(nsl::lower::createNSLExpandGeneratePass());     // slot 2
+  body.addPass(nsl::lower::createNSLExpandVariablesPass());    // slot 3
+  body.addPass(nsl::lower::createNSLCanonicalizePass());       // slot 3b
+  // slot 4 (submodule-array explosion) deferred to NSLToCIRCT
+  body.addPass(nsl::lower::createNSLInlineInternalFuncPass()); // slot 5
+  body.addPass(nsl::lower::createNSLCSEPass());                // slot 5b
+  pm.addPass(nsl::lower::createNSLCheckSemanticsPass());       // slot 6
 
+  configurePassManager(pm, "runNSLPasses");
   return pm.run(module);
 }
 
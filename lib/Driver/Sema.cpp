@@ -10,14 +10,84 @@
 #include "nsl/Driver/Sema.h"
 
 #include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/DeclareBlock.h"
+#include "nsl/AST/ModuleBlock.h"
+#include "nsl/AST/PortDecl.h"
 #include "nsl/Basic/Diagnostic.h"
 #include "nsl/Sema/Sema.h"
 
+#include "llvm/ADT/StringSet.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <memory>
+
 namespace nsl::driver {
 
-sema::SemaResult runSema(ast::CompilationUnit &unit, DiagnosticEngine &diag) {
-  sema::Sema sema(diag);
+sema::SemaResult runSema(ast::CompilationUnit &unit, DiagnosticEngine &diag,
+                         sema::SemaCache *cache,
+                         const sema::InterfaceIndex *interfaces,
+                         sema::SemaStatistics *stats) {
+  sema::Sema sema(diag, cache, interfaces);
+  sema.setStatistics(stats);
   return sema.run(unit);
 }
 
+void writeTimeReport(const sema::SemaStatistics &stats, bool json,
+                     llvm::raw_ostream &os) {
+  if (json) {
+    stats.writeJSON(os);
+    os << '\n';
+  } else {
+    stats.writeText(os);
+  }
+}
+
+bool loadInterfaceIndexes(llvm::ArrayRef<std::string> paths,
+                          sema::InterfaceIndex &index,
+                          llvm::raw_ostream &err) {
+  for (const std::string &path : paths) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buf =
+        llvm::MemoryBuffer::getFile(path);
+    if (!buf) {
+      err << "could not open " << path << ": " << buf.getError().message()
+          << "\n";
+      return false;
+    }
+    std::string error;
+    if (!index.readJSON((*buf)->getBuffer(), error)) {
+      err << "invalid interface index " << path << ": " << error << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool reportIndexOnlyDeclares(const ast::CompilationUnit &unit,
+                             const sema::InterfaceIndex &index,
+                             DiagnosticEngine &diag) {
+  llvm::StringSet<> declared;
+  for (const auto &item : unit.items()) {
+    if (item && item->kind() == ast::NodeKind::NK_DeclareBlock) {
+      declared.insert(static_cast<const ast::DeclareBlock &>(*item).name());
+    }
+  }
+  bool reported = false;
+  for (const auto &item : unit.items()) {
+    if (!item || item->kind() != ast::NodeKind::NK_ModuleBlock) {
+      continue;
+    }
+    const auto &mb = static_cast<const ast::ModuleBlock &>(*item);
+    if (declared.contains(mb.name()) || index.lookup(mb.name()) == nullptr) {
+      continue;
+    }
+    diag.report(Severity::Error, mb.loc().begin(),
+                "module '" + mb.name().str() +
+                    "' has its declare only in an interface index; "
+                    "lowering needs the declare block in the same unit");
+    reported = true;
+  }
+  return reported;
+}
+
 } // namespace nsl::driver
@@ -20,7 +20,9 @@ void CSTBuilder::beginNode(llvm::StringRef kindName,
   Frame f;
   f.kindName = kindName.str();
   f.start = start;
-  // `end` is filled in by the matching `endNode()`.
+  f.depth = static_cast<unsigned>(openStack_.size());
+  f.firstToken = tokens_.size();
+  // `end` / `lastToken` are filled in by the matching `endNode()`.
   openStack_.push_back(std::move(f));
 }
 
@@ -37,9 +39,26 @@ void CSTBuilder::endNode(const ::nsl::SourceLocation &end) {
   }
   Frame f = openStack_.pop_back_val();
   f.end = end;
+  f.lastToken = tokens_.size();
   completedNodes_.push_back(std::move(f));
 }
 
+::nsl::parse::CSTCheckpoint CSTBuilder::checkpoint() {
+  return {tokens_.size(), completedNodes_.size()};
+}
+
+void CSTBuilder::beginNodeAt(const ::nsl::parse::CSTCheckpoint &cp,
+                             llvm::StringRef kindName,
+                             const ::nsl::SourceLocation &start) {
+  // Frames completed since `cp` were children of the innermost open
+  // frame; they move one level down, under the new one.
+  for (std::size_t i = cp.nodeIndex; i < completedNodes_.size(); ++i) {
+    ++completedNodes_[i].depth;
+  }
+  beginNode(kindName, start);
+  openStack_.back().firstToken = cp.tokenIndex;
+}
+
 std::string CSTBuilder::serialize() const {
   std::string out;
   out.reserve(src_.size());
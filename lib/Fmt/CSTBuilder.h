@@ -13,13 +13,15 @@
 // call and reconstitutes a CST tree consumable by the LayoutPlanner
 // (Phase 3).
 //
-// **Phase 2b scope**: only the top-level production is wrapped by
-// the parser today (one beginNode/endNode pair per `parseCompilationUnit`).
-// Tokens flow in via `recordToken`. The CST tree at this stage is a
-// shallow root containing one `NSLToken` leaf per consumed token.
-// Phase 3+ adds per-production `beginNode`/`endNode` instrumentation
-// to the parser, at which point CSTBuilder will build a deeper tree
-// — with no API change here.
+// **Shape**: the parser brackets every grammar production with a
+// beginNode/endNode pair, so frames complete in post-order (the
+// top-level `"CompilationUnit"` frame is always last). Each frame
+// records its nesting depth and the half-open range of `tokens()`
+// it covers, which is enough to rebuild the tree — children of a
+// frame are the deeper frames whose token span it encloses — with
+// one leaf per consumed token. Consumers that want the tree itself,
+// with trivia attached, use `nsl::syntax::GreenTreeBuilder`; this
+// builder stays the flat event recorder behind the CST unit tests.
 //
 // The builder also captures a `StringRef` of the source buffer so
 // `serialize()` can reconstitute the source byte-for-byte (FR-008
@@ -73,10 +75,16 @@ public:
 
   void endNode(const ::nsl::SourceLocation &end) override;
 
+  ::nsl::parse::CSTCheckpoint checkpoint() override;
+
+  void beginNodeAt(const ::nsl::parse::CSTCheckpoint &cp,
+                   llvm::StringRef kindName,
+                   const ::nsl::SourceLocation &start) override;
+
   // ---- Public observers used by tests + the LayoutPlanner -------
 
-  /// Number of completed top-level nodes (one per `endNode` call).
-  /// Phase 2b expects exactly 1 after a successful parse.
+  /// Number of completed nodes (one per `endNode` call) — one per
+  /// parsed production plus the top-level `"CompilationUnit"`.
   [[nodiscard]] std::size_t nodeCount() const noexcept {
     return completedNodes_.size();
   }
@@ -101,8 +109,14 @@ public:
     std::string kindName; // owns the kind string
     ::nsl::SourceLocation start;
     ::nsl::SourceLocation end;
+    /// Nesting depth; the top-level `"CompilationUnit"` is depth 0.
+    unsigned depth = 0;
+    /// Half-open index range into `tokens()` consumed under this node.
+    std::size_t firstToken = 0;
+    std::size_t lastToken = 0;
   };
 
+  /// Completed frames in post-order (children before parents).
   [[nodiscard]] llvm::ArrayRef<Frame> completedNodes() const noexcept {
     return completedNodes_;
   }
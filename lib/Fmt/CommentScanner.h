@@ -12,13 +12,15 @@
 // "trailing" (same line as the preceding decl), or "inline" (between
 // two tokens of a single statement). The Lexer
 // (`lib/Lex/Lexer.cpp::skipWhitespaceAndComments`) discards comments
-// entirely by design — they never reach the AST. The CSTBuilder
-// (`lib/Fmt/CSTBuilder.h`) is Phase 2b and records flat tokens
-// without trivia attachment. So R6 needs its own raw-source scanner
-// that walks the byte range between AST node positions, recognises
-// the two comment forms, and reports each occurrence with its byte
-// span + start/end line. The LayoutPlanner then classifies each
-// occurrence by inspecting the surrounding tokens / newlines.
+// entirely by design — they never reach the AST. `format_buffer`
+// therefore parses in CST mode and hands the LayoutPlanner the
+// fragment's lossless syntax tree (`nsl/Syntax/SyntaxTree.h`), whose
+// trivia index answers comment queries directly. This raw-source
+// scanner is the fallback for planners built without a tree: it
+// walks the byte range between AST node positions, recognises the
+// two comment forms, and reports each occurrence with its byte span
+// + start/end line. Either way the LayoutPlanner then classifies
+// each occurrence by inspecting the surrounding tokens / newlines.
 //
 // Principle II compliance: this scanner is a TRIVIA-ONLY pass that
 // runs ONCE per gap region and produces only span-and-line records.
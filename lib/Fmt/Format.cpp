@@ -49,6 +49,7 @@
 #include "nsl/Fmt/Fmt.h"
 #include "nsl/Lex/Lexer.h"
 #include "nsl/Parse/Parser.h"
+#include "nsl/Syntax/SyntaxTree.h"
 
 #include "llvm/ADT/StringRef.h"
 
@@ -137,8 +138,13 @@ FormatResult format_buffer(llvm::StringRef sourceBuffer,
         fragment_sm.addBufferInMemory("<fragment>", std::move(bytes));
     ::nsl::DiagnosticEngine fragment_diag(fragment_sm);
     ::nsl::Lexer fragment_lex(fragment_sm, fragment_fid, fragment_diag);
+    // CST-mode parse: the same pass also builds the fragment's
+    // lossless syntax tree, whose trivia index answers the planner's
+    // R6 comment queries (no per-gap rescans of the source).
+    ::nsl::syntax::GreenTreeBuilder tree_builder(s.rawText);
     std::unique_ptr<::nsl::ast::CompilationUnit> cu =
-        ::nsl::parse::parseCompilationUnit(fragment_lex, fragment_diag);
+        ::nsl::parse::parseCompilationUnit(fragment_lex, fragment_diag,
+                                           &tree_builder);
 
     if (cu == nullptr || fragment_diag.hasError()) {
       // Atomic refusal — drop everything emitted so far + return.
@@ -169,7 +175,9 @@ FormatResult format_buffer(llvm::StringRef sourceBuffer,
     // to s.rawText (verbatim fallback for every AST node kind);
     // canonical-layout overrides fire only on nodes whose line span
     // intersects `range` (T091).
+    ::nsl::syntax::SyntaxTree tree = tree_builder.finish();
     LayoutPlanner planner(s.rawText, config, range, fragmentStartLine);
+    planner.setSyntaxTree(&tree);
     DocPtr doc = planner.build(*cu);
     out.append(renderer.render(doc, config.max_line_length, indent_spaces));
   }
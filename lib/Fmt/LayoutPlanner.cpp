@@ -104,6 +104,31 @@ int LayoutPlanner::lineForOffset(std::uint32_t offset) const noexcept {
   return fragmentStartLine_ + fragmentLine - 1;
 }
 
+std::vector<CommentTok> LayoutPlanner::commentsIn(std::uint32_t begin,
+                                                  std::uint32_t end) const {
+  if (tree_ == nullptr) {
+    return scanComments(src_, begin, end, lineStartOffsets_);
+  }
+  std::vector<CommentTok> out;
+  end = std::min<std::uint32_t>(end, static_cast<std::uint32_t>(src_.size()));
+  for (const ::nsl::syntax::CommentTrivia &c :
+       tree_->commentsIn(begin, end)) {
+    CommentTok tok;
+    tok.kind = c.kind == ::nsl::syntax::TriviaKind::LineComment
+                   ? CommentKind::Line
+                   : CommentKind::Block;
+    tok.begin = c.begin;
+    tok.end = std::min(c.end, end);
+    tok.startLine = lineForOffsetIn(lineStartOffsets_, tok.begin);
+    tok.endLine = tok.kind == CommentKind::Line
+                      ? tok.startLine
+                      : lineForOffsetIn(lineStartOffsets_,
+                                        tok.end > 0 ? tok.end - 1 : tok.end);
+    out.push_back(tok);
+  }
+  return out;
+}
+
 bool LayoutPlanner::nodeIntersectsRange(
     const ::nsl::ast::ASTNode &node) const noexcept {
   if (!range_.has_value()) {
@@ -187,8 +212,7 @@ DocPtr LayoutPlanner::verbatimGapFiltered(std::uint32_t begin,
   // a stripped comment collapses to a single space so adjacent
   // tokens don't fuse (e.g., `reg /* x */ q[8];` → `reg q[8];`,
   // not `reg q[8];` with double space and not `regq[8];`).
-  std::vector<CommentTok> comments =
-      scanComments(src_, begin, end, lineStartOffsets_);
+  std::vector<CommentTok> comments = commentsIn(begin, end);
   if (comments.empty()) {
     return verbatimFromOffsets(begin, end);
   }
@@ -447,8 +471,7 @@ DocPtr LayoutPlanner::formatNode(const ::nsl::ast::ModuleBlock &node) {
     if (gap_begin >= gap_end) {
       return g;
     }
-    std::vector<CommentTok> cs =
-        scanComments(src_, gap_begin, gap_end, lineStartOffsets_);
+    std::vector<CommentTok> cs = commentsIn(gap_begin, gap_end);
     for (const CommentTok &c : cs) {
       bool same_line_as_prev = false;
       if (have_prev) {
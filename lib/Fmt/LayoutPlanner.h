@@ -37,6 +37,7 @@
 #ifndef NSL_FMT_LIB_LAYOUT_PLANNER_H
 #define NSL_FMT_LIB_LAYOUT_PLANNER_H
 
+#include "CommentScanner.h"
 #include "Doc.h"
 
 #include "nsl/AST/ASTVisitor.h"
@@ -45,6 +46,7 @@
 #include "nsl/AST/CompilationUnit.h"
 #include "nsl/AST/UnaryExpr.h"  // for nested `UnaryExpr::Op`
 #include "nsl/Fmt/Fmt.h"
+#include "nsl/Syntax/SyntaxTree.h"
 // `SliceExpr`, `ConcatExpr`, `WireDecl`, etc. are forward-declared by
 // `ASTVisitor.h`'s NodeKind.def expansion above — no extra includes
 // needed in this header. The full definitions are pulled in by
@@ -84,6 +86,15 @@ public:
   /// Walk `cu` and produce its Doc representation.
   DocPtr build(const ::nsl::ast::CompilationUnit &cu);
 
+  /// Attach the lossless syntax tree parsed from the same `src`. R6
+  /// comment queries are then answered from the tree's trivia index
+  /// instead of rescanning the source gap by gap. Optional: without
+  /// a tree the planner falls back to `scanComments`. The tree MUST
+  /// outlive every `build()` call.
+  void setSyntaxTree(const ::nsl::syntax::SyntaxTree *tree) noexcept {
+    tree_ = tree;
+  }
+
   // visit() override per concrete NodeKind. The macro expands to ~54
   // method DECLARATIONS (one per `NSL_NODE_KIND` entry in
   // `nsl/AST/NodeKind.def`); each body just calls `result_ =
@@ -268,8 +279,14 @@ private:
   std::optional<LineRange> range_;
   int fragmentStartLine_;
   std::vector<std::uint32_t> lineStartOffsets_; // 0-indexed; size = lineCount
+  const ::nsl::syntax::SyntaxTree *tree_ = nullptr;
   DocPtr result_;
 
+  /// Comments starting in `src_[begin, end)` — from the syntax tree's
+  /// trivia index when one is attached, else via `scanComments`.
+  [[nodiscard]] std::vector<CommentTok> commentsIn(std::uint32_t begin,
+                                                   std::uint32_t end) const;
+
   /// Populate `lineStartOffsets_` from `src_` so `lineForOffset` is
   /// O(log n) per query. Called once from the constructor.
   void buildLineTable() noexcept;
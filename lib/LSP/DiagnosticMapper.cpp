@@ -66,6 +66,10 @@ std::string percentEncodePath(llvm::StringRef path) {
 
 } // namespace
 
+std::string toFileUri(llvm::StringRef path) {
+  return std::string("file://") + percentEncodePath(path);
+}
+
 namespace {
 
 int severityToLsp(nsl::Severity s) {
@@ -204,7 +208,7 @@ llvm::json::Value toLspDiagnostic(const nsl::Diagnostic &d,
                     {"end", buildPosition(zline, utf16)},
                     {"start", buildPosition(zline, utf16)},
                 }},
-               {"uri", std::string("file://") + percentEncodePath(vloc.path)},
+               {"uri", toFileUri(vloc.path)},
            }},
           {"message", note.message},
       });
@@ -15,8 +15,11 @@
 #include "nsl/Basic/Diagnostic.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
 #include "llvm/Support/JSON.h"
 
+#include <string>
+
 namespace nsl {
 class SourceManager;
 } // namespace nsl
@@ -35,6 +38,10 @@ llvm::json::Value toLspDiagnostic(const nsl::Diagnostic &d,
 llvm::json::Array toLspDiagnosticArray(llvm::ArrayRef<nsl::Diagnostic> diags,
                                        const nsl::SourceManager &sm);
 
+/// `file://` URI for a filesystem `path`, percent-encoded per
+/// RFC 3986 — the form every `uri` field this server sends uses.
+std::string toFileUri(llvm::StringRef path);
+
 } // namespace nsl::lsp
 
 #endif // NSL_LSP_DIAGNOSTIC_MAPPER_H
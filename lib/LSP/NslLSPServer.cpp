@@ -7,6 +7,7 @@
 // didClose) are Phase 2 stubs that delegate to the backend
 // `NslServer` but do not publish diagnostics yet — that wiring
 // arrives at T071 (Phase 3 / US1) once `DiagnosticMapper` lands.
+// Hover and definition answer from `NslTU::symbolAt`.
 
 #include "NslLSPServer.h"
 
@@ -38,7 +39,9 @@ llvm::json::Object buildCapabilities() {
   // form (llvm::json::Object preserves insertion order).
   // Order chosen alphabetically.
   return llvm::json::Object{
+      {"definitionProvider", true},
       {"foldingRangeProvider", true},
+      {"hoverProvider", true},
       {"textDocumentSync",
        llvm::json::Object{
            {"change", 1},
@@ -50,6 +53,37 @@ llvm::json::Object buildCapabilities() {
   };
 }
 
+llvm::json::Value buildLspPosition(const NslTU::Position &pos) {
+  return llvm::json::Object{
+      {"character", static_cast<int64_t>(pos.character)},
+      {"line", static_cast<int64_t>(pos.line)},
+  };
+}
+
+llvm::json::Value renderHover(const NslTU::SymbolAt &sym, llvm::StringRef) {
+  return llvm::json::Object{
+      {"contents",
+       llvm::json::Object{
+           {"kind", "plaintext"},
+           {"value", sym.description},
+       }},
+  };
+}
+
+llvm::json::Value renderDefinition(const NslTU::SymbolAt &sym,
+                                   llvm::StringRef uri) {
+  if (!sym.has_declaration)
+    return nullptr;
+  return llvm::json::Object{
+      {"range",
+       llvm::json::Object{
+           {"end", buildLspPosition(sym.decl_end)},
+           {"start", buildLspPosition(sym.decl_start)},
+       }},
+      {"uri", sym.decl_path.empty() ? uri.str() : toFileUri(sym.decl_path)},
+  };
+}
+
 llvm::json::Object buildInitializeResult() {
   return llvm::json::Object{
       {"capabilities", buildCapabilities()},
@@ -216,6 +250,18 @@ void NslLSPServer::dispatch(llvm::json::Value envelope) {
       return;
     }
     onFoldingRange(*id, params);
+  } else if (method == "textDocument/hover") {
+    if (!id) {
+      NSL_LSP_LOG_ERROR("nsl-lsp: hover received without id");
+      return;
+    }
+    onHover(*id, params);
+  } else if (method == "textDocument/definition") {
+    if (!id) {
+      NSL_LSP_LOG_ERROR("nsl-lsp: definition received without id");
+      return;
+    }
+    onDefinition(*id, params);
   } else if (method == "$/cancelRequest") {
     onCancelRequest(params);
   } else {
@@ -417,6 +463,47 @@ void NslLSPServer::onFoldingRange(const RequestId &id,
   workers_.push_back(std::move(worker));
 }
 
+void NslLSPServer::onHover(const RequestId &id,
+                           const llvm::json::Value &params) {
+  respondWithSymbolAt(id, params, renderHover);
+}
+
+void NslLSPServer::onDefinition(const RequestId &id,
+                                const llvm::json::Value &params) {
+  respondWithSymbolAt(id, params, renderDefinition);
+}
+
+void NslLSPServer::respondWithSymbolAt(
+    const RequestId &id, const llvm::json::Value &params,
+    llvm::json::Value (*render)(const NslTU::SymbolAt &, llvm::StringRef)) {
+  auto *obj = params.getAsObject();
+  auto *td = obj ? obj->getObject("textDocument") : nullptr;
+  auto *pos = obj ? obj->getObject("position") : nullptr;
+  if (!td || !pos) {
+    sendResponse(id, nullptr);
+    return;
+  }
+  std::string uri = td->getString("uri").value_or("").str();
+  NslTU::Position at;
+  at.line = static_cast<uint32_t>(pos->getInteger("line").value_or(0));
+  at.character =
+      static_cast<uint32_t>(pos->getInteger("character").value_or(0));
+
+  // Same threading as folding: snapshot the contents here, analyse
+  // on a worker so the dispatch thread keeps reading.
+  std::string contents;
+  backend_.scheduler().withState(
+      uri, [&](const NslTU::State &st) { contents = st.contents; });
+
+  std::thread worker([this, id, render, at, uri = std::move(uri),
+                      contents = std::move(contents)]() {
+    auto sym = NslTU::symbolAt(contents, at, backend_.includes());
+    sendResponse(id, sym ? render(*sym, uri) : llvm::json::Value(nullptr));
+  });
+  std::lock_guard<std::mutex> wguard(workers_mtx_);
+  workers_.push_back(std::move(worker));
+}
+
 void NslLSPServer::onCancelRequest(const llvm::json::Value &params) {
   auto *obj = params.getAsObject();
   if (!obj)
@@ -14,6 +14,7 @@
 #define NSL_LSP_NSL_LSP_SERVER_H
 
 #include "CancellationToken.h"
+#include "NslTU.h"
 #include "RequestId.h"
 
 #include "llvm/ADT/StringMap.h"
@@ -58,6 +59,15 @@ private:
 
   // Feature handlers.
   void onFoldingRange(const RequestId &id, const llvm::json::Value &params);
+  void onHover(const RequestId &id, const llvm::json::Value &params);
+  void onDefinition(const RequestId &id, const llvm::json::Value &params);
+
+  /// Shared body of hover and definition: looks up the symbol at the
+  /// request's position on a worker thread and answers with
+  /// `render(symbol, uri)`, or `null` when there is none.
+  void respondWithSymbolAt(
+      const RequestId &id, const llvm::json::Value &params,
+      llvm::json::Value (*render)(const NslTU::SymbolAt &, llvm::StringRef));
 
   // Cancellation.
   void onCancelRequest(const llvm::json::Value &params);
@@ -84,7 +94,8 @@ private:
   std::mutex inflight_mtx_;
   std::map<RequestId, CancellationToken> inflight_;
 
-  // Worker threads spawned for cancellable handlers (foldingRange).
+  // Worker threads spawned for off-thread handlers (foldingRange,
+  // hover, definition).
   // Joined when the run-loop exits so process teardown is clean
   // even if a stray request was in flight at shutdown time.
   std::mutex workers_mtx_;
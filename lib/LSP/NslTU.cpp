@@ -4,11 +4,13 @@
 // preprocess + lex + parse + sema pipeline (Phase 3 / US1, T069).
 // Mirrors the M3 driver pipeline in `lib/Driver/EmitAST.cpp`
 // step-for-step but operates on an in-memory buffer instead of a
-// file path.
+// file path. Hover and go-to-definition (`symbolAt`) parse the
+// request's own snapshot and analyse it through `LazySema`.
 
 #include "NslTU.h"
 
 #include "IncludeSearchPath.h"
+#include "PositionEncoding.h"
 #include "nsl/AST/CompilationUnit.h"
 #include "nsl/Basic/Diagnostic.h"
 #include "nsl/Basic/SourceLocation.h"
@@ -19,10 +21,13 @@
 #include "nsl/Preprocess/Preprocessor.h"
 #include "nsl/Sema/Sema.h"
 #include "nsl/Sema/SymbolTable.h"
+#include "nsl/Sema/TypeSystem.h"
 
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Casting.h"
 #include "llvm/Support/ErrorOr.h"
 
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -90,28 +95,28 @@ void replayLineDirectivesOntoSynth(SourceManager &sm, FileID synth_fid) {
   }
 }
 
-} // namespace
-
-namespace {
+/// Path labels of the document buffer and of its preprocessed form.
+/// A location resolving to either is in the document, not in an
+/// `#include`d file.
+constexpr llvm::StringLiteral kDocumentPath("file:///in-memory.nsl");
+constexpr llvm::StringLiteral kPreprocessedPath("file:///in-memory.nsl-pp");
 
-void runPipeline(int version, std::string contents,
-                 const IncludeSearchPath &includes, NslTU::State *out) {
-  out->version = version;
-  out->contents = std::move(contents);
-  out->ast.reset();
-  out->symbols.reset();
-  out->diagnostics.clear();
-
-  // 1. SourceManager + DiagnosticEngine.
-  auto sm = std::make_shared<nsl::SourceManager>();
-  nsl::DiagnosticEngine diag(*sm);
+bool inDocument(llvm::StringRef path) {
+  return path == kDocumentPath || path == kPreprocessedPath;
+}
 
-  // 2. Register the document buffer in the SourceManager.
-  std::vector<char> bytes(out->contents.begin(), out->contents.end());
-  nsl::FileID input_fid = sm->addBufferInMemory(
-      std::string("file:///in-memory.nsl"), std::move(bytes));
+/// Preprocess, lex and parse `contents` into `sm`. Sets `*synth` to
+/// the preprocessed buffer the AST points into; returns null when
+/// preprocessing or parsing fails (the reasons are on `diag`).
+std::unique_ptr<ast::CompilationUnit>
+parseDocument(const std::string &contents, const IncludeSearchPath &includes,
+              SourceManager &sm, DiagnosticEngine &diag, FileID *synth) {
+  // 1. Register the document buffer in the SourceManager.
+  std::vector<char> bytes(contents.begin(), contents.end());
+  nsl::FileID input_fid =
+      sm.addBufferInMemory(kDocumentPath.str(), std::move(bytes));
 
-  // 3. Build preprocess::IncludeSearchPath from the LSP-side
+  // 2. Build preprocess::IncludeSearchPath from the LSP-side
   //    paths (NSL_INCLUDE) plus the document's parent directory
   //    for quote-form resolution. Phase 3 keeps quote-form
   //    document-relative resolution implicit (FR-020b is a
@@ -123,34 +128,51 @@ void runPipeline(int version, std::string contents,
 
   std::vector<std::pair<std::string, std::string>> predefined;
 
-  preprocess::Preprocessor pp(*sm, diag, search, predefined);
+  preprocess::Preprocessor pp(sm, diag, search, predefined);
   llvm::ErrorOr<std::string> pp_out = pp.run(input_fid);
+  if (!pp_out)
+    return nullptr;
 
-  if (pp_out) {
-    // 4. Register the preprocessed buffer + run the lexer + parser.
-    std::vector<char> synth_bytes(pp_out->begin(), pp_out->end());
-    nsl::FileID synth_fid = sm->addBufferInMemory(
-        std::string("file:///in-memory.nsl-pp"), std::move(synth_bytes));
-
-    // Replay `#line` directives from the synthetic buffer so
-    // `resolveVirtual` resolves locations back to original file
-    // coordinates — required for Principle IV diagnostic
-    // localization and FR-026 include-from-notes auto-attach.
-    replayLineDirectivesOntoSynth(*sm, synth_fid);
-
-    Lexer lexer(*sm, synth_fid, diag);
-    auto cu = parse::parseCompilationUnit(lexer, diag);
-
-    if (cu) {
-      // 5. Sema.
-      sema::SemaResult sema_res = driver::runSema(*cu, diag);
-      out->symbols = std::move(sema_res.symbols);
-      // (TypeSystem currently moves with sema_res.types but
-      // NslTU::State doesn't expose a types field at T3 — the
-      // post-Sema printer / future LSP features (T4 hover) will
-      // request it. Phase 3 doesn't need it.)
-      out->ast = std::move(cu);
-    }
+  // 3. Register the preprocessed buffer + run the lexer + parser.
+  std::vector<char> synth_bytes(pp_out->begin(), pp_out->end());
+  *synth =
+      sm.addBufferInMemory(kPreprocessedPath.str(), std::move(synth_bytes));
+
+  // Replay `#line` directives from the synthetic buffer so
+  // `resolveVirtual` resolves locations back to original file
+  // coordinates — required for Principle IV diagnostic
+  // localization and FR-026 include-from-notes auto-attach.
+  replayLineDirectivesOntoSynth(sm, *synth);
+
+  Lexer lexer(sm, *synth, diag);
+  return parse::parseCompilationUnit(lexer, diag);
+}
+
+void runPipeline(int version, std::string contents,
+                 const IncludeSearchPath &includes, sema::SemaCache &cache,
+                 NslTU::State *out) {
+  out->version = version;
+  out->contents = std::move(contents);
+  out->ast.reset();
+  out->symbols.reset();
+  out->diagnostics.clear();
+
+  // 1. SourceManager + DiagnosticEngine.
+  auto sm = std::make_shared<nsl::SourceManager>();
+  nsl::DiagnosticEngine diag(*sm);
+
+  // 2–4. Preprocess, lex, parse.
+  nsl::FileID synth_fid;
+  auto cu = parseDocument(out->contents, includes, *sm, diag, &synth_fid);
+
+  if (cu) {
+    // 5. Sema.
+    sema::SemaResult sema_res = driver::runSema(*cu, diag, &cache);
+    out->symbols = std::move(sema_res.symbols);
+    // (TypeSystem currently moves with sema_res.types but
+    // NslTU::State doesn't expose a types field; hover reads
+    // types through `symbolAt` instead.)
+    out->ast = std::move(cu);
   }
 
   // 6. Capture every diagnostic accumulated across the pipeline.
@@ -166,12 +188,112 @@ void runPipeline(int version, std::string contents,
   out->source_manager = sm;
 }
 
+/// The location in the preprocessed buffer `synth` of document
+/// position `at`, or an invalid location when no line of `synth`
+/// maps back to that document line.
+SourceLocation locationOf(const SourceManager &sm, FileID synth,
+                          NslTU::Position at) {
+  llvm::StringRef const syn = sm.getBuffer(synth);
+  std::size_t off = 0;
+  while (off < syn.size()) {
+    std::size_t const line_begin = off;
+    std::size_t line_end = syn.find('\n', off);
+    if (line_end == llvm::StringRef::npos)
+      line_end = syn.size();
+    off = line_end + 1;
+    llvm::StringRef const line = syn.slice(line_begin, line_end);
+    if (line.starts_with("#line "))
+      continue;
+    auto const begin =
+        SourceLocation::make(synth, static_cast<uint32_t>(line_begin));
+    auto const vloc = sm.resolveVirtual(begin);
+    if (!inDocument(vloc.path) || vloc.line != at.line + 1)
+      continue;
+    std::size_t const col = utf16ToByteOffset(line, at.character);
+    return SourceLocation::make(synth,
+                                static_cast<uint32_t>(line_begin + col));
+  }
+  return SourceLocation();
+}
+
+/// Zero-based, UTF-16 position of `loc` in its user-visible file.
+NslTU::Position positionOf(const SourceManager &sm, SourceLocation loc) {
+  auto const vloc = sm.resolveVirtual(loc);
+  uint32_t const zero_col_byte = vloc.col == 0 ? 0 : vloc.col - 1;
+  NslTU::Position pos;
+  pos.line = vloc.line == 0 ? 0 : vloc.line - 1;
+  pos.character = byteToUtf16Column(sm.getLine(loc), zero_col_byte);
+  return pos;
+}
+
+/// Spelling of `type` for hover text, e.g. `BitVector(8)`.
+std::string typeText(sema::TypeRef type) {
+  switch (type->kind()) {
+  case sema::TypeKind::Bit:
+    return "Bit";
+  case sema::TypeKind::BitVector:
+    return "BitVector(" +
+           std::to_string(llvm::cast<sema::BitVectorType>(type)->width()) +
+           ")";
+  case sema::TypeKind::Struct:
+    return "Struct(" + llvm::cast<sema::StructType>(type)->name().str() + ")";
+  case sema::TypeKind::Memory: {
+    const auto *mem = llvm::cast<sema::MemoryType>(type);
+    return "Memory(" + std::to_string(mem->depth()) + " x " +
+           typeText(mem->element()) + ")";
+  }
+  case sema::TypeKind::Unresolved:
+    return "Unresolved";
+  }
+  return "Unresolved";
+}
+
 } // namespace
 
+std::optional<NslTU::SymbolAt>
+NslTU::symbolAt(const std::string &contents, Position at,
+                const IncludeSearchPath &includes) {
+  nsl::SourceManager sm;
+  nsl::DiagnosticEngine diag(sm);
+  nsl::FileID synth_fid;
+  auto cu = parseDocument(contents, includes, sm, diag, &synth_fid);
+  if (!cu)
+    return std::nullopt;
+  SourceLocation const loc = locationOf(sm, synth_fid, at);
+  if (!loc.isValid())
+    return std::nullopt;
+
+  sema::LazySema lazy(*cu, diag);
+  const ast::Expr *e = lazy.exprAt(loc);
+  if (e == nullptr)
+    return std::nullopt;
+  const sema::Symbol *sym = lazy.resolve(*e);
+  if (sym == nullptr)
+    return std::nullopt;
+
+  SymbolAt out;
+  out.description = sema::toString(sym->kind()).str() + " " +
+                    sym->name().str();
+  sema::TypeRef const type = lazy.typeOf(*e);
+  if (type != nullptr && type->kind() != sema::TypeKind::Unresolved)
+    out.description += " : " + typeText(type);
+
+  SourceRange const decl = sym->declLoc();
+  if (!decl.isValid())
+    return out;
+  llvm::StringRef const decl_path = sm.resolveVirtual(decl.begin()).path;
+  out.has_declaration = true;
+  if (!inDocument(decl_path))
+    out.decl_path = decl_path.str();
+  out.decl_start = positionOf(sm, decl.begin());
+  out.decl_end = positionOf(sm, decl.end());
+  return out;
+}
+
 int NslTU::reparse(int version, std::string contents,
                    const IncludeSearchPath &includes) {
   std::lock_guard<std::mutex> guard(mtx_);
-  runPipeline(version, std::move(contents), includes, &state_);
+  runPipeline(version, std::move(contents), includes, sema_cache_, &state_);
   return version;
 }
 
@@ -23,10 +23,13 @@
 // acceptable: the only consumers are inside lib/LSP/.
 #include "nsl/AST/CompilationUnit.h"
 #include "nsl/Basic/Diagnostic.h"
+#include "nsl/Sema/Sema.h"
 #include "nsl/Sema/SymbolTable.h"
 
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -52,11 +55,39 @@ public:
     std::shared_ptr<nsl::SourceManager> source_manager;
   };
 
+  /// Zero-based LSP position; `character` counts UTF-16 code units.
+  struct Position {
+    uint32_t line = 0;
+    uint32_t character = 0;
+  };
+
+  /// What a name in a document refers to; see `symbolAt`.
+  struct SymbolAt {
+    /// `<kind> <name>`, then ` : <type>` once its type is known.
+    std::string description;
+    /// False when the symbol has no source location; the fields
+    /// below are then unset.
+    bool has_declaration = false;
+    /// File the declaration is in; empty for the document itself.
+    std::string decl_path;
+    Position decl_start;
+    Position decl_end;
+  };
+
   NslTU();
   ~NslTU();
   NslTU(const NslTU &) = delete;
   NslTU &operator=(const NslTU &) = delete;
 
+  /// What the name at `at` in `contents` refers to, for
+  /// `textDocument/hover` and `textDocument/definition`. Analyses the
+  /// document through `LazySema`, so only the top-level items up to
+  /// the one under the cursor are resolved and no constraint runs.
+  /// Nullopt when no resolved name sits at `at`.
+  static std::optional<SymbolAt> symbolAt(const std::string &contents,
+                                          Position at,
+                                          const IncludeSearchPath &includes);
+
   /// Replace state in-place with a fresh parse + sema for `version`
   /// over `contents` against `includes`. At Phase 2 this is a stub
   /// that stores `version` + `contents` and produces an empty
@@ -98,6 +129,9 @@ public:
 private:
   mutable std::mutex mtx_;
   State state_;
+  /// Constraint results of the previous reparse's modules; an edit
+  /// re-checks only the modules it touched. Guarded by `mtx_`.
+  nsl::sema::SemaCache sema_cache_;
   std::atomic<int> latest_received_{-1};
 };
 
@@ -69,22 +69,20 @@
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Sema/Sema.h"
 
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/ADT/StringRef.h"
 #include "llvm/Support/raw_ostream.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
 
 namespace nsl::lower {
 
 namespace {
 
-/// Resolve an AST width-expression to an integer.
-///
-/// At Phase 3 (US1) this is a minimal parse-the-decimal-literal
-/// helper: handles `LiteralExpr` with `Decimal` kind. Other forms
-/// (param refs, compile-time constants, hex/binary, etc.) default
-/// to 1; richer width resolution lands when the corresponding
-/// expression visitors land.
 /// Strip the surrounding double quotes from a `LiteralExpr::String`
 /// spelling. The lexer preserves the verbatim source text (per
 /// `LiteralExpr.h` line 35), so a `"done"` source token shows up
@@ -100,27 +98,24 @@ llvm::StringRef unquoteStringLiteral(llvm::StringRef spelling) {
   return spelling;
 }
 
-unsigned resolveWidth(const ast::Expr *width_expr) {
+/// Resolve an AST width-expression to an integer.
+///
+/// Widths are not re-derived here: Sema's resolution pass folds every
+/// width and depth expression (literals of any base, `param_int`
+/// references, arithmetic over them) into `SemaResult::constants`,
+/// and lowering reads the same value Sema typed the declaration
+/// with. An omitted width, or one Sema could not fold, lowers as 1
+/// bit.
+unsigned resolveWidth(const ast::Expr *width_expr,
+                      const sema::ConstantTable &constants) {
   if (!width_expr) {
     return 1; // omitted width → 1-bit per lang.ebnf default
   }
-  // Project rule: -fno-rtti, so use NodeKind-based discrimination
-  // (the project's own `isa<>` machinery via the `kKind` static).
-  if (width_expr->kind() != ast::LiteralExpr::kKind) {
-    return 1; // non-literal width → conservative default
+  std::optional<uint64_t> width = constants.width(width_expr);
+  if (!width || *width > std::numeric_limits<unsigned>::max()) {
+    return 1; // non-constant width → conservative default
   }
-  const auto *lit = static_cast<const ast::LiteralExpr *>(width_expr);
-  if (lit->litKind() != ast::LiteralExpr::Lit::Decimal) {
-    return 1;
-  }
-  unsigned value = 0;
-  for (char c : lit->spelling()) {
-    if (c < '0' || c > '9') {
-      return 1; // unparseable → conservative default
-    }
-    value = value * 10 + static_cast<unsigned>(c - '0');
-  }
-  return value == 0 ? 1 : value;
+  return static_cast<unsigned>(*width);
 }
 
 /// Resolve a decimal-literal `Expr` to an `int64_t`. Phase 3 helper
@@ -146,6 +141,18 @@ int64_t resolveDecimalLiteral(const ast::Expr *expr) {
   return value;
 }
 
+/// Resolve a compile-time-constant `Expr` (slice bound, repeat count,
+/// `param_int` initialiser) to an `int64_t`: the value Sema folded it
+/// to, else `resolveDecimalLiteral`'s reading of it.
+int64_t resolveConstant(const ast::Expr *expr,
+                        const sema::ConstantTable &constants) {
+  const llvm::APInt *value = expr ? constants.lookup(*expr) : nullptr;
+  if (value && value->getActiveBits() < 64) {
+    return static_cast<int64_t>(value->getZExtValue());
+  }
+  return resolveDecimalLiteral(expr);
+}
+
 /// Parsed numeric literal: integer value + (optional) explicit width.
 /// If `hasExplicitWidth` is true, the literal carried a sized prefix
 /// (e.g., `2'd0`, `4'b0000`, `8'h2A`) and the `width` field holds it;
@@ -432,22 +439,22 @@ void ASTToMLIR::visit(const ast::DeclareBlock &node) {
       auto port_name_attr = builder_.getStringAttr(port->name());
       switch (port->direction()) {
       case D::Input: {
-        auto bits_ty =
-            nsl::dialect::BitsType::get(&ctx_, resolveWidth(port->width()));
+        auto bits_ty = nsl::dialect::BitsType::get(
+            &ctx_, resolveWidth(port->width(), sr_.constants));
         (void)nsl::dialect::InputPortOp::create(builder_, port_loc, bits_ty,
                                                 port_name_attr);
         break;
       }
       case D::Output: {
-        auto bits_ty =
-            nsl::dialect::BitsType::get(&ctx_, resolveWidth(port->width()));
+        auto bits_ty = nsl::dialect::BitsType::get(
+            &ctx_, resolveWidth(port->width(), sr_.constants));
         (void)nsl::dialect::OutputPortOp::create(builder_, port_loc, bits_ty,
                                                  port_name_attr);
         break;
       }
       case D::Inout: {
-        auto bits_ty =
-            nsl::dialect::BitsType::get(&ctx_, resolveWidth(port->width()));
+        auto bits_ty = nsl::dialect::BitsType::get(
+            &ctx_, resolveWidth(port->width(), sr_.constants));
         (void)nsl::dialect::InoutPortOp::create(builder_, port_loc, bits_ty,
                                                 port_name_attr);
         break;
@@ -498,6 +505,69 @@ void ASTToMLIR::lowerActionBody(const ast::Stmt *body) {
   }
 }
 
+/// Scan `name` for `%<IDENT>%` splices naming a loop variable whose
+/// generate body encloses the insertion point. Text between splices,
+/// and splices naming anything else (a genuine macro residue, left
+/// for slot 6 to report), stay literal.
+mlir::ArrayAttr
+ASTToMLIR::structuredName(llvm::StringRef name,
+                          llvm::SmallVectorImpl<mlir::Value> &indices) {
+  if (loopVars_.empty()) {
+    return {};
+  }
+  mlir::Region *here = builder_.getInsertionBlock()->getParent();
+  llvm::SmallVector<mlir::Attribute, 4> parts;
+  std::string literal;
+  bool structured = false;
+  size_t pos = 0;
+  while (pos < name.size()) {
+    size_t open = name.find('%', pos);
+    if (open == llvm::StringRef::npos) {
+      break;
+    }
+    size_t close = name.find('%', open + 1);
+    if (close == llvm::StringRef::npos) {
+      break;
+    }
+    llvm::StringRef ident = name.slice(open + 1, close);
+    mlir::Value iv;
+    for (auto it = loopVars_.rbegin(); it != loopVars_.rend(); ++it) {
+      if (it->first == ident &&
+          it->second.getParentRegion()->isAncestor(here)) {
+        iv = it->second;
+        break;
+      }
+    }
+    if (!iv) {
+      // Keep the opening `%` literal; the closing one may open the
+      // next splice.
+      literal += name.slice(pos, close);
+      pos = close;
+      continue;
+    }
+    literal += name.slice(pos, open);
+    if (!literal.empty()) {
+      parts.push_back(builder_.getStringAttr(literal));
+      literal.clear();
+    }
+    auto found = llvm::find(indices, iv);
+    parts.push_back(builder_.getI64IntegerAttr(found - indices.begin()));
+    if (found == indices.end()) {
+      indices.push_back(iv);
+    }
+    structured = true;
+    pos = close + 1;
+  }
+  if (!structured) {
+    return {};
+  }
+  literal += name.substr(pos);
+  if (!literal.empty()) {
+    parts.push_back(builder_.getStringAttr(literal));
+  }
+  return builder_.getArrayAttr(parts);
+}
+
 void ASTToMLIR::visit(const ast::FuncDefn &node) {
   // FR-006 row "FuncDefn → nsl.func @<name> { ... }". Per Q5 →
   // Option A', the `sym_name` is a literal dotted form when the
@@ -683,7 +753,8 @@ void ASTToMLIR::visit(const ast::RegDecl &node) {
   // Absence of an init clause leaves the attribute null (printer
   // omits the `= …` form).
   auto loc = builder_.getUnknownLoc();
-  auto bits_ty = nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+  auto bits_ty = nsl::dialect::BitsType::get(
+      &ctx_, resolveWidth(node.width(), sr_.constants));
   mlir::IntegerAttr init_attr;
   if (const ast::Expr *init = node.init();
       init && init->kind() == ast::LiteralExpr::kKind &&
@@ -691,8 +762,13 @@ void ASTToMLIR::visit(const ast::RegDecl &node) {
           ast::LiteralExpr::Lit::Decimal) {
     init_attr = builder_.getI64IntegerAttr(resolveDecimalLiteral(init));
   }
+  // Inside a generate, a name mentioning the loop variable refers
+  // to it through the induction variable (structured name).
+  llvm::SmallVector<mlir::Value, 2> name_indices;
+  mlir::ArrayAttr name_parts = structuredName(node.name(), name_indices);
   auto reg_op = nsl::dialect::RegOp::create(
-      builder_, loc, bits_ty, builder_.getStringAttr(node.name()), init_attr);
+      builder_, loc, bits_ty, builder_.getStringAttr(node.name()), init_attr,
+      name_indices, name_parts);
   // Register the SSA result under the AST identifier so transfer-
   // statement RHS / LHS identifier resolution can locate this storage
   // (transitional name-table — see header comment).
@@ -702,7 +778,8 @@ void ASTToMLIR::visit(const ast::RegDecl &node) {
 void ASTToMLIR::visit(const ast::WireDecl &node) {
   // FR-006 row "WireDecl → nsl.wire "n" : !nsl.bits<W>".
   auto loc = builder_.getUnknownLoc();
-  auto bits_ty = nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+  auto bits_ty = nsl::dialect::BitsType::get(
+      &ctx_, resolveWidth(node.width(), sr_.constants));
   auto wire_op = nsl::dialect::WireOp::create(
       builder_, loc, bits_ty, builder_.getStringAttr(node.name()));
   nameTable_[node.name()] = wire_op.getResult();
@@ -721,7 +798,8 @@ void ASTToMLIR::visit(const ast::VariableDecl &node) {
   // variables pass then walks all uses post-visit and remaps to
   // the per-version wire chain.
   auto loc = builder_.getUnknownLoc();
-  auto bits_ty = nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+  auto bits_ty = nsl::dialect::BitsType::get(
+      &ctx_, resolveWidth(node.width(), sr_.constants));
   auto var_op = nsl::dialect::VariableOp::create(
       builder_, loc, bits_ty, builder_.getStringAttr(node.name()));
   nameTable_[node.name()] = var_op.getResult();
@@ -730,10 +808,10 @@ void ASTToMLIR::visit(const ast::VariableDecl &node) {
 void ASTToMLIR::visit(const ast::MemDecl &node) {
   // FR-006 row "MemDecl → nsl.mem "n" : !nsl.mem<[D x T]>".
   auto loc = builder_.getUnknownLoc();
-  auto element_ty =
-      nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
-  auto mem_ty =
-      nsl::dialect::MemType::get(&ctx_, resolveWidth(node.depth()), element_ty);
+  auto element_ty = nsl::dialect::BitsType::get(
+      &ctx_, resolveWidth(node.width(), sr_.constants));
+  auto mem_ty = nsl::dialect::MemType::get(
+      &ctx_, resolveWidth(node.depth(), sr_.constants), element_ty);
   auto mem_op = nsl::dialect::MemOp::create(
       builder_, loc, mem_ty, builder_.getStringAttr(node.name()));
   nameTable_[node.name()] = mem_op.getResult();
@@ -1125,8 +1203,8 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
     // extend bits<4>→bits<4> is a structural identity that the
     // verifier accepts since `N >= M` permits equality).
     const auto *sx = static_cast<const ast::SignExtendExpr *>(expr);
-    auto result_ty =
-        nsl::dialect::BitsType::get(&ctx_, resolveWidth(sx->width()));
+    auto result_ty = nsl::dialect::BitsType::get(
+        &ctx_, resolveWidth(sx->width(), sr_.constants));
     auto sub_val = lowerExpr(sx->sub(), result_ty);
     if (!sub_val) {
       return {};
@@ -1141,8 +1219,8 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
     // Width-inference: same shape as `nsl.sign_extend` — explicit
     // prefix → result type → hint to sub.
     const auto *zx = static_cast<const ast::ZeroExtendExpr *>(expr);
-    auto result_ty =
-        nsl::dialect::BitsType::get(&ctx_, resolveWidth(zx->width()));
+    auto result_ty = nsl::dialect::BitsType::get(
+        &ctx_, resolveWidth(zx->width(), sr_.constants));
     auto sub_val = lowerExpr(zx->sub(), result_ty);
     if (!sub_val) {
       return {};
@@ -1185,8 +1263,7 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
   }
   if (expr->kind() == ast::SliceExpr::kKind) {
     // FR-007 row "SliceExpr → nsl.extract". Per S15 the indices
-    // are compile-time constants (Sema's domain); at the AST level
-    // they are LiteralExpr Decimals. Single-index form
+    // are compile-time constants, folded by Sema. Single-index form
     // (`v[i]`) has `lo == nullptr` (per SliceExpr.h doc) — that
     // collapses to `lowBit = i`, `width = 1`.
     const auto *sl = static_cast<const ast::SliceExpr *>(expr);
@@ -1194,8 +1271,8 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
     if (!sub_val) {
       return {};
     }
-    int64_t hi = resolveDecimalLiteral(sl->hi());
-    int64_t lo = sl->lo() ? resolveDecimalLiteral(sl->lo()) : hi;
+    int64_t hi = resolveConstant(sl->hi(), sr_.constants);
+    int64_t lo = sl->lo() ? resolveConstant(sl->lo(), sr_.constants) : hi;
     if (hi < lo) {
       return {};
     }
@@ -1361,19 +1438,19 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
     // FR-007 row "RepeatExpr → nsl.repeat". NSL `N{a}` per §11 line
     // 700: operand `a` is repeated `N` times left-to-right, result
     // width is `N × operand_width`. Per S15, `N` is a compile-time
-    // constant — at the AST level that's a `LiteralExpr` decimal or
-    // an `IdentifierExpr` referring to a `param_int` (resolved
-    // eagerly via `paramTable_`, mirroring `visit(StructuralGenerate)`'s
-    // bound-resolution policy so the count lands as a literal
-    // `I64Attr` and `NSLResolveParamsPass` has no work to do here).
+    // constant — Sema folds it into `SemaResult::constants`; an
+    // `IdentifierExpr` it could not fold is looked up in `paramTable_`
+    // (mirroring `visit(StructuralGenerate)`'s bound-resolution
+    // policy so the count lands as a literal `I64Attr` and
+    // `NSLResolveParamsPass` has no work to do here).
     //
     // Compile-time helpers (`_int(...)`, `_pow(...)`, etc., per
     // pp.ebnf §3) are already substituted to a literal by the M1
     // preprocessor by the time we see them here, so they reach this
-    // path as `LiteralExpr` Decimal — the literal-arm covers them.
+    // path as `LiteralExpr` Decimal.
     //
     // Soft-fail per FR-010 if either:
-    //   - the count is neither a decimal literal nor a known param
+    //   - the count is neither a folded constant nor a known param
     //     (Sema-clean inputs would have flagged it upstream);
     //   - the body fails to lower (downstream gap);
     //   - the count is < 1 (the M4 `RepeatOp::verify` would reject it
@@ -1382,9 +1459,8 @@ mlir::Value ASTToMLIR::lowerExpr(const ast::Expr *expr, mlir::Type typeHint) {
     int64_t count = 0;
     const auto *count_expr = rep->count();
     if (count_expr) {
-      if (count_expr->kind() == ast::LiteralExpr::kKind) {
-        count = resolveDecimalLiteral(count_expr);
-      } else if (count_expr->kind() == ast::IdentifierExpr::kKind) {
+      count = resolveConstant(count_expr, sr_.constants);
+      if (count == 0 && count_expr->kind() == ast::IdentifierExpr::kKind) {
         const auto *ident =
             static_cast<const ast::IdentifierExpr *>(count_expr);
         const auto &parts = ident->name().parts;
@@ -1493,9 +1569,8 @@ void ASTToMLIR::visit(const ast::StructDecl &node) {
   // so emit at the current insertion point — top-level placement
   // (sibling of `nsl.module` under the builtin ModuleOp) and nested
   // placement inside `nsl.module` are both legal. Field types come
-  // from each member's width expression (`resolveWidth` — Phase 3
-  // covers Decimal-literal widths only; richer width resolution is
-  // T055 follow-up). Struct-typed fields are deferred to a future
+  // from each member's width expression, as Sema folded it
+  // (`resolveWidth`). Struct-typed fields are deferred to a future
   // increment (the Phase B smoke fixtures use bits-only fields).
   auto loc = builder_.getUnknownLoc();
   auto struct_op = nsl::dialect::StructOp::create(
@@ -1511,8 +1586,8 @@ void ASTToMLIR::visit(const ast::StructDecl &node) {
     mlir::OpBuilder::InsertionGuard guard(builder_);
     builder_.setInsertionPointToStart(&body_block);
     for (const auto &member : node.members()) {
-      auto field_ty =
-          nsl::dialect::BitsType::get(&ctx_, resolveWidth(member.width.get()));
+      auto field_ty = nsl::dialect::BitsType::get(
+          &ctx_, resolveWidth(member.width.get(), sr_.constants));
       (void)nsl::dialect::FieldDeclOp::create(
           builder_, loc, builder_.getStringAttr(member.name),
           mlir::TypeAttr::get(field_ty));
@@ -1541,9 +1616,12 @@ void ASTToMLIR::visit(const ast::StructInstDecl &node) {
     // round-trip fixture `test/Dialect/Types/struct_roundtrip.mlir`.
     // No init attribute at Phase B (struct-init lowering is a
     // follow-up).
+    llvm::SmallVector<mlir::Value, 2> name_indices;
+    mlir::ArrayAttr name_parts =
+        structuredName(node.instanceName(), name_indices);
     auto reg_op = nsl::dialect::RegOp::create(
         builder_, loc, struct_ty, builder_.getStringAttr(node.instanceName()),
-        /*init=*/mlir::IntegerAttr{});
+        /*init=*/mlir::IntegerAttr{}, name_indices, name_parts);
     nameTable_[node.instanceName()] = reg_op.getResult();
     return;
   }
@@ -1704,24 +1782,24 @@ void ASTToMLIR::visit(const ast::PortDecl &node) {
     controlTable_.insert(name);
     return;
   case D::Input: {
-    auto bits_ty =
-        nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+    auto bits_ty = nsl::dialect::BitsType::get(
+        &ctx_, resolveWidth(node.width(), sr_.constants));
     auto op =
         nsl::dialect::InputPortOp::create(builder_, loc, bits_ty, name_attr);
     nameTable_[name] = op.getResult();
     return;
   }
   case D::Output: {
-    auto bits_ty =
-        nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+    auto bits_ty = nsl::dialect::BitsType::get(
+        &ctx_, resolveWidth(node.width(), sr_.constants));
     auto op =
         nsl::dialect::OutputPortOp::create(builder_, loc, bits_ty, name_attr);
     nameTable_[name] = op.getResult();
     return;
   }
   case D::Inout: {
-    auto bits_ty =
-        nsl::dialect::BitsType::get(&ctx_, resolveWidth(node.width()));
+    auto bits_ty = nsl::dialect::BitsType::get(
+        &ctx_, resolveWidth(node.width(), sr_.constants));
     auto op =
         nsl::dialect::InoutPortOp::create(builder_, loc, bits_ty, name_attr);
     nameTable_[name] = op.getResult();
@@ -2022,7 +2100,7 @@ void ASTToMLIR::visit(const ast::TopLevelParamDecl &node) {
   mlir::OpBuilder::InsertionGuard guard(builder_);
   builder_.setInsertionPointToEnd(top_module_.getBody());
   if (node.paramKind() == ast::TopLevelParamDecl::ParamKind::Int) {
-    int64_t value = resolveDecimalLiteral(node.init());
+    int64_t value = resolveConstant(node.init(), sr_.constants);
     paramTable_[node.name()] = value;
     nsl::dialect::ParamIntOp::create(builder_, loc,
                                      builder_.getStringAttr(node.name()),
@@ -2151,7 +2229,17 @@ void ASTToMLIR::visit(const ast::StructuralGenerate &node) {
   auto &body_block = gen_op.getBody().emplaceBlock();
   mlir::OpBuilder::InsertionGuard guard(builder_);
   builder_.setInsertionPointToStart(&body_block);
+  // The loop variable is the body's `index` induction variable; regs
+  // whose names mention it refer to it through `structuredName`.
+  const bool has_loop_var = !node.init().empty();
+  if (has_loop_var) {
+    loopVars_.emplace_back(
+        node.init(), body_block.addArgument(builder_.getIndexType(), loc));
+  }
   lowerActionBody(node.body());
+  if (has_loop_var) {
+    loopVars_.pop_back();
+  }
 }
 
 // ---------- No-op stubs for the remaining 50 AST node kinds ----------
@@ -14,6 +14,7 @@
 #define NSL_LIB_LOWER_ASTTOMLIR_H
 
 #include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/MLIRContext.h"
 #include "mlir/IR/OwningOpRef.h"
@@ -26,6 +27,8 @@
 #include "llvm/ADT/StringRef.h"
 #include "llvm/ADT/StringSet.h"
 
+#include <utility>
+
 namespace nsl::ast {
 class CompilationUnit;
 class Expr;
@@ -103,6 +106,15 @@ private:
   /// avoids leaking RHS-side `nsl.constant` ops into the IR.
   mlir::Value lowerExpr(const ast::Expr *expr, mlir::Type typeHint = nullptr);
 
+  /// Split a declared `name` mentioning an in-scope generate loop
+  /// variable (`buf_%i%`) into `nsl.reg`'s structured-name form:
+  /// returns the `name_parts` array and appends the referenced
+  /// induction variables to `indices` (each once, in first-use
+  /// order). Returns null when `name` mentions none, so the op
+  /// keeps a plain name.
+  mlir::ArrayAttr structuredName(llvm::StringRef name,
+                                 llvm::SmallVectorImpl<mlir::Value> &indices);
+
   mlir::MLIRContext &ctx_;
   const sema::SemaResult &sr_;
   mlir::OpBuilder builder_;
@@ -232,6 +244,14 @@ private:
   /// Ordering rule (Constitution Principle V — determinism): this
   /// map is for LOOKUP only; never iterate it for emission ordering.
   llvm::StringMap<int64_t> paramTable_;
+
+  /// Loop variables of the `generate`s enclosing the current
+  /// insertion point, outermost first, each with its body's `index`
+  /// induction variable. Pushed / popped by
+  /// `visit(StructuralGenerate)`; searched innermost first so a
+  /// shadowing inner loop variable wins (same binding the `%IDENT%`
+  /// expansion order gives).
+  llvm::SmallVector<std::pair<llvm::StringRef, mlir::Value>, 2> loopVars_;
 };
 
 } // namespace nsl::lower
@@ -33,10 +33,13 @@ mlir::OwningOpRef<mlir::ModuleOp> astToMLIR(mlir::MLIRContext &ctx,
 void registerNSLLowerPasses() {
   mlir::registerPass([]() { return createNSLResolveParamsPass(); });
   mlir::registerPass([]() { return createNSLExpandGeneratePass(); });
+  mlir::registerPass([]() { return createNSLCanonicalizePass(); });
   mlir::registerPass([]() { return createNSLExpandVariablesPass(); });
   mlir::registerPass([]() { return createNSLExplodeSubmodArrayPass(); });
   mlir::registerPass([]() { return createNSLInlineInternalFuncPass(); });
+  mlir::registerPass([]() { return createNSLCSEPass(); });
   mlir::registerPass([]() { return createNSLCheckSemanticsPass(); });
+  mlir::registerPass([]() { return createNSLEliminateDeadSignalsPass(); });
   // M6: nsl→CIRCT conversion. Per
   // specs/010-m6-circt-lowering/contracts/lower-api.contract.md §3 —
   // registration set grows from 6 to 7 passes; this function's
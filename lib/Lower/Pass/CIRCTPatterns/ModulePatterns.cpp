@@ -5,7 +5,8 @@
 //
 // **Design §10 rows covered (Phase 4)**: nsl.module → hw.HWModuleOp,
 // nsl.declare → consumed, nsl.{input,output,inout}_port → port +
-// block-arg / output wiring, nsl.submodule → hw.instance,
+// block-arg / output wiring, nsl.submodule → hw.instance (one per
+// element for the array form),
 // nsl.{param_int,param_str} → hw.instance parameters,
 // nsl.constant → hw.constant, nsl.transfer (output-port LHS) →
 // hw.output operand wiring.
@@ -54,6 +55,7 @@
 // `seq::*`, `sv::*`); we drive their *creation* manually.
 
 #include "../CIRCTTypeConverter.h"
+#include "../Common/SubmodArray.h"
 #include "../NSLToCIRCTPass.h"
 #include "circt/Dialect/Comb/CombOps.h"
 #include "circt/Dialect/HW/HWAttributes.h"
@@ -2041,6 +2043,11 @@ mlir::LogicalResult lowerOneModule(nsl::dialect::ModuleOp moduleOp,
       collectInstanceParameters(parentModuleOp, builder);
   // Pre-process: handle submodule first (these don't depend on any
   // body data values; defer them to be sequentially handled).
+  //
+  // An array-form `nsl.submodule @inst : @SUB[N]` reaches this point
+  // intact — the nsl pipeline never explodes it — and becomes N
+  // instances `inst_0` … `inst_<N-1>` here, so no per-element
+  // `nsl` symbol is ever created.
   for (auto &op : llvm::make_early_inc_range(*hwModuleOp.getBodyBlock())) {
     if (auto sub = llvm::dyn_cast<nsl::dialect::SubmoduleOp>(&op)) {
       auto target = parentModuleOp.lookupSymbol<circt::hw::HWModuleOp>(
@@ -2053,9 +2060,24 @@ mlir::LogicalResult lowerOneModule(nsl::dialect::ModuleOp moduleOp,
       mlir::OpBuilder::InsertionGuard g(builder);
       builder.setInsertionPoint(&op);
       llvm::SmallVector<mlir::Value, 0> emptyInputs;
-      circt::hw::InstanceOp::create(
-          builder, sub.getLoc(), target.getOperation(), sub.getSymNameAttr(),
-          llvm::ArrayRef<mlir::Value>(emptyInputs), instanceParams);
+      auto instantiate = [&](mlir::StringAttr name) {
+        circt::hw::InstanceOp::create(
+            builder, sub.getLoc(), target.getOperation(), name,
+            llvm::ArrayRef<mlir::Value>(emptyInputs), instanceParams);
+      };
+      if (auto size = sub.getArraySize()) {
+        int64_t n = *size;
+        if (n < 0) {
+          sub.emitOpError() << "array_size is negative — refusing to expand";
+          return mlir::failure();
+        }
+        for (int64_t k = 0; k < n; ++k) {
+          instantiate(builder.getStringAttr(
+              submodElementName(sub.getSymName(), k)));
+        }
+      } else {
+        instantiate(sub.getSymNameAttr());
+      }
       sub.erase();
     }
   }
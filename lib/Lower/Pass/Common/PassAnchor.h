@@ -0,0 +1,36 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Lower/Pass/Common/PassAnchor.h — private helper naming the ops
+// an M5 structural pass may be anchored on (layer 8a, internal).
+//
+// `nsl.module` is `IsolatedFromAbove`: its body reaches ports,
+// params and structs through symbols, never through SSA values
+// captured from the enclosing builtin `module`. A pass that only
+// rewrites module bodies is therefore declared op-agnostic and
+// scheduled either on the builtin `module` (one run over the whole
+// compilation unit — what `nsl-opt -nsl-<pass>` does) or nested on
+// each `nsl.module`, where the MLIR pass manager runs the modules
+// concurrently (`Compilation::runNSLPasses`).
+//
+// **Internal-only**. Not re-exported from `Lower.h`.
+
+#ifndef NSL_LIB_LOWER_PASS_COMMON_PASSANCHOR_H
+#define NSL_LIB_LOWER_PASS_COMMON_PASSANCHOR_H
+
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/Support/TypeID.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+
+namespace nsl::lower {
+
+/// True if `name` is an op a module-body pass may run on: the builtin
+/// `module` or an `nsl.module`. Use as the pass's `canScheduleOn`.
+inline bool isModuleBodyAnchor(mlir::RegisteredOperationName name) {
+  return name.getTypeID() == mlir::TypeID::get<mlir::ModuleOp>() ||
+         name.getTypeID() == mlir::TypeID::get<nsl::dialect::ModuleOp>();
+}
+
+} // namespace nsl::lower
+
+#endif // NSL_LIB_LOWER_PASS_COMMON_PASSANCHOR_H
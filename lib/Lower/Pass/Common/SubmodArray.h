@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Lower/Pass/Common/SubmodArray.h — private helper naming the
+// elements of an array-form `nsl.submodule` (layer 8a, internal).
+//
+// `SUB[N] inst;` stays one `nsl.submodule @inst : @SUB[N]` op through
+// the nsl pipeline; the nsl→CIRCT conversion expands it into N
+// `hw.instance` ops. The standalone `nsl-explode-submod-array` pass
+// expands it into N singleton `nsl.submodule` ops instead. Both name
+// element `k` with this helper so the two routes agree.
+//
+// **Internal-only**. Not re-exported from `Lower.h`.
+
+#ifndef NSL_LIB_LOWER_PASS_COMMON_SUBMODARRAY_H
+#define NSL_LIB_LOWER_PASS_COMMON_SUBMODARRAY_H
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Twine.h"
+
+#include <cstdint>
+#include <string>
+
+namespace nsl::lower {
+
+/// The name of element `index` of the submodule array `base`:
+/// `<base>_<index>` (e.g. `inst_2`). Not `inst[2]`: MLIR symbol names
+/// cannot contain an unescaped `[` / `]`.
+inline std::string submodElementName(llvm::StringRef base, int64_t index) {
+  return (base + "_" + llvm::Twine(index)).str();
+}
+
+} // namespace nsl::lower
+
+#endif // NSL_LIB_LOWER_PASS_COMMON_SUBMODARRAY_H
@@ -0,0 +1,192 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Lower/Pass/NSLCSEPass.cpp — slot 5b of the M5
+// structural-expansion pipeline.
+//
+// Common-subexpression elimination over the `nsl` dialect. The
+// AST→nsl visitor emits a fresh op for every occurrence of an
+// expression in the source, so the same `a + b` or the same field
+// extract written in ten `alt` arms is ten ops — and, after the
+// nsl→CIRCT conversion, ten `comb` ops for ExportVerilog to print.
+//
+// The pass respects the dialect's side-effect model. Only ops with
+// no memory effects are merged: the Pure expression ops and
+// `nsl.constant`. `nsl.transfer`, `nsl.clocked_transfer`,
+// `nsl.incdec`, `nsl.call`, `nsl.fire_probe` and the storage
+// declarations (`nsl.wire` / `nsl.reg` / `nsl.mem`) carry no effect
+// interface, so MLIR treats them as having unknown effects and
+// never merges or moves them.
+//
+// Two steps, repeated until nothing moves:
+//   1. **Hoist**. Upstream CSE only replaces an op with an equivalent
+//      op that dominates it, and the arms of one `nsl.alt` do not
+//      dominate each other. So a Pure op inside a combinational
+//      action container (`nsl.alt`, `nsl.any`, `nsl.case`,
+//      `nsl.default`, `nsl.if`, `nsl.parallel`) that has an
+//      equivalent op elsewhere under the same block is moved out,
+//      to just before the outermost container its operands are
+//      defined outside of. The hardware evaluates every expression
+//      every cycle anyway, so moving one out of a condition changes
+//      nothing but its position. Ops under `nsl.seq`, `nsl.proc`,
+//      `nsl.state` or `nsl.func` stay put: those bodies are lowered
+//      by the FSM conversion, not as plain combinational logic. An
+//      op with no duplicate is not moved, so the op order in
+//      unaffected modules stays the source order.
+//   2. **Eliminate**. `mlir::eliminateCommonSubExpressions` replaces
+//      each op dominated by an equivalent one. The first op in
+//      program order is the one kept (Constitution Principle V).
+//
+// Anchors:
+//   - `specs/008-m5-structural-passes/contracts/pass-pipeline.contract.md`
+//     §1 (pipeline order)
+//   - `lib/Dialect/NSL/IR/NSLOps.td` — the Pure trait set on the
+//     expression ops
+
+#include "Common/PassAnchor.h"
+#include "mlir/IR/Dominance.h"
+#include "mlir/IR/OperationSupport.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Transforms/CSE.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+#include "nsl/Lower/Lower.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/MapVector.h"
+#include "llvm/ADT/SmallVector.h"
+
+namespace nsl::lower {
+
+namespace {
+
+/// True if `op` is an action container whose body is lowered as
+/// conditional combinational logic.
+bool isCombinationalContainer(mlir::Operation *op) {
+  return mlir::isa<nsl::dialect::AltOp, nsl::dialect::AnyOp,
+                   nsl::dialect::CaseOp, nsl::dialect::DefaultOp,
+                   nsl::dialect::IfOp, nsl::dialect::ParallelOp>(op);
+}
+
+/// The outermost combinational container `op` can be moved in front
+/// of, or null if `op` must stay where it is. Only containers placed
+/// directly in an `nsl.module` body qualify.
+mlir::Operation *hoistTarget(mlir::Operation *op) {
+  if (!mlir::isPure(op) || op->getNumRegions() != 0 ||
+      op->getNumResults() == 0) {
+    return nullptr;
+  }
+  mlir::Operation *target = nullptr;
+  for (mlir::Operation *p = op->getParentOp();
+       p && isCombinationalContainer(p); p = p->getParentOp()) {
+    bool definedOutside = llvm::all_of(op->getOperands(), [&](mlir::Value v) {
+      return !p->isAncestor(v.getParentBlock()->getParentOp());
+    });
+    if (!definedOutside) {
+      break;
+    }
+    target = p;
+  }
+  if (target && !mlir::isa<nsl::dialect::ModuleOp>(target->getParentOp())) {
+    return nullptr;
+  }
+  return target;
+}
+
+struct EquivalentOp : llvm::DenseMapInfo<mlir::Operation *> {
+  static unsigned getHashValue(const mlir::Operation *op) {
+    return mlir::OperationEquivalence::computeHash(
+        const_cast<mlir::Operation *>(op),
+        mlir::OperationEquivalence::directHashValue,
+        mlir::OperationEquivalence::ignoreHashValue,
+        mlir::OperationEquivalence::IgnoreLocations);
+  }
+  static bool isEqual(const mlir::Operation *lhs, const mlir::Operation *rhs) {
+    if (lhs == rhs) {
+      return true;
+    }
+    if (lhs == getEmptyKey() || lhs == getTombstoneKey() ||
+        rhs == getEmptyKey() || rhs == getTombstoneKey()) {
+      return false;
+    }
+    return mlir::OperationEquivalence::isEquivalentTo(
+        const_cast<mlir::Operation *>(lhs), const_cast<mlir::Operation *>(rhs),
+        mlir::OperationEquivalence::IgnoreLocations);
+  }
+};
+
+class NSLCSEPass
+    : public mlir::PassWrapper<NSLCSEPass, mlir::OperationPass<>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLCSEPass)
+
+  NSLCSEPass() = default;
+  NSLCSEPass(const NSLCSEPass &other) : PassWrapper(other) {}
+
+  llvm::StringRef getArgument() const final { return "nsl-cse"; }
+  llvm::StringRef getDescription() const final {
+    return "Slot 5b: merge equivalent Pure nsl expression ops, hoisting "
+           "duplicates out of alt / any / if arms.";
+  }
+
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
+
+  void runOnOperation() final {
+    mlir::IRRewriter rewriter(&getContext());
+    // Each round either moves ops outward or erases ops, so the loop
+    // ends. A round that merges ops can make their users equivalent,
+    // which the next round hoists.
+    bool changed = true;
+    while (changed) {
+      bool hoisted = hoistDuplicates();
+      mlir::DominanceInfo domInfo(getOperation());
+      bool eliminated = false;
+      mlir::eliminateCommonSubExpressions(rewriter, domInfo, getOperation(),
+                                          &eliminated);
+      changed = hoisted || eliminated;
+    }
+  }
+
+private:
+  /// Step 1. Returns true if any op moved.
+  bool hoistDuplicates() {
+    // Group the hoistable ops by equivalence, in pre-order so the
+    // first op of each group is the one upstream CSE will keep.
+    llvm::MapVector<mlir::Operation *,
+                    llvm::SmallVector<std::pair<mlir::Operation *,
+                                                mlir::Operation *>, 2>,
+                    llvm::DenseMap<mlir::Operation *, unsigned, EquivalentOp>>
+        groups;
+    getOperation()->walk<mlir::WalkOrder::PreOrder>([&](mlir::Operation *op) {
+      if (mlir::Operation *target = hoistTarget(op)) {
+        groups[op].emplace_back(op, target);
+      }
+    });
+    bool moved = false;
+    for (auto &group : groups) {
+      if (group.second.size() < 2) {
+        continue;
+      }
+      for (auto [op, target] : group.second) {
+        op->moveBefore(target);
+        ++numHoisted;
+        moved = true;
+      }
+    }
+    return moved;
+  }
+
+  Statistic numHoisted{this, "hoisted",
+                       "Number of duplicated ops hoisted out of action "
+                       "containers"};
+};
+
+} // namespace
+
+std::unique_ptr<mlir::Pass> createNSLCSEPass() {
+  return std::make_unique<NSLCSEPass>();
+}
+
+} // namespace nsl::lower
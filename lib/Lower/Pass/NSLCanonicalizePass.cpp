@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Lower/Pass/NSLCanonicalizePass.cpp — slot 3b of the M5
+// structural-expansion pipeline.
+//
+// Runs the `nsl` dialect's folders and canonicalization patterns
+// (`lib/Dialect/NSL/IR/NSLFolds.cpp`) over every module body. It
+// sits right after `nsl-expand-variables`: by then parameters are
+// resolved, every generate body is replicated and every
+// `nsl.variable` is a chain of wires, so arithmetic on literals,
+// slices of constants and mux arms behind a constant condition all
+// fold away once, here, and inlining, submodule explosion and the
+// nsl→CIRCT conversion see the simplified IR instead of lowering
+// each copy.
+//
+// It must not run before variable expansion. A variable's SSA value
+// reads whatever was last written at the point of each use, so an
+// identity fold (`v + 0` → `v`) that forwards it to a use after a
+// later write would read the new value instead of the old one.
+//
+// Only `nsl.*` patterns are collected — never the upstream
+// `canonicalize` set — so the pass's effect is fixed by this dialect
+// alone. Two greedy-driver defaults are turned off:
+//   - region simplification: `nsl.module` and the action regions
+//     are graph-like; merging or erasing their blocks is not a
+//     canonicalization this pipeline wants;
+//   - constant CSE: folded constants are materialised where the
+//     folded op stood rather than hoisted and merged at the top of
+//     the region, so the op order downstream passes (and the lit
+//     fixtures) see stays the source order (Constitution
+//     Principle V).
+//
+// Anchors:
+//   - `specs/008-m5-structural-passes/contracts/pass-pipeline.contract.md`
+//     §1 (pipeline order)
+//   - `lib/Dialect/NSL/IR/NSLOps.td` — `hasFolder` /
+//     `hasCanonicalizer` on the Pure expression ops
+
+#include "Common/PassAnchor.h"
+#include "mlir/IR/PatternMatch.h"
+#include "mlir/Pass/Pass.h"
+#include "mlir/Rewrite/FrozenRewritePatternSet.h"
+#include "mlir/Transforms/GreedyPatternRewriteDriver.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+#include "nsl/Lower/Lower.h"
+
+#include <cstdint>
+
+namespace nsl::lower {
+
+namespace {
+
+class NSLCanonicalizePass
+    : public mlir::PassWrapper<NSLCanonicalizePass, mlir::OperationPass<>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLCanonicalizePass)
+
+  NSLCanonicalizePass() = default;
+  NSLCanonicalizePass(const NSLCanonicalizePass &other)
+      : PassWrapper(other) {}
+
+  llvm::StringRef getArgument() const final { return "nsl-canonicalize"; }
+  llvm::StringRef getDescription() const final {
+    return "Slot 3b: fold and canonicalize nsl expression ops after "
+           "variable expansion.";
+  }
+
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
+
+  void getDependentDialects(mlir::DialectRegistry &registry) const final {
+    registry.insert<nsl::dialect::NSLDialect>();
+  }
+
+  mlir::LogicalResult initialize(mlir::MLIRContext *ctx) final {
+    mlir::RewritePatternSet set(ctx);
+    for (mlir::RegisteredOperationName op : ctx->getRegisteredOperations()) {
+      if (op.getDialectNamespace() ==
+          nsl::dialect::NSLDialect::getDialectNamespace()) {
+        op.getCanonicalizationPatterns(set, ctx);
+      }
+    }
+    patterns = mlir::FrozenRewritePatternSet(std::move(set));
+    return mlir::success();
+  }
+
+  void runOnOperation() final {
+    mlir::GreedyRewriteConfig config;
+    config.setRegionSimplificationMode(
+        mlir::GreedySimplifyRegionLevel::Disabled);
+    config.enableConstantCSE(false);
+    const uint64_t before = countOps();
+    // Folding reaches a fixpoint on a DAG of Pure ops; non-convergence
+    // would mean a pattern pair undoing each other, which is a bug.
+    if (mlir::failed(
+            mlir::applyPatternsGreedily(getOperation(), patterns, config))) {
+      getOperation()->emitError("nsl-canonicalize did not converge");
+      signalPassFailure();
+      return;
+    }
+    // A fold can also materialise a constant, so this is the net
+    // shrinkage rather than the number of pattern applications.
+    const uint64_t after = countOps();
+    if (after < before) {
+      numOpsFolded += before - after;
+    }
+  }
+
+private:
+  uint64_t countOps() {
+    uint64_t n = 0;
+    getOperation()->walk([&](mlir::Operation *) { ++n; });
+    return n;
+  }
+
+  mlir::FrozenRewritePatternSet patterns;
+
+  Statistic numOpsFolded{this, "ops-folded",
+                         "Net number of ops removed by folding"};
+};
+
+} // namespace
+
+std::unique_ptr<mlir::Pass> createNSLCanonicalizePass() {
+  return std::make_unique<NSLCanonicalizePass>();
+}
+
+} // namespace nsl::lower
@@ -7,9 +7,11 @@
 // `runOnOperation()` invocation per
 // `pass-pipeline.contract.md` §4 (multi-error within one pass):
 //
-//   (1) **Residue detection** — regex scan over every reachable
+//   (1) **Residue detection** — scan of every reachable
 //       `mlir::StringAttr` for unresolved `%IDENT%` splice tokens
-//       (`residue-detection.contract.md` §1, §2). Each match emits
+//       (`residue-detection.contract.md` §1, §2; a hand-written
+//       scanner matching the contract's regex, with one verdict per
+//       uniqued string). Each match emits
 //       `error: unresolved macro splice '%<IDENT>%' after structural expansion`
 //       (frozen by FR-018 + `residue-detection.contract.md` §4).
 //
@@ -18,6 +20,12 @@
 //       `pass-pipeline.contract.md` §3). Diagnostic strings frozen
 //       per Principle VIII; helper bodies land at T097.
 //
+// The pass may run on an `nsl.module` (see `Common/PassAnchor.h`),
+// but `Compilation::runNSLPasses` keeps it on the builtin `module`:
+// a failing nested pass stops the pass manager from starting the
+// remaining modules, which would make the reported set depend on
+// thread scheduling and break the §4 multi-error guarantee.
+//
 // Diagnostic strings are FROZEN per Constitution Principle VIII —
 // renaming is a contract amendment that updates `pass-pipeline.contract.md`
 // §3 + every fixture in the same patch.
@@ -28,101 +36,151 @@
 //   - `specs/008-m5-structural-passes/contracts/pass-pipeline.contract.md`
 //     §3, §4
 
+#include "Common/PassAnchor.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/Pass/Pass.h"
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringMap.h"
 #include "llvm/ADT/StringRef.h"
 
-#include <regex>
-#include <string>
+#include <cstring>
 
 namespace nsl::lower {
 
 namespace {
 
-/// FROZEN regex per `residue-detection.contract.md` §2:
+/// `[A-Za-z_]` — first character of a splice identifier (pp.ebnf §5).
+bool isIdentStart(char c) {
+  return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || c == '_';
+}
+
+/// `[A-Za-z0-9_]` — any later character of a splice identifier.
+bool isIdentBody(char c) { return isIdentStart(c) || (c >= '0' && c <= '9'); }
+
+/// Append the identifier of every non-overlapping `%IDENT%` splice in
+/// `text` to `out`, left to right.
+///
+/// Hand-written equivalent of the FROZEN regex of
+/// `residue-detection.contract.md` §2,
 ///
 ///     R"((%[A-Za-z_][A-Za-z0-9_]*%))"
 ///
-/// `%` literal start, identifier body per pp.ebnf §5, `%` literal
-/// end. ECMAScript-flavour (the `std::regex` default) — character
-/// classes used here are portable across that flavour and POSIX.
-/// Function-local-static so initialisation is one-time per process
-/// and thread-safe (C++11 magic statics).
-const std::regex &residueRegex() {
-  static const std::regex kRe(R"((%[A-Za-z_][A-Za-z0-9_]*%))");
-  return kRe;
+/// with `std::regex_iterator`'s leftmost-match semantics: a match can
+/// only start at a `%`, and since identifier characters never include
+/// `%` the only possible closing `%` is the one right after the
+/// longest identifier run. A `%` that does not open a match is
+/// skipped and the search resumes at the next byte, as the regex
+/// would. `memchr` jumps between `%`s, so a string without one costs
+/// a single scan.
+void scanSplices(llvm::StringRef text,
+                 llvm::SmallVectorImpl<llvm::StringRef> &out) {
+  const char *const end = text.data() + text.size();
+  const char *p = text.data();
+  while (p < end) {
+    const auto *open = static_cast<const char *>(
+        std::memchr(p, '%', static_cast<size_t>(end - p)));
+    if (open == nullptr) {
+      return;
+    }
+    const char *q = open + 1;
+    if (q < end && isIdentStart(*q)) {
+      ++q;
+      while (q < end && isIdentBody(*q)) {
+        ++q;
+      }
+      if (q < end && *q == '%') {
+        out.push_back(
+            llvm::StringRef(open + 1, static_cast<size_t>(q - (open + 1))));
+        p = q + 1;
+        continue;
+      }
+    }
+    p = open + 1;
+  }
 }
 
-/// Run the residue regex over `text` and emit one diagnostic per
-/// non-overlapping match against `op`. Returns the number of
-/// matches found (== diagnostics emitted).
-unsigned scanStringForResidue(mlir::Operation *op, llvm::StringRef text) {
-  // `std::regex_iterator` requires `std::string::const_iterator` or
-  // `const char*`. We use the `cregex_iterator` over the raw range
-  // [begin, end) — no std::string copy needed.
-  const char *begin = text.data();
-  const char *end = begin + text.size();
-  std::cregex_iterator it(begin, end, residueRegex());
-  std::cregex_iterator stop;
-  unsigned count = 0;
-  for (; it != stop; ++it) {
-    auto match = it->str();
-    // `match` includes the surrounding `%` characters; strip them
-    // for the diagnostic. `%[A-Za-z_][A-Za-z0-9_]*%` always has at
-    // least 3 chars (e.g., `%X%`) so this is safe.
-    auto innerStart = match.size() >= 2 ? 1u : 0u;
-    auto innerLen = match.size() >= 2 ? match.size() - 2 : 0u;
-    std::string ident = match.substr(innerStart, innerLen);
-    op->emitError() << "unresolved macro splice '%" << ident
-                    << "%' after structural expansion";
-    ++count;
+/// Residue verdicts for the strings of one pass run. MLIR uniques
+/// `StringAttr`s, so a name shared by many ops (every replica of an
+/// unrolled generate body that kept a literal name, every reference
+/// to one symbol) is scanned once; strings without a `%` never reach
+/// the cache.
+class ResidueScanner {
+public:
+  /// Emit one diagnostic against `op` per `%IDENT%` splice in `text`.
+  /// Returns the number of diagnostics emitted.
+  unsigned scan(mlir::Operation *op, mlir::StringAttr text) {
+    llvm::StringRef value = text.getValue();
+    if (value.empty() ||
+        std::memchr(value.data(), '%', value.size()) == nullptr) {
+      return 0;
+    }
+    auto [it, inserted] = verdicts_.try_emplace(text);
+    if (inserted) {
+      scanSplices(value, it->second);
+    }
+    for (llvm::StringRef ident : it->second) {
+      op->emitError() << "unresolved macro splice '%" << ident
+                      << "%' after structural expansion";
+    }
+    return static_cast<unsigned>(it->second.size());
   }
-  return count;
-}
 
-/// Walk every named attribute on `op` and scan every `StringAttr`
-/// value for residue. Symbol references (`FlatSymbolRefAttr`) are
-/// ALSO scanned per `residue-detection.contract.md` §3 (the contract
-/// note that `FlatSymbolRefAttr::getValue()` is a `StringRef` so the
-/// same regex applies). `IntegerAttr` / `TypeAttr` / nested
-/// `DictionaryAttr` / `ArrayAttr` are NOT scanned — explicit
-/// non-recursion per FR-018 last sentence.
-unsigned scanOpAttrsForResidue(mlir::Operation *op) {
-  unsigned total = 0;
-  for (auto namedAttr : op->getAttrs()) {
-    auto attrValue = namedAttr.getValue();
-    if (auto strAttr = mlir::dyn_cast<mlir::StringAttr>(attrValue)) {
-      total += scanStringForResidue(op, strAttr.getValue());
-    } else if (auto symAttr =
-                   mlir::dyn_cast<mlir::FlatSymbolRefAttr>(attrValue)) {
-      total += scanStringForResidue(op, symAttr.getValue());
+  /// Walk every named attribute on `op` and scan every `StringAttr`
+  /// value for residue. Symbol references (`FlatSymbolRefAttr`) are
+  /// ALSO scanned per `residue-detection.contract.md` §3 (the
+  /// contract note that `FlatSymbolRefAttr::getValue()` is a
+  /// `StringRef` so the same pattern applies). `IntegerAttr` /
+  /// `TypeAttr` / nested `DictionaryAttr` / `ArrayAttr` are NOT
+  /// scanned — explicit non-recursion per FR-018 last sentence.
+  unsigned scanOpAttrs(mlir::Operation *op) {
+    unsigned total = 0;
+    for (auto namedAttr : op->getAttrs()) {
+      auto attrValue = namedAttr.getValue();
+      if (auto strAttr = mlir::dyn_cast<mlir::StringAttr>(attrValue)) {
+        total += scan(op, strAttr);
+      } else if (auto symAttr =
+                     mlir::dyn_cast<mlir::FlatSymbolRefAttr>(attrValue)) {
+        total += scan(op, symAttr.getAttr());
+      }
+      // Nested attribute kinds intentionally not recursed.
     }
-    // Nested attribute kinds intentionally not recursed.
+    return total;
   }
-  return total;
-}
+
+private:
+  /// Splice identifiers per scanned string, in match order. Lookup
+  /// only; never iterated (Constitution Principle V).
+  llvm::DenseMap<mlir::StringAttr, llvm::SmallVector<llvm::StringRef, 1>>
+      verdicts_;
+};
 
 class NSLCheckSemanticsPass
-    : public mlir::PassWrapper<NSLCheckSemanticsPass,
-                               mlir::OperationPass<mlir::ModuleOp>> {
+    : public mlir::PassWrapper<NSLCheckSemanticsPass, mlir::OperationPass<>> {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLCheckSemanticsPass)
 
+  NSLCheckSemanticsPass() = default;
+  NSLCheckSemanticsPass(const NSLCheckSemanticsPass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final { return "nsl-check-semantics"; }
   llvm::StringRef getDescription() const final {
-    return "Slot 6: regex-detect %IDENT% residue across nsl::* StringAttr "
+    return "Slot 6: detect %IDENT% residue across nsl::* StringAttr "
            "values + re-check the six post-expansion-sensitive Sn "
            "(S6/S10/S15/S16/S20/S25) (M5 FR-018).";
   }
 
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
+
   void runOnOperation() final {
-    mlir::ModuleOp module = getOperation();
+    mlir::Operation *root = getOperation();
 
     // Multi-error: per `pass-pipeline.contract.md` §4, we MUST emit
     // ALL diagnostics for ALL violations in a single
@@ -132,19 +190,22 @@ public:
 
     // Step 1 — residue detection. Walk in source order
     // (Constitution Principle V — determinism). Every op
-    // (including the top-level module) has its named-attribute
+    // (including the anchor itself) has its named-attribute
     // dictionary scanned.
-    module.walk(
-        [&](mlir::Operation *op) { diagCount += scanOpAttrsForResidue(op); });
+    ResidueScanner residue;
+    root->walk([&](mlir::Operation *op) {
+      diagCount += residue.scanOpAttrs(op);
+      ++numOpsScanned;
+    });
 
     // Step 2 — sensitive-Sn re-checks per `pass-pipeline.contract.md`
     // §3. Three of the six rows have meaningful structural-only
     // re-checks at M5 (S10, S16, S25); the other three (S6, S15,
     // S20) are documented stubs — see comments below + the XFAIL'd
     // fixtures `test/Lower/passes/nsl-check-semantics/s{6,15,20}_*.mlir`.
-    diagCount += checkS10LoopVarResidue(module);
-    diagCount += checkS16PureNsl(module);
-    diagCount += checkS25ReplicatedCollision(module);
+    diagCount += checkS10LoopVarResidue(root);
+    diagCount += checkS16PureNsl(root);
+    diagCount += checkS25ReplicatedCollision(root);
 
     // **S6 — use-before-def** (DEFERRED at M5): requires SSA
     // operand-traversal across regions. MLIR's SSA verifier already
@@ -165,18 +226,24 @@ public:
     // lands when M6 adds `nsl.submod_iface_bind` (or the eventual
     // op).
 
+    numViolations += diagCount;
     if (diagCount > 0) {
       signalPassFailure();
     }
   }
 
 private:
+  Statistic numOpsScanned{this, "ops-scanned",
+                          "Number of ops scanned for %IDENT% residue"};
+  Statistic numViolations{this, "violations",
+                          "Number of residue / Sn diagnostics emitted"};
+
   /// **S10 re-check**: a `nsl.structural_generate` op surviving to
   /// slot 6 means slot 2 (expand-generate) was skipped or buggy.
   /// FROZEN diagnostic per §3 row S10.
-  unsigned checkS10LoopVarResidue(mlir::ModuleOp module) {
+  unsigned checkS10LoopVarResidue(mlir::Operation *root) {
     unsigned count = 0;
-    module.walk([&](nsl::dialect::StructuralGenerateOp gen) {
+    root->walk([&](nsl::dialect::StructuralGenerateOp gen) {
       llvm::StringRef loopVar =
           gen.getLoopVar().has_value() ? *gen.getLoopVar() : llvm::StringRef{};
       gen.emitError() << "'generate' loop variable '%" << loopVar
@@ -194,15 +261,19 @@ private:
   /// (When M7 introduces V/V/SC submodule lowering, this helper
   /// MUST be amended to walk the submodule list and skip the diag
   /// if any submodule's template resolves to a non-NSL kind.)
-  unsigned checkS16PureNsl(mlir::ModuleOp module) {
+  ///
+  /// Param ops only ever sit in the builtin `module`, so on an
+  /// `nsl.module` anchor this finds nothing.
+  unsigned checkS16PureNsl(mlir::Operation *root) {
     unsigned count = 0;
+    mlir::Block &top = root->getRegion(0).front();
     // Source-order walk via `getOps<>()` — deterministic.
-    for (auto p : module.getOps<nsl::dialect::ParamIntOp>()) {
+    for (auto p : top.getOps<nsl::dialect::ParamIntOp>()) {
       p.emitError() << "parameter '@" << p.getSymName()
                     << "' meaningful only for V/V/SC submodules";
       ++count;
     }
-    for (auto p : module.getOps<nsl::dialect::ParamStrOp>()) {
+    for (auto p : top.getOps<nsl::dialect::ParamStrOp>()) {
       p.emitError() << "parameter '@" << p.getSymName()
                     << "' meaningful only for V/V/SC submodules";
       ++count;
@@ -222,9 +293,9 @@ private:
   /// considered: `nsl.reg`, `nsl.wire`, `nsl.variable`, `nsl.mem`
   /// (each carries a `name` `StringAttr`). FROZEN diagnostic per
   /// §3 row S25.
-  unsigned checkS25ReplicatedCollision(mlir::ModuleOp module) {
+  unsigned checkS25ReplicatedCollision(mlir::Operation *root) {
     unsigned count = 0;
-    module.walk([&](nsl::dialect::ModuleOp nslMod) {
+    root->walk([&](nsl::dialect::ModuleOp nslMod) {
       // Track names seen in source-order in this module's body.
       // `StringMap` lookup is by-key (StringRef), insertion order
       // doesn't affect emission since we only emit on the SECOND
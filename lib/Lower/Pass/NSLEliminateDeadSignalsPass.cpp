@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Lower/Pass/NSLEliminateDeadSignalsPass.cpp — dead-signal
+// elimination ahead of the M6 nsl→CIRCT conversion.
+//
+// Erases logic whose value nothing observes:
+//   - **Write-only signals**. An `nsl.wire` or `nsl.reg` is
+//     write-only when every use is the destination of an
+//     `nsl.transfer` / `nsl.clocked_transfer`, directly or through
+//     an `nsl.extract` partial-assignment slice. The signal, its
+//     writes and its slices are erased. Without this each one
+//     survives into an `hw.wire` / `seq.firreg` that ExportVerilog
+//     prints and no logic reads.
+//   - **Dead expressions**. A Pure op with no uses, including the
+//     source of an erased write, is erased.
+//
+// The pass respects the dialect's side-effect model. Transfers to
+// ports, `nsl.incdec`, `nsl.call`, `nsl.fire_probe`, the `nsl.sim_*`
+// ops and the storage declarations have unknown effects and are
+// never erased as dead on their own; a signal read by any of them,
+// or by anything but a write, is live. `nsl.mem` is not touched: an
+// unread memory still becomes a `seq.firmem` macro. Erasing one
+// signal's writes can leave another signal write-only, so the pass
+// repeats until nothing changes. Signals are visited in source
+// order (Constitution Principle V).
+//
+// Not part of `Compilation::runNSLPasses`: the `-emit=mlir` output
+// shows every declared signal, as written. `Compilation::lowerToCIRCT`
+// runs this pass on each `nsl.module` before `NSLToCIRCTPass`.
+//
+// Anchors:
+//   - `specs/010-m6-circt-lowering/contracts/lower-api.contract.md`
+//     §4 (`lowerToCIRCT` pipeline)
+//   - `lib/Lower/Pass/NSLExpandVariablesPass.cpp` — the same
+//     write-then-erase-feeders walk for unread version wires
+
+#include "Common/PassAnchor.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
+#include "mlir/Pass/Pass.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+#include "nsl/Lower/Lower.h"
+
+#include "llvm/ADT/SetVector.h"
+#include "llvm/ADT/SmallVector.h"
+
+namespace nsl::lower {
+
+namespace {
+
+/// True if `op` writes its operand 0.
+bool isWrite(mlir::Operation *op) {
+  return mlir::isa<nsl::dialect::TransferOp,
+                   nsl::dialect::ClockedTransferOp>(op);
+}
+
+/// Collects the writes to `value` and the slices they write through
+/// into `writes` / `slices`. False if anything reads `value`.
+bool collectWrites(mlir::Value value,
+                   llvm::SmallVectorImpl<mlir::Operation *> &writes,
+                   llvm::SmallVectorImpl<mlir::Operation *> &slices) {
+  for (mlir::OpOperand &use : value.getUses()) {
+    mlir::Operation *user = use.getOwner();
+    if (isWrite(user) && use.getOperandNumber() == 0) {
+      writes.push_back(user);
+    } else if (mlir::isa<nsl::dialect::ExtractOp>(user) &&
+               collectWrites(user->getResult(0), writes, slices)) {
+      slices.push_back(user);
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+class NSLEliminateDeadSignalsPass
+    : public mlir::PassWrapper<NSLEliminateDeadSignalsPass,
+                               mlir::OperationPass<>> {
+public:
+  MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLEliminateDeadSignalsPass)
+
+  NSLEliminateDeadSignalsPass() = default;
+  NSLEliminateDeadSignalsPass(const NSLEliminateDeadSignalsPass &other)
+      : PassWrapper(other) {}
+
+  llvm::StringRef getArgument() const final {
+    return "nsl-eliminate-dead-signals";
+  }
+  llvm::StringRef getDescription() const final {
+    return "Erase write-only wires / regs and unused Pure ops ahead of the "
+           "nsl→CIRCT conversion.";
+  }
+
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
+
+  void runOnOperation() final {
+    // Dead expressions first: a signal they alone read becomes
+    // write-only.
+    eraseDeadOps();
+    while (eraseWriteOnlySignals()) {
+    }
+  }
+
+private:
+  /// Erases every write-only signal, visited in source order. Returns
+  /// true if any signal was erased.
+  bool eraseWriteOnlySignals() {
+    llvm::SmallVector<mlir::Operation *, 16> signals;
+    getOperation()->walk([&](mlir::Operation *op) {
+      if (mlir::isa<nsl::dialect::WireOp, nsl::dialect::RegOp>(op)) {
+        signals.push_back(op);
+      }
+    });
+    bool erased = false;
+    for (mlir::Operation *signal : signals) {
+      llvm::SmallVector<mlir::Operation *, 4> writes;
+      llvm::SmallVector<mlir::Operation *, 2> slices;
+      if (!collectWrites(signal->getResult(0), writes, slices)) {
+        continue;
+      }
+      for (mlir::Operation *write : writes) {
+        mlir::Operation *src = write->getOperand(1).getDefiningOp();
+        write->erase();
+        ++numErasedWrites;
+        if (src && mlir::isOpTriviallyDead(src)) {
+          eraseFeedingOnlyDead(src);
+        }
+      }
+      // `collectWrites` lists a slice before the slice it reads.
+      for (mlir::Operation *slice : slices) {
+        slice->erase();
+      }
+      signal->erase();
+      ++numErasedSignals;
+      erased = true;
+    }
+    return erased;
+  }
+
+  /// Erases `root`, which has no uses, and then every op left without
+  /// uses by it.
+  void eraseFeedingOnlyDead(mlir::Operation *root) {
+    llvm::SmallVector<mlir::Operation *, 8> ops{root};
+    while (!ops.empty()) {
+      mlir::Operation *op = ops.pop_back_val();
+      llvm::SmallSetVector<mlir::Operation *, 4> feeders;
+      for (mlir::Value operand : op->getOperands()) {
+        if (mlir::Operation *def = operand.getDefiningOp()) {
+          feeders.insert(def);
+        }
+      }
+      op->erase();
+      ++numErasedOps;
+      for (mlir::Operation *def : feeders) {
+        if (mlir::isOpTriviallyDead(def)) {
+          ops.push_back(def);
+        }
+      }
+    }
+  }
+
+  /// Erases the unused Pure ops the visitor left behind. Users come
+  /// before the ops they read in reverse post-order, so one sweep
+  /// erases whole dead expression trees.
+  void eraseDeadOps() {
+    llvm::SmallVector<mlir::Operation *, 64> ops;
+    getOperation()->walk<mlir::WalkOrder::PostOrder, mlir::ReverseIterator>(
+        [&](mlir::Operation *op) {
+          if (op != getOperation() && op->getNumRegions() == 0) {
+            ops.push_back(op);
+          }
+        });
+    for (mlir::Operation *op : ops) {
+      if (mlir::isOpTriviallyDead(op)) {
+        op->erase();
+        ++numErasedOps;
+      }
+    }
+  }
+
+  Statistic numErasedSignals{this, "erased-signals",
+                             "Number of write-only wires / regs erased"};
+  Statistic numErasedWrites{this, "erased-writes",
+                            "Number of transfers to erased signals"};
+  Statistic numErasedOps{this, "erased-ops",
+                         "Number of unused Pure ops erased"};
+};
+
+} // namespace
+
+std::unique_ptr<mlir::Pass> createNSLEliminateDeadSignalsPass() {
+  return std::make_unique<NSLEliminateDeadSignalsPass>();
+}
+
+} // namespace nsl::lower
@@ -5,10 +5,20 @@
 //
 // Implements the unroll: every `nsl.structural_generate` op is
 // replaced by N inline copies of its body, where N = (upper - lower
-// + step - 1) / step (clamped at 0 if upper <= lower). Each clone's
-// `%<loop_var>%` substring inside any `StringAttr` value is replaced
-// by the per-iteration integer (decimal). The original op is then
-// erased. Nested generates are handled by a fixed-point loop.
+// + step - 1) / step (clamped at 0 if upper <= lower). When the body
+// takes an `index` induction variable, each clone maps it to an
+// `nsl.index_constant` holding the iteration value, and `nsl.reg`s
+// with a structured name get it rendered from `name_parts`. Any
+// remaining `%<loop_var>%` substring inside a `StringAttr` value is
+// replaced by the per-iteration integer (decimal). The original op
+// is then erased.
+//
+// Nested generates are expanded innermost first from one post-order
+// worklist, so each generate is expanded exactly once and the pass
+// is linear in the size of its output. Before cloning a body, the
+// `StringAttr` slots that mention the loop variable are found once;
+// each replica then rewrites only those slots, with each distinct
+// name substituted and interned once per iteration value.
 //
 // Anchors:
 //   - `specs/008-m5-structural-passes/spec.md` FR-014, acceptance
@@ -16,15 +26,18 @@
 //   - `specs/008-m5-structural-passes/contracts/pass-pipeline.contract.md`
 //     §2 row 2
 
+#include "Common/PassAnchor.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
 #include "mlir/IR/IRMapping.h"
 #include "mlir/Pass/Pass.h"
+#include "mlir/Support/LogicalResult.h"
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
-#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/ADT/StringRef.h"
 
@@ -34,84 +47,153 @@ namespace nsl::lower {
 
 namespace {
 
-/// Substitute every `%<loop_var>%` substring inside `text` with
-/// `replacement`. Returns the new string.
+/// Substitute every occurrence of `needle` (`%<loop_var>%`) inside
+/// `text` with `replacement`. Returns the new string.
 ///
 /// Determinism (Constitution Principle V): pure scan; no map / hash
 /// / unordered iteration involved. Linear in the input size.
-std::string substituteLoopVar(llvm::StringRef text, llvm::StringRef loop_var,
+std::string substituteLoopVar(llvm::StringRef text, llvm::StringRef needle,
                               llvm::StringRef replacement) {
-  if (loop_var.empty()) {
-    return text.str();
-  }
-  // The pattern we match is literal `%<loop_var>%`. We scan once,
-  // appending non-matching prefix + replacement on each hit.
+  // We scan once, appending non-matching prefix + replacement on
+  // each hit.
   std::string out;
   out.reserve(text.size());
   size_t pos = 0;
-  llvm::SmallString<32> needle;
-  needle.push_back('%');
-  needle.append(loop_var.begin(), loop_var.end());
-  needle.push_back('%');
-  llvm::StringRef needleRef = needle.str();
   while (pos < text.size()) {
-    auto nextPos = text.find(needleRef, pos);
+    auto nextPos = text.find(needle, pos);
     if (nextPos == llvm::StringRef::npos) {
       out.append(text.begin() + pos, text.end());
       break;
     }
     out.append(text.begin() + pos, text.begin() + nextPos);
     out.append(replacement.begin(), replacement.end());
-    pos = nextPos + needleRef.size();
+    pos = nextPos + needle.size();
   }
   return out;
 }
 
-/// Walk every `mlir::Attribute` slot on every op inside `block`
-/// (recursively) and rewrite any `StringAttr` whose value contains
-/// `%<loop_var>%` so the substring is replaced by `valueStr`.
+/// Append `op` and every op nested in its regions to `out`, in
+/// pre-order. Cloning preserves this order, so position `k` in a
+/// body's list and in any clone's list name the same op.
+void appendPreorder(mlir::Operation &op,
+                    llvm::SmallVectorImpl<mlir::Operation *> &out) {
+  out.push_back(&op);
+  for (mlir::Region &region : op.getRegions()) {
+    for (mlir::Block &block : region) {
+      for (mlir::Operation &child : block) {
+        appendPreorder(child, out);
+      }
+    }
+  }
+}
+
+/// One `StringAttr` slot in a generate body that mentions the loop
+/// variable: the op holding it (by pre-order position), the
+/// attribute's name, and its value as an index into
+/// `ReplicaPlan::templates`.
+struct LoopVarSlot {
+  unsigned op;
+  mlir::StringAttr name;
+  unsigned value;
+};
+
+/// What every replica of a generate body needs after cloning, found
+/// by one scan of the body before the first clone. Ops are named by
+/// pre-order position.
+struct ReplicaPlan {
+  /// Slots still spelling the loop variable as `%IDENT%`. Distinct
+  /// values are listed once in `templates` (a name repeated across
+  /// slots is substituted and interned once per iteration, not once
+  /// per slot).
+  llvm::SmallVector<LoopVarSlot, 8> slots;
+  llvm::SmallVector<mlir::StringAttr, 8> templates;
+  /// `nsl.reg`s with a structured name.
+  llvm::SmallVector<unsigned, 8> structured;
+  /// `nsl.index_constant`s an inner generate's expansion left behind.
+  llvm::SmallVector<unsigned, 4> constants;
+
+  bool empty() const {
+    return slots.empty() && structured.empty() && constants.empty();
+  }
+};
+
+/// Scan `body` (pre-order). `StringAttr` values containing `needle`
+/// become slots; only the immediate-attribute layer is looked at,
+/// per the M5 spec FR-018 "MUST NOT walk into nested
+/// DictionaryAttr/ArrayAttr" — the same scoping rule residue
+/// detection uses. The `name` of a structured `nsl.reg` is not a
+/// slot: it is rendered from `name_parts` instead.
 ///
-/// We only mutate the immediate-attribute layer per the M5 spec
-/// FR-018 "MUST NOT walk into nested DictionaryAttr/ArrayAttr" —
-/// the same scoping rule applies to substitution to keep behaviour
-/// symmetric with residue detection.
-void substituteLoopVarInBlock(mlir::Block &block, llvm::StringRef loop_var,
-                              llvm::StringRef valueStr) {
-  for (mlir::Operation &op : block) {
-    llvm::SmallVector<mlir::NamedAttribute, 4> rewrites;
-    for (auto namedAttr : op.getAttrs()) {
+/// Determinism (Constitution Principle V): everything is recorded in
+/// body order; the map only deduplicates.
+ReplicaPlan planReplicas(llvm::ArrayRef<mlir::Operation *> body,
+                         llvm::StringRef needle) {
+  ReplicaPlan plan;
+  llvm::DenseMap<mlir::StringAttr, unsigned> templateIndex;
+  for (unsigned k = 0; k < body.size(); ++k) {
+    mlir::Operation *op = body[k];
+    if (mlir::isa<nsl::dialect::IndexConstantOp>(op)) {
+      plan.constants.push_back(k);
+      continue;
+    }
+    auto reg = mlir::dyn_cast<nsl::dialect::RegOp>(op);
+    const bool structured = reg && reg.getNameParts().has_value();
+    if (structured) {
+      plan.structured.push_back(k);
+    }
+    if (needle.empty()) {
+      continue;
+    }
+    for (mlir::NamedAttribute namedAttr : op->getAttrs()) {
       auto strAttr = mlir::dyn_cast<mlir::StringAttr>(namedAttr.getValue());
-      if (!strAttr) {
+      if (!strAttr || !strAttr.getValue().contains(needle) ||
+          (structured && namedAttr.getName() == reg.getNameAttrName())) {
         continue;
       }
-      auto rewritten =
-          substituteLoopVar(strAttr.getValue(), loop_var, valueStr);
-      if (rewritten == strAttr.getValue()) {
-        continue;
+      auto [it, inserted] =
+          templateIndex.try_emplace(strAttr, plan.templates.size());
+      if (inserted) {
+        plan.templates.push_back(strAttr);
       }
-      rewrites.emplace_back(
-          namedAttr.getName(),
-          mlir::StringAttr::get(strAttr.getContext(), rewritten));
+      plan.slots.push_back({k, namedAttr.getName(), it->second});
     }
-    for (auto &kv : rewrites) {
-      op.setAttr(kv.getName(), kv.getValue());
+  }
+  return plan;
+}
+
+/// Render `reg`'s structured name into `name` and drop the structure,
+/// once every index operand is an `nsl.index_constant`. A reg still
+/// indexed by an enclosing generate's induction variable is left for
+/// that generate's expansion.
+void materializeName(nsl::dialect::RegOp reg) {
+  llvm::SmallVector<int64_t, 2> values;
+  for (mlir::Value index : reg.getNameIndices()) {
+    auto c = index.getDefiningOp<nsl::dialect::IndexConstantOp>();
+    if (!c) {
+      return;
     }
-    // Recurse into any regions/blocks the op has — handles a
-    // post-clone sub-structure (e.g., a nested
-    // `nsl.structural_generate` whose StringAttrs inside its body
-    // still need substitution if they contain the OUTER loop_var).
-    for (auto &region : op.getRegions()) {
-      for (mlir::Block &child : region) {
-        substituteLoopVarInBlock(child, loop_var, valueStr);
-      }
+    values.push_back(static_cast<int64_t>(c.getValue()));
+  }
+  std::string name;
+  for (mlir::Attribute part : *reg.getNameParts()) {
+    if (auto literal = mlir::dyn_cast<mlir::StringAttr>(part)) {
+      name += literal.getValue();
+    } else {
+      name += std::to_string(
+          values[mlir::cast<mlir::IntegerAttr>(part).getInt()]);
     }
   }
+  reg.setNameAttr(mlir::StringAttr::get(reg.getContext(), name));
+  reg.removeNamePartsAttr();
+  reg.getNameIndicesMutable().clear();
 }
 
 /// Expand a single `nsl.structural_generate` op into N inline
 /// copies in its parent block. Returns the number of replicas
-/// emitted (0..N).
-unsigned expandOne(nsl::dialect::StructuralGenerateOp gen) {
+/// emitted (0..N), or failure (with an error on `gen`) when the op
+/// cannot be expanded. `gen`'s body must hold no generate of its
+/// own: the pass expands innermost first.
+mlir::FailureOr<unsigned> expandOne(nsl::dialect::StructuralGenerateOp gen) {
   auto lower_v = static_cast<int64_t>(gen.getLower());
   auto upper_v = static_cast<int64_t>(gen.getUpper());
   auto step_v = static_cast<int64_t>(gen.getStep());
@@ -119,10 +201,11 @@ unsigned expandOne(nsl::dialect::StructuralGenerateOp gen) {
       gen.getLoopVar().has_value() ? *gen.getLoopVar() : llvm::StringRef{};
 
   // Defensive: dialect verifier rejects step == 0, but we still
-  // guard so the pass cannot infinite-loop on malformed input.
+  // guard so the pass cannot emit an unbounded expansion on
+  // malformed input.
   if (step_v == 0) {
     gen.emitOpError() << "step is zero — refusing to expand";
-    return 0;
+    return mlir::failure();
   }
   // Determine direction. Positive step expects lower < upper;
   // reverse expansion (upper < lower with negative step) is also
@@ -141,78 +224,92 @@ unsigned expandOne(nsl::dialect::StructuralGenerateOp gen) {
     }
   }
 
-  // Source body block (must exist by SingleBlock trait).
+  // Source body block (must exist by SingleBlock trait). Its
+  // optional `index` argument is the induction variable.
   mlir::Block &srcBlock = gen.getBody().front();
+  mlir::Value iv =
+      srcBlock.getNumArguments() == 1 ? srcBlock.getArgument(0) : nullptr;
+
+  // What each replica needs after cloning is the same for every
+  // replica, so find it once up front.
+  std::string needle;
+  ReplicaPlan plan;
+  if (count != 0) {
+    if (!loop_var.empty()) {
+      needle = "%";
+      needle += loop_var;
+      needle += '%';
+    }
+    llvm::SmallVector<mlir::Operation *, 16> body;
+    for (mlir::Operation &op : srcBlock) {
+      appendPreorder(op, body);
+    }
+    plan = planReplicas(body, needle);
+  }
 
   // Insertion point: just before the structural_generate op so the
   // expanded copies appear in source order at the parent block.
   mlir::OpBuilder builder(gen);
+  mlir::Block *insertBlock = builder.getInsertionBlock();
+  mlir::Block::iterator insertPoint = builder.getInsertionPoint();
+  mlir::MLIRContext *ctx = gen.getContext();
 
+  llvm::SmallVector<mlir::Operation *, 16> replica;
+  llvm::SmallVector<mlir::StringAttr, 8> substituted;
   for (unsigned k = 0; k < count; ++k) {
     int64_t value = lower_v + static_cast<int64_t>(k) * step_v;
-    std::string valueStr = std::to_string(value);
 
     // Clone every op in srcBlock into the parent block at the
-    // current insertion point (just before `gen`). IRMapping
-    // preserves intra-clone SSA value remapping; cross-region
-    // values defined OUTSIDE srcBlock pass through unchanged.
+    // insertion point. IRMapping preserves intra-clone SSA value
+    // remapping, including the induction variable's uses, which
+    // read this iteration's `nsl.index_constant`; values defined
+    // OUTSIDE srcBlock pass through unchanged.
     mlir::IRMapping mapping;
-    // Snapshot the insertion-point block — clones land here.
-    mlir::Block *insertBlock = builder.getBlock();
-    auto insertPoint = builder.getInsertionPoint();
+    nsl::dialect::IndexConstantOp ivValue;
+    if (iv) {
+      ivValue = nsl::dialect::IndexConstantOp::create(
+          builder, gen.getLoc(), builder.getIndexType(),
+          builder.getI64IntegerAttr(value));
+      mapping.map(iv, ivValue.getResult());
+    }
+    replica.clear();
     for (mlir::Operation &op : srcBlock) {
-      auto *cloned = op.clone(mapping);
+      mlir::Operation *cloned = op.clone(mapping);
       insertBlock->getOperations().insert(insertPoint, cloned);
+      if (!plan.empty()) {
+        appendPreorder(*cloned, replica);
+      }
     }
 
-    // After cloning, walk the just-inserted ops and rewrite their
-    // `StringAttr` values (and recursively those of any sub-ops in
-    // their regions) substituting `%<loop_var>%` with `valueStr`.
-    // We iterate from the post-clone position back to the original
-    // insertion point.
-    if (!loop_var.empty() && !srcBlock.empty()) {
-      // Identify the cloned range. After insert, the new ops are
-      // contiguous in `insertBlock` ending just before `insertPoint`
-      // (== `gen`'s iterator). We re-run a per-op visitor over them.
-      auto endIt = insertPoint;
-      // Walk backward `srcBlock.getOperations().size()` ops to find
-      // the start of the cloned range.
-      auto count_in_src = std::distance(srcBlock.begin(), srcBlock.end());
-      auto startIt = endIt;
-      for (size_t i = 0; i < static_cast<size_t>(count_in_src); ++i) {
-        --startIt;
-      }
-      // Visit each cloned op + recurse into its regions.
-      for (auto it = startIt; it != endIt; ++it) {
-        mlir::Operation &op = *it;
-        llvm::SmallVector<mlir::NamedAttribute, 4> rewrites;
-        for (auto namedAttr : op.getAttrs()) {
-          auto strAttr = mlir::dyn_cast<mlir::StringAttr>(namedAttr.getValue());
-          if (!strAttr) {
-            continue;
-          }
-          auto rewritten =
-              substituteLoopVar(strAttr.getValue(), loop_var, valueStr);
-          if (rewritten == strAttr.getValue()) {
-            continue;
-          }
-          rewrites.emplace_back(
-              namedAttr.getName(),
-              mlir::StringAttr::get(strAttr.getContext(), rewritten));
-        }
-        for (auto &kv : rewrites) {
-          op.setAttr(kv.getName(), kv.getValue());
-        }
-        // Recurse into nested regions/blocks for substitution
-        // (handles a nested `nsl.structural_generate` body that
-        // also references the OUTER loop_var via `%i%`).
-        for (auto &region : op.getRegions()) {
-          for (mlir::Block &child : region) {
-            substituteLoopVarInBlock(child, loop_var, valueStr);
-          }
-        }
+    // Structured names: render those whose indices are now all
+    // constant, then drop the constants nothing reads any more.
+    for (unsigned pos : plan.structured) {
+      materializeName(mlir::cast<nsl::dialect::RegOp>(replica[pos]));
+    }
+    for (unsigned pos : plan.constants) {
+      if (replica[pos]->use_empty()) {
+        replica[pos]->erase();
       }
     }
+    if (ivValue && ivValue->use_empty()) {
+      ivValue->erase();
+    }
+    if (plan.slots.empty()) {
+      continue;
+    }
+
+    // `%IDENT%` slots: substitute and intern each distinct name once
+    // for this iteration value, then point every slot of the
+    // replica at it.
+    std::string valueStr = std::to_string(value);
+    substituted.clear();
+    for (mlir::StringAttr text : plan.templates) {
+      substituted.push_back(mlir::StringAttr::get(
+          ctx, substituteLoopVar(text.getValue(), needle, valueStr)));
+    }
+    for (const LoopVarSlot &slot : plan.slots) {
+      replica[slot.op]->setAttr(slot.name, substituted[slot.value]);
+    }
   }
 
   // Erase the original generate op.
@@ -221,60 +318,59 @@ unsigned expandOne(nsl::dialect::StructuralGenerateOp gen) {
 }
 
 class NSLExpandGeneratePass
-    : public mlir::PassWrapper<NSLExpandGeneratePass,
-                               mlir::OperationPass<mlir::ModuleOp>> {
+    : public mlir::PassWrapper<NSLExpandGeneratePass, mlir::OperationPass<>> {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLExpandGeneratePass)
 
+  NSLExpandGeneratePass() = default;
+  NSLExpandGeneratePass(const NSLExpandGeneratePass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final { return "nsl-expand-generate"; }
   llvm::StringRef getDescription() const final {
     return "Slot 2: unroll nsl.structural_generate into N copies of body; "
            "substitute %IDENT% loop-var references (M5 FR-014).";
   }
 
-  void runOnOperation() final {
-    mlir::ModuleOp module = getOperation();
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
 
-    // Fixed-point expansion: repeatedly find any
-    // `nsl.structural_generate` op and expand it. Nested generates
-    // are handled correctly because expanding an outer generate
-    // clones the inner ones VERBATIM into the parent block (the
-    // inner's StringAttrs may contain `%<outer-loop-var>%` references
-    // which the outer's expansion substitutes in-place); the next
-    // iteration then finds and expands the inner clones.
+  void runOnOperation() final {
+    // One post-order walk lists every generate, inner before outer
+    // and otherwise in source order. Expanding a generate only
+    // clones its body (which by then holds no generate) into its
+    // parent and erases it, so every op still on the list stays
+    // valid and no new generate ever appears: each is expanded
+    // once, in the order a re-walk-from-the-top would pick them.
     //
-    // Determinism (Constitution Principle V): each iteration uses
-    // `walk` which traverses ops in source order; we always expand
-    // the first found op, so the output is byte-stable across
-    // builds.
+    // Inner-first is also what makes a shadowing inner loop var
+    // (`generate(i ...) { generate(i ...) { ... } }`) bind the inner
+    // `%i%` before the outer expansion sees it.
     //
-    // Termination: every iteration either expands one op (strictly
-    // decreasing the count of `StructuralGenerateOp` ops in the
-    // module — replicas have NO inner-generate-with-the-same-attrs
-    // because cloning preserves nested ops verbatim) or finds none
-    // and exits. A pathological input with infinite-recursion
-    // generate (not currently expressible at the dialect level)
-    // would trigger our defensive iteration cap.
-    constexpr unsigned kIterationCap = 1u << 16; // 65536 — safety net
-    unsigned iter = 0;
-    while (iter++ < kIterationCap) {
-      nsl::dialect::StructuralGenerateOp target;
-      module.walk([&](nsl::dialect::StructuralGenerateOp gen) {
-        target = gen;
-        return mlir::WalkResult::interrupt();
-      });
-      if (!target) {
-        break;
+    // Determinism (Constitution Principle V): `walk` traverses ops
+    // in source order, so the output is byte-stable across builds.
+    llvm::SmallVector<nsl::dialect::StructuralGenerateOp, 8> worklist;
+    getOperation()->walk([&](nsl::dialect::StructuralGenerateOp gen) {
+      worklist.push_back(gen);
+    });
+    for (nsl::dialect::StructuralGenerateOp gen : worklist) {
+      mlir::FailureOr<unsigned> copies = expandOne(gen);
+      if (mlir::failed(copies)) {
+        signalPassFailure();
+        return;
       }
-      expandOne(target);
-    }
-    if (iter >= kIterationCap) {
-      module.emitOpError() << "expand-generate iteration cap reached ("
-                           << kIterationCap
-                           << ") — possible non-terminating expansion";
-      signalPassFailure();
+      ++numExpanded;
+      numCopies += *copies;
     }
   }
+
+private:
+  Statistic numExpanded{this, "generates-expanded",
+                        "Number of nsl.structural_generate ops expanded"};
+  Statistic numCopies{this, "body-copies",
+                      "Number of generate bodies cloned (one per "
+                      "iteration)"};
 };
 
 } // namespace
@@ -10,39 +10,53 @@
 // of the variable are remapped to the most-recently-written
 // version. Post-pass IR contains zero `nsl.variable` ops.
 //
-// Algorithm (per FR-015 + spec US3 acceptance scenarios 1-3):
+// Algorithm (per FR-015 + spec US3 acceptance scenarios 1-3): one
+// renaming walk over the whole module for every variable at once,
+// in the style of Braun et al., "Simple and Efficient Construction
+// of Static Single Assignment Form" (CC 2013), followed by a dead-
+// version sweep.
 //
-//   for each `nsl.variable` op `%v "name" : !nsl.bits<N>`:
-//     let currentValue = %v
-//     walk the variable's enclosing region recursively in source
-//     order; for each Op visited (skipping the variable itself):
-//       for each operand-index of Op consuming %v:
-//         if Op is nsl.transfer / nsl.clocked_transfer AND the
-//         consuming operand index is 0 (the dst slot) AND the
-//         insertion site's parent is a valid wire-parent:
-//           (this is a whole-width write `v = src` / `v := src`)
-//           build a fresh nsl.wire "name[_K]" : !nsl.bits<N> just
-//           before the transfer; setOperand(0) to wire.result;
-//           let currentValue = wire.result.
-//         else:
-//           (read site OR partial-assignment LHS via nsl.extract,
-//            OR write inside a non-wire-parent region — leave the
-//            use pointing at the current version, which initially
-//            is the variable itself)
-//           setOperand of this use to currentValue.
-//     if the variable has zero remaining uses, erase it; otherwise
-//     leave it in place (residual partial-assignment etc.).
+//   1. Rename. Walk the module once in source order, keeping each
+//      expandable variable's current definition (initially the
+//      variable itself):
+//        - a whole-width write `v = src` / `v := src` (operand 0 of
+//          an nsl.transfer / nsl.clocked_transfer whose parent is a
+//          valid wire-parent) gets a fresh nsl.wire "name" just
+//          before the transfer, which becomes the current
+//          definition;
+//        - every other use (a read, a partial-assignment LHS via
+//          nsl.extract, a write inside a non-wire-parent region) is
+//          remapped to the current definition.
+//      Versioned writes only ever sit directly in a module or func
+//      body, a single block, so `readVariable` is always a local
+//      lookup and no block arguments are ever needed.
+//   2. Sweep. A version wire whose only uses are as the dst of a
+//      transfer is never read: its transfers are erased, then the
+//      wire, then whatever pure ops fed only those transfers. That
+//      may leave an earlier version unread in turn, so the sweep
+//      runs to a fixpoint over a worklist.
+//   3. Name. The surviving versions of each variable are named
+//      "name", "name_1", "name_2", ... in source order.
+//   A variable with no uses left after renaming is erased; otherwise
+//   it stays (residual partial-assignment etc.).
 //
-// Source-order determinism (Constitution Principle V): we walk the
-// region with `mlir::Region::walk` (PreOrder = source-order DFS).
-// We do NOT iterate `getUsers()` directly because MLIR's use-list
-// iteration order is allocation-order, not source-order. Region
-// walk preserves byte-stable output across builds.
+// Cost is one walk of the module plus work proportional to what the
+// sweep erases, independent of the number of variables. Unread
+// versions have no observable effect: a variable is not a port, so
+// only its reads make its writes visible.
+//
+// Source-order determinism (Constitution Principle V): the renaming
+// walk is `mlir::WalkOrder::PreOrder` (source-order DFS) and the
+// names are assigned afterwards from each variable's version list,
+// also in source order. We do NOT iterate `getUsers()` to discover
+// versions because MLIR's use-list iteration order is allocation-
+// order, not source-order; the sweep does inspect use lists, but
+// only to decide whether a wire is read, never to order anything.
 //
 // **Nested-region uses** (e.g., a module-scope variable consumed
 // inside `nsl.func`'s body — the s12 partial-assignment shape):
-// the walk descends into all nested regions of the variable's
-// enclosing region, so uses are discovered no matter how deep.
+// the walk descends into all nested regions, so uses are discovered
+// no matter how deep.
 // Wire-insertion only happens when the use's enclosing parent is
 // itself a valid wire-parent (`ModuleOp` or `FuncOp` per the M4
 // post-merge amendment #5); writes inside `nsl.proc` / `nsl.state`
@@ -67,12 +81,18 @@
 // **At Phase 2 this pass was a registered NO-OP slot.** This file
 // now implements the real body per T081.
 
+#include "Common/PassAnchor.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/Interfaces/SideEffectInterfaces.h"
 #include "mlir/Pass/Pass.h"
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallVector.h"
 
 #include <string>
@@ -89,139 +109,230 @@ bool isVariableWriteOp(mlir::Operation *op) {
       op);
 }
 
-/// Expand a single `nsl.variable` op. Returns true if the op was
-/// expanded; false if the op was skipped (e.g., its parent is not
-/// `nsl.module` per the scope policy in the file banner).
-///
-/// Determinism: we iterate the parent block in source order, so
-/// the per-version wire ordering and naming is byte-stable across
-/// builds.
-bool expandOne(nsl::dialect::VariableOp variable) {
-  // Scope guard: post-merge M4-amendment 2026-05-02 #5 widened
-  // `nsl.wire`'s parent trait to `ParentOneOf<["ModuleOp",
-  // "FuncOp"]>`, so per-version wires can sibling either parent.
-  // `nsl.variable` already accepted both. Reject anything else.
-  mlir::Operation *parent = variable->getParentOp();
-  if (!mlir::isa<nsl::dialect::ModuleOp, nsl::dialect::FuncOp>(parent)) {
-    return false;
-  }
+/// Renaming state of one expandable `nsl.variable`.
+struct VariableState {
+  nsl::dialect::VariableOp variable;
+  /// Definition a read at the current walk position sees.
+  mlir::Value current;
+  /// Every version wire created for the variable, in source order.
+  llvm::SmallVector<nsl::dialect::WireOp, 4> versions;
+};
 
-  mlir::Value variableValue = variable.getResult();
-  mlir::Type type = variableValue.getType();
-  llvm::StringRef baseName = variable.getName();
-  mlir::MLIRContext *ctx = variable.getContext();
-  auto loc = variable.getLoc();
-
-  // Walk the variable's enclosing region recursively in source
-  // order. PreOrder DFS gives source-order deterministic version-
-  // assignment (Constitution Principle V) and — critically —
-  // discovers uses inside nested regions (e.g., a module-scope
-  // variable consumed inside `nsl.func`'s body, the s12 partial-
-  // assignment shape).
-  mlir::Region *region = variable->getParentRegion();
-  mlir::Value currentValue = variableValue;
-  unsigned versionIndex = 0;
-
-  region->walk([&](mlir::Operation *op) {
-    if (op == variable.getOperation()) {
-      return; // skip self
+/// True if every use of `wire` is the dst of a transfer, i.e. no op
+/// ever reads it.
+bool isWriteOnly(nsl::dialect::WireOp wire) {
+  for (mlir::OpOperand &use : wire.getResult().getUses()) {
+    if (use.getOperandNumber() != 0 || !isVariableWriteOp(use.getOwner())) {
+      return false;
     }
-    // For each operand of this op, check whether it currently
-    // refers to `variableValue`. We do this by index because the
-    // check must distinguish operand-0 (write dst) from other
-    // operands (read).
-    for (unsigned operandIdx = 0; operandIdx < op->getNumOperands();
-         ++operandIdx) {
-      mlir::OpOperand &opOperand = op->getOpOperand(operandIdx);
-      if (opOperand.get() != variableValue) {
-        continue;
+  }
+  return true;
+}
+
+/// Expands every `nsl.variable` under the pass anchor; see the file
+/// banner.
+class VariableRenamer {
+public:
+  void run(mlir::Operation *root) {
+    rename(root);
+    sweep();
+    eraseUnusedVariables();
+    name();
+  }
+
+  /// Variables expanded, and version wires created for them.
+  unsigned numVariables() const { return states_.size(); }
+  unsigned numWiresCreated() const { return numWiresCreated_; }
+  /// Version wires left after the sweep.
+  unsigned numWiresKept() const { return versions_.size(); }
+
+private:
+  /// Step 1: the renaming walk.
+  void rename(mlir::Operation *root) {
+    root->walk<mlir::WalkOrder::PreOrder>([&](mlir::Operation *op) {
+      if (auto variable = mlir::dyn_cast<nsl::dialect::VariableOp>(op)) {
+        // Scope guard: post-merge M4-amendment 2026-05-02 #5
+        // widened `nsl.wire`'s parent trait to `ParentOneOf<
+        // ["ModuleOp", "FuncOp"]>`, so per-version wires can
+        // sibling either parent. `nsl.variable` already accepted
+        // both. Leave anything else untouched.
+        if (mlir::isa<nsl::dialect::ModuleOp, nsl::dialect::FuncOp>(
+                variable->getParentOp())) {
+          index_[variable.getResult()] = states_.size();
+          states_.push_back({variable, variable.getResult(), {}});
+        }
+        return;
       }
-      // Found a use of the variable's result.
-      bool isWrite = (operandIdx == 0 && isVariableWriteOp(op));
       // Wire-insertion is only legal when the insertion site's
       // parent is `ModuleOp` or `FuncOp` (per `nsl.wire`'s parent
-      // constraint, M4 post-merge amendment #5). If the write is
-      // inside a `nsl.proc` / `nsl.state`, we cannot create a
-      // sibling wire there — fall through to the read-remap path
-      // (leaving the use pointing at currentValue).
-      mlir::Operation *opParent = op->getParentOp();
-      bool wireInsertionLegal =
-          mlir::isa<nsl::dialect::ModuleOp, nsl::dialect::FuncOp>(opParent);
-      if (isWrite && wireInsertionLegal) {
-        // Write site: build a fresh wire and rewire the transfer's
-        // dst operand. The wire is inserted JUST BEFORE the
-        // transfer so source order is preserved (write-before-
-        // any-later-read).
-        std::string wireName = baseName.str();
+      // constraint, M4 post-merge amendment #5).
+      const bool wireInsertionLegal =
+          mlir::isa<nsl::dialect::ModuleOp, nsl::dialect::FuncOp>(
+              op->getParentOp());
+      for (mlir::OpOperand &use : op->getOpOperands()) {
+        auto it = index_.find(use.get());
+        if (it == index_.end()) {
+          continue;
+        }
+        VariableState &state = states_[it->second];
+        if (use.getOperandNumber() == 0 && isVariableWriteOp(op) &&
+            wireInsertionLegal) {
+          // Write site: the wire goes JUST BEFORE the transfer so
+          // source order is preserved (write-before-any-later-read).
+          // It is named in step 3, once we know which versions live.
+          mlir::OpBuilder builder(op);
+          auto wire = nsl::dialect::WireOp::create(
+              builder, state.variable.getLoc(), use.get().getType(),
+              state.variable.getNameAttr());
+          use.set(wire.getResult());
+          state.current = wire.getResult();
+          state.versions.push_back(wire);
+          versions_.insert(wire.getOperation());
+          ++numWiresCreated_;
+        } else {
+          // Read site OR write site whose parent is not a valid
+          // wire-parent: remap the use to the current version. With
+          // no prior whole-width write `current` is the variable, so
+          // a partial-assignment slice (`nsl.extract %v`) keeps it
+          // alive — see `eraseUnusedVariables`.
+          use.set(state.current);
+        }
+      }
+    });
+  }
+
+  /// Step 2: erase versions nothing reads, to a fixpoint.
+  void sweep() {
+    llvm::SmallVector<mlir::Operation *, 16> worklist;
+    for (VariableState &state : states_) {
+      for (nsl::dialect::WireOp wire : state.versions) {
+        worklist.push_back(wire.getOperation());
+      }
+    }
+    while (!worklist.empty()) {
+      mlir::Operation *wireOp = worklist.pop_back_val();
+      // Already swept (it fed a transfer erased after it was queued).
+      if (!versions_.contains(wireOp)) {
+        continue;
+      }
+      auto wire = mlir::cast<nsl::dialect::WireOp>(wireOp);
+      if (!isWriteOnly(wire)) {
+        continue;
+      }
+      for (mlir::Operation *transfer :
+           llvm::make_early_inc_range(wire.getResult().getUsers())) {
+        eraseFeedingOnlyDead(transfer, worklist);
+      }
+      versions_.erase(wireOp);
+      wire.erase();
+    }
+  }
+
+  /// Erases `root` and then every pure op left without uses by it,
+  /// queueing any version wire that loses a read along the way.
+  void eraseFeedingOnlyDead(mlir::Operation *root,
+                            llvm::SmallVectorImpl<mlir::Operation *> &wires) {
+    llvm::SmallVector<mlir::Operation *, 8> ops{root};
+    while (!ops.empty()) {
+      mlir::Operation *op = ops.pop_back_val();
+      llvm::SmallSetVector<mlir::Operation *, 4> feeders;
+      for (mlir::Value operand : op->getOperands()) {
+        if (mlir::Operation *def = operand.getDefiningOp()) {
+          feeders.insert(def);
+        }
+      }
+      op->erase();
+      for (mlir::Operation *def : feeders) {
+        if (versions_.contains(def)) {
+          wires.push_back(def);
+        } else if (mlir::isOpTriviallyDead(def)) {
+          ops.push_back(def);
+        }
+      }
+    }
+  }
+
+  /// Erases each variable nothing refers to any more.
+  void eraseUnusedVariables() {
+    // Only erase a variable if all uses were rewired away. Partial-
+    // assignment shapes (s12: `v[3:0] = 0;` lowered as
+    // `nsl.transfer %ext, %lit` where `%ext = nsl.extract %v, ...`)
+    // leave the variable consumed by `nsl.extract`. The residual
+    // `nsl.variable` op is acceptable at M5 — fully eliminating it
+    // requires either visitor-side whole-width-concat synthesis (the
+    // shape demonstrated by `partial_assignment_S12.mlir`) or a
+    // dedicated partial-assignment lowering pass, both deferred.
+    for (VariableState &state : states_) {
+      if (state.variable.getResult().use_empty()) {
+        state.variable.erase();
+      }
+    }
+  }
+
+  /// Step 3: name the surviving versions "name", "name_1", ...
+  void name() {
+    for (VariableState &state : states_) {
+      unsigned versionIndex = 0;
+      for (nsl::dialect::WireOp wire : state.versions) {
+        if (!versions_.contains(wire.getOperation())) {
+          continue;
+        }
         if (versionIndex > 0) {
+          std::string wireName = wire.getName().str();
           wireName += "_";
           wireName += std::to_string(versionIndex);
+          wire.setName(wireName);
         }
-        mlir::OpBuilder builder(op);
-        auto wire = nsl::dialect::WireOp::create(
-            builder, loc, type, mlir::StringAttr::get(ctx, wireName));
-        opOperand.set(wire.getResult());
-        currentValue = wire.getResult();
         ++versionIndex;
-      } else {
-        // Read site OR write site whose parent is not a valid
-        // wire-parent: remap the use to the current version. On
-        // the first iteration `currentValue == variableValue`, so
-        // a partial-assignment slice (`nsl.extract %v` consuming
-        // %v with no prior whole-width write) leaves the use
-        // pointing at the variable. The variable is then NOT
-        // erased — see the `use_empty()` guard below.
-        opOperand.set(currentValue);
       }
     }
-  });
-
-  // Only erase the variable if all uses were rewired away. Partial-
-  // assignment shapes (s12: `v[3:0] = 0;` lowered as
-  // `nsl.transfer %ext, %lit` where `%ext = nsl.extract %v, ...`)
-  // leave the variable consumed by `nsl.extract`. Erasing in that
-  // state would crash MLIR's use-list invariant. The residual
-  // `nsl.variable` op is acceptable at M5 — fully eliminating it
-  // requires either visitor-side whole-width-concat synthesis (the
-  // shape demonstrated by `partial_assignment_S12.mlir`) or a
-  // dedicated partial-assignment lowering pass, both deferred.
-  if (variableValue.use_empty()) {
-    variable.erase();
   }
-  return true;
-}
+
+  /// Result of each expandable variable -> its entry in `states_`.
+  llvm::DenseMap<mlir::Value, unsigned> index_;
+  /// Expandable variables, in source order.
+  llvm::SmallVector<VariableState, 8> states_;
+  /// Version wires not yet swept away.
+  llvm::DenseSet<mlir::Operation *> versions_;
+  unsigned numWiresCreated_ = 0;
+};
 
 class NSLExpandVariablesPass
-    : public mlir::PassWrapper<NSLExpandVariablesPass,
-                               mlir::OperationPass<mlir::ModuleOp>> {
+    : public mlir::PassWrapper<NSLExpandVariablesPass, mlir::OperationPass<>> {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLExpandVariablesPass)
 
+  NSLExpandVariablesPass() = default;
+  NSLExpandVariablesPass(const NSLExpandVariablesPass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final { return "nsl-expand-variables"; }
   llvm::StringRef getDescription() const final {
     return "Slot 3: convert nsl.variable to SSA chain of "
-           "nsl.wire+nsl.transfer; "
-           "per-field for struct-typed; preserve S12 partial-assignment (M5 "
-           "FR-015).";
+           "nsl.wire+nsl.transfer in one renaming walk, dropping unread "
+           "versions; preserve S12 partial-assignment (M5 FR-015).";
+  }
+
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
   }
 
   void runOnOperation() final {
-    mlir::ModuleOp module = getOperation();
-
-    // Collect every `nsl.variable` op in source order, then expand
-    // each. We collect first (rather than expand-during-walk)
-    // because `expandOne` erases the op, and erasing during a
-    // `walk` mutates the IR underneath the visitor.
-    //
-    // Source-order walk is byte-stable across builds (Constitution
-    // Principle V).
-    llvm::SmallVector<nsl::dialect::VariableOp, 8> variables;
-    module.walk([&](nsl::dialect::VariableOp v) { variables.push_back(v); });
-
-    for (auto v : variables) {
-      expandOne(v);
-    }
+    VariableRenamer renamer;
+    renamer.run(getOperation());
+    numVariables += renamer.numVariables();
+    numWiresCreated += renamer.numWiresCreated();
+    numWiresKept += renamer.numWiresKept();
   }
+
+private:
+  Statistic numVariables{this, "variables-split",
+                         "Number of nsl.variable ops expanded"};
+  Statistic numWiresCreated{this, "wires-created",
+                            "Number of version wires created"};
+  Statistic numWiresKept{this, "wires-kept",
+                         "Number of version wires left after dropping "
+                         "unread ones"};
 };
 
 } // namespace
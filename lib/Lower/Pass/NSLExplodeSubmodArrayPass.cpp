@@ -1,7 +1,17 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 //
-// lib/Lower/Pass/NSLExplodeSubmodArrayPass.cpp — slot 4 of the M5
-// structural-expansion pipeline (FR-016).
+// lib/Lower/Pass/NSLExplodeSubmodArrayPass.cpp — standalone
+// submodule-array explosion (formerly slot 4 of the M5 pipeline,
+// FR-016).
+//
+// **Not in `Compilation::runNSLPasses`**. Exploding `SUB[4096] bank;`
+// up front puts 4096 symbols into the `nsl.module` symbol table that
+// every later pass then walks and the table rebuilds. The pipeline
+// instead keeps the array-form op intact and the nsl→CIRCT
+// conversion (`ModulePatterns.cpp`) emits one `hw.instance` per
+// element directly, so the cost only scales with N at the point it
+// has to. The pass stays registered for `nsl-opt` and for consumers
+// that want the exploded `nsl` form.
 //
 // Replaces every array-form `nsl.submodule` (i.e., one carrying an
 // `array_size` attribute, source spelling `SUB[N] inst;`) with N
@@ -9,7 +19,8 @@
 // `<orig-name>_<index>` (e.g., `@inst_0`, `@inst_1`, `@inst_2`).
 // The original array-form op is erased.
 //
-// **Naming scheme**: `<orig-name>_<index>` (NOT `<orig-name>[<index>]`).
+// **Naming scheme**: `<orig-name>_<index>` (NOT `<orig-name>[<index>]`),
+// shared with the CIRCT conversion via `Common/SubmodArray.h`.
 // MLIR symbol names cannot contain unescaped `[`/`]`; the in-printer
 // notation `@inst[3]` decorates the OPTIONAL `array_size` attribute,
 // it is not part of the canonical symbol name. After explosion the
@@ -28,8 +39,8 @@
 // verifier currently permits any non-negative I64.)
 //
 // **Singleton pass-through**: a `nsl.submodule` op WITHOUT
-// `array_size` is left unchanged. The pipeline post-condition
-// "zero array-form `nsl.submodule`" follows.
+// `array_size` is left unchanged. The post-condition "zero
+// array-form `nsl.submodule`" follows.
 //
 // Anchors:
 //   - `specs/008-m5-structural-passes/spec.md` FR-016, US4
@@ -38,6 +49,8 @@
 //   - `lib/Dialect/NSL/IR/NSLOps.td` `NSL_SubmoduleOp`
 //     (post-merge M4-amendment 2026-05-02 #4 added `array_size`)
 
+#include "Common/PassAnchor.h"
+#include "Common/SubmodArray.h"
 #include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinAttributes.h"
 #include "mlir/IR/BuiltinOps.h"
@@ -45,39 +58,42 @@
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
-#include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/SmallVector.h"
 
-#include <string>
-
 namespace nsl::lower {
 
 namespace {
 
 class NSLExplodeSubmodArrayPass
     : public mlir::PassWrapper<NSLExplodeSubmodArrayPass,
-                               mlir::OperationPass<mlir::ModuleOp>> {
+                               mlir::OperationPass<>> {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLExplodeSubmodArrayPass)
 
+  NSLExplodeSubmodArrayPass() = default;
+  NSLExplodeSubmodArrayPass(const NSLExplodeSubmodArrayPass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final {
     return "nsl-explode-submod-array";
   }
   llvm::StringRef getDescription() const final {
-    return "Slot 4: replace array-form nsl.submodule (SUB[3]) with N "
-           "independent "
-           "ops + rewrite cross-IR port references (M5 FR-016).";
+    return "Replace array-form nsl.submodule (SUB[3]) with N independent "
+           "ops + rewrite cross-IR port references (M5 FR-016; not in the "
+           "default pipeline).";
   }
 
-  void runOnOperation() final {
-    mlir::ModuleOp module = getOperation();
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
+  }
 
+  void runOnOperation() final {
     // Step 1 — collect every array-form `nsl.submodule` (carrying
     // an `array_size` attribute). We snapshot first then mutate so
     // the in-flight walk is not invalidated by ops we erase. Walk
     // is in source order (Constitution Principle V — determinism).
     llvm::SmallVector<nsl::dialect::SubmoduleOp, 8> arrayForms;
-    module.walk([&](nsl::dialect::SubmoduleOp sub) {
+    getOperation()->walk([&](nsl::dialect::SubmoduleOp sub) {
       if (sub.getArraySize().has_value()) {
         arrayForms.push_back(sub);
       }
@@ -104,23 +120,17 @@ public:
       mlir::OpBuilder builder(sub);
 
       for (int64_t k = 0; k < size; ++k) {
-        llvm::SmallString<64> name;
-        name.append(baseName.begin(), baseName.end());
-        name.push_back('_');
-        // Decimal-encode k via std::to_string — deterministic, no
-        // locale dependency.
-        auto kStr = std::to_string(k);
-        name.append(kStr.begin(), kStr.end());
-
         // Build a singleton-form replica: same templateRef, no
         // array_size attribute. SymbolNameAttr is taken from the
         // namespace context.
-        auto nameAttr = mlir::StringAttr::get(&getContext(), name);
+        auto nameAttr = mlir::StringAttr::get(
+            &getContext(), submodElementName(baseName, k));
         // SubmoduleOp::build takes (sym_name, templateRef, array_size?)
         // per TableGen — we pass an empty IntegerAttr for the
         // optional array_size.
         nsl::dialect::SubmoduleOp::create(builder, loc, nameAttr, templateRef,
                                           /*array_size=*/mlir::IntegerAttr{});
+        ++numReplicas;
       }
 
       // **Cross-IR port-reference rewrite hook**: when M6 introduces
@@ -133,8 +143,15 @@ public:
 
       // Erase the original array-form op.
       sub.erase();
+      ++numArrays;
     }
   }
+
+private:
+  Statistic numArrays{this, "arrays-exploded",
+                      "Number of array-form nsl.submodule ops exploded"};
+  Statistic numReplicas{this, "submodules-created",
+                        "Number of singleton nsl.submodule ops created"};
 };
 
 } // namespace
@@ -3,44 +3,299 @@
 // lib/Lower/Pass/NSLInlineInternalFuncPass.cpp — slot 5 of the M5
 // structural-expansion pipeline (FR-017).
 //
-// **At M5 this pass STAYS a registered no-op slot** per
-// Clarifications Q3 → Option B. The slot reserves the pipeline ABI
-// (pass-name + signature + position) so a future PR can fill in
-// functional `func_self` inlining without amending the M5 spec.
+// Inlines internal functions into their callers. An internal function
+// is an `nsl.func @f` whose name is declared by a sibling
+// `nsl.func_self "f"`; a `func_in` handler is called from outside
+// the module and is never a candidate. Each `nsl.call @f(args)` is
+// replaced by one `nsl.transfer` per argument into the matching
+// `func_self` argument value, followed by a copy of `@f`'s body. Once
+// every call is replaced, `@f` is erased. The `nsl.func_self`
+// declaration stays because it is the module's record of the name.
+//
+// Every call the pass removes is one less `<f>_valid` wire and one
+// less activation condition for the nsl→CIRCT conversion to build.
+// The inlined body also runs only under the call site's own
+// condition. An `nsl.func` that is never inlined is lowered by
+// `lowerControlOp` at module scope.
+//
+// **Func-scope wires**. Slot 3 turns a func-scope `nsl.variable`
+// into `nsl.wire` versions under the `nsl.func`. A wire may only sit
+// directly under `nsl.module` or `nsl.func`, not under the action
+// container holding the call, so each one is hoisted into the module
+// body, just before the module-level op holding the call, instead of
+// being moved or copied with the rest of the body. It is renamed
+// `<f>_<name>`, with a `_<n>` suffix when that is taken by another
+// module-level name or by the copy for an earlier call site. Its
+// transfers stay at the call site, under the call's condition.
+//
+// **Cost model**. `size` is the number of ops in `@f`'s body, nested
+// ops included, and `calls` is the number of `nsl.call @f` in the
+// module. Inlining duplicates the body `calls - 1` times, so a
+// function is inlined when
+//
+//     size * (calls - 1) <= max-growth
+//
+// (pass option, default 16). A single-call function always passes:
+// its body is moved, not copied. A function with no calls is left
+// alone.
+//
+// **Legality**. A function is inlined at all of its call sites or at
+// none of them:
+//   - the body holds no op that only makes sense in a function or
+//     procedure of its own (`nsl.seq` and the multi-cycle `nsl.while`
+//     / `nsl.for` under it, `nsl.goto`, `nsl.finish`,
+//     `nsl.finish_method`) and no call to `@f` itself;
+//   - the body declares no `nsl.variable`, which slot 3 leaves in
+//     place for a partial assignment (`v[3:0] = ...`). Unlike its
+//     wire versions, its reads depend on where they sit relative to
+//     its writes;
+//   - no `nsl.fire_probe @f` observes the function's activation;
+//   - each call passes as many arguments as `func_self` declares,
+//     of the same types, and produces no results;
+//   - no call sits inside `nsl.proc` or `nsl.seq`, whose bodies the
+//     FSM conversion lowers, or inside `@f` itself.
+//
+// Functions are visited in the source order of their `func_self`
+// declarations, and the call sites of each in pre-order. The result
+// is deterministic (Constitution Principle V). A body already
+// inlined into another function is copied with that function.
 //
 // Anchors:
 //   - `specs/008-m5-structural-passes/research.md` §3.
 //   - `specs/008-m5-structural-passes/contracts/pass-pipeline.contract.md`
 //     §2 row 5.
+//   - `docs/design/nsl_compiler_design.md` line 1229 (pass table).
 
+#include "Common/PassAnchor.h"
+#include "mlir/IR/Builders.h"
 #include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/IRMapping.h"
+#include "mlir/IR/SymbolTable.h"
 #include "mlir/Pass/Pass.h"
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringSet.h"
+#include "llvm/ADT/Twine.h"
+
+#include <cstdint>
+#include <string>
+
 namespace nsl::lower {
 
 namespace {
 
+using nsl::dialect::CallOp;
+using nsl::dialect::FuncOp;
+using nsl::dialect::FuncSelfOp;
+using nsl::dialect::WireOp;
+
+/// Ops in `fn`'s body, nested ones included.
+uint64_t bodySize(FuncOp fn) {
+  uint64_t size = 0;
+  fn.getBody().walk([&](mlir::Operation *) { ++size; });
+  return size;
+}
+
+/// True if `fn`'s body can stand in for a call to it.
+bool isInlinableBody(FuncOp fn) {
+  llvm::StringRef name = fn.getSymName();
+  mlir::WalkResult r = fn.getBody().walk([&](mlir::Operation *op) {
+    if (mlir::isa<nsl::dialect::SeqOp, nsl::dialect::WhileOp,
+                  nsl::dialect::ForOp, nsl::dialect::GotoOp,
+                  nsl::dialect::FinishOp, nsl::dialect::FinishMethodOp>(op)) {
+      return mlir::WalkResult::interrupt();
+    }
+    if (mlir::isa<nsl::dialect::VariableOp>(op)) {
+      return mlir::WalkResult::interrupt();
+    }
+    if (auto call = mlir::dyn_cast<CallOp>(op)) {
+      if (call.getCallee() == name) {
+        return mlir::WalkResult::interrupt();
+      }
+    }
+    return mlir::WalkResult::advance();
+  });
+  return !r.wasInterrupted();
+}
+
+/// True if `call` can be replaced by `fn`'s body with arguments bound
+/// to `decl`'s argument values.
+bool isInlinableCall(CallOp call, FuncOp fn, FuncSelfOp decl) {
+  if (call.getNumResults() != 0 ||
+      call.getArgs().size() != decl.getArgs().size()) {
+    return false;
+  }
+  for (auto [arg, param] : llvm::zip(call.getArgs(), decl.getArgs())) {
+    if (arg.getType() != param.getType()) {
+      return false;
+    }
+  }
+  for (mlir::Operation *p = call->getParentOp(); p; p = p->getParentOp()) {
+    if (p == fn.getOperation() ||
+        mlir::isa<nsl::dialect::ProcOp, nsl::dialect::SeqOp>(p)) {
+      return false;
+    }
+    if (mlir::isa<nsl::dialect::ModuleOp>(p)) {
+      break;
+    }
+  }
+  return true;
+}
+
+/// The `name` of every op directly in `m`'s body that has one.
+llvm::StringSet<> moduleNames(nsl::dialect::ModuleOp m) {
+  llvm::StringSet<> names;
+  for (mlir::Operation &op : m.getBody().front()) {
+    if (auto name = op.getAttrOfType<mlir::StringAttr>("name")) {
+      names.insert(name.getValue());
+    }
+  }
+  return names;
+}
+
+/// `base`, or `base_<n>` for the smallest `n` not in `taken`. The
+/// result is added to `taken`.
+std::string freshName(llvm::StringRef base, llvm::StringSet<> &taken) {
+  std::string name = base.str();
+  for (unsigned n = 1; !taken.insert(name).second; ++n) {
+    name = base.str() + "_" + std::to_string(n);
+  }
+  return name;
+}
+
+/// The op directly in the module body that holds `op`.
+mlir::Operation *moduleLevelAncestor(mlir::Operation *op) {
+  while (!mlir::isa<nsl::dialect::ModuleOp>(op->getParentOp())) {
+    op = op->getParentOp();
+  }
+  return op;
+}
+
 class NSLInlineInternalFuncPass
     : public mlir::PassWrapper<NSLInlineInternalFuncPass,
-                               mlir::OperationPass<mlir::ModuleOp>> {
+                               mlir::OperationPass<>> {
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLInlineInternalFuncPass)
 
+  NSLInlineInternalFuncPass() = default;
+  NSLInlineInternalFuncPass(const NSLInlineInternalFuncPass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final {
     return "nsl-inline-internal-func";
   }
   llvm::StringRef getDescription() const final {
-    return "Slot 5: optional perf pass — inline single-call-site func_self. "
-           "Registered no-op slot at M5 (Q3 → Option B); reserves pipeline "
-           "ABI.";
+    return "Slot 5: inline func_self functions into their callers under a "
+           "size/call-count cost model (M5 FR-017).";
+  }
+
+  bool canScheduleOn(mlir::RegisteredOperationName name) const final {
+    return isModuleBodyAnchor(name);
   }
 
   void runOnOperation() final {
-    // Permanent no-op at M5 per Q3 → Option B. A future PR may
-    // implement functional inlining without amending the M5 spec.
+    llvm::SmallVector<nsl::dialect::ModuleOp, 4> modules;
+    getOperation()->walk(
+        [&](nsl::dialect::ModuleOp m) { modules.push_back(m); });
+    for (nsl::dialect::ModuleOp m : modules) {
+      for (FuncSelfOp decl :
+           llvm::to_vector<4>(m.getBody().front().getOps<FuncSelfOp>())) {
+        inlineFunction(m, decl);
+      }
+    }
   }
+
+private:
+  void inlineFunction(nsl::dialect::ModuleOp m, FuncSelfOp decl) {
+    auto fn = mlir::dyn_cast_or_null<FuncOp>(
+        mlir::SymbolTable::lookupSymbolIn(m, decl.getName()));
+    if (!fn) {
+      return;
+    }
+    llvm::SmallVector<CallOp, 4> calls;
+    bool probed = false;
+    m.walk<mlir::WalkOrder::PreOrder>([&](mlir::Operation *op) {
+      if (auto call = mlir::dyn_cast<CallOp>(op)) {
+        if (call.getCallee() == decl.getName()) {
+          calls.push_back(call);
+        }
+      } else if (auto probe = mlir::dyn_cast<nsl::dialect::FireProbeOp>(op)) {
+        probed |= probe.getTarget() == decl.getName();
+      }
+    });
+    if (calls.empty()) {
+      return;
+    }
+
+    const uint64_t growth = bodySize(fn) * (calls.size() - 1);
+    const bool copied = calls.size() > 1;
+    if (probed || growth > maxGrowth || !isInlinableBody(fn) ||
+        !llvm::all_of(calls, [&](CallOp call) {
+          return isInlinableCall(call, fn, decl);
+        })) {
+      ++numKeptFuncs;
+      return;
+    }
+
+    mlir::Block &body = fn.getBody().front();
+    llvm::StringSet<> taken = moduleNames(m);
+    for (CallOp call : calls) {
+      mlir::OpBuilder builder(call);
+      for (auto [arg, param] : llvm::zip(call.getArgs(), decl.getArgs())) {
+        nsl::dialect::TransferOp::create(builder, call.getLoc(), param, arg);
+      }
+      mlir::Operation *anchor = moduleLevelAncestor(call);
+      auto hoist = [&](WireOp wire) {
+        wire.setName(freshName(
+            (llvm::Twine(fn.getSymName()) + "_" + wire.getName()).str(),
+            taken));
+        ++numHoistedWires;
+      };
+      if (copied) {
+        mlir::OpBuilder hoisted(anchor);
+        mlir::IRMapping mapping;
+        for (mlir::Operation &op : body) {
+          if (mlir::isa<WireOp>(op)) {
+            hoist(mlir::cast<WireOp>(hoisted.clone(op, mapping)));
+          } else {
+            builder.clone(op, mapping);
+          }
+        }
+      } else {
+        for (WireOp wire : llvm::to_vector<4>(body.getOps<WireOp>())) {
+          wire->moveBefore(anchor);
+          hoist(wire);
+        }
+        call->getBlock()->getOperations().splice(
+            call->getIterator(), body.getOperations());
+      }
+      call.erase();
+      ++numInlinedCalls;
+    }
+    fn.erase();
+    ++numInlinedFuncs;
+  }
+
+  Option<uint64_t> maxGrowth{
+      *this, "max-growth",
+      llvm::cl::desc("Largest number of ops inlining one function may add "
+                     "(body size times extra call sites)"),
+      llvm::cl::init(16)};
+
+  Statistic numInlinedCalls{this, "inlined-calls",
+                            "Number of func_self calls inlined"};
+  Statistic numInlinedFuncs{this, "inlined-funcs",
+                            "Number of func_self functions erased after "
+                            "inlining"};
+  Statistic numHoistedWires{this, "hoisted-wires",
+                            "Number of func-scope wires hoisted into the "
+                            "module body by inlining"};
+  Statistic numKeptFuncs{this, "kept-funcs",
+                         "Number of called func_self functions left out "
+                         "of line by the cost model or legality checks"};
 };
 
 } // namespace
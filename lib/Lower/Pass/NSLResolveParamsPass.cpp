@@ -67,6 +67,10 @@ class NSLResolveParamsPass
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLResolveParamsPass)
 
+  NSLResolveParamsPass() = default;
+  NSLResolveParamsPass(const NSLResolveParamsPass &other)
+      : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final { return "nsl-resolve-params"; }
   llvm::StringRef getDescription() const final {
     return "Slot 1: substitute nsl.param_int / nsl.param_str references with "
@@ -89,6 +93,7 @@ public:
     for (auto p : module.getOps<nsl::dialect::ParamIntOp>()) {
       paramMap[p.getSymName()] = static_cast<int64_t>(p.getValue());
     }
+    numParams += paramMap.size();
 
     if (paramMap.empty()) {
       // No `nsl.param_int` ops — nothing to substitute. Common case
@@ -140,6 +145,7 @@ public:
       for (auto &kv : replacements) {
         op->setAttr(kv.first, kv.second);
       }
+      numResolvedRefs += replacements.size();
       return mlir::WalkResult::advance();
     });
 
@@ -149,6 +155,12 @@ public:
     // information the later milestone needs. If a future amendment
     // decides to erase them post-resolution, this is the spot.
   }
+
+private:
+  Statistic numParams{this, "params", "Number of nsl.param_int declarations"};
+  Statistic numResolvedRefs{this, "resolved-refs",
+                            "Number of param references replaced by "
+                            "constants"};
 };
 
 } // namespace
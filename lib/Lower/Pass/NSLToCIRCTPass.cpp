@@ -21,6 +21,7 @@
 #include "CIRCTTypeConverter.h"
 #include "circt/Dialect/Comb/CombDialect.h"
 #include "circt/Dialect/FSM/FSMDialect.h"
+#include "circt/Dialect/FSM/FSMOps.h"
 #include "circt/Dialect/HW/HWDialect.h"
 #include "circt/Dialect/SV/SVDialect.h"
 #include "circt/Dialect/Seq/SeqDialect.h"
@@ -32,6 +33,8 @@
 #include "nsl/Dialect/NSL/IR/NSLDialect.h"
 #include "nsl/Lower/Lower.h"
 
+#include "llvm/ADT/STLExtras.h"
+
 #include <memory>
 
 namespace nsl::lower {
@@ -44,6 +47,9 @@ class NSLToCIRCTPass
 public:
   MLIR_DEFINE_EXPLICIT_INTERNAL_INLINE_TYPE_ID(NSLToCIRCTPass)
 
+  NSLToCIRCTPass() = default;
+  NSLToCIRCTPass(const NSLToCIRCTPass &other) : PassWrapper(other) {}
+
   llvm::StringRef getArgument() const final { return "nsl-to-circt"; }
 
   llvm::StringRef getDescription() const final {
@@ -68,6 +74,18 @@ public:
     mlir::ModuleOp module = getOperation();
     mlir::MLIRContext &ctx = getContext();
 
+    // Input size, for `-mlir-pass-statistics`.
+    module.walk([&](mlir::Operation *op) {
+      if (mlir::isa<nsl::dialect::ModuleOp>(op)) {
+        ++numModules;
+      }
+      if (op->getDialect() &&
+          op->getDialect()->getNamespace() ==
+              nsl::dialect::NSLDialect::getDialectNamespace()) {
+        ++numNSLOps;
+      }
+    });
+
     // ---------- Phase 4 (US2) structural pre-pass ----------
     // Every `nsl::ModuleOp` is rewritten into a `hw::HWModuleOp`
     // with port list derived from the paired `nsl::DeclareOp`.
@@ -101,6 +119,7 @@ public:
       signalPassFailure();
       return;
     }
+    numMachines += llvm::range_size(module.getOps<circt::fsm::MachineOp>());
 
     // ---------- ConversionTarget ----------
     // Mark `nsl` dialect illegal: every `nsl::*` op MUST be converted
@@ -141,6 +160,14 @@ public:
       signalPassFailure();
     }
   }
+
+private:
+  Statistic numModules{this, "modules-lowered",
+                       "Number of nsl.module ops lowered to hw.module"};
+  Statistic numMachines{this, "fsm-machines",
+                        "Number of fsm.machine ops created for procs and "
+                        "seq functions"};
+  Statistic numNSLOps{this, "nsl-ops", "Number of nsl ops in the input"};
 };
 
 } // namespace
@@ -9,20 +9,18 @@
 // load-bearing entry point used by every nslc invocation; the
 // CST-mode wiring is purely additive (an opt-in observer hook). Per
 // Constitution Principle II's no-duplication rule the new overload
-// reuses the same `Parser::parseCompilationUnit()` body — it does
-// NOT duplicate the parse loop. The only logic added here is the
-// top-level `beginNode`/`endNode` bracketing.
-//
-// Sub-production (`parseModuleItem`, `parseAltBlock`, etc.) sink
-// instrumentation is deferred to T2 Phase 3+ when the
-// LayoutPlanner needs the structural context to emit `Doc::group`
-// boundaries.
+// reuses the same `BasicParser::parseCompilationUnit()` body,
+// instantiated with `SinkCSTPolicy` — it does NOT duplicate the parse
+// loop. The only logic added here is the top-level
+// `beginNode`/`endNode` bracketing, which spans leading trivia and
+// closes at EOF; every sub-production brackets itself through
+// `BasicParser::NodeScope`.
 //
 // **Spec / contract anchors**:
 //   - `specs/010-t2-formatter-v0/research.md` §2 (CST-mode parser
 //     extension shape).
 //   - `specs/010-t2-formatter-v0/contracts/cst-shape.contract.md` §6
-//     (top-level production wraps with begin/endNode; tokens via
+//     (every production wraps with begin/endNode; tokens via
 //     recordToken).
 //   - Constitution Principle II — no second public header on
 //     nsl-parse; this file is private to lib/Parse/.
@@ -49,8 +47,7 @@ parseCompilationUnit(Lexer &lex, DiagnosticEngine &diag, CSTSink *sink) {
     return parseCompilationUnit(lex, diag);
   }
 
-  Parser p(lex, diag);
-  p.setCSTSink(sink);
+  CSTParser p(lex, diag, SinkCSTPolicy(*sink));
 
   // Top-level production wrap. `peek(0)` forces the lexer to lex the
   // first token; its `range().begin()` is the first byte of the
@@ -71,7 +71,9 @@ bool isFuncDefStart(TokenKind k) {
 
 // ---------- §3 struct_declaration ----------
 
-std::unique_ptr<ast::Decl> Parser::parseStructDecl() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseStructDecl() {
+  NodeScope node(*this, "StructDecl");
   Token struct_tok;
   if (!expect(TokenKind::tk_struct_, "'struct'", &struct_tok)) {
     return nullptr;
@@ -124,7 +126,9 @@ std::unique_ptr<ast::Decl> Parser::parseStructDecl() {
 
 // ---------- §3.1 top_level_parameter ----------
 
-std::unique_ptr<ast::Decl> Parser::parseTopLevelParam() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseTopLevelParam() {
+  NodeScope node(*this, "TopLevelParamDecl");
   Token kw;
   ast::TopLevelParamDecl::ParamKind kind =
       ast::TopLevelParamDecl::ParamKind::Int;
@@ -161,7 +165,9 @@ std::unique_ptr<ast::Decl> Parser::parseTopLevelParam() {
 
 // ---------- §4 declare_block ----------
 
-std::unique_ptr<ast::Decl> Parser::parseDeclareBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseDeclareBlock() {
+  NodeScope node(*this, "DeclareBlock");
   Token decl_tok;
   if (!expect(TokenKind::tk_declare, "'declare'", &decl_tok)) {
     return nullptr;
@@ -294,9 +300,11 @@ std::unique_ptr<ast::Decl> Parser::parseDeclareBlock() {
       clockName, resetName, std::move(headerParams), std::move(port_list));
 }
 
-bool Parser::parseDeclareItem(
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::parseDeclareItem(
     std::vector<std::unique_ptr<ast::Decl>> &headerParams,
     std::vector<std::unique_ptr<ast::Decl>> &ports) {
+  NodeScope node(*this, "DeclareItem");
   TokenKind k = peekKind();
 
   // parameter_declaration: "param_int" identifier { "," identifier } ";"
@@ -544,7 +552,9 @@ bool Parser::parseDeclareItem(
 
 // ---------- §5 module_block ----------
 
-std::unique_ptr<ast::Decl> Parser::parseModuleBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseModuleBlock() {
+  NodeScope node(*this, "ModuleBlock");
   Token mod_tok;
   if (!expect(TokenKind::tk_module, "'module'", &mod_tok)) {
     return nullptr;
@@ -608,10 +618,12 @@ std::unique_ptr<ast::Decl> Parser::parseModuleBlock() {
       std::move(funcs), std::move(procs));
 }
 
-bool Parser::parseModuleItem(std::vector<std::unique_ptr<ast::Decl>> &internals,
-                             std::vector<std::unique_ptr<ast::Stmt>> &actions,
-                             std::vector<std::unique_ptr<ast::Decl>> &funcs,
-                             std::vector<std::unique_ptr<ast::Decl>> &procs) {
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::parseModuleItem(
+    std::vector<std::unique_ptr<ast::Decl>> &internals,
+    std::vector<std::unique_ptr<ast::Stmt>> &actions,
+    std::vector<std::unique_ptr<ast::Decl>> &funcs,
+    std::vector<std::unique_ptr<ast::Decl>> &procs) {
   TokenKind k = peekKind();
 
   if (isInternalDeclStart(k)) {
@@ -690,7 +702,9 @@ bool Parser::parseModuleItem(std::vector<std::unique_ptr<ast::Decl>> &internals,
 
 // ---------- §6 internal_declaration dispatch ----------
 
-std::unique_ptr<ast::Decl> Parser::parseInternalDecl() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseInternalDecl() {
+  NodeScope node(*this, "InternalDecl");
   // Reset multi-declarator side-table at every call so trailing
   // declarators from a prior call (if any) don't leak forward.
   pendingExtraDecls_.clear();
@@ -1367,7 +1381,9 @@ std::unique_ptr<ast::Decl> Parser::parseInternalDecl() {
 
 // ---------- §7 function/procedure/state definitions ----------
 
-std::unique_ptr<ast::Decl> Parser::parseFuncDefn() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseFuncDefn() {
+  NodeScope node(*this, "FuncDefn");
   Token kw;
   if (check(TokenKind::tk_func)) {
     kw = consume();
@@ -1403,7 +1419,9 @@ std::unique_ptr<ast::Decl> Parser::parseFuncDefn() {
       std::move(body));
 }
 
-std::unique_ptr<ast::Decl> Parser::parseProcDefn() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseProcDefn() {
+  NodeScope node(*this, "ProcDefn");
   Token kw;
   if (!expect(TokenKind::tk_proc, "'proc'", &kw)) {
     return nullptr;
@@ -1422,7 +1440,9 @@ std::unique_ptr<ast::Decl> Parser::parseProcDefn() {
       std::move(body));
 }
 
-std::unique_ptr<ast::Decl> Parser::parseStateDefn() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Decl> BasicParser<CSTPolicy>::parseStateDefn() {
+  NodeScope node(*this, "StateDefn");
   Token kw;
   if (!expect(TokenKind::tk_state, "'state'", &kw)) {
     return nullptr;
@@ -1441,4 +1461,29 @@ std::unique_ptr<ast::Decl> Parser::parseStateDefn() {
       std::move(body));
 }
 
+// ---------- Explicit instantiation (both CST policies) ----------
+
+#define NSL_PARSE_DECL_INSTANTIATE(P) \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseStructDecl(); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseTopLevelParam(); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseDeclareBlock(); \
+  template bool BasicParser<P>::parseDeclareItem( \
+      std::vector<std::unique_ptr<ast::Decl>> &, \
+      std::vector<std::unique_ptr<ast::Decl>> &); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseModuleBlock(); \
+  template bool BasicParser<P>::parseModuleItem( \
+      std::vector<std::unique_ptr<ast::Decl>> &, \
+      std::vector<std::unique_ptr<ast::Stmt>> &, \
+      std::vector<std::unique_ptr<ast::Decl>> &, \
+      std::vector<std::unique_ptr<ast::Decl>> &); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseInternalDecl(); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseFuncDefn(); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseProcDefn(); \
+  template std::unique_ptr<ast::Decl> BasicParser<P>::parseStateDefn();
+
+NSL_PARSE_DECL_INSTANTIATE(NoCSTPolicy)
+NSL_PARSE_DECL_INSTANTIATE(SinkCSTPolicy)
+
+#undef NSL_PARSE_DECL_INSTANTIATE
+
 } // namespace nsl::parse
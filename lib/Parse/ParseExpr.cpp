@@ -28,9 +28,16 @@
 //   - N11(b): `_random` / `_time` (no parens) → `SystemVarExpr`. The
 //     lexer emits `tk_system_function` for these names; we route them
 //     as a leaf nud.
+//
+// CST mode: a nud opens a `PrimaryExpr`, `UnaryExpr` or `IncDecExpr`
+// node. Each `led` and postfix step opens its node (`BinaryExpr`,
+// `SliceExpr`, `CallExpr`, …) retroactively at a checkpoint taken
+// before the left operand, so `a + b * c` is a `BinaryExpr` whose
+// children are `a`'s node, `+` and a nested `BinaryExpr`.
 
 #include "ParserImpl.h"
 #include "PrecedenceTable.h"
+#include "Recovery.h"
 #include "nsl/AST/BinaryExpr.h"
 #include "nsl/AST/CallExpr.h"
 #include "nsl/AST/ConcatExpr.h"
@@ -141,18 +148,75 @@ bool isPostfixStart(TokenKind k) {
          k == TokenKind::tk_lparen;
 }
 
+/// CST node kind of the nud starting with `k`.
+llvm::StringRef nudKindName(TokenKind k) {
+  switch (k) {
+  case TokenKind::tk_minus:
+  case TokenKind::tk_plus:
+  case TokenKind::tk_tilde:
+  case TokenKind::tk_logical_not:
+  case TokenKind::tk_amp:
+  case TokenKind::tk_pipe:
+  case TokenKind::tk_caret:
+    return "UnaryExpr";
+  case TokenKind::tk_plus_plus:
+  case TokenKind::tk_minus_minus:
+    return "IncDecExpr";
+  default:
+    return "PrimaryExpr";
+  }
+}
+
+/// CST node kind of the led (infix / postfix operator) `k`.
+llvm::StringRef ledKindName(TokenKind k) {
+  switch (k) {
+  case TokenKind::tk_hash_sign_extend:
+    return "SignExtendExpr";
+  case TokenKind::tk_apostrophe_zero_extend:
+    return "ZeroExtendExpr";
+  case TokenKind::tk_plus_plus:
+  case TokenKind::tk_minus_minus:
+    return "IncDecExpr";
+  case TokenKind::tk_question:
+    return "ConditionalExpr";
+  default:
+    return "BinaryExpr";
+  }
+}
+
+/// CST node kind of the postfix step starting with `k`.
+llvm::StringRef postfixKindName(TokenKind k) {
+  switch (k) {
+  case TokenKind::tk_lbracket:
+    return "SliceExpr";
+  case TokenKind::tk_dot:
+    return "FieldAccessExpr";
+  default:
+    return "CallExpr";
+  }
+}
+
 } // namespace
 
 // ---------- Nud (prefix / leaf) ----------
 
-std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Expr> BasicParser<CSTPolicy>::parseNudExpr() {
+  // The kind needs a peek; the AST-only policy skips it.
+  NodeScope node(*this,
+                 CSTPolicy::kEnabled ? nudKindName(peekKind()) : "");
+  NestingGuard nest(*this);
+  if (nest.exceeded()) {
+    skipNested(*this);
+    return nullptr;
+  }
   Token t = peek();
   TokenKind k = t.kind();
 
   // Literals
   if (isLiteralKind(k)) {
     Token tok = consume();
-    auto lit = std::make_unique<ast::LiteralExpr>(
+    auto lit = makeExpr<ast::LiteralExpr>(
         tok.range(), toLitKind(tok.kind()), tok.spelling(), tok.flags());
 
     // §11 sign_extend / zero_extend / repeat have the constant_expression
@@ -186,7 +250,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
     }
     ast::ScopedName name;
     name.parts.push_back(name_part);
-    return std::make_unique<ast::IdentifierExpr>(whole, std::move(name));
+    return makeExpr<ast::IdentifierExpr>(whole, std::move(name));
   }
 
   // System variables (`_random`, `_time` — no parens; per N11(b))
@@ -196,7 +260,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
     if (tok.spelling() == "_time") {
       var = ast::SystemVarExpr::Var::Time;
     }
-    return std::make_unique<ast::SystemVarExpr>(tok.range(), var);
+    return makeExpr<ast::SystemVarExpr>(tok.range(), var);
   }
 
   // Parenthesized expression OR struct-cast
@@ -244,7 +308,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
         path.push_back(nxt);
         end = nxt_range.end();
       }
-      return std::make_unique<ast::StructCastExpr>(
+      return makeExpr<ast::StructCastExpr>(
           rangeFromTo(lpar.range().begin(), end), type_tok.spelling(),
           std::move(inner), std::move(path));
     }
@@ -282,7 +346,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
     if (!expect(TokenKind::tk_rbrace, "'}' after concat expression", &rbr)) {
       return nullptr;
     }
-    return std::make_unique<ast::ConcatExpr>(
+    return makeExpr<ast::ConcatExpr>(
         rangeFromTo(lbr.range().begin(), rbr.range().end()), std::move(parts));
   }
 
@@ -312,7 +376,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
     if (!expect(TokenKind::tk_rbrace, "'}' after .{...} concat", &rbr)) {
       return nullptr;
     }
-    return std::make_unique<ast::ConcatExpr>(
+    return makeExpr<ast::ConcatExpr>(
         rangeFromTo(mark.range().begin(), rbr.range().end()), std::move(parts));
   }
 
@@ -358,7 +422,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
       return nullptr;
     }
     SourceLocation end_loc = sub->loc().end();
-    return std::make_unique<ast::UnaryExpr>(
+    return makeExpr<ast::UnaryExpr>(
         rangeFromTo(op_tok.range().begin(), end_loc), uop, std::move(sub));
   }
 
@@ -377,7 +441,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
       return nullptr;
     }
     const SourceLocation end_loc = sub->loc().end();
-    return std::make_unique<ast::IncDecExpr>(
+    return makeExpr<ast::IncDecExpr>(
         rangeFromTo(op_tok.range().begin(), end_loc), std::move(sub), op,
         /*prefix=*/true);
   }
@@ -421,7 +485,7 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
       b.addFixIt(ins, " else ");
     }
     SourceLocation end_loc = elseE ? elseE->loc().end() : thenE->loc().end();
-    return std::make_unique<ast::ConditionalExpr>(
+    return makeExpr<ast::ConditionalExpr>(
         rangeFromTo(if_tok.range().begin(), end_loc), std::move(cond),
         std::move(thenE), std::move(elseE));
   }
@@ -433,9 +497,12 @@ std::unique_ptr<ast::Expr> Parser::parseNudExpr() {
 
 // ---------- Postfix tail walker ----------
 
+template <typename CSTPolicy>
 std::unique_ptr<ast::Expr>
-Parser::parsePostfix(std::unique_ptr<ast::Expr> head) {
+BasicParser<CSTPolicy>::parsePostfix(std::unique_ptr<ast::Expr> head,
+                                     const Checkpoint &start) {
   while (head && isPostfixStart(peekKind())) {
+    NodeScope node(*this, start, postfixKindName(peekKind()));
     if (check(TokenKind::tk_lbracket)) {
       consume();
       auto hi = parseExpr();
@@ -456,9 +523,8 @@ Parser::parsePostfix(std::unique_ptr<ast::Expr> head) {
       }
       SourceLocation begin = head->loc().begin();
       SourceLocation end = rbr.range().end();
-      head = std::make_unique<ast::SliceExpr>(rangeFromTo(begin, end),
-                                              std::move(head), std::move(hi),
-                                              std::move(lo));
+      head = makeExpr<ast::SliceExpr>(rangeFromTo(begin, end), std::move(head),
+                                      std::move(hi), std::move(lo));
       continue;
     }
     if (check(TokenKind::tk_dot)) {
@@ -471,8 +537,8 @@ Parser::parsePostfix(std::unique_ptr<ast::Expr> head) {
       }
       SourceLocation begin = head->loc().begin();
       SourceLocation end = field_range.end();
-      head = std::make_unique<ast::FieldAccessExpr>(rangeFromTo(begin, end),
-                                                    std::move(head), field);
+      head = makeExpr<ast::FieldAccessExpr>(rangeFromTo(begin, end),
+                                            std::move(head), field);
       continue;
     }
     if (check(TokenKind::tk_lparen)) {
@@ -514,7 +580,7 @@ Parser::parsePostfix(std::unique_ptr<ast::Expr> head) {
         target = ident->name();
       }
       SourceLocation begin = head->loc().begin();
-      head = std::make_unique<ast::CallExpr>(
+      head = makeExpr<ast::CallExpr>(
           rangeFromTo(begin, end_loc), std::move(target), std::move(args));
       continue;
     }
@@ -525,17 +591,22 @@ Parser::parsePostfix(std::unique_ptr<ast::Expr> head) {
 
 // ---------- Pratt loop ----------
 
-std::unique_ptr<ast::Expr> Parser::parseExpr() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Expr> BasicParser<CSTPolicy>::parseExpr() {
+  NodeScope node(*this, "Expr");
   return parseExprAtPrecedence(0);
 }
 
-std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Expr>
+BasicParser<CSTPolicy>::parseExprAtPrecedence(int floor) {
+  const Checkpoint start = checkpoint();
   auto lhs = parseNudExpr();
   if (!lhs) {
     return nullptr;
   }
   // Postfix tail wraps the leaf head.
-  lhs = parsePostfix(std::move(lhs));
+  lhs = parsePostfix(std::move(lhs), start);
   if (!lhs) {
     return nullptr;
   }
@@ -544,6 +615,7 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
   // (constant-evaluable) expression and the next token is `{`. We
   // accept it whenever an `{` follows; Sema validates count-ness.
   if (check(TokenKind::tk_lbrace)) {
+    NodeScope node(*this, start, "RepeatExpr");
     consume();
     auto body = parseExpr();
     if (!body) {
@@ -556,8 +628,8 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
     }
     SourceLocation begin = lhs->loc().begin();
     SourceLocation end = rbr.range().end();
-    lhs = std::make_unique<ast::RepeatExpr>(rangeFromTo(begin, end),
-                                            std::move(lhs), std::move(body));
+    lhs = makeExpr<ast::RepeatExpr>(rangeFromTo(begin, end), std::move(lhs),
+                                    std::move(body));
   }
 
   for (;;) {
@@ -570,23 +642,25 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
     if (prec < floor) {
       break;
     }
+    NodeScope node(*this, start, ledKindName(k));
     Token op_tok = consume();
 
     // N5 sign-extend: `<width> # <primary>`
     if (k == TokenKind::tk_hash_sign_extend) {
       // The grammar allows either `N#sig` (a primary) or `N#(expr)`.
       // parseNudExpr handles both via the `(`-leaf path.
+      const Checkpoint sub_start = checkpoint();
       auto sub = parseNudExpr();
       if (!sub) {
         return nullptr;
       }
-      sub = parsePostfix(std::move(sub));
+      sub = parsePostfix(std::move(sub), sub_start);
       if (!sub) {
         return nullptr;
       }
       SourceLocation begin = lhs->loc().begin();
       SourceLocation end = sub->loc().end();
-      lhs = std::make_unique<ast::SignExtendExpr>(
+      lhs = makeExpr<ast::SignExtendExpr>(
           rangeFromTo(begin, end), std::move(lhs), std::move(sub));
       continue;
     }
@@ -607,7 +681,7 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
       }
       SourceLocation begin = lhs->loc().begin();
       SourceLocation end = rpar.range().end();
-      lhs = std::make_unique<ast::ZeroExtendExpr>(
+      lhs = makeExpr<ast::ZeroExtendExpr>(
           rangeFromTo(begin, end), std::move(lhs), std::move(sub));
       continue;
     }
@@ -621,9 +695,8 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
                                                      : ast::IncDecExpr::Op::Dec;
       const SourceLocation begin = lhs->loc().begin();
       const SourceLocation end = op_tok.range().end();
-      lhs = std::make_unique<ast::IncDecExpr>(rangeFromTo(begin, end),
-                                              std::move(lhs), op,
-                                              /*prefix=*/false);
+      lhs = makeExpr<ast::IncDecExpr>(rangeFromTo(begin, end), std::move(lhs),
+                                      op, /*prefix=*/false);
       continue;
     }
 
@@ -644,7 +717,7 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
       }
       SourceLocation begin = lhs->loc().begin();
       SourceLocation end = elseE->loc().end();
-      lhs = std::make_unique<ast::ConditionalExpr>(
+      lhs = makeExpr<ast::ConditionalExpr>(
           rangeFromTo(begin, end), std::move(lhs), std::move(thenE),
           std::move(elseE));
       continue;
@@ -659,15 +732,18 @@ std::unique_ptr<ast::Expr> Parser::parseExprAtPrecedence(int floor) {
     SourceLocation begin = lhs->loc().begin();
     SourceLocation end = rhs->loc().end();
     auto bop = binaryOpFor(k);
-    lhs = std::make_unique<ast::BinaryExpr>(rangeFromTo(begin, end), bop,
-                                            std::move(lhs), std::move(rhs));
+    lhs = makeExpr<ast::BinaryExpr>(rangeFromTo(begin, end), bop,
+                                    std::move(lhs), std::move(rhs));
   }
   return lhs;
 }
 
 // ---------- Argument-list helper ----------
 
-bool Parser::parseArgumentList(std::vector<std::unique_ptr<ast::Expr>> &out) {
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::parseArgumentList(
+    std::vector<std::unique_ptr<ast::Expr>> &out) {
+  NodeScope node(*this, "ArgumentList");
   // Caller has consumed the `(`. Empty arg list is `( )`.
   if (check(TokenKind::tk_rparen)) {
     consume();
@@ -688,4 +764,22 @@ bool Parser::parseArgumentList(std::vector<std::unique_ptr<ast::Expr>> &out) {
   return expect(TokenKind::tk_rparen, "')' after argument list");
 }
 
+// ---------- Explicit instantiation (both CST policies) ----------
+
+#define NSL_PARSE_EXPR_INSTANTIATE(P) \
+  template std::unique_ptr<ast::Expr> BasicParser<P>::parseNudExpr(); \
+  template std::unique_ptr<ast::Expr> \
+      BasicParser<P>::parsePostfix(std::unique_ptr<ast::Expr>, \
+                                   const Checkpoint &); \
+  template std::unique_ptr<ast::Expr> BasicParser<P>::parseExpr(); \
+  template std::unique_ptr<ast::Expr> \
+      BasicParser<P>::parseExprAtPrecedence(int); \
+  template bool BasicParser<P>::parseArgumentList( \
+      std::vector<std::unique_ptr<ast::Expr>> &);
+
+NSL_PARSE_EXPR_INSTANTIATE(NoCSTPolicy)
+NSL_PARSE_EXPR_INSTANTIATE(SinkCSTPolicy)
+
+#undef NSL_PARSE_EXPR_INSTANTIATE
+
 } // namespace nsl::parse
@@ -92,7 +92,9 @@ bool isLabelNameDecl(TokenKind k) {
 /// Skip a `label_name id { , id } ;` form. The AST has no node kind
 /// for it (it's a Sema/M3 concern); parsing it correctly preserves
 /// the surrounding seq_block items.
-bool skipLabelNameDecl(Parser &p) {
+template <typename CSTPolicy>
+bool skipLabelNameDecl(BasicParser<CSTPolicy> &p) {
+  typename BasicParser<CSTPolicy>::NodeScope node(p, "LabelNameDecl");
   p.consume(); // label_name
   Token t;
   if (!p.expect(TokenKind::tk_identifier, "label_name identifier", &t)) {
@@ -129,7 +131,13 @@ ast::IncDecStmt::Op incDecOpForStmt(TokenKind k) {
 
 // ---------- action_statement dispatch ----------
 
-std::unique_ptr<ast::Stmt> Parser::parseActionStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseActionStatement() {
+  NestingGuard nest(*this);
+  if (nest.exceeded()) {
+    skipNested(*this);
+    return nullptr;
+  }
   TokenKind k = peekKind();
   switch (k) {
   case TokenKind::tk_lbrace:
@@ -154,6 +162,7 @@ std::unique_ptr<ast::Stmt> Parser::parseActionStatement() {
     return parseGotoStatement();
   case TokenKind::tk_finish: {
     // bare `finish;` form per `lang.ebnf §9` line 478.
+    NodeScope node(*this, "BareFinishStmt");
     Token t = consume();
     Token semi;
     if (!expect(TokenKind::tk_semicolon, "';' after 'finish'", &semi)) {
@@ -165,6 +174,7 @@ std::unique_ptr<ast::Stmt> Parser::parseActionStatement() {
   case TokenKind::tk_system_task:
     return parseSystemTaskStatement();
   case TokenKind::tk_semicolon: {
+    NodeScope node(*this, "EmptyStmt");
     Token t = consume();
     return std::make_unique<ast::EmptyStmt>(t.range());
   }
@@ -179,7 +189,9 @@ std::unique_ptr<ast::Stmt> Parser::parseActionStatement() {
 
 // ---------- LValue-led: transfer / control-call / inc-dec / labeled ----------
 
-std::unique_ptr<ast::Stmt> Parser::parseLValueLedStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseLValueLedStatement() {
+  NodeScope node(*this, "LValueStmt");
   // Prefix inc/dec at statement position (`lang.ebnf §11` lines
   // 654–655 lifted to §9 atomic-action position): `++x;` / `--x;`.
   // Build `IncDecStmt` directly so the AST node-kind cleanly matches
@@ -189,11 +201,12 @@ std::unique_ptr<ast::Stmt> Parser::parseLValueLedStatement() {
     const auto op = incDecOpForStmt(op_tok.kind());
     // Per spec the operand is `identifier`; we accept any nud-led
     // expression and rely on Sema (M3) to reject non-l-value targets.
+    const Checkpoint target_start = checkpoint();
     auto target = parseNudExpr();
     if (!target) {
       return nullptr;
     }
-    target = parsePostfix(std::move(target));
+    target = parsePostfix(std::move(target), target_start);
     if (!target) {
       return nullptr;
     }
@@ -234,6 +247,7 @@ std::unique_ptr<ast::Stmt> Parser::parseLValueLedStatement() {
   // the general parseExpr() fallback below.
   if (peekKind() == TokenKind::tk_identifier ||
       peekKind() == TokenKind::tk_label) {
+    const Checkpoint head_start = checkpoint();
     SourceRange head_range;
     ast::ScopedName head_name = parseScopedName(head_range);
     if (head_name.parts.empty()) {
@@ -262,8 +276,8 @@ std::unique_ptr<ast::Stmt> Parser::parseLValueLedStatement() {
     // `[hi:lo]` etc. then attach. We synthesize an IdentifierExpr
     // and feed it through parsePostfix to pick up the bit-select tail.
     std::unique_ptr<ast::Expr> lhs =
-        std::make_unique<ast::IdentifierExpr>(head_range, std::move(head_name));
-    lhs = parsePostfix(std::move(lhs));
+        makeExpr<ast::IdentifierExpr>(head_range, std::move(head_name));
+    lhs = parsePostfix(std::move(lhs), head_start);
     if (!lhs) {
       return nullptr;
     }
@@ -336,7 +350,9 @@ std::unique_ptr<ast::Stmt> Parser::parseLValueLedStatement() {
 
 // ---------- Block forms ----------
 
-std::unique_ptr<ast::Stmt> Parser::parseParallelBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseParallelBlock() {
+  NodeScope node(*this, "ParallelBlock");
   Token lbr;
   if (!expect(TokenKind::tk_lbrace, "'{' to begin parallel block", &lbr)) {
     return nullptr;
@@ -436,7 +452,9 @@ std::unique_ptr<ast::Stmt> Parser::parseParallelBlock() {
       std::move(decls));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseAltBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseAltBlock() {
+  NodeScope node(*this, "AltBlock");
   Token alt_tok;
   if (!expect(TokenKind::tk_alt, "'alt'", &alt_tok)) {
     return nullptr;
@@ -520,7 +538,9 @@ std::unique_ptr<ast::Stmt> Parser::parseAltBlock() {
       std::move(elseCase));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseAnyBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseAnyBlock() {
+  NodeScope node(*this, "AnyBlock");
   Token any_tok;
   if (!expect(TokenKind::tk_any, "'any'", &any_tok)) {
     return nullptr;
@@ -604,7 +624,9 @@ std::unique_ptr<ast::Stmt> Parser::parseAnyBlock() {
       std::move(elseCase));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseSeqBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseSeqBlock() {
+  NodeScope node(*this, "SeqBlock");
   Token seq_tok;
   if (!expect(TokenKind::tk_seq, "'seq'", &seq_tok)) {
     return nullptr;
@@ -687,7 +709,9 @@ std::unique_ptr<ast::Stmt> Parser::parseSeqBlock() {
       std::move(decls));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseWhileBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseWhileBlock() {
+  NodeScope node(*this, "WhileBlock");
   Token while_tok;
   if (!expect(TokenKind::tk_while_, "'while'", &while_tok)) {
     return nullptr;
@@ -760,7 +784,9 @@ std::unique_ptr<ast::Stmt> Parser::parseWhileBlock() {
       std::move(cond), std::move(items));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseForBlock() {
+  NodeScope node(*this, "ForBlock");
   Token for_tok;
   if (!expect(TokenKind::tk_for_, "'for'", &for_tok)) {
     return nullptr;
@@ -791,7 +817,7 @@ std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
     }
     // Synthesize a `TransferStmt` for the init; the for-form stores
     // the init clause as a Stmt regardless of single/compound shape.
-    auto target = std::make_unique<ast::IdentifierExpr>(
+    auto target = makeExpr<ast::IdentifierExpr>(
         name_tok.range(), ast::ScopedName{{name_tok.spelling()}});
     SourceLocation begin = name_tok.range().begin();
     SourceLocation end = init_expr->loc().end();
@@ -843,7 +869,7 @@ std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
                     "identifier after prefix increment/decrement", &name_tok)) {
           return nullptr;
         }
-        auto target = std::make_unique<ast::IdentifierExpr>(
+        auto target = makeExpr<ast::IdentifierExpr>(
             name_tok.range(), ast::ScopedName{{name_tok.spelling()}});
         form.step = std::make_unique<ast::IncDecStmt>(
             rangeFromTo(op_tok.range().begin(), name_tok.range().end()),
@@ -859,7 +885,7 @@ std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
           // Postfix form `id++` / `id--`.
           const Token op_tok = consume();
           const auto op = incDecOpForStmt(op_tok.kind());
-          auto target = std::make_unique<ast::IdentifierExpr>(
+          auto target = makeExpr<ast::IdentifierExpr>(
               name_tok.range(), ast::ScopedName{{name_tok.spelling()}});
           form.step = std::make_unique<ast::IncDecStmt>(
               rangeFromTo(name_tok.range().begin(), op_tok.range().end()),
@@ -872,7 +898,7 @@ std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
           if (!step_expr) {
             return nullptr;
           }
-          auto target = std::make_unique<ast::IdentifierExpr>(
+          auto target = makeExpr<ast::IdentifierExpr>(
               name_tok.range(), ast::ScopedName{{name_tok.spelling()}});
           SourceLocation begin = name_tok.range().begin();
           SourceLocation end = step_expr->loc().end();
@@ -950,7 +976,9 @@ std::unique_ptr<ast::Stmt> Parser::parseForBlock() {
 
 // ---------- if / generate / return / goto ----------
 
-std::unique_ptr<ast::Stmt> Parser::parseIfStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseIfStatement() {
+  NodeScope node(*this, "IfStmt");
   Token if_tok;
   if (!expect(TokenKind::tk_if_, "'if'", &if_tok)) {
     return nullptr;
@@ -984,7 +1012,9 @@ std::unique_ptr<ast::Stmt> Parser::parseIfStatement() {
       std::move(thenBr), std::move(elseBr));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseStructuralGenerate() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseStructuralGenerate() {
+  NodeScope node(*this, "StructuralGenerate");
   Token gen_tok;
   if (!expect(TokenKind::tk_generate, "'generate'", &gen_tok)) {
     return nullptr;
@@ -1049,7 +1079,9 @@ std::unique_ptr<ast::Stmt> Parser::parseStructuralGenerate() {
       std::move(body));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseReturnStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseReturnStatement() {
+  NodeScope node(*this, "ReturnStmt");
   Token ret_tok;
   if (!expect(TokenKind::tk_return_, "'return'", &ret_tok)) {
     return nullptr;
@@ -1070,7 +1102,9 @@ std::unique_ptr<ast::Stmt> Parser::parseReturnStatement() {
       std::move(value));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseGotoStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseGotoStatement() {
+  NodeScope node(*this, "GotoStmt");
   Token goto_tok;
   if (!expect(TokenKind::tk_goto_, "'goto'", &goto_tok)) {
     return nullptr;
@@ -1090,7 +1124,9 @@ std::unique_ptr<ast::Stmt> Parser::parseGotoStatement() {
 
 // ---------- _init / _delay / system_task ----------
 
-std::unique_ptr<ast::Stmt> Parser::parseInitBlock() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseInitBlock() {
+  NodeScope node(*this, "InitBlockStmt");
   // Caller has gated on `tk_system_task` whose spelling is `_init`.
   Token init_tok = consume();
   if (!expect(TokenKind::tk_lbrace, "'{' after '_init'")) {
@@ -1126,7 +1162,9 @@ std::unique_ptr<ast::Stmt> Parser::parseInitBlock() {
       std::move(items));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseDelayTask() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseDelayTask() {
+  NodeScope node(*this, "DelayTaskStmt");
   Token delay_tok = consume(); // `_delay`
   if (!expect(TokenKind::tk_lparen, "'(' after '_delay'")) {
     return nullptr;
@@ -1147,7 +1185,9 @@ std::unique_ptr<ast::Stmt> Parser::parseDelayTask() {
       std::move(count));
 }
 
-std::unique_ptr<ast::Stmt> Parser::parseSystemTaskStatement() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::Stmt> BasicParser<CSTPolicy>::parseSystemTaskStatement() {
+  NodeScope node(*this, "SystemTaskStmt");
   // peek().spelling() carries the leading-underscore name (`_display`,
   // `_finish`, `_init`, `_delay`, `_readmemh`, …). Per N11(a) all of
   // these are statement-position system tasks. `_init { ... }` and
@@ -1176,4 +1216,31 @@ std::unique_ptr<ast::Stmt> Parser::parseSystemTaskStatement() {
       name_tok.spelling(), std::move(args));
 }
 
+// ---------- Explicit instantiation (both CST policies) ----------
+
+#define NSL_PARSE_STMT_INSTANTIATE(P) \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseActionStatement(); \
+  template std::unique_ptr<ast::Stmt> \
+      BasicParser<P>::parseLValueLedStatement(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseParallelBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseAltBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseAnyBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseSeqBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseWhileBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseForBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseIfStatement(); \
+  template std::unique_ptr<ast::Stmt> \
+      BasicParser<P>::parseStructuralGenerate(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseReturnStatement(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseGotoStatement(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseInitBlock(); \
+  template std::unique_ptr<ast::Stmt> BasicParser<P>::parseDelayTask(); \
+  template std::unique_ptr<ast::Stmt> \
+      BasicParser<P>::parseSystemTaskStatement();
+
+NSL_PARSE_STMT_INSTANTIATE(NoCSTPolicy)
+NSL_PARSE_STMT_INSTANTIATE(SinkCSTPolicy)
+
+#undef NSL_PARSE_STMT_INSTANTIATE
+
 } // namespace nsl::parse
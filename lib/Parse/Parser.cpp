@@ -29,7 +29,9 @@ namespace nsl::parse {
 
 // ---------- Parser class out-of-line members ----------
 
-bool Parser::expect(TokenKind k, llvm::StringRef what, Token *out) {
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::expect(TokenKind k, llvm::StringRef what,
+                                     Token *out) {
   if (check(k)) {
     Token t = consume();
     if (out != nullptr) {
@@ -43,8 +45,9 @@ bool Parser::expect(TokenKind k, llvm::StringRef what, Token *out) {
   return false;
 }
 
-bool Parser::consumeIdentifierLike(ast::Identifier &out_name,
-                                   SourceRange &out_range) {
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::consumeIdentifierLike(ast::Identifier &out_name,
+                                                    SourceRange &out_range) {
   TokenKind k = peekKind();
   if (k == TokenKind::tk_identifier) {
     Token t = consume();
@@ -66,7 +69,9 @@ bool Parser::consumeIdentifierLike(ast::Identifier &out_name,
   return false;
 }
 
-bool Parser::expectIdentifierAllowLabel(llvm::StringRef what, Token *out) {
+template <typename CSTPolicy>
+bool BasicParser<CSTPolicy>::expectIdentifierAllowLabel(llvm::StringRef what,
+                                                         Token *out) {
   TokenKind k = peekKind();
   if (k == TokenKind::tk_identifier) {
     Token t = consume();
@@ -92,7 +97,10 @@ bool Parser::expectIdentifierAllowLabel(llvm::StringRef what, Token *out) {
   return false;
 }
 
-ast::ScopedName Parser::parseScopedName(SourceRange &out_range) {
+template <typename CSTPolicy>
+ast::ScopedName
+BasicParser<CSTPolicy>::parseScopedName(SourceRange &out_range) {
+  NodeScope node(*this, "ScopedName");
   ast::ScopedName name;
   ast::Identifier first;
   SourceRange first_range;
@@ -137,7 +145,9 @@ ast::ScopedName Parser::parseScopedName(SourceRange &out_range) {
 
 // ---------- Top-level parser ----------
 
-std::unique_ptr<ast::CompilationUnit> Parser::parseCompilationUnit() {
+template <typename CSTPolicy>
+std::unique_ptr<ast::CompilationUnit>
+BasicParser<CSTPolicy>::parseCompilationUnit() {
   // Snapshot the location at which the compilation unit begins. We
   // peek (which forces lex of the first token) and capture its
   // begin() — even for an empty file, peek() returns `tk_eof` whose
@@ -211,10 +221,27 @@ std::unique_ptr<ast::CompilationUnit> Parser::parseCompilationUnit() {
   // begin() of `tk_eof` (which is the EOF cursor — for an empty file
   // both endpoints coincide, yielding a zero-length valid range).
   SourceLocation end = peek().range().begin();
-  return std::make_unique<ast::CompilationUnit>(rangeFromTo(begin, end),
-                                                std::move(items));
+  return std::make_unique<ast::CompilationUnit>(
+      rangeFromTo(begin, end), std::move(items), nextExprOrdinal_);
 }
 
+// ---------- Explicit instantiation (both CST policies) ----------
+
+#define NSL_PARSE_PARSER_INSTANTIATE(P) \
+  template bool BasicParser<P>::expect(TokenKind, llvm::StringRef, Token *); \
+  template bool \
+      BasicParser<P>::consumeIdentifierLike(ast::Identifier &, SourceRange &); \
+  template bool \
+      BasicParser<P>::expectIdentifierAllowLabel(llvm::StringRef, Token *); \
+  template ast::ScopedName BasicParser<P>::parseScopedName(SourceRange &); \
+  template std::unique_ptr<ast::CompilationUnit> \
+      BasicParser<P>::parseCompilationUnit();
+
+NSL_PARSE_PARSER_INSTANTIATE(NoCSTPolicy)
+NSL_PARSE_PARSER_INSTANTIATE(SinkCSTPolicy)
+
+#undef NSL_PARSE_PARSER_INSTANTIATE
+
 // ---------- Public API ----------
 
 std::unique_ptr<ast::CompilationUnit>
@@ -30,6 +30,15 @@
 // directly. The lexer maintains its own peek-cache deque per
 // `include/nsl/Lex/Lexer.h`, so cumulative `peek()` + `next()` is
 // O(1) amortized. The parser does not maintain a parallel buffer.
+//
+// CST mode: the driver is a class template over a CST policy.
+// `Parser` (= `BasicParser<NoCSTPolicy>`) is the AST-only instantiation
+// every `nslc` stage uses; its hooks are empty inline bodies, so the
+// per-token `recordToken` and per-production `NodeScope` compile to
+// nothing — no sink pointer, no branch. `CSTParser` (=
+// `BasicParser<SinkCSTPolicy>`) forwards the same hooks to a
+// `CSTSink`. Member definitions live in the per-file parsers, which
+// explicitly instantiate both policies at their foot.
 
 #ifndef NSL_LIB_PARSE_PARSERIMPL_H
 #define NSL_LIB_PARSE_PARSERIMPL_H
@@ -48,24 +57,81 @@
 
 #include "llvm/ADT/StringRef.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace nsl::parse {
 
+// ----- CST-mode policies -----
+
+/// AST-only policy (the `nslc` hot path). Every hook is an empty
+/// inline body; `kEnabled == false` also lets `NodeScope` skip the
+/// `peek()` it would otherwise need for the production's start.
+struct NoCSTPolicy {
+  static constexpr bool kEnabled = false;
+
+  void recordToken(const Token & /*tok*/) noexcept {}
+  void beginNode(llvm::StringRef /*kindName*/,
+                 SourceLocation /*start*/) noexcept {}
+  void endNode(SourceLocation /*start*/) noexcept {}
+  CSTCheckpoint checkpoint() noexcept { return {}; }
+  void beginNodeAt(const CSTCheckpoint & /*cp*/, llvm::StringRef /*kindName*/,
+                   SourceLocation /*start*/) noexcept {}
+};
+
+/// CST-mode policy: forwards every hook to the attached `CSTSink`.
+/// Tracks the end of the last consumed token so `endNode` can report
+/// the one-past-last-byte of the production without peeking ahead
+/// (a peek here would fold the trailing trivia into the node).
+class SinkCSTPolicy {
+public:
+  static constexpr bool kEnabled = true;
+
+  explicit SinkCSTPolicy(CSTSink &sink) noexcept : sink_(&sink) {}
+
+  void recordToken(const Token &tok) {
+    lastTokenEnd_ = tok.range().end();
+    sink_->recordToken(tok);
+  }
+
+  void beginNode(llvm::StringRef kindName, SourceLocation start) {
+    sink_->beginNode(kindName, start);
+  }
+
+  CSTCheckpoint checkpoint() { return sink_->checkpoint(); }
+
+  void beginNodeAt(const CSTCheckpoint &cp, llvm::StringRef kindName,
+                   SourceLocation start) {
+    sink_->beginNodeAt(cp, kindName, start);
+  }
+
+  /// `start` is the matching `beginNode` location; a production that
+  /// consumed no token (error path) closes as an empty node there.
+  void endNode(SourceLocation start) {
+    sink_->endNode(lastTokenEnd_ < start ? start : lastTokenEnd_);
+  }
+
+private:
+  CSTSink *sink_;
+  SourceLocation lastTokenEnd_;
+};
+
 /// Recursive-descent driver. Holds the lexer cursor + diagnostic sink.
 ///
 /// Construction: cheap (the lexer reference is stored; no eager peek).
 /// Method invocation order is up to the caller — `parseCompilationUnit`
 /// drives the canonical top-level loop.
-class Parser {
+template <typename CSTPolicy> class BasicParser {
 public:
-  Parser(Lexer &lex, DiagnosticEngine &diag) noexcept
-      : lex_(lex), diag_(diag) {}
+  BasicParser(Lexer &lex, DiagnosticEngine &diag,
+              CSTPolicy cst = CSTPolicy()) noexcept
+      : lex_(lex), diag_(diag), cst_(cst) {}
 
-  Parser(const Parser &) = delete;
-  Parser &operator=(const Parser &) = delete;
+  BasicParser(const BasicParser &) = delete;
+  BasicParser &operator=(const BasicParser &) = delete;
 
   // ----- Token-buffer primitives -----
 
@@ -78,33 +144,111 @@ public:
   /// Convenience: kind of next-to-be-returned token.
   TokenKind peekKind() { return lex_.peek(0).kind(); }
 
-  /// Consume the next token and return it.
-  ///
-  /// T2 Phase 2b extension: when a `CSTSink` is attached via
-  /// `setCSTSink()`, every consumed token is also routed through
-  /// `sink_->recordToken(t)` so a parallel CST-mode observer can
-  /// rebuild the source. Per `specs/010-t2-formatter-v0/research.md`
-  /// §2 + Constitution Principle II: the sink lives ABOVE the
-  /// `nsl-parse` layer; the inline call here adds zero overhead
-  /// when `sink_` is null (the AST-only hot path).
+  /// Consume the next token and return it. Every consumed token is
+  /// routed through the CST policy; under `NoCSTPolicy` that call is
+  /// an empty inline body (the AST-only hot path pays nothing).
   Token consume() {
     Token t = lex_.next();
-    if (sink_ != nullptr) {
-      sink_->recordToken(t);
-    }
+    cst_.recordToken(t);
     return t;
   }
 
-  /// Attach a CST-mode observer. `sink == nullptr` (the default)
-  /// disables the observer. Lifetime of `*sink` MUST exceed every
-  /// subsequent `parseFoo()` call — typically the sink lives on the
-  /// caller's stack frame for the duration of `parseCompilationUnit`.
-  void setCSTSink(CSTSink *sink) noexcept { sink_ = sink; }
+  /// Build an `Expr` node and stamp it with the next dense ordinal
+  /// (`ast::Expr::ordinal()`). Every expression the parser creates
+  /// goes through here so the unit's ordinals stay gap-free.
+  template <typename T, typename... Args>
+  std::unique_ptr<T> makeExpr(Args &&...args) {
+    auto e = std::make_unique<T>(std::forward<Args>(args)...);
+    e->setOrdinal(nextExprOrdinal_++);
+    return e;
+  }
 
-  /// Public accessor for the attached sink (used by free-function
-  /// overloads in `lib/Parse/CSTMode.cpp` to wrap top-level
-  /// productions with `beginNode`/`endNode`).
-  [[nodiscard]] CSTSink *cstSink() const noexcept { return sink_; }
+  /// Where a production that is opened retroactively starts: the
+  /// next token's location and the sink's checkpoint. Taken before
+  /// the first child of an expression whose kind is only known once
+  /// that child is parsed (`a + b`, `x[3]`). Empty under
+  /// `NoCSTPolicy`.
+  struct Checkpoint {
+    SourceLocation start;
+    CSTCheckpoint sink;
+  };
+
+  Checkpoint checkpoint() {
+    if constexpr (CSTPolicy::kEnabled) {
+      return {peek().range().begin(), cst_.checkpoint()};
+    } else {
+      return {};
+    }
+  }
+
+  /// RAII bracket for one grammar production. Construction reports
+  /// `beginNode(kindName, peek().begin)`; destruction reports the
+  /// matching `endNode` — on every return path, so error unwinds stay
+  /// balanced. Compiles away entirely under `NoCSTPolicy`.
+  class NodeScope {
+  public:
+    NodeScope(BasicParser &p, [[maybe_unused]] llvm::StringRef kindName)
+        : p_(p) {
+      if constexpr (CSTPolicy::kEnabled) {
+        start_ = p_.peek().range().begin();
+        p_.cst_.beginNode(kindName, start_);
+      }
+    }
+    /// Open the production at `cp` instead (`CSTSink::beginNodeAt`):
+    /// everything parsed since `cp` becomes its leading children.
+    NodeScope(BasicParser &p, [[maybe_unused]] const Checkpoint &cp,
+              [[maybe_unused]] llvm::StringRef kindName)
+        : p_(p) {
+      if constexpr (CSTPolicy::kEnabled) {
+        start_ = cp.start;
+        p_.cst_.beginNodeAt(cp.sink, kindName, start_);
+      }
+    }
+    ~NodeScope() {
+      if constexpr (CSTPolicy::kEnabled) {
+        p_.cst_.endNode(start_);
+      }
+    }
+
+    NodeScope(const NodeScope &) = delete;
+    NodeScope &operator=(const NodeScope &) = delete;
+
+  private:
+    BasicParser &p_;
+    SourceLocation start_;
+  };
+
+  /// Upper bound on nested statements / expressions the recursive
+  /// descent will enter. Mirrors `Preprocessor::kMaxIncludeDepth`: a
+  /// fixed cap keeps adversarial input (`seq { seq { ...`, `((((...`)
+  /// from exhausting the native stack.
+  static constexpr unsigned kMaxNestingDepth = 256;
+
+  /// RAII depth counter for the recursive productions. Construction
+  /// bumps the depth; once it passes `kMaxNestingDepth` the guard
+  /// reports one error at `peek()` and `exceeded()` turns true — the
+  /// caller then drops the whole over-deep construct with
+  /// `skipNested()` and returns nullptr.
+  class NestingGuard {
+  public:
+    explicit NestingGuard(BasicParser &p) : p_(p) {
+      if (++p_.nesting_depth_ > kMaxNestingDepth) {
+        exceeded_ = true;
+        p_.errorAtPeek("nesting exceeds the maximum depth of " +
+                       std::to_string(kMaxNestingDepth));
+      }
+    }
+    ~NestingGuard() { --p_.nesting_depth_; }
+
+    NestingGuard(const NestingGuard &) = delete;
+    NestingGuard &operator=(const NestingGuard &) = delete;
+
+    bool exceeded() const noexcept { return exceeded_; }
+
+  private:
+    BasicParser &p_;
+    bool exceeded_ = false;
+  };
 
   /// True if the next token is `k`.
   bool check(TokenKind k) { return peekKind() == k; }
@@ -152,17 +296,23 @@ public:
 
   // ----- Recovery-stack management (Phase 5 / US3) -----
   //
-  // Each active `RecoveryGuard` pushes one entry. `currentRecoverySet()`
-  // returns the merged union of every entry on the stack — that's the
-  // "active set" passed to `skipUntil()` on error. Per
-  // parser-recovery.contract.md "Recovery model": when an inner rule
-  // hits a token in an OUTER guard's set, the inner skipUntil() yields
-  // (peek() == that token), the inner rule unwinds, the caller's loop
-  // checks the parked token, and resumption proceeds at the outer
-  // rule's iteration boundary.
+  // Each active `RecoveryGuard` pushes one entry. The stack is a
+  // running OR: every entry already holds the union of its own set
+  // and all enclosing ones, so `currentRecoverySet()` is the top
+  // entry — O(1) regardless of nesting depth — and a pop restores the
+  // enclosing active set exactly. Per parser-recovery.contract.md
+  // "Recovery model": when an inner rule hits a token in an OUTER
+  // guard's set, the inner skipUntil() yields (peek() == that token),
+  // the inner rule unwinds, the caller's loop checks the parked
+  // token, and resumption proceeds at the outer rule's iteration
+  // boundary.
 
   /// Used by `RecoveryGuard` only (RAII push).
-  void pushRecoverySet(TokenSet s) { recovery_stack_.push_back(s); }
+  void pushRecoverySet(TokenSet s) {
+    recovery_stack_.push_back(recovery_stack_.empty()
+                                  ? s
+                                  : recovery_stack_.back() | s);
+  }
 
   /// Used by `RecoveryGuard` only (RAII pop).
   void popRecoverySet() noexcept {
@@ -173,14 +323,9 @@ public:
 
   /// Merged union of every guard currently on the stack. Returned by
   /// value (the bitset is small — `(tk_count + 63) / 64` 64-bit words,
-  /// i.e., a few cache lines). Determinism: traversal order is the
-  /// vector's index order, no hash-map iteration.
+  /// i.e., a few cache lines).
   [[nodiscard]] TokenSet currentRecoverySet() const noexcept {
-    TokenSet merged;
-    for (const TokenSet &s : recovery_stack_) {
-      merged |= s;
-    }
-    return merged;
+    return recovery_stack_.empty() ? TokenSet{} : recovery_stack_.back();
   }
 
   // ----- N14: line_marker consumption -----
@@ -298,16 +443,22 @@ public:
   std::unique_ptr<ast::Expr> parseExprAtPrecedence(int floor);
   /// "nud" dispatch — primary / unary / leaf.
   std::unique_ptr<ast::Expr> parseNudExpr();
-  /// Postfix tail: `[hi]`, `[hi:lo]`, `.field`, `(args)`. Wraps `head`.
-  std::unique_ptr<ast::Expr> parsePostfix(std::unique_ptr<ast::Expr> head);
+  /// Postfix tail: `[hi]`, `[hi:lo]`, `.field`, `(args)`. Wraps `head`,
+  /// which was parsed from `start` on.
+  std::unique_ptr<ast::Expr> parsePostfix(std::unique_ptr<ast::Expr> head,
+                                          const Checkpoint &start);
 
 private:
   Lexer &lex_;
   DiagnosticEngine &diag_;
-  /// Recovery stack — each `RecoveryGuard` pushes one entry. Vector
-  /// (not `std::stack`) so `currentRecoverySet()` can iterate in
-  /// deterministic index order to compute the merged union.
+  /// Recovery stack — each `RecoveryGuard` pushes one entry holding
+  /// the running union of every enclosing guard's set (see
+  /// `pushRecoverySet`).
   std::vector<TokenSet> recovery_stack_;
+  /// Live `NestingGuard` count.
+  unsigned nesting_depth_ = 0;
+  /// Ordinal `makeExpr` stamps next; 0 is `ast::Expr::kNoOrdinal`.
+  uint32_t nextExprOrdinal_ = 1;
 
   /// Side-table populated by `parseInternalDecl` when the parsed
   /// internal_declaration is a multi-declarator form (e.g.
@@ -317,16 +468,19 @@ private:
   /// call. Cleared at the top of every `parseInternalDecl` invocation.
   std::vector<std::unique_ptr<ast::Decl>> pendingExtraDecls_;
 
-  /// Optional CST-mode observer (T2 Phase 2b). `nullptr` when CST
-  /// emission is disabled (the AST-only hot path). Set via
-  /// `setCSTSink()`; consumed in `consume()` and by the free-
-  /// function overload in `lib/Parse/CSTMode.cpp` that wraps the
-  /// top-level production with `beginNode`/`endNode`. Per Principle
-  /// II the sink lives above the `nsl-parse` layer; the Parser
-  /// holds only an opaque pointer to the abstract interface.
-  CSTSink *sink_ = nullptr;
+  /// CST-mode policy (T2 Phase 2b). Empty for the AST-only
+  /// instantiation; holds the `CSTSink` pointer for `CSTParser`. Per
+  /// Principle II the sink lives above the `nsl-parse` layer; the
+  /// parser holds only an opaque pointer to the abstract interface.
+  CSTPolicy cst_;
 };
 
+/// AST-only parser — the instantiation every `nslc` stage uses.
+using Parser = BasicParser<NoCSTPolicy>;
+
+/// CST-mode parser driven by the 3-arg `parseCompilationUnit`.
+using CSTParser = BasicParser<SinkCSTPolicy>;
+
 } // namespace nsl::parse
 
 #endif // NSL_LIB_PARSE_PARSERIMPL_H
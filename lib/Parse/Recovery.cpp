@@ -12,8 +12,17 @@
 //    iteration; Principle V).
 //
 //  * `RecoveryGuard` pushes / pops a single `TokenSet` entry on the
-//    parser's per-rule stack. It does NOT itself merge — merging is
-//    done at observation time by `Parser::currentRecoverySet()`.
+//    parser's per-rule stack. The parser ORs each pushed set into
+//    the running union at push time, so observing the active set
+//    (`Parser::currentRecoverySet()`) never walks the stack.
+//
+//  * `skipNested` is the same forward-only scan with a bracket
+//    counter, so an over-deep construct is dropped iteratively
+//    instead of through the recursion that tripped the limit.
+//
+//  * All three primitives are templated over the parser's CST policy and
+//    explicitly instantiated below for the two policies
+//    `ParserImpl.h` defines.
 
 #include "Recovery.h"
 
@@ -21,7 +30,8 @@
 
 namespace nsl::parse {
 
-TokenKind skipUntil(Parser &p, TokenSet set) {
+template <typename CSTPolicy>
+TokenKind skipUntil(BasicParser<CSTPolicy> &p, TokenSet set) {
   for (;;) {
     const TokenKind k = p.peekKind();
     if (k == TokenKind::tk_eof) {
@@ -34,12 +44,59 @@ TokenKind skipUntil(Parser &p, TokenSet set) {
   }
 }
 
-RecoveryGuard::RecoveryGuard(Parser &p, TokenSet local) noexcept : p_(p) {
+template <typename CSTPolicy> void skipNested(BasicParser<CSTPolicy> &p) {
+  unsigned depth = 0;
+  for (;;) {
+    switch (p.peekKind()) {
+    case TokenKind::tk_eof:
+      return;
+    case TokenKind::tk_lbrace:
+    case TokenKind::tk_dot_lbrace:
+    case TokenKind::tk_lparen:
+    case TokenKind::tk_lbracket:
+      ++depth;
+      break;
+    case TokenKind::tk_rbrace:
+    case TokenKind::tk_rparen:
+    case TokenKind::tk_rbracket:
+      if (depth == 0) {
+        return;
+      }
+      if (--depth == 0) {
+        p.consume();
+        return;
+      }
+      break;
+    case TokenKind::tk_semicolon:
+    case TokenKind::tk_comma:
+      if (depth == 0) {
+        return;
+      }
+      break;
+    default:
+      break;
+    }
+    p.consume();
+  }
+}
+
+template <typename CSTPolicy>
+RecoveryGuard<CSTPolicy>::RecoveryGuard(BasicParser<CSTPolicy> &p,
+                                        TokenSet local) noexcept
+    : p_(p) {
   p_.pushRecoverySet(local);
 }
 
-RecoveryGuard::~RecoveryGuard() noexcept {
+template <typename CSTPolicy>
+RecoveryGuard<CSTPolicy>::~RecoveryGuard() noexcept {
   p_.popRecoverySet();
 }
 
+template TokenKind skipUntil(Parser &p, TokenSet set);
+template TokenKind skipUntil(CSTParser &p, TokenSet set);
+template void skipNested(Parser &p);
+template void skipNested(CSTParser &p);
+template class RecoveryGuard<NoCSTPolicy>;
+template class RecoveryGuard<SinkCSTPolicy>;
+
 } // namespace nsl::parse
@@ -33,7 +33,7 @@
 
 namespace nsl::parse {
 
-class Parser;
+template <typename CSTPolicy> class BasicParser;
 
 /// Constexpr-friendly bitset over `nsl::TokenKind`. Size is computed
 /// from `tk_count` (the trailing sentinel in `TokenKind`); each bit
@@ -74,8 +74,8 @@ public:
     return (words_[idx / 64U] & (uint64_t{1} << (idx % 64U))) != 0U;
   }
 
-  /// Set union — used at runtime by `Parser::currentRecoverySet()` to
-  /// merge a stack of nested per-rule sets. The result represents
+  /// Set union — used at runtime by `Parser::pushRecoverySet()` to
+  /// extend the running union of nested per-rule sets. The result represents
   /// "tokens at which ANY enclosing rule wants to resume": when an
   /// inner rule's recovery hits one of these, control unwinds to the
   /// rule that owns it.
@@ -94,6 +94,27 @@ public:
     return *this;
   }
 
+  /// True iff every member of `*this` is also a member of `other`.
+  /// Used by the compile-time drift checks below, which hold each
+  /// hand-written recovery set against the grammar's FIRST/FOLLOW.
+  [[nodiscard]] constexpr bool isSubsetOf(TokenSet other) const noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      if ((words_[i] & ~other.words_[i]) != 0U) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr bool operator==(TokenSet other) const noexcept {
+    for (std::size_t i = 0; i < kWords; ++i) {
+      if (words_[i] != other.words_[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
 private:
   std::array<uint64_t, kWords> words_;
 };
@@ -106,21 +127,35 @@ private:
 /// The recovery token is NOT consumed — the caller's loop or the
 /// rule that owns the set is responsible for deciding whether to
 /// consume a `;` (rule-local resync) or leave a `}` / item-keyword
-/// in place (block close / next-iteration dispatch).
-TokenKind skipUntil(Parser &p, TokenSet set);
+/// in place (block close / next-iteration dispatch). Skipped tokens
+/// still flow through `consume()`, so CST mode stays lossless.
+template <typename CSTPolicy>
+TokenKind skipUntil(BasicParser<CSTPolicy> &p, TokenSet set);
+
+/// Consume one bracket-balanced token run: everything up to the
+/// first `;` or `,` at bracket depth zero (left in place), or through
+/// the closer that returns the depth to zero after an opener. Stops
+/// at an unmatched closer (it belongs to an enclosing rule) or
+/// `tk_eof`. Used to drop a construct that nests past
+/// `kMaxNestingDepth` without recursing into it.
+template <typename CSTPolicy> void skipNested(BasicParser<CSTPolicy> &p);
 
 /// RAII helper: at construction, pushes `local` onto
-/// `Parser::recovery_stack_` (combined with the existing top of stack
-/// to form the new "active set"). At destruction, pops the entry.
+/// `Parser::recovery_stack_` (OR-ed with the existing top of stack to
+/// form the new "active set"). At destruction, pops the entry, which
+/// restores the enclosing active set exactly.
 ///
 /// Per parser-recovery.contract.md the merged "active set" is the
 /// UNION of every `RecoveryGuard` currently on the stack — when an
 /// inner rule's recovery hits a token belonging to an OUTER guard,
 /// the inner skipUntil() yields, control returns to the inner rule's
 /// caller, which sees a parked recovery token and unwinds further.
-class RecoveryGuard {
+///
+/// Templated over the parser's CST policy; class-template argument
+/// deduction keeps the call sites as `RecoveryGuard guard(*this, set)`.
+template <typename CSTPolicy> class RecoveryGuard {
 public:
-  RecoveryGuard(Parser &p, TokenSet local) noexcept;
+  RecoveryGuard(BasicParser<CSTPolicy> &p, TokenSet local) noexcept;
   ~RecoveryGuard() noexcept;
 
   RecoveryGuard(const RecoveryGuard &) = delete;
@@ -129,7 +164,7 @@ public:
   RecoveryGuard &operator=(RecoveryGuard &&) = delete;
 
 private:
-  Parser &p_;
+  BasicParser<CSTPolicy> &p_;
 };
 
 // ---------- Recovery sets (per parser-recovery.contract.md
@@ -188,6 +223,56 @@ inline constexpr TokenSet kSeqItem{
 
 } // namespace recovery_sets
 
+// ---------- Grammar FIRST/FOLLOW sets. `GrammarSets.inc` is generated
+// at build time from `docs/spec/nsl_lang.ebnf` by
+// `scripts/gen_first_follow.py` (see lib/Parse/CMakeLists.txt); each
+// row becomes `grammar::first::<rule>` / `grammar::follow::<rule>`,
+// named after the EBNF production.
+namespace grammar {
+namespace first {
+#define NSL_FIRST(rule, ...) inline constexpr TokenSet rule{__VA_ARGS__};
+#define NSL_FOLLOW(rule, ...)
+#include "GrammarSets.inc"
+#undef NSL_FOLLOW
+#undef NSL_FIRST
+} // namespace first
+namespace follow {
+#define NSL_FIRST(rule, ...)
+#define NSL_FOLLOW(rule, ...) inline constexpr TokenSet rule{__VA_ARGS__};
+#include "GrammarSets.inc"
+#undef NSL_FOLLOW
+#undef NSL_FIRST
+} // namespace follow
+} // namespace grammar
+
+// ---------- Drift checks. A recovery set may only name tokens that
+// can start the item (FIRST), legitimately follow it (FOLLOW), or the
+// `;` separator at which a rule resynchronises. `#line` markers are
+// dropped by every item loop (N14) and EOF always terminates
+// `skipUntil`, so neither needs to appear in a hand-written set.
+namespace recovery_sets {
+
+inline constexpr TokenSet kSemi{TokenKind::tk_semicolon};
+inline constexpr TokenSet kSeamAndEof{TokenKind::tk_line_directive,
+                                      TokenKind::tk_eof};
+
+static_assert(kTopLevel.isSubsetOf(grammar::first::top_level_item |
+                                   kSeamAndEof) &&
+                  grammar::first::top_level_item.isSubsetOf(kTopLevel |
+                                                            kSeamAndEof),
+              "kTopLevel must equal FIRST(top_level_item) ∪ {EOF}");
+static_assert(kDeclareItem.isSubsetOf(grammar::first::declare_item |
+                                      grammar::follow::declare_item | kSemi),
+              "kDeclareItem names a token outside FIRST/FOLLOW(declare_item)");
+static_assert(kModuleItem.isSubsetOf(grammar::first::module_item |
+                                     grammar::follow::module_item | kSemi),
+              "kModuleItem names a token outside FIRST/FOLLOW(module_item)");
+static_assert(kSeqItem.isSubsetOf(grammar::first::seq_block_item |
+                                  grammar::follow::seq_block_item | kSemi),
+              "kSeqItem names a token outside FIRST/FOLLOW(seq_block_item)");
+
+} // namespace recovery_sets
+
 } // namespace nsl::parse
 
 #endif // NSL_LIB_PARSE_RECOVERY_H
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/ConstantEvaluator.cpp — constant folding for width
+// inference. See ConstantEvaluator.h.
+
+#include "ConstantEvaluator.h"
+
+#include "nsl/AST/BinaryExpr.h"
+#include "nsl/AST/ConditionalExpr.h"
+#include "nsl/AST/Expr.h"
+#include "nsl/AST/IdentifierExpr.h"
+#include "nsl/AST/LiteralExpr.h"
+#include "nsl/AST/UnaryExpr.h"
+#include "nsl/Sema/Sema.h"
+#include "nsl/Sema/SymbolTable.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace nsl::sema {
+
+namespace {
+
+/// Shift amounts beyond this do not fold; no hardware width gets
+/// near it, and it keeps a stray `1 << N` from allocating N bits.
+constexpr uint64_t kMaxShift = 1U << 16U;
+
+/// `v` narrowed to its active bits; zero is one bit wide.
+llvm::APInt trim(const llvm::APInt &v) {
+  return v.trunc(std::max(v.getActiveBits(), 1U));
+}
+
+llvm::APInt fromBool(bool b) { return llvm::APInt(1, b ? 1 : 0); }
+
+/// Value of a numeric literal spelling: `123`, `1_000`, `0xFF`,
+/// `0b101`, or sized `<w>'<b|o|d|h><digits>` (truncated to `w` bits).
+std::optional<llvm::APInt> literalValue(const ast::LiteralExpr &lit) {
+  if (lit.litKind() == ast::LiteralExpr::Lit::String || lit.flags() != 0) {
+    return std::nullopt;
+  }
+  llvm::StringRef s = lit.spelling();
+  unsigned radix = 10;
+  unsigned sized = 0;
+  const std::size_t apos = s.find('\'');
+  if (apos != llvm::StringRef::npos) {
+    llvm::SmallString<16> w;
+    for (char c : s.take_front(apos)) {
+      if (c != '_') {
+        w.push_back(c);
+      }
+    }
+    if (llvm::StringRef(w).getAsInteger(10, sized) || sized == 0) {
+      return std::nullopt;
+    }
+    s = s.drop_front(apos + 1);
+    switch (s.empty() ? '\0' : s.front()) {
+    case 'b':
+    case 'B':
+      radix = 2;
+      break;
+    case 'o':
+    case 'O':
+      radix = 8;
+      break;
+    case 'd':
+    case 'D':
+      radix = 10;
+      break;
+    case 'h':
+    case 'H':
+      radix = 16;
+      break;
+    default:
+      return std::nullopt;
+    }
+    s = s.drop_front();
+  } else if (s.size() > 2 && s[0] == '0' &&
+             (s[1] == 'x' || s[1] == 'X' || s[1] == 'b' || s[1] == 'B')) {
+    radix = (s[1] == 'x' || s[1] == 'X') ? 16 : 2;
+    s = s.drop_front(2);
+  }
+  llvm::SmallString<32> digits;
+  for (char c : s) {
+    if (c != '_') {
+      digits.push_back(c);
+    }
+  }
+  llvm::APInt v;
+  if (digits.empty() || llvm::StringRef(digits).getAsInteger(radix, v)) {
+    return std::nullopt;
+  }
+  if (sized != 0) {
+    v = v.zextOrTrunc(sized);
+  }
+  return trim(v);
+}
+
+std::optional<llvm::APInt> unary(ast::UnaryExpr::Op op, llvm::APInt v) {
+  switch (op) {
+  case ast::UnaryExpr::Op::Plus:
+    return v;
+  case ast::UnaryExpr::Op::Neg:
+    // Only `-0` stays non-negative.
+    if (!v.isZero()) {
+      return std::nullopt;
+    }
+    return v;
+  case ast::UnaryExpr::Op::BitNot:
+    return trim(~v);
+  case ast::UnaryExpr::Op::LogicalNot:
+    return fromBool(v.isZero());
+  case ast::UnaryExpr::Op::ReduceAnd:
+    return fromBool(v.isAllOnes());
+  case ast::UnaryExpr::Op::ReduceOr:
+    return fromBool(!v.isZero());
+  case ast::UnaryExpr::Op::ReduceXor:
+    return fromBool((v.countPopulation() & 1U) != 0U);
+  }
+  return std::nullopt;
+}
+
+std::optional<llvm::APInt> binary(ast::BinaryExpr::Op op, llvm::APInt a,
+                                  llvm::APInt b) {
+  using Op = ast::BinaryExpr::Op;
+  const unsigned wa = a.getBitWidth();
+  const unsigned wb = b.getBitWidth();
+  if (op == Op::Mul) {
+    return trim(a.zext(wa + wb) * b.zext(wa + wb));
+  }
+  if (op == Op::ShiftLeft || op == Op::ShiftRight) {
+    if (b.getActiveBits() > 32 || b.getZExtValue() > kMaxShift) {
+      return std::nullopt;
+    }
+    const auto amount = static_cast<unsigned>(b.getZExtValue());
+    if (op == Op::ShiftLeft) {
+      return trim(a.zext(wa + amount).shl(amount));
+    }
+    return trim(amount >= wa ? llvm::APInt(1, 0) : a.lshr(amount));
+  }
+  // Everything else works at the wider operand's width, plus a carry
+  // bit for `+`.
+  const unsigned w = std::max(wa, wb) + (op == Op::Add ? 1U : 0U);
+  a = a.zext(w);
+  b = b.zext(w);
+  switch (op) {
+  case Op::Add:
+    return trim(a + b);
+  case Op::Sub:
+    if (a.ult(b)) {
+      return std::nullopt;
+    }
+    return trim(a - b);
+  case Op::Div:
+  case Op::Mod:
+    if (b.isZero()) {
+      return std::nullopt;
+    }
+    return trim(op == Op::Div ? a.udiv(b) : a.urem(b));
+  case Op::BitAnd:
+    return trim(a & b);
+  case Op::BitOr:
+    return trim(a | b);
+  case Op::BitXor:
+    return trim(a ^ b);
+  case Op::Equal:
+    return fromBool(a == b);
+  case Op::NotEqual:
+    return fromBool(a != b);
+  case Op::Less:
+    return fromBool(a.ult(b));
+  case Op::LessEqual:
+    return fromBool(a.ule(b));
+  case Op::Greater:
+    return fromBool(a.ugt(b));
+  case Op::GreaterEqual:
+    return fromBool(a.uge(b));
+  case Op::LogicalAnd:
+    return fromBool(!a.isZero() && !b.isZero());
+  case Op::LogicalOr:
+    return fromBool(!a.isZero() || !b.isZero());
+  default:
+    return std::nullopt;
+  }
+}
+
+} // namespace
+
+std::optional<llvm::APInt> ConstantEvaluator::evaluate(const ast::Expr &e) {
+  if (const llvm::APInt *v = constants_.lookup(e)) {
+    return *v;
+  }
+  std::optional<llvm::APInt> v = fold(e);
+  if (v) {
+    constants_.record(e, *v);
+  }
+  return v;
+}
+
+void ConstantEvaluator::bindParam(const Symbol &param, const ast::Expr *init) {
+  if (init == nullptr) {
+    return;
+  }
+  if (std::optional<llvm::APInt> v = evaluate(*init)) {
+    params_.try_emplace(&param, std::move(*v));
+  }
+}
+
+void ConstantEvaluator::bindParam(const Symbol &param,
+                                  const llvm::APInt &value) {
+  params_.try_emplace(&param, trim(value));
+}
+
+uint64_t ConstantEvaluator::width(const ast::Expr *e) {
+  if (e == nullptr) {
+    return 0;
+  }
+  evaluate(*e);
+  return constants_.width(e).value_or(0);
+}
+
+std::optional<llvm::APInt> ConstantEvaluator::fold(const ast::Expr &e) {
+  switch (e.kind()) {
+  case ast::NodeKind::NK_LiteralExpr:
+    return literalValue(static_cast<const ast::LiteralExpr &>(e));
+  case ast::NodeKind::NK_IdentifierExpr: {
+    const auto &id = static_cast<const ast::IdentifierExpr &>(e);
+    if (id.name().parts.size() != 1) {
+      return std::nullopt;
+    }
+    const Symbol *sym = symbols_.lookup(id.name().parts.front());
+    auto it = sym != nullptr ? params_.find(sym) : params_.end();
+    if (it == params_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+  case ast::NodeKind::NK_UnaryExpr: {
+    const auto &u = static_cast<const ast::UnaryExpr &>(e);
+    std::optional<llvm::APInt> v = u.sub() ? evaluate(*u.sub()) : std::nullopt;
+    return v ? unary(u.op(), *v) : std::nullopt;
+  }
+  case ast::NodeKind::NK_BinaryExpr: {
+    const auto &b = static_cast<const ast::BinaryExpr &>(e);
+    if (!b.lhs() || !b.rhs()) {
+      return std::nullopt;
+    }
+    std::optional<llvm::APInt> l = evaluate(*b.lhs());
+    std::optional<llvm::APInt> r = evaluate(*b.rhs());
+    return l && r ? binary(b.op(), *l, *r) : std::nullopt;
+  }
+  case ast::NodeKind::NK_ConditionalExpr: {
+    const auto &c = static_cast<const ast::ConditionalExpr &>(e);
+    if (!c.cond() || !c.thenE() || !c.elseE()) {
+      return std::nullopt;
+    }
+    std::optional<llvm::APInt> cond = evaluate(*c.cond());
+    if (!cond) {
+      return std::nullopt;
+    }
+    return evaluate(cond->isZero() ? *c.elseE() : *c.thenE());
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+} // namespace nsl::sema
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/ConstantEvaluator.h — private impl header for the
+// constant-expression folder behind width inference. NOT a public
+// header; lives under `lib/Sema/` per the `sema-api.contract.md`
+// Invariant 1 freeze on `include/nsl/Sema/`.
+//
+// The resolution pass folds the expressions that must be constant —
+// declared widths and depths, `'(...)` extension widths, repeat
+// counts, slice bounds — so `reg r[W*2]` or `x[W-1:0]` get a real
+// width instead of the 1-bit fallback. Arithmetic is on unsigned
+// `llvm::APInt`s, so no width or intermediate value can overflow.
+//
+// A name folds when it resolves, in the scope being walked, to a
+// `param_int` whose initialiser folded where it was declared. Each
+// initialiser is folded once, at its declaration; declarations only
+// see earlier names, so parameters cannot form a cycle.
+
+#ifndef NSL_SEMA_CONSTANT_EVALUATOR_H
+#define NSL_SEMA_CONSTANT_EVALUATOR_H
+
+#include "llvm/ADT/APInt.h"
+#include "llvm/ADT/DenseMap.h"
+
+#include <optional>
+
+namespace nsl::ast {
+class Expr;
+} // namespace nsl::ast
+
+namespace nsl::sema {
+
+class ConstantTable;
+class Symbol;
+class SymbolTable;
+
+class ConstantEvaluator {
+public:
+  /// Names are looked up in `symbols`' current scope; every folded
+  /// expression is memoised in `constants`.
+  ConstantEvaluator(const SymbolTable &symbols, ConstantTable &constants)
+      : symbols_(symbols), constants_(constants) {}
+
+  /// Unsigned value of `e`, trimmed to its active bits (at least
+  /// one), or nullopt when `e` is not a constant: it names something
+  /// other than a folded `param_int`, holds a Z/X/U digit, divides by
+  /// zero, or goes negative.
+  std::optional<llvm::APInt> evaluate(const ast::Expr &e);
+
+  /// Fold `init` now, in the scope declaring `param`, and bind the
+  /// result to `param` for later references. A null or non-constant
+  /// `init` leaves `param` unfoldable.
+  void bindParam(const Symbol &param, const ast::Expr *init);
+
+  /// Bind `param` to an already-folded `value` (a parameter imported
+  /// from an `InterfaceSummary`).
+  void bindParam(const Symbol &param, const llvm::APInt &value);
+
+  /// `evaluate(*e)` as a width: 0 when `e` is null or does not fold
+  /// to a non-zero value that fits in 64 bits.
+  uint64_t width(const ast::Expr *e);
+
+private:
+  std::optional<llvm::APInt> fold(const ast::Expr &e);
+
+  const SymbolTable &symbols_;
+  ConstantTable &constants_;
+  /// Folded `param_int` values, by declaring symbol.
+  llvm::DenseMap<const Symbol *, llvm::APInt> params_;
+};
+
+} // namespace nsl::sema
+
+#endif // NSL_SEMA_CONSTANT_EVALUATOR_H
@@ -4,9 +4,43 @@
 // Each S<NN>_*.cpp self-registers via NSL_REGISTER_CONSTRAINT at
 // static-init time. The fan-out happens in Sn-numeric order at the
 // end of Sema::run() (orchestrated from Sema.cpp).
+//
+// Fused walk: `FusedWalker` mirrors `detail::walkDecl` /
+// `detail::walkStmt` node for node (same order, same LexCtx bits),
+// so a fused checker sees exactly the event sequence its own walkUnit
+// callback used to. Each fused checker reports into a private
+// DiagnosticEngine; once the traversal is done the buffers are
+// replayed into ctx.diag in Sn order, interleaved with the run()-only
+// visitors, which reproduces the unfused emission order exactly.
+//
+// The traversal is sharded over contiguous runs of top-level items;
+// every shard has its own checkers and buffers, so the workers share
+// nothing mutable. Shards run on one process-wide pool; a single
+// shard runs inline on the calling thread. Per Sn, the shards' traversal output is merged in
+// source order, followed by their finish() output in source order.
+//
+// The per-item path is the same merge with one shard per top-level
+// item, run on the calling thread, whose buffers outlive the call so
+// SemaCache can hand them back in on the next run.
+//
+// With `ctx.stats` set, every call into a checker (makeFused, each
+// hook, finish, run) is timed and charged to its Sn. Shards time into
+// their own accumulators, summed once the workers are done.
 
 #include "ConstraintCheckRegistry.h"
 
+#include "Constraints/ConstraintHelpers.h"
+#include "SemaTimer.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Sema/Sema.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/ThreadPool.h"
+#include "llvm/Support/Threading.h"
+
+#include <algorithm>
+#include <array>
 #include <map>
 #include <memory>
 #include <utility>
@@ -14,8 +48,33 @@
 
 namespace nsl::sema {
 
+FusedCheck::~FusedCheck() = default;
+void FusedCheck::onDecl(const ast::Decl &, const FusedCursor &) {}
+void FusedCheck::onStmt(const ast::Stmt &, const FusedCursor &) {}
+void FusedCheck::finish() {}
+
 ConstraintVisitor::~ConstraintVisitor() = default;
 
+std::unique_ptr<FusedCheck>
+ConstraintVisitor::makeFused(const ConstraintContext &) const {
+  return nullptr;
+}
+
+llvm::hash_code
+ConstraintVisitor::crossItemKey(const ConstraintContext &) const {
+  return llvm::hash_code(0);
+}
+
+llvm::ArrayRef<std::unique_ptr<ast::Decl>> ConstraintContext::items() const {
+  if (unit == nullptr) {
+    return {};
+  }
+  llvm::ArrayRef<std::unique_ptr<ast::Decl>> all(unit->items());
+  const std::size_t end = std::min(itemEnd, all.size());
+  const std::size_t begin = std::min(itemBegin, end);
+  return all.slice(begin, end - begin);
+}
+
 namespace {
 
 // File-static registry keyed by Sn-number. std::map is iteration-
@@ -27,8 +86,342 @@ registry() {
   return r;
 }
 
+/// The workers the sharded walk runs on. Created on first use and
+/// kept for the life of the process, so repeated Sema runs (each LSP
+/// re-check) do not spawn and join a thread set every time.
+llvm::DefaultThreadPool &shardPool() {
+  static llvm::DefaultThreadPool pool(llvm::hardware_concurrency());
+  return pool;
+}
+
+/// Every registered visitor, in Sn order.
+std::vector<const ConstraintVisitor *> registeredVisitors() {
+  std::vector<const ConstraintVisitor *> out;
+  for (const auto &kv : registry()) {
+    for (const auto &v : kv.second) {
+      out.push_back(v.get());
+    }
+  }
+  return out;
+}
+
+/// The Sn of each of registeredVisitors(), in the same order.
+std::vector<unsigned> registeredSns() {
+  std::vector<unsigned> out;
+  for (const auto &kv : registry()) {
+    out.insert(out.end(), kv.second.size(), kv.first);
+  }
+  return out;
+}
+
+/// Per-visitor accumulators of one run's constraint statistics,
+/// indexed like registeredVisitors(); empty when not collecting.
+struct VisitorStats {
+  std::vector<double> seconds;
+  std::vector<std::size_t> diagnostics;
+
+  explicit VisitorStats(const ConstraintContext &ctx, std::size_t visitors) {
+    if (ctx.stats != nullptr) {
+      seconds.resize(visitors);
+      diagnostics.resize(visitors);
+    }
+  }
+
+  /// Accumulator for visitor `v`, or null when not collecting.
+  double *time(std::size_t v) {
+    return seconds.empty() ? nullptr : &seconds[v];
+  }
+
+  /// Add everything accumulated to `stats`, per Sn.
+  void commit(SemaStatistics *stats) const {
+    if (stats == nullptr || seconds.empty()) {
+      return;
+    }
+    const std::vector<unsigned> sns = registeredSns();
+    for (std::size_t v = 0; v < sns.size(); ++v) {
+      SemaStatistics::Constraint &c = stats->constraint(sns[v]);
+      c.seconds += seconds[v];
+      c.diagnostics += diagnostics[v];
+    }
+  }
+};
+
+/// Below this many top-level items per shard, spinning up workers
+/// costs more than the traversal they would share.
+constexpr std::size_t kMinItemsPerShard = 8;
+
+/// One traversal of the unit, dispatching each node to the fused
+/// checkers that registered its kind (in registration = Sn order).
+class FusedWalker {
+public:
+  /// Add `c`; with `seconds`, the time spent in its hooks is added to
+  /// `*seconds`.
+  void add(FusedCheck &c, double *seconds = nullptr) {
+    const NodeKindSet k = c.kinds();
+    for (std::size_t i = 0; i < k.size(); ++i) {
+      if (k.test(i)) {
+        byKind_[i].push_back(Hook{&c, seconds});
+      }
+    }
+  }
+
+  void walkDecl(const ast::Decl &d, uint32_t lex);
+  void walkStmt(const ast::Stmt &s, uint32_t lex);
+
+  template <typename Range> void walkDecls(const Range &r, uint32_t lex) {
+    for (const auto &it : r) {
+      if (it) {
+        walkDecl(*it, lex);
+      }
+    }
+  }
+
+private:
+  template <typename Range> void walkStmts(const Range &r, uint32_t lex) {
+    for (const auto &it : r) {
+      if (it) {
+        walkStmt(*it, lex);
+      }
+    }
+  }
+
+  struct Hook {
+    FusedCheck *check;
+    double *seconds;
+  };
+
+  llvm::ArrayRef<Hook> interested(ast::NodeKind k) const {
+    return byKind_[static_cast<std::size_t>(k)];
+  }
+
+  std::array<llvm::SmallVector<Hook, 4>,
+             static_cast<std::size_t>(ast::NodeKind::NK_count)>
+      byKind_;
+  FusedCursor cur_;
+};
+
+void FusedWalker::walkStmt(const ast::Stmt &s, uint32_t lex) {
+  using detail::LexCtx;
+  using detail::opOr;
+  using detail::toRaw;
+  cur_.lex = lex;
+  for (const Hook &h : interested(s.kind())) {
+    ScopedTimer timer(h.seconds);
+    h.check->onStmt(s, cur_);
+  }
+  const uint32_t action = lex | toRaw(LexCtx::InAnyAction);
+  switch (s.kind()) {
+  case ast::NodeKind::NK_SeqBlock:
+    walkStmts(static_cast<const ast::SeqBlock &>(s).items(),
+              opOr(action, LexCtx::InSeq));
+    break;
+  case ast::NodeKind::NK_ParallelBlock:
+    walkStmts(static_cast<const ast::ParallelBlock &>(s).items(),
+              opOr(action, LexCtx::InParallel));
+    break;
+  case ast::NodeKind::NK_AltBlock: {
+    const auto &n = static_cast<const ast::AltBlock &>(s);
+    const uint32_t c = opOr(action, LexCtx::InAlt);
+    for (const auto &cc : n.cases()) {
+      if (cc.body) {
+        walkStmt(*cc.body, c);
+      }
+    }
+    if (n.elseCase()) {
+      walkStmt(*n.elseCase(), c);
+    }
+    break;
+  }
+  case ast::NodeKind::NK_AnyBlock: {
+    const auto &n = static_cast<const ast::AnyBlock &>(s);
+    const uint32_t c = opOr(action, LexCtx::InAny);
+    for (const auto &cc : n.cases()) {
+      if (cc.body) {
+        walkStmt(*cc.body, c);
+      }
+    }
+    if (n.elseCase()) {
+      walkStmt(*n.elseCase(), c);
+    }
+    break;
+  }
+  case ast::NodeKind::NK_IfStmt: {
+    const auto &n = static_cast<const ast::IfStmt &>(s);
+    const uint32_t c = opOr(action, LexCtx::InIf);
+    if (n.thenBr()) {
+      walkStmt(*n.thenBr(), c);
+    }
+    if (n.elseBr()) {
+      walkStmt(*n.elseBr(), c);
+    }
+    break;
+  }
+  case ast::NodeKind::NK_WhileBlock:
+    walkStmts(static_cast<const ast::WhileBlock &>(s).items(),
+              opOr(action, LexCtx::InWhile));
+    break;
+  case ast::NodeKind::NK_ForBlock:
+    walkStmts(static_cast<const ast::ForBlock &>(s).items(),
+              opOr(action, LexCtx::InFor));
+    break;
+  case ast::NodeKind::NK_InitBlockStmt:
+    walkStmts(static_cast<const ast::InitBlockStmt &>(s).items(),
+              opOr(action, LexCtx::InInitBlock));
+    break;
+  case ast::NodeKind::NK_LabeledStmt: {
+    const auto &n = static_cast<const ast::LabeledStmt &>(s);
+    if (n.body()) {
+      walkStmt(*n.body(), action);
+    }
+    break;
+  }
+  case ast::NodeKind::NK_StructuralGenerate: {
+    const auto &n = static_cast<const ast::StructuralGenerate &>(s);
+    if (n.body()) {
+      walkStmt(*n.body(), opOr(action, LexCtx::InGenerate));
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+void FusedWalker::walkDecl(const ast::Decl &d, uint32_t lex) {
+  using detail::LexCtx;
+  using detail::toRaw;
+  cur_.lex = lex;
+  for (const Hook &h : interested(d.kind())) {
+    ScopedTimer timer(h.seconds);
+    h.check->onDecl(d, cur_);
+  }
+  switch (d.kind()) {
+  case ast::NodeKind::NK_DeclareBlock: {
+    const auto &n = static_cast<const ast::DeclareBlock &>(d);
+    walkDecls(n.headerParams(), lex);
+    walkDecls(n.ports(), lex);
+    break;
+  }
+  case ast::NodeKind::NK_ModuleBlock: {
+    const auto &n = static_cast<const ast::ModuleBlock &>(d);
+    const ast::ModuleBlock *outer = cur_.module;
+    cur_.module = &n;
+    const uint32_t c = lex | toRaw(LexCtx::InModule);
+    walkDecls(n.internals(), c);
+    walkDecls(n.funcs(), c);
+    walkDecls(n.procs(), c);
+    walkStmts(n.actions(), c);
+    cur_.module = outer;
+    break;
+  }
+  case ast::NodeKind::NK_FuncDefn: {
+    const auto &n = static_cast<const ast::FuncDefn &>(d);
+    if (n.body()) {
+      const ast::FuncDefn *outer = cur_.func;
+      cur_.func = cur_.module != nullptr ? &n : nullptr;
+      walkStmt(*n.body(), lex | toRaw(LexCtx::InFunc));
+      cur_.func = outer;
+    }
+    break;
+  }
+  case ast::NodeKind::NK_ProcDefn: {
+    const auto &n = static_cast<const ast::ProcDefn &>(d);
+    if (n.body()) {
+      walkStmt(*n.body(), lex | toRaw(LexCtx::InProc));
+    }
+    break;
+  }
+  case ast::NodeKind::NK_StateDefn: {
+    const auto &n = static_cast<const ast::StateDefn &>(d);
+    if (n.body()) {
+      walkStmt(*n.body(),
+               lex | toRaw(LexCtx::InProc) | toRaw(LexCtx::InState));
+    }
+    break;
+  }
+  default:
+    break;
+  }
+}
+
+/// Append `from`'s diagnostics [begin, end) onto `to`, in order.
+void replayDiagnostics(const DiagnosticEngine &from, std::size_t begin,
+                       std::size_t end, DiagnosticEngine &to) {
+  for (const Diagnostic &d : from.diagnostics().slice(begin, end - begin)) {
+    replayDiagnostic(d, to);
+  }
+}
+
+/// Run every visitor on `ctx`'s items alone (a one-item slice) and
+/// capture what each reports, split as ItemDiagnostics describes.
+ItemDiagnostics
+checkItem(const ConstraintContext &ctx,
+          llvm::ArrayRef<const ConstraintVisitor *> visitors,
+          VisitorStats &stats) {
+  SourceManager &sm = ctx.diag->sourceManager();
+  std::vector<std::unique_ptr<DiagnosticEngine>> buffers(visitors.size());
+  std::vector<std::unique_ptr<FusedCheck>> checks(visitors.size());
+  FusedWalker walker;
+  ConstraintContext local = ctx;
+  for (std::size_t v = 0; v < visitors.size(); ++v) {
+    ScopedTimer timer(stats.time(v));
+    buffers[v] = std::make_unique<DiagnosticEngine>(sm);
+    local.diag = buffers[v].get();
+    checks[v] = visitors[v]->makeFused(local);
+    if (checks[v]) {
+      walker.add(*checks[v], stats.time(v));
+    }
+  }
+  walker.walkDecls(ctx.items(), 0U);
+
+  ItemDiagnostics out;
+  out.walk.resize(visitors.size());
+  out.finish.resize(visitors.size());
+  for (std::size_t v = 0; v < visitors.size(); ++v) {
+    ScopedTimer timer(stats.time(v));
+    if (checks[v]) {
+      const std::size_t start = buffers[v]->diagnostics().size();
+      checks[v]->finish();
+      llvm::ArrayRef<Diagnostic> all = buffers[v]->diagnostics();
+      out.walk[v].assign(all.begin(), all.begin() + start);
+      out.finish[v].assign(all.begin() + start, all.end());
+    } else {
+      local.diag = buffers[v].get();
+      visitors[v]->run(local);
+      llvm::ArrayRef<Diagnostic> all = buffers[v]->diagnostics();
+      out.walk[v].assign(all.begin(), all.end());
+    }
+  }
+  return out;
+}
+
 } // namespace
 
+// `report()` re-derives the included-from notes, so only the other
+// notes are copied across.
+void replayDiagnostic(const Diagnostic &d, DiagnosticEngine &to) {
+  auto b = to.report(d.severity, d.loc, d.message);
+  for (const FixItHint &f : d.fixits) {
+    b.addFixIt(f.range, f.replacement);
+  }
+  for (const Diagnostic &n : d.notes) {
+    if (!n.is_include_from_note) {
+      to.appendNoteAt(to.diagnostics().size() - 1, n);
+    }
+  }
+}
+
+void ConstraintVisitor::run(const ConstraintContext &ctx) const {
+  std::unique_ptr<FusedCheck> check = makeFused(ctx);
+  if (!check || ctx.unit == nullptr) {
+    return;
+  }
+  FusedWalker walker;
+  walker.add(*check);
+  walker.walkDecls(ctx.items(), 0U);
+  check->finish();
+}
+
 void registerConstraint(unsigned sn,
                         std::unique_ptr<ConstraintVisitor> visitor) {
   if (!visitor) {
@@ -37,12 +430,192 @@ void registerConstraint(unsigned sn,
   registry()[sn].push_back(std::move(visitor));
 }
 
-void runAllConstraints(const ConstraintContext &ctx) {
-  for (const auto &kv : registry()) {
-    for (const auto &v : kv.second) {
-      v->run(ctx);
+void runAllConstraints(const ConstraintContext &ctx, unsigned threads) {
+  if (ctx.unit == nullptr || ctx.diag == nullptr) {
+    runAllConstraintsUnfused(ctx);
+    return;
+  }
+
+  const std::vector<const ConstraintVisitor *> visitors =
+      registeredVisitors();
+
+  // One shard per worker, each a contiguous run of top-level items.
+  // A shard owns one checker per fused visitor (indexed like
+  // `visitors`, null for run()-only ones) plus the private engine it
+  // reports into, and where that engine's finish() output starts.
+  struct Shard {
+    std::size_t begin;
+    std::size_t end;
+    std::vector<std::unique_ptr<DiagnosticEngine>> buffers;
+    std::vector<std::unique_ptr<FusedCheck>> checks;
+    std::vector<std::size_t> finishStart;
+    std::vector<double> seconds;
+  };
+  const auto &items = ctx.unit->items();
+  const std::size_t workers =
+      threads != 0U ? threads
+                    : llvm::hardware_concurrency().compute_thread_count();
+  const std::size_t nshards = std::max<std::size_t>(
+      1U, std::min(workers, items.size() / kMinItemsPerShard));
+  std::vector<Shard> shards(nshards);
+  for (std::size_t i = 0; i < nshards; ++i) {
+    shards[i].begin = items.size() * i / nshards;
+    shards[i].end = items.size() * (i + 1) / nshards;
+  }
+
+  SourceManager &sm = ctx.diag->sourceManager();
+  auto runShard = [&](Shard &shard) {
+    FusedWalker walker;
+    shard.buffers.resize(visitors.size());
+    shard.checks.resize(visitors.size());
+    shard.finishStart.resize(visitors.size());
+    if (ctx.stats != nullptr) {
+      shard.seconds.resize(visitors.size());
+    }
+    auto time = [&shard](std::size_t v) {
+      return shard.seconds.empty() ? nullptr : &shard.seconds[v];
+    };
+    for (std::size_t v = 0; v < visitors.size(); ++v) {
+      ScopedTimer timer(time(v));
+      shard.buffers[v] = std::make_unique<DiagnosticEngine>(sm);
+      ConstraintContext local = ctx;
+      local.diag = shard.buffers[v].get();
+      shard.checks[v] = visitors[v]->makeFused(local);
+      if (shard.checks[v]) {
+        walker.add(*shard.checks[v], time(v));
+      }
+    }
+    llvm::ArrayRef<std::unique_ptr<ast::Decl>> all(items);
+    walker.walkDecls(all.slice(shard.begin, shard.end - shard.begin), 0U);
+    for (std::size_t v = 0; v < visitors.size(); ++v) {
+      if (shard.checks[v]) {
+        ScopedTimer timer(time(v));
+        shard.finishStart[v] = shard.buffers[v]->diagnostics().size();
+        shard.checks[v]->finish();
+      }
+    }
+  };
+
+  if (nshards == 1U) {
+    runShard(shards.front());
+  } else {
+    // The engines' include-note lookup reads the line tables; build
+    // them up front so the workers only ever read the SourceManager.
+    sm.buildLineTables();
+    // A task group waits for this run's shards only; another thread
+    // may be running its own Sema on the same pool.
+    llvm::ThreadPoolTaskGroup group(shardPool());
+    for (Shard &shard : shards) {
+      group.async([&runShard, &shard] { runShard(shard); });
+    }
+    group.wait();
+  }
+
+  VisitorStats stats(ctx, visitors.size());
+  for (std::size_t v = 0; v < visitors.size(); ++v) {
+    const std::size_t before = ctx.diag->diagnostics().size();
+    if (!shards.front().checks[v]) {
+      ScopedTimer timer(stats.time(v));
+      visitors[v]->run(ctx);
+    } else {
+      for (const Shard &shard : shards) {
+        replayDiagnostics(*shard.buffers[v], 0U, shard.finishStart[v],
+                          *ctx.diag);
+      }
+      for (const Shard &shard : shards) {
+        replayDiagnostics(*shard.buffers[v], shard.finishStart[v],
+                          shard.buffers[v]->diagnostics().size(), *ctx.diag);
+      }
+      for (const Shard &shard : shards) {
+        if (double *t = stats.time(v)) {
+          *t += shard.seconds[v];
+        }
+      }
+    }
+    if (!stats.diagnostics.empty()) {
+      stats.diagnostics[v] = ctx.diag->diagnostics().size() - before;
+    }
+  }
+  stats.commit(ctx.stats);
+}
+
+void runAllConstraintsUnfused(const ConstraintContext &ctx) {
+  const std::vector<const ConstraintVisitor *> visitors =
+      registeredVisitors();
+  VisitorStats stats(ctx, visitors.size());
+  for (std::size_t v = 0; v < visitors.size(); ++v) {
+    const std::size_t before =
+        ctx.diag != nullptr ? ctx.diag->diagnostics().size() : 0U;
+    {
+      ScopedTimer timer(stats.time(v));
+      visitors[v]->run(ctx);
     }
+    if (!stats.diagnostics.empty() && ctx.diag != nullptr) {
+      stats.diagnostics[v] = ctx.diag->diagnostics().size() - before;
+    }
+  }
+  stats.commit(ctx.stats);
+}
+
+void runConstraintsByItem(const ConstraintContext &ctx,
+                          std::vector<std::optional<ItemDiagnostics>> &items) {
+  if (ctx.unit == nullptr || ctx.diag == nullptr) {
+    runAllConstraintsUnfused(ctx);
+    return;
+  }
+  const std::vector<const ConstraintVisitor *> visitors =
+      registeredVisitors();
+  VisitorStats stats(ctx, visitors.size());
+  items.resize(ctx.unit->items().size());
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (!items[i]) {
+      ConstraintContext one = ctx;
+      one.itemBegin = i;
+      one.itemEnd = i + 1;
+      items[i] = checkItem(one, visitors, stats);
+    }
+  }
+  for (std::size_t v = 0; v < visitors.size(); ++v) {
+    const std::size_t before = ctx.diag->diagnostics().size();
+    for (const std::optional<ItemDiagnostics> &item : items) {
+      for (const Diagnostic &d : item->walk[v]) {
+        replayDiagnostic(d, *ctx.diag);
+      }
+    }
+    for (const std::optional<ItemDiagnostics> &item : items) {
+      for (const Diagnostic &d : item->finish[v]) {
+        replayDiagnostic(d, *ctx.diag);
+      }
+    }
+    if (!stats.diagnostics.empty()) {
+      stats.diagnostics[v] = ctx.diag->diagnostics().size() - before;
+    }
+  }
+  stats.commit(ctx.stats);
+}
+
+ItemDiagnostics checkConstraintsForItem(const ConstraintContext &ctx,
+                                        std::size_t index) {
+  const std::vector<const ConstraintVisitor *> visitors =
+      registeredVisitors();
+  VisitorStats stats(ctx, visitors.size());
+  ConstraintContext one = ctx;
+  one.itemBegin = index;
+  one.itemEnd = index + 1;
+  ItemDiagnostics out = checkItem(one, visitors, stats);
+  for (std::size_t v = 0; v < stats.diagnostics.size(); ++v) {
+    stats.diagnostics[v] = out.walk[v].size() + out.finish[v].size();
+  }
+  stats.commit(ctx.stats);
+  return out;
+}
+
+llvm::hash_code crossItemKey(const ConstraintContext &ctx) {
+  llvm::hash_code h(0);
+  for (const ConstraintVisitor *v : registeredVisitors()) {
+    h = llvm::hash_combine(h, v->crossItemKey(ctx));
   }
+  return h;
 }
 
 } // namespace nsl::sema
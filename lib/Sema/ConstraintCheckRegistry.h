@@ -13,26 +13,57 @@
 // run() on each visitor.
 //
 // Pattern is LLVM INITIALIZE_PASS / libtooling check registries.
+//
+// Fused walk: a checker whose rule is a per-node test over the
+// `walkDecl` / `walkStmt` traversal (ConstraintHelpers.h) overrides
+// makeFused() instead of run(). runAllConstraints() then drives every
+// fused checker from ONE shared traversal, dispatching each node only
+// to the checkers that registered its NodeKind, and replays their
+// diagnostics in Sn order so the output is identical to running each
+// checker on its own walk.
+//
+// Sharding: the top-level items are split into contiguous shards, one
+// per worker thread, and each shard gets its own set of fused checkers
+// and diagnostic buffers. The buffers are merged per Sn in shard
+// (= source) order, so the result does not depend on the thread count.
+//
+// Per-item runs: runConstraintsByItem() checks each top-level item on
+// its own and keeps its diagnostics apart, so SemaCache can reuse an
+// unchanged module's output on the next run and LazySema can check
+// only the modules asked about. A checker whose output for one item
+// reads other items folds that state into crossItemKey().
 
 #ifndef NSL_SEMA_CONSTRAINT_CHECK_REGISTRY_H
 #define NSL_SEMA_CONSTRAINT_CHECK_REGISTRY_H
 
+#include "nsl/AST/NodeKind.h"
+#include "nsl/Basic/Diagnostic.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Hashing.h"
+
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <initializer_list>
 #include <memory>
-
-namespace nsl {
-class DiagnosticEngine;
-} // namespace nsl
+#include <optional>
+#include <vector>
 
 namespace nsl::ast {
 class CompilationUnit;
+class Decl;
+class FuncDefn;
+class ModuleBlock;
+class Stmt;
 } // namespace nsl::ast
 
 namespace nsl::sema {
 
 class SymbolTable;
 class TypeSystem;
-struct ResolutionMap;
+class ResolutionTable;
+struct SemaStatistics;
 
 /// Aggregates the post-resolution context every per-Sn checker
 /// reads. Passed by const-ref to ConstraintVisitor::run() so
@@ -41,13 +72,70 @@ struct ConstraintContext {
   const ast::CompilationUnit *unit;
   SymbolTable *symbols;
   TypeSystem *types;
-  const ResolutionMap *resolutions;
+  const ResolutionTable *resolutions;
   DiagnosticEngine *diag;
+  /// The top-level items [itemBegin, itemEnd) a run()-only checker
+  /// looks at; the whole unit unless runConstraintsByItem() narrows
+  /// it. Fused checkers are handed their items by the traversal.
+  std::size_t itemBegin = 0;
+  std::size_t itemEnd = SIZE_MAX;
+  /// When set, each `Sn`'s time and diagnostic count are added to it.
+  SemaStatistics *stats = nullptr;
+
+  /// `unit->items()` clipped to [itemBegin, itemEnd).
+  [[nodiscard]] llvm::ArrayRef<std::unique_ptr<ast::Decl>> items() const;
+};
+
+/// Set of node kinds a fused checker wants to see.
+using NodeKindSet =
+    std::bitset<static_cast<std::size_t>(ast::NodeKind::NK_count)>;
+
+/// `{k1, k2, ...}` as a NodeKindSet.
+inline NodeKindSet nodeKinds(std::initializer_list<ast::NodeKind> ks) {
+  NodeKindSet out;
+  for (ast::NodeKind k : ks) {
+    out.set(static_cast<std::size_t>(k));
+  }
+  return out;
+}
+
+/// Position of the shared traversal, handed to every fused hook.
+struct FusedCursor {
+  /// `detail::LexCtx` bits of the node, exactly as `walkDecl` /
+  /// `walkStmt` would pass them.
+  uint32_t lex = 0U;
+  /// Enclosing `module` block, or null outside one.
+  const ast::ModuleBlock *module = nullptr;
+  /// Enclosing `func` definition of that module, or null.
+  const ast::FuncDefn *func = nullptr;
+};
+
+/// Per-run state of one checker on the fused walk. Created by
+/// ConstraintVisitor::makeFused() once per shard and discarded after
+/// finish(). Shards run concurrently: a checker sees only its shard's
+/// top-level items and may read, but never write, shared state.
+class FusedCheck {
+public:
+  FusedCheck() = default;
+  virtual ~FusedCheck();
+  FusedCheck(const FusedCheck &) = delete;
+  FusedCheck &operator=(const FusedCheck &) = delete;
+  FusedCheck(FusedCheck &&) = delete;
+  FusedCheck &operator=(FusedCheck &&) = delete;
+
+  /// Node kinds routed to onDecl() / onStmt().
+  [[nodiscard]] virtual NodeKindSet kinds() const = 0;
+  virtual void onDecl(const ast::Decl &d, const FusedCursor &cur);
+  virtual void onStmt(const ast::Stmt &s, const FusedCursor &cur);
+  /// After the shard's traversal; emit anything held back for
+  /// ordering. What finish() reports is merged after the traversal
+  /// diagnostics of every shard.
+  virtual void finish();
 };
 
 /// Abstract base for every per-Sn checker. Each S<NN>_*.cpp ships
-/// a private subclass implementing run() and self-registers at
-/// static-init time.
+/// a private subclass implementing run() — or makeFused() — and
+/// self-registers at static-init time.
 class ConstraintVisitor {
 public:
   ConstraintVisitor() = default;
@@ -58,8 +146,32 @@ public:
   ConstraintVisitor &operator=(ConstraintVisitor &&) = delete;
 
   /// Walk ctx.unit and emit any S<NN> violations to ctx.diag.
-  /// MUST be deterministic (Principle V) and idempotent.
-  virtual void run(const ConstraintContext &ctx) const = 0;
+  /// MUST be deterministic (Principle V) and idempotent. The default
+  /// drives makeFused()'s checker over a traversal of its own.
+  virtual void run(const ConstraintContext &ctx) const;
+
+  /// Opt into the fused walk: return this run's checker, reporting
+  /// into ctx.diag. Null (the default) keeps the visitor on run().
+  /// A fused checker runs before every run()-only visitor, so it
+  /// must not read state another constraint mutates (S18's struct
+  /// re-packing is the only such mutation, and S18 is not fused).
+  [[nodiscard]] virtual std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const;
+
+  /// Hash of whatever this checker reads from outside the item it is
+  /// reporting on, beyond the non-module items and the `Global`-
+  /// scope bindings (SemaCache keys on those already). Two units with equal keys must produce the same
+  /// diagnostics for a textually equal item. Default: 0, nothing.
+  [[nodiscard]] virtual llvm::hash_code
+  crossItemKey(const ConstraintContext &ctx) const;
+};
+
+/// Diagnostics one top-level item produced on its own, per visitor
+/// in registry order: what it reported during the traversal (or
+/// run()), then what its fused checker's finish() reported.
+struct ItemDiagnostics {
+  std::vector<std::vector<Diagnostic>> walk;
+  std::vector<std::vector<Diagnostic>> finish;
 };
 
 /// Register visitor to fire on S<sn>. Lower sn runs first
@@ -68,9 +180,37 @@ public:
 void registerConstraint(unsigned sn,
                         std::unique_ptr<ConstraintVisitor> visitor);
 
-/// Run every registered constraint visitor in Sn-numeric order
-/// against ctx. Called by Sema::runConstraintPasses.
-void runAllConstraints(const ConstraintContext &ctx);
+/// Run every registered constraint visitor against ctx: the fused
+/// checkers share one traversal, sharded over up to `threads` workers
+/// (0 = hardware concurrency), then each visitor's diagnostics land
+/// in Sn-numeric order. Called by Sema::runConstraintPasses.
+void runAllConstraints(const ConstraintContext &ctx, unsigned threads = 0);
+
+/// Reference path: call run() on every visitor in Sn-numeric order,
+/// one traversal per fused checker. Same diagnostics, same order as
+/// runAllConstraints(); kept for equivalence tests and benchmarks.
+void runAllConstraintsUnfused(const ConstraintContext &ctx);
+
+/// Per-item path for SemaCache: check every item whose slot in
+/// `items` is empty on its own and fill the slot, then replay all
+/// slots into ctx.diag in the order runAllConstraints() emits them.
+/// `items` is resized to one slot per top-level item; filled slots
+/// must hold diagnostics located in this unit.
+void runConstraintsByItem(const ConstraintContext &ctx,
+                          std::vector<std::optional<ItemDiagnostics>> &items);
+
+/// Check top-level item `index` of ctx.unit on its own, as
+/// runConstraintsByItem() does for an empty slot, and return what it
+/// reports; nothing goes into ctx.diag, which only supplies the
+/// SourceManager.
+ItemDiagnostics checkConstraintsForItem(const ConstraintContext &ctx,
+                                        std::size_t index);
+
+/// Append `d` onto `to`, as if it had been reported there.
+void replayDiagnostic(const Diagnostic &d, DiagnosticEngine &to);
+
+/// Combined crossItemKey() of every registered visitor.
+[[nodiscard]] llvm::hash_code crossItemKey(const ConstraintContext &ctx);
 
 /// Self-registration helper. Each S<NN>_*.cpp writes:
 ///   namespace nsl::sema { namespace {
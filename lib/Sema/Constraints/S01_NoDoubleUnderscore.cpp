@@ -322,7 +322,7 @@ public:
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
       return;
     }
-    for (const auto &item : ctx.unit->items()) {
+    for (const auto &item : ctx.items()) {
       if (item) {
         checkDecl(*item, *ctx.diag);
       }
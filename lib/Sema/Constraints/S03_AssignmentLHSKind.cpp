@@ -44,72 +44,87 @@ ast::Identifier headIdentifier(const ast::Expr *e) noexcept {
   return ast::Identifier();
 }
 
+class S03Check : public FusedCheck {
+public:
+  explicit S03Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_TransferStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor & /*cur*/) override {
+    const ConstraintContext &ctx = ctx_;
+    if (s.kind() != ast::NodeKind::NK_TransferStmt) {
+      return;
+    }
+    const auto &t = static_cast<const ast::TransferStmt &>(s);
+    if (t.lhs() == nullptr) {
+      return;
+    }
+    ast::Identifier head = headIdentifier(t.lhs());
+    if (head.empty()) {
+      return;
+    }
+    Symbol *sym = ctx.symbols->lookup(head);
+    if (sym == nullptr) {
+      return; // unresolved — no-cascade per FR-017
+    }
+    SymbolKind k = sym->kind();
+    // `=` (WireEq) targets wire/output/inout/variable/integer.
+    // `:=` (RegColonEq) targets reg (or struct-instance which
+    // is modeled as a RegSymbol per ResolutionPass).
+    // Memory cells use clocked-write semantics: `mem[idx] := val`
+    // is the canonical mem write; `mem[idx]` on RHS is a
+    // combinational read. Skip S3 when the LHS root is a Mem.
+    if (k == SymbolKind::SK_Mem) {
+      return;
+    }
+    // The fix-it range targets the op token only (the gap
+    // between lhs and rhs in source). M2's TransferStmt
+    // doesn't store the op token's SourceRange separately, so
+    // we approximate it via [lhs.end, rhs.begin). Without this
+    // narrowing, applying the fix-it would replace the whole
+    // statement (loc covers `lhs op rhs;`) with just the
+    // operator — that's the bug Copilot flagged at
+    // PR#8 review (lines 87 + 96).
+    auto opRange = [&]() noexcept -> SourceRange {
+      if (t.lhs() != nullptr && t.rhs() != nullptr) {
+        return SourceRange{t.lhs()->loc().end(), t.rhs()->loc().begin()};
+      }
+      return t.loc();
+    };
+    if (t.op() == ast::TransferStmt::Op::WireEq) {
+      if (k == SymbolKind::SK_Reg) {
+        auto b = ctx.diag->report(
+            Severity::Error, t.loc().begin(),
+            "'=' targets a wire, output, inout, variable, or "
+            "integer; use ':=' for reg (S3)");
+        b.addFixIt(opRange(), " := ");
+      }
+    } else if (t.op() == ast::TransferStmt::Op::RegColonEq) {
+      bool reg_target = (k == SymbolKind::SK_Reg);
+      if (!reg_target) {
+        auto b = ctx.diag->report(
+            Severity::Error, t.loc().begin(),
+            "':=' targets a reg or struct-instance-reg; use "
+            "'=' for wire/output/inout/variable/integer (S3)");
+        b.addFixIt(opRange(), " = ");
+      }
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S03Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t /*lex*/) {
-          if (s.kind() != ast::NodeKind::NK_TransferStmt) {
-            return;
-          }
-          const auto &t = static_cast<const ast::TransferStmt &>(s);
-          if (t.lhs() == nullptr) {
-            return;
-          }
-          ast::Identifier head = headIdentifier(t.lhs());
-          if (head.empty()) {
-            return;
-          }
-          Symbol *sym = ctx.symbols->lookup(head);
-          if (sym == nullptr) {
-            return; // unresolved — no-cascade per FR-017
-          }
-          SymbolKind k = sym->kind();
-          // `=` (WireEq) targets wire/output/inout/variable/integer.
-          // `:=` (RegColonEq) targets reg (or struct-instance which
-          // is modeled as a RegSymbol per ResolutionPass).
-          // Memory cells use clocked-write semantics: `mem[idx] := val`
-          // is the canonical mem write; `mem[idx]` on RHS is a
-          // combinational read. Skip S3 when the LHS root is a Mem.
-          if (k == SymbolKind::SK_Mem) {
-            return;
-          }
-          // The fix-it range targets the op token only (the gap
-          // between lhs and rhs in source). M2's TransferStmt
-          // doesn't store the op token's SourceRange separately, so
-          // we approximate it via [lhs.end, rhs.begin). Without this
-          // narrowing, applying the fix-it would replace the whole
-          // statement (loc covers `lhs op rhs;`) with just the
-          // operator — that's the bug Copilot flagged at
-          // PR#8 review (lines 87 + 96).
-          auto opRange = [&]() noexcept -> SourceRange {
-            if (t.lhs() != nullptr && t.rhs() != nullptr) {
-              return SourceRange{t.lhs()->loc().end(), t.rhs()->loc().begin()};
-            }
-            return t.loc();
-          };
-          if (t.op() == ast::TransferStmt::Op::WireEq) {
-            if (k == SymbolKind::SK_Reg) {
-              auto b = ctx.diag->report(
-                  Severity::Error, t.loc().begin(),
-                  "'=' targets a wire, output, inout, variable, or "
-                  "integer; use ':=' for reg (S3)");
-              b.addFixIt(opRange(), " := ");
-            }
-          } else if (t.op() == ast::TransferStmt::Op::RegColonEq) {
-            bool reg_target = (k == SymbolKind::SK_Reg);
-            if (!reg_target) {
-              auto b = ctx.diag->report(
-                  Severity::Error, t.loc().begin(),
-                  "':=' targets a reg or struct-instance-reg; use "
-                  "'=' for wire/output/inout/variable/integer (S3)");
-              b.addFixIt(opRange(), " = ");
-            }
-          }
-        });
+    return std::make_unique<S03Check>(ctx);
   }
 };
 
@@ -26,7 +26,7 @@ public:
     }
     // Build a name -> direction map for ports inside the same
     // declare block, so we can validate dummy-arg references.
-    for (const auto &item : ctx.unit->items()) {
+    for (const auto &item : ctx.items()) {
       if (!item || item->kind() != ast::NodeKind::NK_DeclareBlock) {
         continue;
       }
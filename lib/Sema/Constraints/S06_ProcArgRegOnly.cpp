@@ -12,29 +12,42 @@
 namespace nsl::sema {
 namespace {
 
+class S06Check : public FusedCheck {
+public:
+  explicit S06Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_ProcNameDecl});
+  }
+
+  void onDecl(const ast::Decl &d, const FusedCursor & /*cur*/) override {
+    const ConstraintContext &ctx = ctx_;
+    if (d.kind() != ast::NodeKind::NK_ProcNameDecl) {
+      return;
+    }
+    const auto &pn = static_cast<const ast::ProcNameDecl &>(d);
+    for (auto arg : pn.regArgs()) {
+      Symbol *sym = ctx.symbols->lookup(arg);
+      if (sym != nullptr && sym->kind() != SymbolKind::SK_Reg) {
+        ctx.diag->report(
+            Severity::Error, pn.loc().begin(),
+            "'proc_name' arguments must be 'reg' identifiers (S6)");
+      }
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S06Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit,
-        [&](const ast::Decl &d, uint32_t /*lex*/) {
-          if (d.kind() != ast::NodeKind::NK_ProcNameDecl) {
-            return;
-          }
-          const auto &pn = static_cast<const ast::ProcNameDecl &>(d);
-          for (auto arg : pn.regArgs()) {
-            Symbol *sym = ctx.symbols->lookup(arg);
-            if (sym != nullptr && sym->kind() != SymbolKind::SK_Reg) {
-              ctx.diag->report(
-                  Severity::Error, pn.loc().begin(),
-                  "'proc_name' arguments must be 'reg' identifiers (S6)");
-            }
-          }
-        },
-        /*scb=*/nullptr);
+    return std::make_unique<S06Check>(ctx);
   }
 };
 
@@ -11,34 +11,51 @@
 namespace nsl::sema {
 namespace {
 
+class S08Check : public FusedCheck {
+public:
+  explicit S08Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_WhileBlock,
+                      ast::NodeKind::NK_ForBlock});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor &cur) override {
+    const ConstraintContext &ctx = ctx_;
+    const uint32_t lex = cur.lex;
+    if (detail::has(lex, detail::LexCtx::InSeq)) {
+      return;
+    }
+    // Only fire if we're at least inside a func/proc body —
+    // otherwise S7 will already have fired and S8 is noise.
+    bool in_func_or_proc = detail::has(lex, detail::LexCtx::InFunc) ||
+                           detail::has(lex, detail::LexCtx::InProc);
+    if (!in_func_or_proc) {
+      return;
+    }
+    if (s.kind() == ast::NodeKind::NK_WhileBlock) {
+      ctx.diag->report(
+          Severity::Error, s.loc().begin(),
+          "'while' block may appear only inside a 'seq' block (S8)");
+    } else if (s.kind() == ast::NodeKind::NK_ForBlock) {
+      ctx.diag->report(
+          Severity::Error, s.loc().begin(),
+          "'for' block may appear only inside a 'seq' block (S8)");
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S08Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t lex) {
-          if (detail::has(lex, detail::LexCtx::InSeq)) {
-            return;
-          }
-          // Only fire if we're at least inside a func/proc body —
-          // otherwise S7 will already have fired and S8 is noise.
-          bool in_func_or_proc = detail::has(lex, detail::LexCtx::InFunc) ||
-                                 detail::has(lex, detail::LexCtx::InProc);
-          if (!in_func_or_proc) {
-            return;
-          }
-          if (s.kind() == ast::NodeKind::NK_WhileBlock) {
-            ctx.diag->report(
-                Severity::Error, s.loc().begin(),
-                "'while' block may appear only inside a 'seq' block (S8)");
-          } else if (s.kind() == ast::NodeKind::NK_ForBlock) {
-            ctx.diag->report(
-                Severity::Error, s.loc().begin(),
-                "'for' block may appear only inside a 'seq' block (S8)");
-          }
-        });
+    return std::make_unique<S08Check>(ctx);
   }
 };
 
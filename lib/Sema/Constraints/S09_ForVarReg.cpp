@@ -43,29 +43,44 @@ ast::Identifier loopVarFromInit(const ast::Stmt *init) noexcept {
   return ast::Identifier();
 }
 
+class S09Check : public FusedCheck {
+public:
+  explicit S09Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_ForBlock});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor & /*cur*/) override {
+    const ConstraintContext &ctx = ctx_;
+    if (s.kind() != ast::NodeKind::NK_ForBlock) {
+      return;
+    }
+    const auto &fb = static_cast<const ast::ForBlock &>(s);
+    ast::Identifier name = loopVarFromInit(fb.form().init.get());
+    if (name.empty()) {
+      return;
+    }
+    Symbol *sym = ctx.symbols->lookup(name);
+    if (sym != nullptr && sym->kind() != SymbolKind::SK_Reg) {
+      ctx.diag->report(
+          Severity::Error, fb.loc().begin(),
+          "for-loop variable must be a 'reg' identifier (S9)");
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S09Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t /*lex*/) {
-          if (s.kind() != ast::NodeKind::NK_ForBlock) {
-            return;
-          }
-          const auto &fb = static_cast<const ast::ForBlock &>(s);
-          ast::Identifier name = loopVarFromInit(fb.form().init.get());
-          if (name.empty()) {
-            return;
-          }
-          Symbol *sym = ctx.symbols->lookup(name);
-          if (sym != nullptr && sym->kind() != SymbolKind::SK_Reg) {
-            ctx.diag->report(
-                Severity::Error, fb.loc().begin(),
-                "for-loop variable must be a 'reg' identifier (S9)");
-          }
-        });
+    return std::make_unique<S09Check>(ctx);
   }
 };
 
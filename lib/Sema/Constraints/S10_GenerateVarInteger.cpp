@@ -13,29 +13,44 @@
 namespace nsl::sema {
 namespace {
 
+class S10Check : public FusedCheck {
+public:
+  explicit S10Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_StructuralGenerate});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor & /*cur*/) override {
+    const ConstraintContext &ctx = ctx_;
+    if (s.kind() != ast::NodeKind::NK_StructuralGenerate) {
+      return;
+    }
+    const auto &sg = static_cast<const ast::StructuralGenerate &>(s);
+    ast::Identifier name = sg.init();
+    if (name.empty()) {
+      return;
+    }
+    Symbol *sym = ctx.symbols->lookup(name);
+    if (sym != nullptr && sym->kind() != SymbolKind::SK_Integer) {
+      ctx.diag->report(Severity::Error, sg.loc().begin(),
+                       "'generate' loop variable must be an 'integer' "
+                       "identifier (S10)");
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S10Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t /*lex*/) {
-          if (s.kind() != ast::NodeKind::NK_StructuralGenerate) {
-            return;
-          }
-          const auto &sg = static_cast<const ast::StructuralGenerate &>(s);
-          ast::Identifier name = sg.init();
-          if (name.empty()) {
-            return;
-          }
-          Symbol *sym = ctx.symbols->lookup(name);
-          if (sym != nullptr && sym->kind() != SymbolKind::SK_Integer) {
-            ctx.diag->report(Severity::Error, sg.loc().begin(),
-                             "'generate' loop variable must be an 'integer' "
-                             "identifier (S10)");
-          }
-        });
+    return std::make_unique<S10Check>(ctx);
   }
 };
 
@@ -38,9 +38,13 @@
 #include "nsl/AST/UnaryExpr.h"
 #include "nsl/Basic/Diagnostic.h"
 
+#include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringMap.h"
 
+#include <algorithm>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace nsl::sema {
 namespace {
@@ -214,7 +218,7 @@ public:
     if (index.empty()) {
       return;
     }
-    for (const auto &item : ctx.unit->items()) {
+    for (const auto &item : ctx.items()) {
       if (!item || item->kind() != ast::NodeKind::NK_ModuleBlock) {
         continue;
       }
@@ -238,6 +242,22 @@ public:
       }
     }
   }
+
+  // The index spans every module, so one module's S11 output depends
+  // on the state_names the others declare.
+  llvm::hash_code crossItemKey(const ConstraintContext &ctx) const override {
+    if (ctx.unit == nullptr) {
+      return llvm::hash_code(0);
+    }
+    StateNameOwnerMap index;
+    buildIndex(*ctx.unit, index);
+    std::vector<std::pair<llvm::StringRef, llvm::StringRef>> owners;
+    for (const auto &kv : index) {
+      owners.emplace_back(kv.getKey(), kv.getValue());
+    }
+    std::sort(owners.begin(), owners.end());
+    return llvm::hash_combine_range(owners.begin(), owners.end());
+  }
 };
 
 } // namespace
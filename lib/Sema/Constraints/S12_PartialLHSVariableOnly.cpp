@@ -34,49 +34,64 @@ ast::Identifier underlyingHead(const ast::Expr *e) noexcept {
   return ast::Identifier();
 }
 
+class S12Check : public FusedCheck {
+public:
+  explicit S12Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_TransferStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor & /*cur*/) override {
+    const ConstraintContext &ctx = ctx_;
+    if (s.kind() != ast::NodeKind::NK_TransferStmt) {
+      return;
+    }
+    const auto &t = static_cast<const ast::TransferStmt &>(s);
+    if (t.lhs() == nullptr) {
+      return;
+    }
+    // S12 fires only on PARTIAL assignment shapes (LHS is a
+    // slice / concat / field-access). A bare IdentifierExpr
+    // LHS is whole-assignment and not in scope.
+    if (t.lhs()->kind() != ast::NodeKind::NK_SliceExpr) {
+      return;
+    }
+    ast::Identifier head = underlyingHead(t.lhs());
+    if (head.empty()) {
+      return;
+    }
+    Symbol *sym = ctx.symbols->lookup(head);
+    if (sym == nullptr) {
+      return;
+    }
+    // Memory cell indexing (`mem[i] := val`) is NOT a partial
+    // assignment — it's a whole-cell write to the addressed
+    // element. The S12 partial-assign-restricted-to-variable
+    // rule applies only to bit-slice-on-non-mem LHS.
+    if (sym->kind() == SymbolKind::SK_Mem) {
+      return;
+    }
+    if (sym->kind() != SymbolKind::SK_Variable) {
+      ctx.diag->report(
+          Severity::Error, t.loc().begin(),
+          "partial assignment is permitted only on 'variable' "
+          "identifiers (S12)");
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S12Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t /*lex*/) {
-          if (s.kind() != ast::NodeKind::NK_TransferStmt) {
-            return;
-          }
-          const auto &t = static_cast<const ast::TransferStmt &>(s);
-          if (t.lhs() == nullptr) {
-            return;
-          }
-          // S12 fires only on PARTIAL assignment shapes (LHS is a
-          // slice / concat / field-access). A bare IdentifierExpr
-          // LHS is whole-assignment and not in scope.
-          if (t.lhs()->kind() != ast::NodeKind::NK_SliceExpr) {
-            return;
-          }
-          ast::Identifier head = underlyingHead(t.lhs());
-          if (head.empty()) {
-            return;
-          }
-          Symbol *sym = ctx.symbols->lookup(head);
-          if (sym == nullptr) {
-            return;
-          }
-          // Memory cell indexing (`mem[i] := val`) is NOT a partial
-          // assignment — it's a whole-cell write to the addressed
-          // element. The S12 partial-assign-restricted-to-variable
-          // rule applies only to bit-slice-on-non-mem LHS.
-          if (sym->kind() == SymbolKind::SK_Mem) {
-            return;
-          }
-          if (sym->kind() != SymbolKind::SK_Variable) {
-            ctx.diag->report(
-                Severity::Error, t.loc().begin(),
-                "partial assignment is permitted only on 'variable' "
-                "identifiers (S12)");
-          }
-        });
+    return std::make_unique<S12Check>(ctx);
   }
 };
 
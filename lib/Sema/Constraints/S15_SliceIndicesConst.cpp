@@ -209,20 +209,39 @@ void walkExprsInStmt(const ast::Stmt &s, DiagnosticEngine &diag,
   }
 }
 
+class S15Check : public FusedCheck {
+public:
+  S15Check(DiagnosticEngine &diag, SymbolTable *symbols)
+      : diag_(diag), symbols_(symbols) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_RegDecl, ast::NodeKind::NK_WireDecl,
+                      ast::NodeKind::NK_VariableDecl, ast::NodeKind::NK_MemDecl,
+                      ast::NodeKind::NK_StructInstDecl,
+                      ast::NodeKind::NK_TransferStmt});
+  }
+
+  void onDecl(const ast::Decl &d, const FusedCursor & /*cur*/) override {
+    walkExprsInDecl(d, diag_, symbols_);
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor & /*cur*/) override {
+    walkExprsInStmt(s, diag_, symbols_);
+  }
+
+private:
+  DiagnosticEngine &diag_;
+  SymbolTable *symbols_;
+};
+
 class S15Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit,
-        [&](const ast::Decl &d, uint32_t /*lex*/) {
-          walkExprsInDecl(d, *ctx.diag, ctx.symbols);
-        },
-        [&](const ast::Stmt &s, uint32_t /*lex*/) {
-          walkExprsInStmt(s, *ctx.diag, ctx.symbols);
-        });
+    return std::make_unique<S15Check>(*ctx.diag, ctx.symbols);
   }
 };
 
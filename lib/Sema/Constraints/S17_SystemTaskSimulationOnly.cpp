@@ -17,15 +17,81 @@
 #include "llvm/ADT/StringRef.h"
 
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace nsl::sema {
 namespace {
 
+class S17Check : public FusedCheck {
+public:
+  S17Check(DiagnosticEngine &diag, llvm::DenseSet<llvm::StringRef> simModules)
+      : diag_(diag), simModules_(std::move(simModules)) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_SystemTaskStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor &cur) override {
+    // Only statements whose enclosing module is not a simulation
+    // module are in violation.
+    if (cur.module == nullptr || simModules_.count(cur.module->name()) != 0U) {
+      return;
+    }
+    const auto &st = static_cast<const ast::SystemTaskStmt &>(s);
+    std::string msg = "system task '";
+    msg += st.name().str();
+    msg += "' is permitted only in modules whose 'declare' "
+           "carries the 'simulation' modifier (S17)";
+    // The traversal visits funcs, then procs, then actions; the
+    // diagnostics are reported per module as actions, procs, funcs.
+    PerModule &pm = moduleBucket(cur.module);
+    if (detail::has(cur.lex, detail::LexCtx::InFunc)) {
+      pm.funcs.emplace_back(st.loc().begin(), std::move(msg));
+    } else if (detail::has(cur.lex, detail::LexCtx::InProc)) {
+      pm.procs.emplace_back(st.loc().begin(), std::move(msg));
+    } else {
+      pm.actions.emplace_back(st.loc().begin(), std::move(msg));
+    }
+  }
+
+  void finish() override {
+    for (PerModule &pm : modules_) {
+      for (auto *list : {&pm.actions, &pm.procs, &pm.funcs}) {
+        for (auto &d : *list) {
+          diag_.report(Severity::Error, d.first, std::move(d.second));
+        }
+      }
+    }
+  }
+
+private:
+  using Pending = std::vector<std::pair<SourceLocation, std::string>>;
+  struct PerModule {
+    const ast::ModuleBlock *module;
+    Pending actions;
+    Pending procs;
+    Pending funcs;
+  };
+
+  PerModule &moduleBucket(const ast::ModuleBlock *mb) {
+    if (modules_.empty() || modules_.back().module != mb) {
+      modules_.push_back(PerModule{mb, {}, {}, {}});
+    }
+    return modules_.back();
+  }
+
+  DiagnosticEngine &diag_;
+  llvm::DenseSet<llvm::StringRef> simModules_;
+  std::vector<PerModule> modules_;
+};
+
 class S17Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
-      return;
+      return nullptr;
     }
     // Build set of module names whose paired declare carries the
     // simulation modifier.
@@ -39,45 +105,7 @@ public:
         simModules.insert(db.name());
       }
     }
-
-    // Walk per-module so we know whether the SystemTaskStmt's
-    // enclosing module is a simulation module.
-    for (const auto &item : ctx.unit->items()) {
-      if (!item || item->kind() != ast::NodeKind::NK_ModuleBlock) {
-        continue;
-      }
-      const auto &mb = static_cast<const ast::ModuleBlock &>(*item);
-      bool is_sim = simModules.count(mb.name()) != 0U;
-      if (is_sim) {
-        continue;
-      }
-      auto fire = [&](const ast::Stmt &s, uint32_t /*lex*/) {
-        if (s.kind() != ast::NodeKind::NK_SystemTaskStmt) {
-          return;
-        }
-        const auto &st = static_cast<const ast::SystemTaskStmt &>(s);
-        std::string msg = "system task '";
-        msg += st.name().str();
-        msg += "' is permitted only in modules whose 'declare' "
-               "carries the 'simulation' modifier (S17)";
-        ctx.diag->report(Severity::Error, st.loc().begin(), std::move(msg));
-      };
-      for (const auto &a : mb.actions()) {
-        if (a) {
-          detail::walkStmt(*a, 0U, fire);
-        }
-      }
-      for (const auto &p : mb.procs()) {
-        if (p) {
-          detail::walkDecl(*p, 0U, /*dcb=*/nullptr, fire);
-        }
-      }
-      for (const auto &f : mb.funcs()) {
-        if (f) {
-          detail::walkDecl(*f, 0U, /*dcb=*/nullptr, fire);
-        }
-      }
-    }
+    return std::make_unique<S17Check>(*ctx.diag, std::move(simModules));
   }
 };
 
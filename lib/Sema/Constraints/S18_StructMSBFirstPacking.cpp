@@ -28,7 +28,7 @@ public:
     if (ctx.unit == nullptr || ctx.symbols == nullptr) {
       return;
     }
-    for (const auto &item : ctx.unit->items()) {
+    for (const auto &item : ctx.items()) {
       if (!item || item->kind() != ast::NodeKind::NK_StructDecl) {
         continue;
       }
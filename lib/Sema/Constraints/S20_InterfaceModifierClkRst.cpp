@@ -24,7 +24,7 @@ public:
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
       return;
     }
-    for (const auto &item : ctx.unit->items()) {
+    for (const auto &item : ctx.items()) {
       if (!item || item->kind() != ast::NodeKind::NK_DeclareBlock) {
         continue;
       }
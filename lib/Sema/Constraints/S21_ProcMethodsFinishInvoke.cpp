@@ -16,43 +16,60 @@
 namespace nsl::sema {
 namespace {
 
+class S21Check : public FusedCheck {
+public:
+  explicit S21Check(const ConstraintContext &ctx) : ctx_(ctx) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_BareFinishStmt,
+                      ast::NodeKind::NK_ControlCallStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor &cur) override {
+    const ConstraintContext &ctx = ctx_;
+    const uint32_t lex = cur.lex;
+    if (s.kind() == ast::NodeKind::NK_BareFinishStmt) {
+      if (!detail::has(lex, detail::LexCtx::InProc)) {
+        ctx.diag->report(
+            Severity::Error, s.loc().begin(),
+            "'finish' / 'invoke' is a built-in proc method; "
+            "bare form is permitted only inside a 'proc' body "
+            "(S21)");
+      }
+      return;
+    }
+    if (s.kind() == ast::NodeKind::NK_ControlCallStmt) {
+      const auto &cc = static_cast<const ast::ControlCallStmt &>(s);
+      if (cc.target().parts.size() < 2) {
+        return;
+      }
+      llvm::StringRef tail = cc.target().parts.back();
+      if (tail != "finish" && tail != "invoke") {
+        return;
+      }
+      llvm::StringRef head = cc.target().parts.front();
+      Symbol *sym = ctx.symbols->lookup(head);
+      if (sym == nullptr || sym->kind() != SymbolKind::SK_Proc) {
+        ctx.diag->report(Severity::Error, s.loc().begin(),
+                         "dotted form '<inst>.finish()' / "
+                         "'<inst>.invoke()' requires '<inst>' to resolve "
+                         "to a 'proc_name' declaration (S21)");
+      }
+    }
+  }
+
+private:
+  ConstraintContext ctx_;
+};
+
 class S21Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr || ctx.symbols == nullptr) {
-      return;
+      return nullptr;
     }
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t lex) {
-          if (s.kind() == ast::NodeKind::NK_BareFinishStmt) {
-            if (!detail::has(lex, detail::LexCtx::InProc)) {
-              ctx.diag->report(
-                  Severity::Error, s.loc().begin(),
-                  "'finish' / 'invoke' is a built-in proc method; "
-                  "bare form is permitted only inside a 'proc' body "
-                  "(S21)");
-            }
-            return;
-          }
-          if (s.kind() == ast::NodeKind::NK_ControlCallStmt) {
-            const auto &cc = static_cast<const ast::ControlCallStmt &>(s);
-            if (cc.target().parts.size() < 2) {
-              return;
-            }
-            llvm::StringRef tail = cc.target().parts.back();
-            if (tail != "finish" && tail != "invoke") {
-              return;
-            }
-            llvm::StringRef head = cc.target().parts.front();
-            Symbol *sym = ctx.symbols->lookup(head);
-            if (sym == nullptr || sym->kind() != SymbolKind::SK_Proc) {
-              ctx.diag->report(Severity::Error, s.loc().begin(),
-                               "dotted form '<inst>.finish()' / "
-                               "'<inst>.invoke()' requires '<inst>' to resolve "
-                               "to a 'proc_name' declaration (S21)");
-            }
-          }
-        });
+    return std::make_unique<S21Check>(ctx);
   }
 };
 
@@ -23,6 +23,8 @@
 
 #include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace nsl::sema {
 namespace {
@@ -41,11 +43,77 @@ uint64_t exprWidth(const ast::Expr *e) noexcept {
   return 0U;
 }
 
+class S22Check : public FusedCheck {
+public:
+  S22Check(DiagnosticEngine &diag,
+           llvm::DenseMap<llvm::StringRef, uint64_t> portWidths,
+           llvm::DenseMap<llvm::StringRef, llvm::StringRef> funcReturn)
+      : diag_(diag), portWidths_(std::move(portWidths)),
+        funcReturn_(std::move(funcReturn)) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_ReturnStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor &cur) override {
+    const auto &r = static_cast<const ast::ReturnStmt &>(s);
+    if (!detail::has(cur.lex, detail::LexCtx::InFunc)) {
+      diag_.report(Severity::Error, r.loc().begin(),
+                   "'return' may appear only inside a 'func' body (S22)");
+      return;
+    }
+    // Width-mismatch / bare-return-with-terminal against the
+    // enclosing module-level func. These used to come from a second
+    // per-FuncDefn walk, so they are held back until finish() to keep
+    // them after every placement diagnostic.
+    if (cur.func == nullptr || cur.func->name().parts.empty()) {
+      return;
+    }
+    llvm::StringRef fname = cur.func->name().parts.back();
+    auto it = funcReturn_.find(fname);
+    if (it == funcReturn_.end()) {
+      return;
+    }
+    uint64_t terminal_w = 0U;
+    auto pwit = portWidths_.find(it->second);
+    if (pwit != portWidths_.end()) {
+      terminal_w = pwit->second;
+    }
+    if (r.value() == nullptr) {
+      deferred_.emplace_back(r.loc().begin(),
+                             "bare 'return;' is valid only when the func "
+                             "has no return-value terminal (S22)");
+      return;
+    }
+    uint64_t rw = exprWidth(r.value());
+    if (rw != 0U && terminal_w != 0U && rw != terminal_w) {
+      std::string msg = "return-expression width " + std::to_string(rw) +
+                        " does not match func's return-value-terminal "
+                        "width " +
+                        std::to_string(terminal_w) + " (S22)";
+      deferred_.emplace_back(r.loc().begin(), std::move(msg));
+    }
+  }
+
+  void finish() override {
+    for (auto &d : deferred_) {
+      diag_.report(Severity::Error, d.first, std::move(d.second));
+    }
+  }
+
+private:
+  DiagnosticEngine &diag_;
+  llvm::DenseMap<llvm::StringRef, uint64_t> portWidths_;
+  llvm::DenseMap<llvm::StringRef, llvm::StringRef> funcReturn_;
+  std::vector<std::pair<SourceLocation, std::string>> deferred_;
+};
+
 class S22Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
-      return;
+      return nullptr;
     }
     // Build map of func-name -> return-terminal width (0 if none).
     // Use the declare block's port declarations to resolve return
@@ -81,85 +149,8 @@ public:
         }
       }
     }
-
-    detail::walkUnit(
-        *ctx.unit, /*dcb=*/nullptr, [&](const ast::Stmt &s, uint32_t lex) {
-          if (s.kind() != ast::NodeKind::NK_ReturnStmt) {
-            return;
-          }
-          const auto &r = static_cast<const ast::ReturnStmt &>(s);
-          if (!detail::has(lex, detail::LexCtx::InFunc)) {
-            ctx.diag->report(
-                Severity::Error, r.loc().begin(),
-                "'return' may appear only inside a 'func' body (S22)");
-            return;
-          }
-          // Width-mismatch / bare-return-with-terminal: at M3 we
-          // can't easily plumb the enclosing FuncDefn's name into the
-          // walker (the lex-context doesn't carry the func name). We
-          // approximate by scanning every FuncDefn whose body
-          // textually encloses this Return — the cheap check is to
-          // re-walk per-FuncDefn instead.
-          (void)r;
-          (void)funcReturn;
-          (void)portWidths;
-        });
-
-    // Per-FuncDefn walk: for each func, find all returns and check
-    // them against the func's return-terminal.
-    for (const auto &item : ctx.unit->items()) {
-      if (!item || item->kind() != ast::NodeKind::NK_ModuleBlock) {
-        continue;
-      }
-      const auto &mb = static_cast<const ast::ModuleBlock &>(*item);
-      for (const auto &f : mb.funcs()) {
-        if (!f || f->kind() != ast::NodeKind::NK_FuncDefn) {
-          continue;
-        }
-        const auto &fd = static_cast<const ast::FuncDefn &>(*f);
-        if (fd.name().parts.empty() || fd.body() == nullptr) {
-          continue;
-        }
-        llvm::StringRef fname = fd.name().parts.back();
-        uint64_t terminal_w = 0U;
-        bool has_terminal = false;
-        auto it = funcReturn.find(fname);
-        if (it != funcReturn.end()) {
-          has_terminal = true;
-          auto pwit = portWidths.find(it->second);
-          if (pwit != portWidths.end()) {
-            terminal_w = pwit->second;
-          }
-        }
-        detail::walkStmt(
-            *fd.body(), 0U, [&](const ast::Stmt &s, uint32_t /*lex*/) {
-              if (s.kind() != ast::NodeKind::NK_ReturnStmt) {
-                return;
-              }
-              const auto &r = static_cast<const ast::ReturnStmt &>(s);
-              if (r.value() == nullptr) {
-                if (has_terminal) {
-                  ctx.diag->report(Severity::Error, r.loc().begin(),
-                                   "bare 'return;' is valid only when the func "
-                                   "has no return-value terminal (S22)");
-                }
-                return;
-              }
-              if (has_terminal) {
-                uint64_t rw = exprWidth(r.value());
-                if (rw != 0U && terminal_w != 0U && rw != terminal_w) {
-                  std::string msg =
-                      "return-expression width " + std::to_string(rw) +
-                      " does not match func's return-value-terminal "
-                      "width " +
-                      std::to_string(terminal_w) + " (S22)";
-                  ctx.diag->report(Severity::Error, r.loc().begin(),
-                                   std::move(msg));
-                }
-              }
-            });
-      }
-    }
+    return std::make_unique<S22Check>(*ctx.diag, std::move(portWidths),
+                                      std::move(funcReturn));
   }
 };
 
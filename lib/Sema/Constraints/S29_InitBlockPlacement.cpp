@@ -15,14 +15,50 @@
 #include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/StringRef.h"
 
+#include <utility>
+
 namespace nsl::sema {
 namespace {
 
+class S29Check : public FusedCheck {
+public:
+  S29Check(DiagnosticEngine &diag, llvm::DenseSet<llvm::StringRef> simModules)
+      : diag_(diag), simModules_(std::move(simModules)) {}
+
+  [[nodiscard]] NodeKindSet kinds() const override {
+    return nodeKinds({ast::NodeKind::NK_InitBlockStmt});
+  }
+
+  void onStmt(const ast::Stmt &s, const FusedCursor &cur) override {
+    // Only module actions are in scope; func / proc bodies are not.
+    if (cur.module == nullptr ||
+        detail::has(cur.lex, detail::LexCtx::InFunc) ||
+        detail::has(cur.lex, detail::LexCtx::InProc)) {
+      return;
+    }
+    // Top-level _init permitted iff the module is simulation-
+    // modified. If non-simulation, fire on every InitBlockStmt
+    // at any nesting depth. If simulation, allow only top-level;
+    // nested ones (under any action block) violate.
+    bool is_sim = simModules_.count(cur.module->name()) != 0U;
+    if (!is_sim || detail::has(cur.lex, detail::LexCtx::InAnyAction)) {
+      diag_.report(Severity::Error, s.loc().begin(),
+                   "'_init' block is permitted only at module top level "
+                   "inside a 'simulation'-modified module (S29)");
+    }
+  }
+
+private:
+  DiagnosticEngine &diag_;
+  llvm::DenseSet<llvm::StringRef> simModules_;
+};
+
 class S29Visitor : public ConstraintVisitor {
 public:
-  void run(const ConstraintContext &ctx) const override {
+  std::unique_ptr<FusedCheck>
+  makeFused(const ConstraintContext &ctx) const override {
     if (ctx.unit == nullptr || ctx.diag == nullptr) {
-      return;
+      return nullptr;
     }
     llvm::DenseSet<llvm::StringRef> simModules;
     for (const auto &item : ctx.unit->items()) {
@@ -34,42 +70,7 @@ public:
         simModules.insert(db.name());
       }
     }
-
-    for (const auto &item : ctx.unit->items()) {
-      if (!item || item->kind() != ast::NodeKind::NK_ModuleBlock) {
-        continue;
-      }
-      const auto &mb = static_cast<const ast::ModuleBlock &>(*item);
-      bool is_sim = simModules.count(mb.name()) != 0U;
-      // Top-level _init permitted iff the module is simulation-
-      // modified. If non-simulation, fire on every InitBlockStmt
-      // at any nesting depth. If simulation, allow only top-level.
-      auto fire = [&](const ast::Stmt &s, uint32_t lex) {
-        if (s.kind() != ast::NodeKind::NK_InitBlockStmt) {
-          return;
-        }
-        if (!is_sim) {
-          ctx.diag->report(
-              Severity::Error, s.loc().begin(),
-              "'_init' block is permitted only at module top level "
-              "inside a 'simulation'-modified module (S29)");
-          return;
-        }
-        // Simulation module: only top-level _init allowed; nested
-        // ones (under any action block) violate.
-        if (detail::has(lex, detail::LexCtx::InAnyAction)) {
-          ctx.diag->report(
-              Severity::Error, s.loc().begin(),
-              "'_init' block is permitted only at module top level "
-              "inside a 'simulation'-modified module (S29)");
-        }
-      };
-      for (const auto &a : mb.actions()) {
-        if (a) {
-          detail::walkStmt(*a, 0U, fire);
-        }
-      }
-    }
+    return std::make_unique<S29Check>(*ctx.diag, std::move(simModules));
   }
 };
 
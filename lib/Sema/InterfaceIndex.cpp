@@ -0,0 +1,464 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/InterfaceIndex.cpp — `declare`-block summaries and their
+// JSON form. See `InterfaceSummary` / `InterfaceIndex` in Sema.h.
+//
+// Document layout (`kVersion` 1); empty strings, empty lists and a
+// `none` modifier are left out:
+//
+//   {"version": 1,
+//    "interfaces": [
+//      {"name": "alu", "modifier": "interface",
+//       "clock": "clk", "reset": "rst",
+//       "params": [{"name": "W", "kind": "int", "value": "8"}],
+//       "ports": [{"name": "a", "direction": "input", "width": 8},
+//                 {"name": "go", "direction": "func_in",
+//                  "args": ["a"], "return": "y"}]}]}
+//
+// The writer streams through `llvm::json::OStream` in a fixed key
+// order, so equal indexes produce identical bytes.
+
+#include "nsl/Sema/Sema.h"
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/DeclareBlock.h"
+#include "nsl/AST/Expr.h"
+#include "nsl/AST/LiteralExpr.h"
+#include "nsl/AST/PortDecl.h"
+#include "nsl/AST/TopLevelParamDecl.h"
+
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Error.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nsl::sema {
+
+namespace {
+
+using Direction = InterfaceSummary::Direction;
+using Modifier = InterfaceSummary::Modifier;
+
+constexpr std::pair<Direction, llvm::StringLiteral> kDirections[] = {
+    {Direction::Input, "input"},       {Direction::Output, "output"},
+    {Direction::Inout, "inout"},       {Direction::FuncIn, "func_in"},
+    {Direction::FuncOut, "func_out"},  {Direction::Wire, "wire"},
+    {Direction::FuncSelf, "func_self"},
+};
+
+constexpr std::pair<Modifier, llvm::StringLiteral> kModifiers[] = {
+    {Modifier::None, "none"},
+    {Modifier::Interface, "interface"},
+    {Modifier::Simulation, "simulation"},
+};
+
+template <typename E, std::size_t N>
+llvm::StringRef spell(const std::pair<E, llvm::StringLiteral> (&table)[N],
+                      E value) {
+  for (const auto &entry : table) {
+    if (entry.first == value) {
+      return entry.second;
+    }
+  }
+  return table[0].second;
+}
+
+template <typename E, std::size_t N>
+std::optional<E> parseName(const std::pair<E, llvm::StringLiteral> (&table)[N],
+                           llvm::StringRef name) {
+  for (const auto &entry : table) {
+    if (entry.second == name) {
+      return entry.first;
+    }
+  }
+  return std::nullopt;
+}
+
+Direction mapDirection(ast::PortDecl::Direction d) {
+  switch (d) {
+  case ast::PortDecl::Direction::Input:
+    return Direction::Input;
+  case ast::PortDecl::Direction::Output:
+    return Direction::Output;
+  case ast::PortDecl::Direction::Inout:
+    return Direction::Inout;
+  case ast::PortDecl::Direction::FuncIn:
+    return Direction::FuncIn;
+  case ast::PortDecl::Direction::FuncOut:
+    return Direction::FuncOut;
+  case ast::PortDecl::Direction::Wire:
+    return Direction::Wire;
+  case ast::PortDecl::Direction::FuncSelf:
+    return Direction::FuncSelf;
+  }
+  return Direction::Input;
+}
+
+Modifier mapModifier(ast::DeclareBlock::Modifier m) {
+  switch (m) {
+  case ast::DeclareBlock::Modifier::None:
+    return Modifier::None;
+  case ast::DeclareBlock::Modifier::Interface:
+    return Modifier::Interface;
+  case ast::DeclareBlock::Modifier::Simulation:
+    return Modifier::Simulation;
+  }
+  return Modifier::None;
+}
+
+void writeIfSet(llvm::json::OStream &j, llvm::StringRef key,
+                llvm::StringRef value) {
+  if (!value.empty()) {
+    j.attribute(key, value);
+  }
+}
+
+void writeSummary(llvm::json::OStream &j, const InterfaceSummary &s) {
+  j.object([&] {
+    j.attribute("name", s.name);
+    if (s.modifier != Modifier::None) {
+      j.attribute("modifier", spell(kModifiers, s.modifier));
+    }
+    writeIfSet(j, "clock", s.clock);
+    writeIfSet(j, "reset", s.reset);
+    if (!s.params.empty()) {
+      j.attributeArray("params", [&] {
+        for (const InterfaceSummary::Param &p : s.params) {
+          j.object([&] {
+            j.attribute("name", p.name);
+            j.attribute("kind", p.isString ? "str" : "int");
+            writeIfSet(j, "value", p.value);
+          });
+        }
+      });
+    }
+    if (!s.ports.empty()) {
+      j.attributeArray("ports", [&] {
+        for (const InterfaceSummary::Port &p : s.ports) {
+          j.object([&] {
+            j.attribute("name", p.name);
+            j.attribute("direction", spell(kDirections, p.direction));
+            if (p.width != 0) {
+              j.attribute("width", static_cast<int64_t>(p.width));
+            }
+            if (!p.dummyArgs.empty()) {
+              j.attributeArray("args", [&] {
+                for (const std::string &a : p.dummyArgs) {
+                  j.value(a);
+                }
+              });
+            }
+            writeIfSet(j, "return", p.returnTerminal);
+          });
+        }
+      });
+    }
+  });
+}
+
+/// Reads one summary document, recording the first problem found.
+class Reader {
+public:
+  explicit Reader(std::string &error) : error_(error) {}
+
+  bool fail(const llvm::Twine &what) {
+    error_ = what.str();
+    return false;
+  }
+
+  /// `key` of `o` as a string; absent reads as empty.
+  bool string(const llvm::json::Object &o, llvm::StringRef key,
+              std::string &out) {
+    const llvm::json::Value *v = o.get(key);
+    if (v == nullptr) {
+      return true;
+    }
+    auto s = v->getAsString();
+    if (!s) {
+      return fail("'" + key + "' is not a string");
+    }
+    out = s->str();
+    return true;
+  }
+
+  /// `key` of `o` as an array; absent reads as empty.
+  const llvm::json::Array *array(const llvm::json::Object &o,
+                                 llvm::StringRef key) {
+    static const llvm::json::Array kEmpty;
+    const llvm::json::Value *v = o.get(key);
+    if (v == nullptr) {
+      return &kEmpty;
+    }
+    if (v->getAsArray() == nullptr) {
+      fail("'" + key + "' is not an array");
+    }
+    return v->getAsArray();
+  }
+
+  bool param(const llvm::json::Value &v, InterfaceSummary::Param &out) {
+    const llvm::json::Object *o = v.getAsObject();
+    if (o == nullptr) {
+      return fail("parameter is not an object");
+    }
+    std::string kind;
+    if (!string(*o, "name", out.name) || !string(*o, "kind", kind) ||
+        !string(*o, "value", out.value)) {
+      return false;
+    }
+    if (kind != "int" && kind != "str") {
+      return fail("parameter '" + out.name + "' has unknown kind '" + kind +
+                  "'");
+    }
+    out.isString = kind == "str";
+    return true;
+  }
+
+  bool port(const llvm::json::Value &v, InterfaceSummary::Port &out) {
+    const llvm::json::Object *o = v.getAsObject();
+    if (o == nullptr) {
+      return fail("port is not an object");
+    }
+    std::string direction;
+    if (!string(*o, "name", out.name) ||
+        !string(*o, "direction", direction) ||
+        !string(*o, "return", out.returnTerminal)) {
+      return false;
+    }
+    std::optional<Direction> d = parseName(kDirections, direction);
+    if (!d) {
+      return fail("port '" + out.name + "' has unknown direction '" +
+                  direction + "'");
+    }
+    out.direction = *d;
+    if (const llvm::json::Value *w = o->get("width")) {
+      auto width = w->getAsInteger();
+      if (!width || *width < 0) {
+        return fail("port '" + out.name + "' has an invalid width");
+      }
+      out.width = static_cast<uint64_t>(*width);
+    }
+    const llvm::json::Array *args = array(*o, "args");
+    if (args == nullptr) {
+      return false;
+    }
+    for (const llvm::json::Value &a : *args) {
+      auto s = a.getAsString();
+      if (!s) {
+        return fail("port '" + out.name + "' has a non-string argument");
+      }
+      out.dummyArgs.push_back(s->str());
+    }
+    return true;
+  }
+
+  bool summary(const llvm::json::Value &v, InterfaceSummary &out) {
+    const llvm::json::Object *o = v.getAsObject();
+    if (o == nullptr) {
+      return fail("interface is not an object");
+    }
+    std::string modifier;
+    if (!string(*o, "name", out.name) || !string(*o, "modifier", modifier) ||
+        !string(*o, "clock", out.clock) || !string(*o, "reset", out.reset)) {
+      return false;
+    }
+    if (out.name.empty()) {
+      return fail("interface has no name");
+    }
+    std::optional<Modifier> m =
+        modifier.empty() ? Modifier::None : parseName(kModifiers, modifier);
+    if (!m) {
+      return fail("interface '" + out.name + "' has unknown modifier '" +
+                  modifier + "'");
+    }
+    out.modifier = *m;
+    const llvm::json::Array *params = array(*o, "params");
+    const llvm::json::Array *ports = params ? array(*o, "ports") : nullptr;
+    if (ports == nullptr) {
+      return false;
+    }
+    out.params.resize(params->size());
+    for (std::size_t i = 0; i < params->size(); ++i) {
+      if (!param((*params)[i], out.params[i])) {
+        return false;
+      }
+    }
+    out.ports.resize(ports->size());
+    for (std::size_t i = 0; i < ports->size(); ++i) {
+      if (!port((*ports)[i], out.ports[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+private:
+  std::string &error_;
+};
+
+} // namespace
+
+// ---------- InterfaceSummary ----------
+
+const InterfaceSummary::Port *
+InterfaceSummary::port(llvm::StringRef port) const {
+  for (const Port &p : ports) {
+    if (p.name == port) {
+      return &p;
+    }
+  }
+  return nullptr;
+}
+
+InterfaceSummary InterfaceSummary::fromDeclare(const ast::DeclareBlock &declare,
+                                               const ConstantTable &constants) {
+  InterfaceSummary s;
+  s.name = declare.name().str();
+  s.modifier = mapModifier(declare.modifier());
+  s.clock = declare.clockName().str();
+  s.reset = declare.resetName().str();
+  for (const auto &d : declare.headerParams()) {
+    if (!d || d->kind() != ast::NodeKind::NK_TopLevelParamDecl) {
+      continue;
+    }
+    const auto &decl = static_cast<const ast::TopLevelParamDecl &>(*d);
+    Param p;
+    p.name = decl.name().str();
+    p.isString = decl.paramKind() == ast::TopLevelParamDecl::ParamKind::Str;
+    if (p.isString) {
+      const ast::Expr *init = decl.init();
+      if (init != nullptr && init->kind() == ast::NodeKind::NK_LiteralExpr) {
+        p.value = static_cast<const ast::LiteralExpr &>(*init).spelling().str();
+      }
+    } else if (const llvm::APInt *v =
+                   decl.init() ? constants.lookup(*decl.init()) : nullptr) {
+      llvm::SmallString<24> digits;
+      v->toStringUnsigned(digits, 10);
+      p.value = digits.str().str();
+    }
+    s.params.push_back(std::move(p));
+  }
+  for (const auto &d : declare.ports()) {
+    if (!d) {
+      continue;
+    }
+    Port p;
+    p.name = d->name().str();
+    p.direction = mapDirection(d->direction());
+    p.width = constants.width(d->width()).value_or(0);
+    for (ast::Identifier a : d->dummyArgs()) {
+      p.dummyArgs.push_back(a.str());
+    }
+    p.returnTerminal = d->returnTerminal().str();
+    s.ports.push_back(std::move(p));
+  }
+  return s;
+}
+
+// ---------- InterfaceIndex ----------
+
+void InterfaceIndex::add(InterfaceSummary summary) {
+  std::string name = summary.name;
+  byName_[name] = std::move(summary);
+}
+
+const InterfaceSummary *InterfaceIndex::lookup(llvm::StringRef name) const {
+  auto it = byName_.find(name);
+  return it != byName_.end() ? &it->getValue() : nullptr;
+}
+
+void InterfaceIndex::writeJSON(llvm::raw_ostream &os) const {
+  std::vector<llvm::StringRef> names;
+  names.reserve(byName_.size());
+  for (const auto &kv : byName_) {
+    names.push_back(kv.getKey());
+  }
+  std::sort(names.begin(), names.end());
+  llvm::json::OStream j(os);
+  j.object([&] {
+    j.attribute("version", kVersion);
+    j.attributeArray("interfaces", [&] {
+      for (llvm::StringRef name : names) {
+        writeSummary(j, *lookup(name));
+      }
+    });
+  });
+  os << "\n";
+}
+
+bool InterfaceIndex::readJSON(llvm::StringRef text, std::string &error) {
+  llvm::Expected<llvm::json::Value> doc = llvm::json::parse(text);
+  if (!doc) {
+    error = llvm::toString(doc.takeError());
+    return false;
+  }
+  Reader r(error);
+  const llvm::json::Object *root = doc->getAsObject();
+  if (root == nullptr) {
+    return r.fail("interface index is not a JSON object");
+  }
+  auto version = root->getInteger("version");
+  if (!version || *version != kVersion) {
+    return r.fail("unsupported interface index version");
+  }
+  const llvm::json::Array *items = root->getArray("interfaces");
+  if (items == nullptr) {
+    return r.fail("interface index has no 'interfaces' array");
+  }
+  std::vector<InterfaceSummary> read(items->size());
+  for (std::size_t i = 0; i < items->size(); ++i) {
+    if (!r.summary((*items)[i], read[i])) {
+      return false;
+    }
+  }
+  for (InterfaceSummary &s : read) {
+    add(std::move(s));
+  }
+  return true;
+}
+
+std::size_t InterfaceIndex::fingerprint() const {
+  // Summed, so the result does not depend on the map's order.
+  std::size_t h = 0;
+  for (const auto &kv : byName_) {
+    const InterfaceSummary &s = kv.getValue();
+    llvm::hash_code one =
+        llvm::hash_combine(llvm::StringRef(s.name), s.modifier,
+                           llvm::StringRef(s.clock), llvm::StringRef(s.reset));
+    for (const InterfaceSummary::Param &p : s.params) {
+      one = llvm::hash_combine(one, llvm::StringRef(p.name), p.isString,
+                               llvm::StringRef(p.value));
+    }
+    for (const InterfaceSummary::Port &p : s.ports) {
+      one = llvm::hash_combine(one, llvm::StringRef(p.name), p.direction,
+                               p.width, llvm::StringRef(p.returnTerminal));
+      for (const std::string &a : p.dummyArgs) {
+        one = llvm::hash_combine(one, llvm::StringRef(a));
+      }
+    }
+    h += one;
+  }
+  return h;
+}
+
+InterfaceIndex InterfaceIndex::fromUnit(const ast::CompilationUnit &unit,
+                                        const ConstantTable &constants) {
+  InterfaceIndex index;
+  for (const auto &item : unit.items()) {
+    if (item && item->kind() == ast::NodeKind::NK_DeclareBlock) {
+      const auto &db = static_cast<const ast::DeclareBlock &>(*item);
+      if (!db.name().empty()) {
+        index.add(InterfaceSummary::fromDeclare(db, constants));
+      }
+    }
+  }
+  return index;
+}
+
+} // namespace nsl::sema
@@ -0,0 +1,247 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/LazySema.cpp — demand-driven Sema. See `LazySema` in
+// Sema.h.
+//
+// The resolution pass runs through `IncrementalResolution`, one
+// top-level item at a time and always in source order, reporting
+// into a private engine; the end of each item's diagnostics there is
+// recorded so they can be handed out per item. Constraint checks go
+// through the per-item path behind `SemaCache`, and `finish()`
+// replays both in the order `Sema::run()` emits them: resolution
+// first, then each `Sn` across the items. The walk also lists every
+// expression it visits, which is how `exprAt()` maps a location back
+// to a node.
+
+#include "nsl/Sema/Sema.h"
+
+#include "ConstraintCheckRegistry.h"
+#include "ResolutionPass.h"
+#include "SemaTimer.h"
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/Decl.h"
+#include "nsl/AST/Expr.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Sema/SymbolTable.h"
+#include "nsl/Sema/TypeSystem.h"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nsl::sema {
+
+namespace {
+
+constexpr std::size_t kAllItems = std::numeric_limits<std::size_t>::max();
+
+} // namespace
+
+struct LazySema::Impl {
+  Impl(ast::CompilationUnit &unit, DiagnosticEngine &diag,
+       const InterfaceIndex *interfaces, SemaStatistics *stats)
+      : unit(unit), diag(diag), stats(stats),
+        symbols(std::make_unique<SymbolTable>()),
+        types(std::make_unique<TypeSystem>()), buffer(diag.sourceManager()),
+        resolution(unit, *symbols, *types, buffer, resolutions, constants,
+                   interfaces, stats),
+        checked(unit.items().size()), reported(unit.items().size()) {
+    resolution.recordWalkedExprs(&walked);
+  }
+
+  ast::CompilationUnit &unit;
+  DiagnosticEngine &diag;
+  SemaStatistics *stats;
+  std::unique_ptr<SymbolTable> symbols;
+  std::unique_ptr<TypeSystem> types;
+  ResolutionTable resolutions;
+  ConstantTable constants;
+  /// Resolution diagnostics, held back until `finish()`.
+  DiagnosticEngine buffer;
+  /// End of each resolved item's diagnostics in `buffer`.
+  std::vector<std::size_t> resolvedEnd;
+  IncrementalResolution resolution;
+  /// Every expression resolved so far, outer before inner.
+  std::vector<const ast::Expr *> walked;
+  /// Constraint output of each item checked so far.
+  std::vector<std::optional<ItemDiagnostics>> checked;
+  std::size_t numChecked = 0;
+  /// `diagnosticsFor()` answers, by item.
+  std::vector<std::optional<std::vector<Diagnostic>>> reported;
+
+  void resolveThrough(std::size_t index) {
+    ScopedTimer timer(stats != nullptr ? &stats->resolutionSeconds
+                                       : nullptr);
+    const std::size_t n = unit.items().size();
+    while (!resolution.done() && resolution.resolvedItems() <= index) {
+      const std::size_t next = resolution.resolvedItems();
+      resolution.resolveThrough(next);
+      if (next < n) {
+        resolvedEnd.push_back(buffer.diagnostics().size());
+      }
+    }
+  }
+
+  std::optional<std::size_t> itemAt(SourceLocation loc) const {
+    if (!loc.isValid()) {
+      return std::nullopt;
+    }
+    const auto &items = unit.items();
+    for (std::size_t i = 0; i < items.size(); ++i) {
+      const SourceRange r = items[i] ? items[i]->loc() : SourceRange();
+      if (r.isValid() && r.begin().file() == loc.file() &&
+          r.begin().offset() <= loc.offset() &&
+          loc.offset() <= r.end().offset()) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  /// Resolve up to the item holding `e`; everything when none does
+  /// (an expression built outside the parser).
+  void resolveFor(const ast::Expr &e) {
+    resolveThrough(itemAt(e.loc().begin()).value_or(kAllItems));
+  }
+
+  ConstraintContext context(DiagnosticEngine &to) {
+    ConstraintContext ctx{&unit, symbols.get(), types.get(), &resolutions,
+                          &to};
+    ctx.stats = stats;
+    return ctx;
+  }
+};
+
+namespace {
+
+/// `SemaStatistics` reset for a new run, as `Sema::run()` does.
+SemaStatistics *reset(SemaStatistics *stats) {
+  if (stats != nullptr) {
+    *stats = SemaStatistics();
+  }
+  return stats;
+}
+
+} // namespace
+
+LazySema::LazySema(ast::CompilationUnit &unit, DiagnosticEngine &diag,
+                   const InterfaceIndex *interfaces, SemaStatistics *stats)
+    : impl_(std::make_unique<Impl>(unit, diag, interfaces, reset(stats))) {}
+
+LazySema::~LazySema() = default;
+
+std::optional<std::size_t> LazySema::itemAt(SourceLocation loc) const {
+  return impl_->itemAt(loc);
+}
+
+void LazySema::resolveThrough(std::size_t index) {
+  impl_->resolveThrough(index);
+}
+
+const Symbol *LazySema::resolve(const ast::Expr &e) {
+  impl_->resolveFor(e);
+  return impl_->resolutions.lookup(e);
+}
+
+TypeRef LazySema::typeOf(const ast::Expr &e) {
+  impl_->resolveFor(e);
+  return e.inferredType();
+}
+
+const ast::Expr *LazySema::exprAt(SourceLocation loc) {
+  Impl &s = *impl_;
+  const std::optional<std::size_t> item = s.itemAt(loc);
+  if (!item) {
+    return nullptr;
+  }
+  s.resolveThrough(*item);
+  // Inner expressions follow the outer ones they sit in, so the last
+  // of the narrowest matches is the innermost.
+  const ast::Expr *best = nullptr;
+  uint32_t bestSize = 0;
+  for (const ast::Expr *e : s.walked) {
+    const SourceRange r = e->loc();
+    if (!r.isValid() || r.begin().file() != loc.file() ||
+        loc.offset() < r.begin().offset() || loc.offset() > r.end().offset()) {
+      continue;
+    }
+    const uint32_t size = r.end().offset() - r.begin().offset();
+    if (best == nullptr || size <= bestSize) {
+      best = e;
+      bestSize = size;
+    }
+  }
+  return best;
+}
+
+const std::vector<Diagnostic> &LazySema::diagnosticsFor(std::size_t index) {
+  Impl &s = *impl_;
+  if (index >= s.reported.size()) {
+    static const std::vector<Diagnostic> kNone;
+    return kNone;
+  }
+  if (s.reported[index]) {
+    return *s.reported[index];
+  }
+  s.resolveThrough(index);
+  if (!s.checked[index]) {
+    ScopedTimer timer(s.stats != nullptr ? &s.stats->constraintSeconds
+                                         : nullptr);
+    s.checked[index] = checkConstraintsForItem(s.context(s.buffer), index);
+    ++s.numChecked;
+  }
+
+  std::vector<Diagnostic> out;
+  llvm::ArrayRef<Diagnostic> resolved = s.buffer.diagnostics();
+  const std::size_t begin = index == 0 ? 0 : s.resolvedEnd[index - 1];
+  out.assign(resolved.begin() + begin,
+             resolved.begin() + s.resolvedEnd[index]);
+  const ItemDiagnostics &item = *s.checked[index];
+  for (std::size_t v = 0; v < item.walk.size(); ++v) {
+    out.insert(out.end(), item.walk[v].begin(), item.walk[v].end());
+    out.insert(out.end(), item.finish[v].begin(), item.finish[v].end());
+  }
+  s.reported[index] = std::move(out);
+  return *s.reported[index];
+}
+
+std::size_t LazySema::resolvedItems() const noexcept {
+  return impl_->resolution.resolvedItems();
+}
+
+std::size_t LazySema::checkedItems() const noexcept {
+  return impl_->numChecked;
+}
+
+SemaResult LazySema::finish() {
+  Impl &s = *impl_;
+  s.resolveThrough(kAllItems);
+  for (const Diagnostic &d : s.buffer.diagnostics()) {
+    replayDiagnostic(d, s.diag);
+  }
+  {
+    ScopedTimer timer(s.stats != nullptr ? &s.stats->constraintSeconds
+                                         : nullptr);
+    runConstraintsByItem(s.context(s.diag), s.checked);
+  }
+  s.numChecked = s.checked.size();
+  if (s.stats != nullptr) {
+    s.stats->identifiers = s.symbols->identifiers().size();
+    s.stats->resolvedExprs = s.resolutions.numResolved();
+    s.stats->foldedConstants = s.constants.size();
+  }
+
+  SemaResult result;
+  result.interfaces = InterfaceIndex::fromUnit(s.unit, s.constants);
+  result.symbols = std::move(s.symbols);
+  result.types = std::move(s.types);
+  result.resolutions = std::move(s.resolutions);
+  result.constants = std::move(s.constants);
+  result.hasErrors = s.diag.hasError();
+  return result;
+}
+
+} // namespace nsl::sema
@@ -16,7 +16,7 @@
 //   3. Name resolution — `IdentifierExpr` / `FieldAccessExpr` /
 //      `ScopedName` heads call `SymbolTable::lookup` /
 //      `lookupScoped`. The resolved `Symbol*` is recorded in the
-//      `ResolutionMap`'s `exprToSymbol` side-table for printer
+//      run's `ResolutionTable` (slot = `Expr::ordinal()`) for printer
 //      consumption (per data-model §6 / `emit-ast-format.contract.md`
 //      Invariant 3). Unresolved names emit exactly ONE diagnostic
 //      per distinct name (FR-017 no-cascade) and tag the Expr's
@@ -44,6 +44,8 @@
 //      Invariant 6.
 
 #include "ResolutionPass.h"
+#include "ConstantEvaluator.h"
+#include "SemaTimer.h"
 
 #include "nsl/AST/AltBlock.h"
 #include "nsl/AST/AnyBlock.h"
@@ -112,6 +114,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -343,16 +346,50 @@ PortDirection mapPortDir(ast::PortDecl::Direction d) noexcept {
 class Walker {
 public:
   Walker(SymbolTable &table, TypeSystem &types, DiagnosticEngine &diag,
-         ResolutionMap &resolutionMap)
-      : table_(table), types_(types), diag_(diag), rmap_(resolutionMap) {}
-
-  void runUnit(const ast::CompilationUnit &cu);
+         ResolutionTable &resolutions, ConstantTable &constants,
+         const InterfaceIndex *interfaces, SemaStatistics *stats)
+      : table_(table), types_(types), diag_(diag), resolutions_(resolutions),
+        folded_(constants), constants_(table, constants),
+        interfaces_(interfaces), stats_(stats) {}
+
+  /// Index the unit's `declare` blocks and open its global scope.
+  void beginUnit(const ast::CompilationUnit &cu);
+  /// Walk one top-level item of the unit, in the global scope.
+  void visitItem(const ast::Decl &item);
+  /// Close the global scope.
+  void endUnit();
+
+  /// Append every expression visited from now on to `out`; null
+  /// stops.
+  void recordWalked(std::vector<const ast::Expr *> *out) { walked_ = out; }
 
 private:
   SymbolTable &table_;
   TypeSystem &types_;
   DiagnosticEngine &diag_;
-  ResolutionMap &rmap_;
+  ResolutionTable &resolutions_;
+  /// Everything folded so far; read when a use needs the width of a
+  /// declaration that was folded in another scope.
+  const ConstantTable &folded_;
+  /// Folds width-shaped expressions, resolving `param_int` names in
+  /// the scope being walked.
+  ConstantEvaluator constants_;
+  /// Summaries of `declare` blocks the unit does not contain.
+  const InterfaceIndex *interfaces_;
+  /// Template summary of each `submodule` instance whose `declare`
+  /// came from `interfaces_`.
+  llvm::DenseMap<const Symbol *, const InterfaceSummary *> submoduleIfaces_;
+  /// Where to time the walk and count the symbol-table traffic; null
+  /// when the run is not collecting statistics.
+  SemaStatistics *stats_;
+  /// Sink of `recordWalked`, or null.
+  std::vector<const ast::Expr *> *walked_ = nullptr;
+
+  /// The steps `stats_` times the walk in; empty without `stats_`.
+  enum Step { Index, Params, Structs, Declares, Modules, Other, NumSteps };
+  std::vector<SemaStatistics::Step> steps_;
+  /// Accumulator for the next item of `step`, or null.
+  double *stepTimer(Step step);
 
   /// Names that have already been reported as unresolved — per
   /// `sema-stability.contract.md` Invariant 6.
@@ -373,6 +410,39 @@ private:
   /// inherent-width-less Expr forms.
   std::vector<uint64_t> contextWidth_;
 
+  // ---------- Symbol-table access, counted into `stats_` ----------
+  template <typename S> bool declare(S &&sym) {
+    return counted(table_.declare(std::forward<S>(sym)));
+  }
+  template <typename S> bool declareInScope(ScopeKind kind, S &&sym) {
+    return counted(table_.declareInScope(kind, std::forward<S>(sym)));
+  }
+  void enterScope(ScopeKind kind) {
+    if (stats_ != nullptr) {
+      ++stats_->scopes;
+    }
+    table_.enterScope(kind);
+  }
+  Symbol *lookup(ast::Identifier name) {
+    return counted(table_.lookup(name));
+  }
+  Symbol *lookupScoped(const ast::ScopedName &name) {
+    return counted(table_.lookupScoped(name));
+  }
+  bool counted(bool declared) {
+    if (stats_ != nullptr) {
+      ++(declared ? stats_->symbols : stats_->duplicates);
+    }
+    return declared;
+  }
+  Symbol *counted(Symbol *found) {
+    if (stats_ != nullptr) {
+      ++stats_->lookups;
+      stats_->failedLookups += found == nullptr ? 1 : 0;
+    }
+    return found;
+  }
+
   // ---------- Top-level dispatch on Decl/Stmt/Expr base ----------
   void visitDecl(const ast::Decl &d);
   void visitStmt(const ast::Stmt &s);
@@ -399,6 +469,14 @@ private:
   void declProcDefn(const ast::ProcDefn &n);
   void declStateDefn(const ast::StateDefn &n);
 
+  /// Declare the ports and parameters of `iface` in the current
+  /// scope, as `declModuleBlock` does for a `declare` in the unit.
+  /// The symbols are located at `where`.
+  void importInterface(const InterfaceSummary &iface, SourceRange where);
+
+  /// Declare `raw`, or report a duplicate at `where`; true on success.
+  bool declareOrReport(Symbol *raw, SourceRange where);
+
   // ---------- Stmt handlers ----------
   void stmtTransfer(const ast::TransferStmt &n);
   void stmtIncDec(const ast::IncDecStmt &n);
@@ -439,7 +517,7 @@ private:
   /// return null.
   Symbol *resolveName(ast::Identifier name, SourceRange where);
 
-  /// Record a resolution into the `ResolutionMap` (no-op for null
+  /// Record a resolution into the `ResolutionTable` (no-op for null
   /// `sym`).
   void recordResolution(const ast::Expr &e, const Symbol *sym);
 
@@ -453,15 +531,24 @@ private:
   }
 
   /// Compute the declared width of a `width` expression that
-  /// accompanies a declaration (e.g., `reg q[8]`). Returns 0 if the
-  /// expression is null or not a literal — for M3 stubs, complex
-  /// width expressions resolve to `BitVector(1)` later.
-  uint64_t declaredWidth(const ast::Expr *width) const noexcept;
+  /// accompanies a declaration (e.g., `reg q[8]`, `reg q[W*2]`).
+  /// Returns 0 if the expression is null or does not fold to a
+  /// constant; callers then fall back to `BitVector(1)`.
+  uint64_t declaredWidth(const ast::Expr *width);
+
+  /// Folded value of a slice bound; 0 when it does not fold or does
+  /// not fit in 64 bits.
+  uint64_t bitIndex(const ast::Expr &index);
+
+  /// Declared width of port `port` of submodule `sub`'s template, or
+  /// 0 when the template, the port or its width is unknown.
+  uint64_t submodulePortWidth(const SubmoduleSymbol &sub,
+                              ast::Identifier port) const;
 };
 
-// ---------- Walker::runUnit + dispatch ----------
+// ---------- Walker unit walk + dispatch ----------
 
-void Walker::runUnit(const ast::CompilationUnit &cu) {
+void Walker::beginUnit(const ast::CompilationUnit &cu) {
   // Pre-pass: index every top-level `declare <name>` block by name
   // so the matching `module <name>` body (parsed before OR after the
   // declare in source order — both are valid per the EBNF) can
@@ -469,21 +556,72 @@ void Walker::runUnit(const ast::CompilationUnit &cu) {
   // scope. Without this pre-pass, references like `y = a & b;` in
   // a module body whose ports are declared in a sibling declare
   // block surface as "unresolved name" diagnostics.
-  for (const auto &item : cu.items()) {
-    if (item && item->kind() == ast::NodeKind::NK_DeclareBlock) {
-      const auto &db = static_cast<const ast::DeclareBlock &>(*item);
-      if (!db.name().empty()) {
-        declareByName_[db.name()] = &db;
+  //
+  // With statistics on, the pre-pass and the walk of each kind of
+  // top-level item are timed as separate steps.
+  if (stats_ != nullptr) {
+    steps_.resize(NumSteps);
+    steps_[Index].name = "declare index";
+    steps_[Params].name = "params";
+    steps_[Structs].name = "structs";
+    steps_[Declares].name = "declares";
+    steps_[Modules].name = "modules";
+    steps_[Other].name = "other";
+  }
+  {
+    ScopedTimer timer(stepTimer(Index));
+    for (const auto &item : cu.items()) {
+      if (item && item->kind() == ast::NodeKind::NK_DeclareBlock) {
+        const auto &db = static_cast<const ast::DeclareBlock &>(*item);
+        if (!db.name().empty()) {
+          declareByName_[db.name()] = &db;
+        }
       }
     }
   }
-  table_.enterScope(ScopeKind::Global);
-  for (const auto &item : cu.items()) {
-    if (item) {
-      visitDecl(*item);
-    }
+  if (!steps_.empty()) {
+    steps_[Index].items = declareByName_.size();
+  }
+  enterScope(ScopeKind::Global);
+}
+
+void Walker::visitItem(const ast::Decl &item) {
+  Step step = Other;
+  switch (item.kind()) {
+  case ast::NodeKind::NK_TopLevelParamDecl:
+    step = Params;
+    break;
+  case ast::NodeKind::NK_StructDecl:
+    step = Structs;
+    break;
+  case ast::NodeKind::NK_DeclareBlock:
+    step = Declares;
+    break;
+  case ast::NodeKind::NK_ModuleBlock:
+    step = Modules;
+    break;
+  default:
+    break;
   }
+  ScopedTimer timer(stepTimer(step));
+  visitDecl(item);
+}
+
+void Walker::endUnit() {
   table_.leaveScope();
+  if (stats_ != nullptr) {
+    for (SemaStatistics::Step &step : steps_) {
+      stats_->resolutionSteps.push_back(std::move(step));
+    }
+  }
+}
+
+double *Walker::stepTimer(Step step) {
+  if (steps_.empty()) {
+    return nullptr;
+  }
+  ++steps_[step].items;
+  return &steps_[step].seconds;
 }
 
 void Walker::visitDecl(const ast::Decl &d) {
@@ -581,6 +719,9 @@ void Walker::visitStmt(const ast::Stmt &s) {
 }
 
 void Walker::visitExpr(const ast::Expr &e) {
+  if (walked_ != nullptr) {
+    walked_->push_back(&e);
+  }
   switch (e.kind()) {
   case ast::NodeKind::NK_LiteralExpr:
     return exprLiteral(static_cast<const ast::LiteralExpr &>(e));
@@ -621,24 +762,35 @@ void Walker::visitExpr(const ast::Expr &e) {
 
 // ---------- Helpers ----------
 
-uint64_t Walker::declaredWidth(const ast::Expr *width) const noexcept {
-  if (!width) {
-    return 0;
-  }
-  if (width->kind() == ast::NodeKind::NK_LiteralExpr) {
-    const auto &lit = static_cast<const ast::LiteralExpr &>(*width);
-    if (lit.litKind() == ast::LiteralExpr::Lit::Decimal) {
-      return parseDecimal(lit.spelling());
-    }
-    if (lit.litKind() == ast::LiteralExpr::Lit::Hex) {
-      return parseHex(lit.spelling());
+uint64_t Walker::declaredWidth(const ast::Expr *width) {
+  return constants_.width(width);
+}
+
+uint64_t Walker::bitIndex(const ast::Expr &index) {
+  std::optional<llvm::APInt> v = constants_.evaluate(index);
+  return v && v->getActiveBits() <= 64 ? v->getZExtValue() : 0;
+}
+
+uint64_t Walker::submodulePortWidth(const SubmoduleSymbol &sub,
+                                    ast::Identifier port) const {
+  if (const ast::DeclareBlock *templ = sub.templateDecl()) {
+    for (const auto &p : templ->ports()) {
+      if (p && p->name() == port) {
+        // Folded when the `declare` was walked; a `declare` later in
+        // the unit than this use is not folded yet.
+        return folded_.width(p->width()).value_or(0);
+      }
     }
+    return 0;
   }
-  return 0;
+  auto it = submoduleIfaces_.find(&sub);
+  const InterfaceSummary::Port *p =
+      it != submoduleIfaces_.end() ? it->second->port(port) : nullptr;
+  return p != nullptr ? p->width : 0;
 }
 
 Symbol *Walker::resolveName(ast::Identifier name, SourceRange where) {
-  Symbol *sym = table_.lookup(name);
+  Symbol *sym = lookup(name);
   if (sym) {
     return sym;
   }
@@ -652,9 +804,16 @@ Symbol *Walker::resolveName(ast::Identifier name, SourceRange where) {
 }
 
 void Walker::recordResolution(const ast::Expr &e, const Symbol *sym) {
-  if (sym) {
-    rmap_.exprToSymbol.insert({&e, sym});
+  if (!sym) {
+    return;
+  }
+  // Parsed expressions arrive numbered; a hand-built one (unit tests
+  // assembling an AST directly) takes the next slot past the table.
+  // Same const_cast rationale as `markUnresolved`.
+  if (e.ordinal() == ast::Expr::kNoOrdinal) {
+    const_cast<ast::Expr &>(e).setOrdinal(resolutions_.size());
   }
+  resolutions_.record(e, sym);
 }
 
 void Walker::markUnresolved(const ast::Expr &e) {
@@ -669,22 +828,26 @@ void Walker::markUnresolved(const ast::Expr &e) {
 
 void Walker::declTopLevelParam(const ast::TopLevelParamDecl &n) {
   // Treated as an integer-shaped declaration in the global scope.
-  bool ok = table_.declare(std::make_unique<IntegerSymbol>(n.name(), n.loc()));
+  IntegerSymbol *sym = table_.create<IntegerSymbol>(n.name(), n.loc());
+  bool ok = declare(sym);
   if (!ok) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
     diag_.report(Severity::Error, n.loc().begin(), std::move(msg));
   }
+  if (n.paramKind() == ast::TopLevelParamDecl::ParamKind::Int) {
+    // Folded here, so the initialiser only sees earlier names.
+    constants_.bindParam(*sym, n.init());
+  }
   if (n.init()) {
     visitExpr(*n.init());
   }
 }
 
 void Walker::declStruct(const ast::StructDecl &n) {
-  auto sym = std::make_unique<StructTypeSymbol>(n.name(), n.loc());
-  StructTypeSymbol *raw = sym.get();
-  bool ok = table_.declare(std::move(sym));
+  StructTypeSymbol *raw = table_.create<StructTypeSymbol>(n.name(), n.loc());
+  bool ok = declare(raw);
   if (!ok) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
@@ -722,7 +885,7 @@ void Walker::declDeclareBlock(const ast::DeclareBlock &n) {
   // surface — actually, the design says DeclareBlocks are first-
   // class entities resolvable via a future SubmoduleDecl. For M3
   // we just open a Declare scope and recurse into ports.
-  table_.enterScope(ScopeKind::Declare);
+  enterScope(ScopeKind::Declare);
   for (const auto &param : n.headerParams()) {
     if (param) {
       visitDecl(*param);
@@ -737,7 +900,7 @@ void Walker::declDeclareBlock(const ast::DeclareBlock &n) {
 }
 
 void Walker::declModuleBlock(const ast::ModuleBlock &n) {
-  table_.enterScope(ScopeKind::Module);
+  enterScope(ScopeKind::Module);
   // Re-declare the matching `declare <name>` block's ports and
   // header-params into this Module scope so module-body references
   // resolve. The declare itself was already walked at top-level
@@ -759,6 +922,11 @@ void Walker::declModuleBlock(const ast::ModuleBlock &n) {
           visitDecl(*port);
         }
       }
+    } else if (const InterfaceSummary *iface =
+                   interfaces_ ? interfaces_->lookup(n.name()) : nullptr) {
+      // The `declare` lives in another file; its summary carries the
+      // same names and widths.
+      importInterface(*iface, n.loc());
     }
   }
   for (const auto &i : n.internals()) {
@@ -786,33 +954,91 @@ void Walker::declModuleBlock(const ast::ModuleBlock &n) {
   table_.leaveScope();
 }
 
+bool Walker::declareOrReport(Symbol *raw, SourceRange where) {
+  if (declare(raw)) {
+    return true;
+  }
+  std::string msg = "duplicate declaration of '";
+  msg += raw->name().str();
+  msg += "'";
+  diag_.report(Severity::Error, where.begin(), std::move(msg));
+  return false;
+}
+
+void Walker::importInterface(const InterfaceSummary &iface,
+                             SourceRange where) {
+  // Symbol names must outlive the index; intern them into the table.
+  auto own = [this](const std::string &s) { return table_.internName(s); };
+  for (const InterfaceSummary::Param &p : iface.params) {
+    auto *sym = table_.create<IntegerSymbol>(own(p.name), where);
+    if (!declareOrReport(sym, where)) {
+      continue;
+    }
+    llvm::APInt v;
+    if (!p.isString && !p.value.empty() &&
+        !llvm::StringRef(p.value).getAsInteger(10, v)) {
+      constants_.bindParam(*sym, v);
+    }
+  }
+  for (const InterfaceSummary::Port &p : iface.ports) {
+    const ast::Identifier name = own(p.name);
+    Symbol *raw = nullptr;
+    switch (p.direction) {
+    case InterfaceSummary::Direction::Input:
+      raw = table_.create<PortSymbol>(name, where, PortDirection::Input);
+      break;
+    case InterfaceSummary::Direction::Output:
+      raw = table_.create<PortSymbol>(name, where, PortDirection::Output);
+      break;
+    case InterfaceSummary::Direction::Inout:
+      raw = table_.create<PortSymbol>(name, where, PortDirection::Inout);
+      break;
+    case InterfaceSummary::Direction::FuncIn:
+      raw = table_.create<FuncInSymbol>(name, where);
+      break;
+    case InterfaceSummary::Direction::FuncOut:
+      raw = table_.create<FuncOutSymbol>(name, where);
+      break;
+    case InterfaceSummary::Direction::FuncSelf:
+      raw = table_.create<FuncSelfSymbol>(name, where);
+      break;
+    case InterfaceSummary::Direction::Wire:
+      raw = table_.create<WireSymbol>(name, where);
+      break;
+    }
+    if (raw == nullptr || !declareOrReport(raw, where)) {
+      continue;
+    }
+    raw->setType(p.width == 0 ? types_.bit() : types_.bitVector(p.width));
+  }
+}
+
 void Walker::declPort(const ast::PortDecl &n) {
-  std::unique_ptr<Symbol> sym;
+  Symbol *raw = nullptr;
   switch (n.direction()) {
   case ast::PortDecl::Direction::Input:
   case ast::PortDecl::Direction::Output:
   case ast::PortDecl::Direction::Inout:
-    sym = std::make_unique<PortSymbol>(n.name(), n.loc(),
-                                       mapPortDir(n.direction()));
+    raw = table_.create<PortSymbol>(n.name(), n.loc(),
+                                    mapPortDir(n.direction()));
     break;
   case ast::PortDecl::Direction::FuncIn:
-    sym = std::make_unique<FuncInSymbol>(n.name(), n.loc());
+    raw = table_.create<FuncInSymbol>(n.name(), n.loc());
     break;
   case ast::PortDecl::Direction::FuncOut:
-    sym = std::make_unique<FuncOutSymbol>(n.name(), n.loc());
+    raw = table_.create<FuncOutSymbol>(n.name(), n.loc());
     break;
   case ast::PortDecl::Direction::FuncSelf:
-    sym = std::make_unique<FuncSelfSymbol>(n.name(), n.loc());
+    raw = table_.create<FuncSelfSymbol>(n.name(), n.loc());
     break;
   case ast::PortDecl::Direction::Wire:
     // Wire-class declare-block terminal — model as a WireSymbol so
     // S4's func_self dummy-arg check can identify it. Width
     // defaults to bit if not set.
-    sym = std::make_unique<WireSymbol>(n.name(), n.loc());
+    raw = table_.create<WireSymbol>(n.name(), n.loc());
     break;
   }
-  Symbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -832,9 +1058,8 @@ void Walker::declPort(const ast::PortDecl &n) {
 }
 
 void Walker::declReg(const ast::RegDecl &n) {
-  auto sym = std::make_unique<RegSymbol>(n.name(), n.loc());
-  RegSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  RegSymbol *raw = table_.create<RegSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -858,9 +1083,8 @@ void Walker::declReg(const ast::RegDecl &n) {
 }
 
 void Walker::declWire(const ast::WireDecl &n) {
-  auto sym = std::make_unique<WireSymbol>(n.name(), n.loc());
-  WireSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  WireSymbol *raw = table_.create<WireSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -875,9 +1099,8 @@ void Walker::declWire(const ast::WireDecl &n) {
 }
 
 void Walker::declVariable(const ast::VariableDecl &n) {
-  auto sym = std::make_unique<VariableSymbol>(n.name(), n.loc());
-  VariableSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  VariableSymbol *raw = table_.create<VariableSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -892,9 +1115,8 @@ void Walker::declVariable(const ast::VariableDecl &n) {
 }
 
 void Walker::declInteger(const ast::IntegerDecl &n) {
-  auto sym = std::make_unique<IntegerSymbol>(n.name(), n.loc());
-  IntegerSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  IntegerSymbol *raw = table_.create<IntegerSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -906,9 +1128,8 @@ void Walker::declInteger(const ast::IntegerDecl &n) {
 }
 
 void Walker::declMem(const ast::MemDecl &n) {
-  auto sym = std::make_unique<MemSymbol>(n.name(), n.loc());
-  MemSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  MemSymbol *raw = table_.create<MemSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -936,9 +1157,8 @@ void Walker::declMem(const ast::MemDecl &n) {
 }
 
 void Walker::declFuncSelf(const ast::FuncSelfDecl &n) {
-  auto sym = std::make_unique<FuncSelfSymbol>(n.name(), n.loc());
-  FuncSelfSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  FuncSelfSymbol *raw = table_.create<FuncSelfSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -949,9 +1169,8 @@ void Walker::declFuncSelf(const ast::FuncSelfDecl &n) {
 }
 
 void Walker::declProcName(const ast::ProcNameDecl &n) {
-  auto sym = std::make_unique<ProcSymbol>(n.name(), n.loc());
-  ProcSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  ProcSymbol *raw = table_.create<ProcSymbol>(n.name(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.name().str();
     msg += "'";
@@ -965,15 +1184,14 @@ void Walker::declProcName(const ast::ProcNameDecl &n) {
 
 void Walker::declStateName(const ast::StateNameDecl &n) {
   for (auto name : n.names()) {
-    auto sym = std::make_unique<StateSymbol>(name, n.loc());
-    StateSymbol *raw = sym.get();
+    StateSymbol *raw = table_.create<StateSymbol>(name, n.loc());
     // Lift the state_name into the nearest enclosing Module scope
     // (rather than the proc's local scope) so references from
     // sibling func/proc/module-action bodies resolve. The S11
     // checker then enforces that the use site's enclosing proc is
     // the declaring proc — references from elsewhere fire S11
     // instead of cascading into "unresolved name" diagnostics.
-    if (!table_.declareInScope(ScopeKind::Module, std::move(sym))) {
+    if (!declareInScope(ScopeKind::Module, raw)) {
       std::string msg = "duplicate declaration of '";
       msg += name.str();
       msg += "'";
@@ -990,18 +1208,29 @@ void Walker::declFirstState(const ast::FirstStateDecl &n) {
 }
 
 void Walker::declSubmodule(const ast::SubmoduleDecl &n) {
-  // Each instance becomes a SubmoduleSymbol; templateDecl is left
-  // null at M3 (Phase 4 S20 / M5 lowering populates).
+  // Each instance becomes a SubmoduleSymbol. Its template is the
+  // unit's `declare` of that name; failing that, the indexed summary
+  // stands in for it (templateDecl stays null).
+  const ast::DeclareBlock *templ = nullptr;
+  const InterfaceSummary *iface = nullptr;
+  auto it = declareByName_.find(n.templateName());
+  if (it != declareByName_.end()) {
+    templ = it->second;
+  } else if (interfaces_ != nullptr) {
+    iface = interfaces_->lookup(n.templateName());
+  }
   for (const auto &inst : n.instances()) {
-    auto sym = std::make_unique<SubmoduleSymbol>(inst.name, n.loc(), nullptr);
-    SubmoduleSymbol *raw = sym.get();
-    if (!table_.declare(std::move(sym))) {
+    auto *raw = table_.create<SubmoduleSymbol>(inst.name, n.loc(), templ);
+    if (!declare(raw)) {
       std::string msg = "duplicate declaration of '";
       msg += inst.name.str();
       msg += "'";
       diag_.report(Severity::Error, n.loc().begin(), std::move(msg));
       continue;
     }
+    if (iface != nullptr) {
+      submoduleIfaces_[raw] = iface;
+    }
     raw->setType(types_.bit());
     if (inst.arraySize) {
       visitExpr(*inst.arraySize);
@@ -1015,9 +1244,8 @@ void Walker::declSubmodule(const ast::SubmoduleDecl &n) {
 }
 
 void Walker::declStructInst(const ast::StructInstDecl &n) {
-  auto sym = std::make_unique<RegSymbol>(n.instanceName(), n.loc());
-  RegSymbol *raw = sym.get();
-  if (!table_.declare(std::move(sym))) {
+  RegSymbol *raw = table_.create<RegSymbol>(n.instanceName(), n.loc());
+  if (!declare(raw)) {
     std::string msg = "duplicate declaration of '";
     msg += n.instanceName().str();
     msg += "'";
@@ -1039,16 +1267,15 @@ void Walker::declFuncDefn(const ast::FuncDefn &n) {
   // Single-part name → declare a FuncInSymbol if not already present.
   // Multi-part name (inst.func) → look up `inst` (Submodule) — Phase 4.
   if (n.name().parts.size() == 1) {
-    Symbol *existing = table_.lookup(n.name().parts.front());
+    Symbol *existing = lookup(n.name().parts.front());
     if (!existing) {
-      auto sym =
-          std::make_unique<FuncInSymbol>(n.name().parts.front(), n.loc());
-      FuncInSymbol *raw = sym.get();
-      table_.declare(std::move(sym));
+      auto *raw =
+          table_.create<FuncInSymbol>(n.name().parts.front(), n.loc());
+      declare(raw);
       raw->setType(types_.bit());
     }
   }
-  table_.enterScope(ScopeKind::Function);
+  enterScope(ScopeKind::Function);
   if (n.body()) {
     visitStmt(*n.body());
   }
@@ -1056,14 +1283,13 @@ void Walker::declFuncDefn(const ast::FuncDefn &n) {
 }
 
 void Walker::declProcDefn(const ast::ProcDefn &n) {
-  Symbol *existing = table_.lookup(n.name());
+  Symbol *existing = lookup(n.name());
   if (!existing) {
-    auto sym = std::make_unique<ProcSymbol>(n.name(), n.loc());
-    ProcSymbol *raw = sym.get();
-    table_.declare(std::move(sym));
+    ProcSymbol *raw = table_.create<ProcSymbol>(n.name(), n.loc());
+    declare(raw);
     raw->setType(types_.bit());
   }
-  table_.enterScope(ScopeKind::Proc);
+  enterScope(ScopeKind::Proc);
   if (n.body()) {
     visitStmt(*n.body());
   }
@@ -1074,7 +1300,7 @@ void Walker::declStateDefn(const ast::StateDefn &n) {
   // The state name should already be declared via StateNameDecl.
   // We open a new SeqOrParallel scope for the body so locals are
   // contained.
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   if (n.body()) {
     visitStmt(*n.body());
   }
@@ -1138,7 +1364,7 @@ void Walker::stmtReturn(const ast::ReturnStmt &n) {
 }
 
 void Walker::stmtSeq(const ast::SeqBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   for (const auto &item : n.items()) {
     if (item) {
       visitStmt(*item);
@@ -1148,7 +1374,7 @@ void Walker::stmtSeq(const ast::SeqBlock &n) {
 }
 
 void Walker::stmtParallel(const ast::ParallelBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   for (const auto &item : n.items()) {
     if (item) {
       visitStmt(*item);
@@ -1158,7 +1384,7 @@ void Walker::stmtParallel(const ast::ParallelBlock &n) {
 }
 
 void Walker::stmtAlt(const ast::AltBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   for (const auto &c : n.cases()) {
     if (c.cond) {
       visitExpr(*c.cond);
@@ -1174,7 +1400,7 @@ void Walker::stmtAlt(const ast::AltBlock &n) {
 }
 
 void Walker::stmtAny(const ast::AnyBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   for (const auto &c : n.cases()) {
     if (c.cond) {
       visitExpr(*c.cond);
@@ -1202,7 +1428,7 @@ void Walker::stmtIf(const ast::IfStmt &n) {
 }
 
 void Walker::stmtWhile(const ast::WhileBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   if (n.cond()) {
     visitExpr(*n.cond());
   }
@@ -1215,7 +1441,7 @@ void Walker::stmtWhile(const ast::WhileBlock &n) {
 }
 
 void Walker::stmtFor(const ast::ForBlock &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   if (n.form().init) {
     visitStmt(*n.form().init);
   }
@@ -1234,7 +1460,7 @@ void Walker::stmtFor(const ast::ForBlock &n) {
 }
 
 void Walker::stmtInitBlock(const ast::InitBlockStmt &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   for (const auto &item : n.items()) {
     if (item) {
       visitStmt(*item);
@@ -1256,16 +1482,15 @@ void Walker::stmtLabeled(const ast::LabeledStmt &n) {
 }
 
 void Walker::stmtStructuralGenerate(const ast::StructuralGenerate &n) {
-  table_.enterScope(ScopeKind::SeqOrParallel);
+  enterScope(ScopeKind::SeqOrParallel);
   // Register the loop variable as an `integer` symbol per S10
   // (`generate` loop var must be integer). Without this, references
   // to the loop var inside cond / step / body fail name resolution
   // ("unresolved name 'i'"). The symbol is scoped to this generate
   // block and goes out of scope when we leaveScope() below.
   if (!n.init().empty()) {
-    auto sym = std::make_unique<IntegerSymbol>(n.init(), n.loc());
-    IntegerSymbol *raw = sym.get();
-    if (table_.declare(std::move(sym))) {
+    IntegerSymbol *raw = table_.create<IntegerSymbol>(n.init(), n.loc());
+    if (declare(raw)) {
       // Match `declInteger`'s host-int-sized BitVector(64) so that
       // `exprIdentifier` finds a non-null inferred type when
       // resolving references to the loop variable in cond / step /
@@ -1451,13 +1676,8 @@ void Walker::exprConcat(const ast::ConcatExpr &n) {
 void Walker::exprRepeat(const ast::RepeatExpr &n) {
   uint64_t count = 0;
   if (n.count()) {
+    count = declaredWidth(n.count());
     visitExpr(*n.count());
-    if (n.count()->kind() == ast::NodeKind::NK_LiteralExpr) {
-      const auto &lit = static_cast<const ast::LiteralExpr &>(*n.count());
-      if (lit.litKind() == ast::LiteralExpr::Lit::Decimal) {
-        count = parseDecimal(lit.spelling());
-      }
-    }
   }
   uint64_t bw = 0;
   if (n.body()) {
@@ -1511,23 +1731,14 @@ void Walker::exprSlice(const ast::SliceExpr &n) {
   }
   uint64_t hi = 0;
   uint64_t lo = 0;
+  // Bounds are bit indices, so 0 is a value here, not "unknown".
   if (n.hi()) {
+    hi = bitIndex(*n.hi());
     visitExpr(*n.hi());
-    if (n.hi()->kind() == ast::NodeKind::NK_LiteralExpr) {
-      const auto &lit = static_cast<const ast::LiteralExpr &>(*n.hi());
-      if (lit.litKind() == ast::LiteralExpr::Lit::Decimal) {
-        hi = parseDecimal(lit.spelling());
-      }
-    }
   }
   if (n.lo()) {
+    lo = bitIndex(*n.lo());
     visitExpr(*n.lo());
-    if (n.lo()->kind() == ast::NodeKind::NK_LiteralExpr) {
-      const auto &lit = static_cast<const ast::LiteralExpr &>(*n.lo());
-      if (lit.litKind() == ast::LiteralExpr::Lit::Decimal) {
-        lo = parseDecimal(lit.spelling());
-      }
-    }
   }
   uint64_t w = 0;
   if (n.lo()) {
@@ -1551,10 +1762,18 @@ void Walker::exprFieldAccess(const ast::FieldAccessExpr &n) {
   // BitVector(1). Phase 4 S18 walker refines using
   // StructTypeSymbol::fields().
   TypeRef t = n.obj() ? n.obj()->inferredType() : nullptr;
+  const Symbol *objSym = n.obj() ? resolutions_.lookup(*n.obj()) : nullptr;
+  const auto *sub =
+      objSym && objSym->kind() == SymbolKind::SK_Submodule
+          ? static_cast<const SubmoduleSymbol *>(objSym)
+          : nullptr;
   if (!t) {
     t = types_.bitVector(1);
   } else if (t->kind() == TypeKind::Unresolved) {
     t = types_.unresolved();
+  } else if (uint64_t w = sub ? submodulePortWidth(*sub, n.field()) : 0) {
+    // `SUB.port`: the port's declared width.
+    t = types_.bitVector(w);
   } else {
     // Default: treat field as 1-bit until S18 lands.
     t = types_.bitVector(1);
@@ -1571,7 +1790,7 @@ void Walker::exprCall(const ast::CallExpr &n) {
         recordResolution(n, sym);
       }
     } else {
-      Symbol *sym = table_.lookupScoped(target);
+      Symbol *sym = lookupScoped(target);
       if (sym) {
         recordResolution(n, sym);
       }
@@ -1592,7 +1811,7 @@ void Walker::exprStructCast(const ast::StructCastExpr &n) {
   if (n.sub()) {
     visitExpr(*n.sub());
   }
-  Symbol *sym = table_.lookup(n.typeName());
+  Symbol *sym = lookup(n.typeName());
   if (sym && sym->kind() == SymbolKind::SK_StructType) {
     const auto *sts = static_cast<const StructTypeSymbol *>(sym);
     const_cast<ast::StructCastExpr &>(n).setInferredType(
@@ -1620,48 +1839,61 @@ void Walker::exprIncDec(const ast::IncDecExpr &n) {
 // Public entry points
 // =====================================================================
 
-ResolutionMap runResolutionPassImpl(const ast::CompilationUnit &unit,
-                                    SymbolTable &symbols, TypeSystem &types,
-                                    DiagnosticEngine &diag) {
-  ResolutionMap rmap;
-  Walker walker(symbols, types, diag, rmap);
-  walker.runUnit(unit);
-  return rmap;
-}
+struct IncrementalResolution::Impl {
+  Impl(SymbolTable &symbols, TypeSystem &types, DiagnosticEngine &diag,
+       ResolutionTable &resolutions, ConstantTable &constants,
+       const InterfaceIndex *interfaces, SemaStatistics *stats)
+      : walker(symbols, types, diag, resolutions, constants, interfaces,
+               stats) {}
 
-// TLS hook for the printer. Single-threaded compiler — no contention.
-namespace {
-thread_local const ResolutionMap *g_currentMap = nullptr;
-} // namespace
+  Walker walker;
+};
 
-const ResolutionMap *currentResolutionMap() noexcept {
-  return g_currentMap;
+IncrementalResolution::IncrementalResolution(
+    const ast::CompilationUnit &unit, SymbolTable &symbols, TypeSystem &types,
+    DiagnosticEngine &diag, ResolutionTable &resolutions,
+    ConstantTable &constants, const InterfaceIndex *interfaces,
+    SemaStatistics *stats)
+    : unit_(unit) {
+  resolutions.resize(unit.numExprOrdinals());
+  impl_ = std::make_unique<Impl>(symbols, types, diag, resolutions, constants,
+                                 interfaces, stats);
+  impl_->walker.beginUnit(unit);
 }
 
-void setCurrentResolutionMap(const ResolutionMap *map) noexcept {
-  g_currentMap = map;
+IncrementalResolution::~IncrementalResolution() = default;
+
+void IncrementalResolution::recordWalkedExprs(
+    std::vector<const ast::Expr *> *out) {
+  impl_->walker.recordWalked(out);
 }
 
-// Public wrapper consumed by `lib/Driver/EmitAST.cpp` (forward-
-// declared there to avoid pulling the private `ResolutionPass.h`
-// into the driver layer). Returns the resolved declaration's
-// `SourceRange` for `e` or an invalid range if unresolved.
-SourceRange lookupDeclLoc(const ast::Expr *e) noexcept {
-  if (!e) {
-    return SourceRange{};
-  }
-  const ResolutionMap *map = currentResolutionMap();
-  if (!map) {
-    return SourceRange{};
-  }
-  auto it = map->exprToSymbol.find(e);
-  if (it == map->exprToSymbol.end()) {
-    return SourceRange{};
-  }
-  if (!it->second) {
-    return SourceRange{};
+void IncrementalResolution::resolveThrough(std::size_t index) {
+  const auto &items = unit_.items();
+  for (; next_ < items.size() && next_ <= index; ++next_) {
+    if (items[next_]) {
+      impl_->walker.visitItem(*items[next_]);
+    }
   }
-  return it->second->declLoc();
+  if (next_ == items.size() && !closed_) {
+    impl_->walker.endUnit();
+    closed_ = true;
+  }
+}
+
+ResolutionTable runResolutionPassImpl(const ast::CompilationUnit &unit,
+                                      SymbolTable &symbols, TypeSystem &types,
+                                      DiagnosticEngine &diag,
+                                      ConstantTable *constants,
+                                      const InterfaceIndex *interfaces,
+                                      SemaStatistics *stats) {
+  ResolutionTable resolutions;
+  ConstantTable scratch;
+  IncrementalResolution pass(unit, symbols, types, diag, resolutions,
+                             constants != nullptr ? *constants : scratch,
+                             interfaces, stats);
+  pass.finish();
+  return resolutions;
 }
 
 } // namespace nsl::sema
@@ -15,20 +15,25 @@
 //       `ScopedName` to a `Symbol*` (writing it into a side-table
 //       — the AST nodes themselves are immutable in M3);
 //   (d) infers widths for every `Expr` (writing through
-//       `Expr::setInferredType()`);
+//       `Expr::setInferredType()`), folding width, depth and slice
+//       expressions to constants (`ConstantEvaluator.h`);
 //   (e) emits exactly one "unresolved name 'X'" diagnostic per
 //       distinct `X` per FR-017.
 //
-// The result of the walk is a `ResolutionMap` that the post-Sema
-// printer consumes. The map is owned by `Sema` (private state) so
-// it lives for the duration of the `CompilationUnit`.
+// The result of the walk is the run's `ResolutionTable` (declared
+// in `nsl/Sema/Sema.h`), which `Sema::run()` hands to the
+// `SemaResult` for the constraint checkers and the post-Sema
+// printer.
 
 #ifndef NSL_SEMA_RESOLUTION_PASS_H
 #define NSL_SEMA_RESOLUTION_PASS_H
 
-#include "nsl/Basic/SourceLocation.h"
+#include "nsl/Sema/Sema.h"
 
-#include "llvm/ADT/DenseMap.h"
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace nsl {
 class DiagnosticEngine;
@@ -41,27 +46,54 @@ class Expr;
 
 namespace nsl::sema {
 
-class Symbol;
 class SymbolTable;
 class TypeSystem;
 
-/// Side-table mapping resolved name-references (`IdentifierExpr`,
-/// `FieldAccessExpr` head, `ScopedName` head) to their declaring
-/// `Symbol*`. Populated by `runResolutionPass`; consumed by the
-/// post-Sema `-emit=ast` printer to render the
-/// `→ decl@<file>:<line>:<col>` suffix.
+/// The same pass walked one top-level item at a time, for
+/// `LazySema`. Items are walked strictly in source order, so after
+/// `resolveThrough(i)` the tables hold exactly what the one-shot
+/// pass holds when it finishes item `i`; `runResolutionPassImpl` is
+/// this class run through the last item.
 ///
-/// Pointer keys are stable for the lifetime of the surrounding
-/// `CompilationUnit` (AST nodes are owned by `unique_ptr<>` and
-/// never relocated). The map is iteration-order-deterministic in
-/// practice because the printer never iterates it — it only does
-/// per-key lookups during the deterministic AST walk.
-struct ResolutionMap {
-  /// `IdentifierExpr*` / `FieldAccessExpr*` keys mapped to the
-  /// resolved declaration's `Symbol*`. Null entries are not
-  /// inserted (lookup returning end() means "unresolved" — the
-  /// printer prints `Unresolved` and omits the decl-loc suffix).
-  llvm::DenseMap<const ast::Expr *, const Symbol *> exprToSymbol;
+/// Construction runs the `declare` pre-pass and opens the global
+/// scope; the scope is closed once the last item is walked. Every
+/// reference passed in must outlive the object.
+class IncrementalResolution {
+public:
+  IncrementalResolution(const ast::CompilationUnit &unit,
+                        SymbolTable &symbols, TypeSystem &types,
+                        DiagnosticEngine &diag, ResolutionTable &resolutions,
+                        ConstantTable &constants,
+                        const InterfaceIndex *interfaces = nullptr,
+                        SemaStatistics *stats = nullptr);
+  ~IncrementalResolution();
+  IncrementalResolution(const IncrementalResolution &) = delete;
+  IncrementalResolution &operator=(const IncrementalResolution &) = delete;
+
+  /// Walk every item up to and including `index` that is not walked
+  /// yet. Does nothing for items already walked.
+  void resolveThrough(std::size_t index);
+
+  /// Walk the remaining items and close the global scope.
+  void finish() { resolveThrough(std::numeric_limits<std::size_t>::max()); }
+
+  /// Number of leading items walked so far.
+  [[nodiscard]] std::size_t resolvedItems() const noexcept { return next_; }
+
+  /// True once every item is walked and the global scope is closed.
+  [[nodiscard]] bool done() const noexcept { return closed_; }
+
+  /// Append every expression the walk visits from now on to `out`,
+  /// outer before inner; null stops.
+  void recordWalkedExprs(std::vector<const ast::Expr *> *out);
+
+private:
+  struct Impl;
+
+  const ast::CompilationUnit &unit_;
+  std::unique_ptr<Impl> impl_;
+  std::size_t next_ = 0;
+  bool closed_ = false;
 };
 
 /// Driver for the resolution + width-inference pass.
@@ -72,27 +104,36 @@ struct ResolutionMap {
 /// / `unresolved()` on it); `diag` (diagnostic surface for
 /// "unresolved name" / "duplicate name" reports).
 ///
-/// Output: a populated `ResolutionMap` for printer consumption.
+/// Output: the run's `ResolutionTable`, sized to the unit's
+/// `numExprOrdinals()` and grown for any hand-built expression the
+/// walk numbers on the fly.
 ///
-/// Side effects on the AST: `Expr::setInferredType(...)` is called
-/// on every `Expr` reached during the walk. Other AST slots are
-/// not mutated.
-ResolutionMap runResolutionPassImpl(const ast::CompilationUnit &unit,
-                                    SymbolTable &symbols, TypeSystem &types,
-                                    DiagnosticEngine &diag);
-
-/// Thread-local accessor used by the printer (`lib/AST/Printer.cpp`)
-/// to look up the resolution data for a given AST node. Set by
-/// `Sema::run()` before the printer is invoked; cleared after.
+/// When `constants` is given, every width, depth, repeat count and
+/// slice bound the walk folds (and each `param_int` initialiser) is
+/// recorded there; without it the folding still drives the inferred
+/// types but is not kept.
+///
+/// `interfaces` stands in for `declare` blocks the unit does not
+/// contain: a `module` without a `declare` in the unit imports the
+/// ports and parameters of the indexed summary of its name, and
+/// `SUB.port` on a `submodule` of an indexed template gets the
+/// port's width. A `declare` in the unit always wins.
 ///
-/// Why TLS rather than a parameter: the public `nsl::ast::print`
-/// signature in `include/nsl/AST/Printer.h` is M2-frozen; the
-/// post-Sema enrichments are additive and the printer detects
-/// them dynamically. The TLS pointer is null in the pre-Sema
-/// (M2) print mode, non-null post-Sema. Single-threaded compiler
-/// → no contention.
-const ResolutionMap *currentResolutionMap() noexcept;
-void setCurrentResolutionMap(const ResolutionMap *map) noexcept;
+/// When `stats` is given, the walk is timed per top-level item kind
+/// (appended to `resolutionSteps`) and every declaration, scope and
+/// name lookup is counted into it.
+///
+/// Side effects on the AST: `Expr::setInferredType(...)` is called
+/// on every `Expr` reached during the walk, and a resolved name-
+/// reference built outside the parser gets its `Expr::ordinal()`
+/// stamped. Other AST slots are not mutated.
+ResolutionTable runResolutionPassImpl(const ast::CompilationUnit &unit,
+                                      SymbolTable &symbols, TypeSystem &types,
+                                      DiagnosticEngine &diag,
+                                      ConstantTable *constants = nullptr,
+                                      const InterfaceIndex *interfaces =
+                                          nullptr,
+                                      SemaStatistics *stats = nullptr);
 
 } // namespace nsl::sema
 
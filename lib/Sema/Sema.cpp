@@ -17,7 +17,9 @@
 
 #include "ConstraintCheckRegistry.h"
 #include "ResolutionPass.h"
+#include "SemaTimer.h"
 #include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/Expr.h"
 #include "nsl/AST/IdentifierExpr.h"
 #include "nsl/Basic/Diagnostic.h"
 #include "nsl/Sema/SymbolTable.h"
@@ -29,20 +31,58 @@
 
 namespace nsl::sema {
 
-namespace {
+// ---------- ResolutionTable ----------
 
-/// Storage for the most-recent run's `ResolutionMap`, kept alive
-/// for the duration of the post-Sema printer invocation. The
-/// Printer reads this via `currentResolutionMap()`. Single-threaded
-/// compiler so a thread-local is sufficient; LSP-tier callers MUST
-/// drive Sema and the printer on the same thread (per
-/// `sema-stability.contract.md` Invariant 8).
-thread_local std::unique_ptr<ResolutionMap> g_lastRunMap;
+const Symbol *ResolutionTable::lookup(const ast::Expr &e) const noexcept {
+  uint32_t const slot = e.ordinal();
+  return slot < bySlot_.size() ? bySlot_[slot] : nullptr;
+}
+
+SourceRange ResolutionTable::declLoc(const ast::Expr *e) const noexcept {
+  const Symbol *sym = e != nullptr ? lookup(*e) : nullptr;
+  return sym != nullptr ? sym->declLoc() : SourceRange{};
+}
+
+void ResolutionTable::record(const ast::Expr &e, const Symbol *sym) {
+  uint32_t const slot = e.ordinal();
+  assert(slot != ast::Expr::kNoOrdinal && "recording an unnumbered Expr");
+  if (sym == nullptr) {
+    return;
+  }
+  if (slot >= bySlot_.size()) {
+    bySlot_.resize(slot + 1, nullptr);
+  }
+  if (bySlot_[slot] == nullptr) {
+    bySlot_[slot] = sym;
+    ++numResolved_;
+  }
+}
+
+// ---------- ConstantTable ----------
 
-} // namespace
+const llvm::APInt *ConstantTable::lookup(const ast::Expr &e) const {
+  auto it = values_.find(&e);
+  return it != values_.end() ? &it->second : nullptr;
+}
 
-Sema::Sema(DiagnosticEngine &diag)
-    : diag_(diag), symbols_(std::make_unique<SymbolTable>()),
+std::optional<uint64_t> ConstantTable::width(const ast::Expr *e) const {
+  const llvm::APInt *v = e != nullptr ? lookup(*e) : nullptr;
+  if (v == nullptr || v->isZero() || v->getActiveBits() > 64) {
+    return std::nullopt;
+  }
+  return v->getZExtValue();
+}
+
+void ConstantTable::record(const ast::Expr &e, const llvm::APInt &value) {
+  values_.try_emplace(&e, value);
+}
+
+// ---------- Sema ----------
+
+Sema::Sema(DiagnosticEngine &diag, SemaCache *cache,
+           const InterfaceIndex *interfaces)
+    : diag_(diag), cache_(cache), interfaces_(interfaces),
+      symbols_(std::make_unique<SymbolTable>()),
       types_(std::make_unique<TypeSystem>()) {}
 
 Sema::~Sema() = default;
@@ -57,8 +97,24 @@ SemaResult Sema::run(ast::CompilationUnit &unit) {
   // Phase 2 stub orchestration: invoke the two stages so the layout
   // is in place; Phase 3 / Phase 4 fill the concrete bodies. Both
   // stubs are no-ops here.
-  runResolutionPass(unit);
-  runConstraintPasses(unit);
+  if (stats_ != nullptr) {
+    *stats_ = SemaStatistics();
+  }
+  {
+    ScopedTimer timer(stats_ != nullptr ? &stats_->resolutionSeconds
+                                        : nullptr);
+    runResolutionPass(unit);
+  }
+  {
+    ScopedTimer timer(stats_ != nullptr ? &stats_->constraintSeconds
+                                        : nullptr);
+    runConstraintPasses(unit);
+  }
+  if (stats_ != nullptr) {
+    stats_->identifiers = symbols_->identifiers().size();
+    stats_->resolvedExprs = resolutions_.numResolved();
+    stats_->foldedConstants = constants_.size();
+  }
 
   // Snapshot diagnostic state (Invariant 7). `hasError()` returns
   // true iff any error-severity diagnostic was emitted; warnings
@@ -71,8 +127,11 @@ SemaResult Sema::run(ast::CompilationUnit &unit) {
   // the result. After this, `*this` no longer owns either. Calling
   // `run()` a second time would assert at the top of this method.
   SemaResult result;
+  result.interfaces = InterfaceIndex::fromUnit(unit, constants_);
   result.symbols = std::move(symbols_);
   result.types = std::move(types_);
+  result.resolutions = std::move(resolutions_);
+  result.constants = std::move(constants_);
   result.hasErrors = errs;
   return result;
 }
@@ -80,23 +139,18 @@ SemaResult Sema::run(ast::CompilationUnit &unit) {
 ClassifierKind
 Sema::classifyIdentifierExpr(const ast::IdentifierExpr &expr) const {
   // Phase 4b T070 implementation. Resolve `expr.name()` via the
-  // resolution map (set by the Phase 3 ResolutionPass) and return
+  // resolution table (set by the Phase 3 ResolutionPass) and return
   // `ControlTerminalTap` when the resolved Symbol's kind is one of
   // FuncIn / FuncOut / FuncSelf / Proc; otherwise `Value`.
-  const ResolutionMap *map = currentResolutionMap();
-  if (map != nullptr) {
-    auto it = map->exprToSymbol.find(&expr);
-    if (it != map->exprToSymbol.end() && it->second != nullptr) {
-      const Symbol *sym = it->second;
-      switch (sym->kind()) {
-      case SymbolKind::SK_FuncIn:
-      case SymbolKind::SK_FuncOut:
-      case SymbolKind::SK_FuncSelf:
-      case SymbolKind::SK_Proc:
-        return ClassifierKind::ControlTerminalTap;
-      default:
-        return ClassifierKind::Value;
-      }
+  if (const Symbol *sym = resolutions_.lookup(expr)) {
+    switch (sym->kind()) {
+    case SymbolKind::SK_FuncIn:
+    case SymbolKind::SK_FuncOut:
+    case SymbolKind::SK_FuncSelf:
+    case SymbolKind::SK_Proc:
+      return ClassifierKind::ControlTerminalTap;
+    default:
+      return ClassifierKind::Value;
     }
   }
   // Fallback: probe the symbol table directly. Useful for tests that
@@ -123,28 +177,37 @@ Sema::classifyIdentifierExpr(const ast::IdentifierExpr &expr) const {
 void Sema::runResolutionPass(ast::CompilationUnit &unit) {
   // Phase 3 (T026-T030): invoke the top-down ASTVisitor walker
   // that opens scopes, declares symbols, resolves names, and
-  // infers widths. The result map is stashed in the thread-local
-  // `g_lastRunMap` so the post-Sema `-emit=ast` printer can
-  // consume it via `currentResolutionMap()`.
+  // infers widths. The resolutions land in this run's own table,
+  // which `run()` hands to the `SemaResult` for the post-Sema
+  // `-emit=ast` printer; the widths it folds go to lowering.
+  // `declare` blocks the unit lacks come from `interfaces_`.
   assert(symbols_ && types_ && "runResolutionPass after ownership transfer");
-  auto map = std::make_unique<ResolutionMap>(
-      runResolutionPassImpl(unit, *symbols_, *types_, diag_));
-  g_lastRunMap = std::move(map);
-  setCurrentResolutionMap(g_lastRunMap.get());
+  resolutions_ = runResolutionPassImpl(unit, *symbols_, *types_, diag_,
+                                       &constants_, interfaces_, stats_);
 }
 
 void Sema::runConstraintPasses(ast::CompilationUnit &unit) {
-  // Fan out over every per-`Sn` walker registered at static-init
-  // time via `NSL_REGISTER_CONSTRAINT`. The registry iterates in
-  // Sn-numeric order (deterministic per Principle V); each walker
-  // reads `ctx` (immutable post-resolution view) and emits any
-  // S<NN> diagnostics into `ctx.diag`.
+  // Drive every per-`Sn` checker registered at static-init time via
+  // `NSL_REGISTER_CONSTRAINT` from one fused traversal. Diagnostics
+  // land in Sn-numeric order (deterministic per Principle V); each
+  // checker reads `ctx` (immutable post-resolution view) and emits
+  // any S<NN> diagnostics into `ctx.diag`. With a `SemaCache`, the
+  // checkers run per module instead and skip the unchanged ones.
   ConstraintContext ctx;
   ctx.unit = &unit;
   ctx.symbols = symbols_.get();
   ctx.types = types_.get();
-  ctx.resolutions = g_lastRunMap.get();
+  ctx.resolutions = &resolutions_;
   ctx.diag = &diag_;
+  ctx.stats = stats_;
+  if (cache_ != nullptr) {
+    cache_->runConstraints(ctx, interfaces_);
+    if (stats_ != nullptr) {
+      stats_->cachedModules = cache_->lastHits();
+      stats_->checkedModules = cache_->lastMisses();
+    }
+    return;
+  }
   runAllConstraints(ctx);
 }
 
@@ -0,0 +1,261 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/SemaCache.cpp — per-module cache of the constraint stage.
+//
+// Each run first hashes what the checkers can see outside a module
+// (see `SemaCache` in Sema.h) and drops every entry if that changed.
+// Modules whose text is cached get their old diagnostics back,
+// shifted from where the module sat then to where it sits now;
+// `runConstraintsByItem` checks the rest and replays everything in
+// the order the uncached path would have emitted it. Freshly checked
+// modules are stored back, relative to their own start.
+
+#include "nsl/Sema/Sema.h"
+
+#include "ConstraintCheckRegistry.h"
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/Decl.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Sema/SymbolTable.h"
+#include "nsl/Sema/TypeSystem.h"
+
+#include "llvm/ADT/Hashing.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace nsl::sema {
+
+struct SemaCache::Impl {
+  /// One module's diagnostics, located as they were when it was
+  /// checked with its first byte at `origin`.
+  struct Entry {
+    SourceLocation origin;
+    ItemDiagnostics diags;
+    bool used = false;
+  };
+
+  /// Keyed by the module's source text.
+  llvm::StringMap<Entry> modules;
+  /// Environment key the entries were computed under.
+  llvm::hash_code env = llvm::hash_code(0);
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+};
+
+namespace {
+
+bool isModule(const std::unique_ptr<ast::Decl> &d) {
+  return d && d->kind() == ast::NodeKind::NK_ModuleBlock;
+}
+
+/// Source text of `d`; empty when its range does not map to one.
+llvm::StringRef itemText(const ast::Decl &d, const SourceManager &sm) {
+  const SourceRange r = d.loc();
+  if (!r.isValid()) {
+    return {};
+  }
+  llvm::StringRef buf = sm.getBuffer(r.begin().file());
+  if (r.end().offset() > buf.size()) {
+    return {};
+  }
+  return buf.slice(r.begin().offset(), r.end().offset());
+}
+
+/// Structural hash of `t`; struct `TypeRef`s (and memories of them)
+/// are per run, so the pointer itself cannot be the key.
+llvm::hash_code hashType(TypeRef t) {
+  if (t == nullptr) {
+    return llvm::hash_code(0);
+  }
+  const auto kind = static_cast<unsigned>(t->kind());
+  switch (t->kind()) {
+  case TypeKind::BitVector:
+    return llvm::hash_combine(
+        kind, static_cast<const BitVectorType *>(t)->width());
+  case TypeKind::Struct:
+    return llvm::hash_combine(kind,
+                              static_cast<const StructType *>(t)->name());
+  case TypeKind::Memory: {
+    const auto *m = static_cast<const MemoryType *>(t);
+    return llvm::hash_combine(kind, m->depth(), hashType(m->element()));
+  }
+  default:
+    return llvm::hash_combine(kind);
+  }
+}
+
+/// Everything a checker may read about the unit beyond the module it
+/// is checking: the non-module items, the `Global`-scope bindings
+/// every module can see, and the checkers' own cross-item state.
+/// Names bound inside a module stay out, so a local edit in one
+/// module leaves the others cached.
+llvm::hash_code environmentKey(const ConstraintContext &ctx,
+                               const SourceManager &sm) {
+  llvm::hash_code h = crossItemKey(ctx);
+  for (const auto &item : ctx.unit->items()) {
+    if (!isModule(item)) {
+      h = llvm::hash_combine(h, item ? itemText(*item, sm) : "");
+    }
+  }
+  if (const Scope *global = ctx.symbols->globalScope()) {
+    for (const Symbol *sym : global->declOrder()) {
+      h = llvm::hash_combine(h, sym->name(),
+                             static_cast<unsigned>(sym->kind()),
+                             hashType(sym->type()));
+    }
+  }
+  return h;
+}
+
+/// True iff `loc` lies in `r`, end included.
+bool within(SourceLocation loc, SourceRange r) {
+  return loc.isValid() && loc.file() == r.begin().file() &&
+         loc.offset() >= r.begin().offset() &&
+         loc.offset() <= r.end().offset();
+}
+
+/// True iff everything `d` points at lies in `r`. Included-from
+/// notes are ignored; replay re-derives them.
+bool within(const Diagnostic &d, SourceRange r) {
+  if (!within(d.loc, r)) {
+    return false;
+  }
+  for (const FixItHint &f : d.fixits) {
+    if (!within(f.range.begin(), r) || !within(f.range.end(), r)) {
+      return false;
+    }
+  }
+  for (const Diagnostic &n : d.notes) {
+    if (!n.is_include_from_note && !within(n, r)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool within(const ItemDiagnostics &item, SourceRange r) {
+  for (const auto *lists : {&item.walk, &item.finish}) {
+    for (const std::vector<Diagnostic> &list : *lists) {
+      for (const Diagnostic &d : list) {
+        if (!within(d, r)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+SourceLocation shift(SourceLocation loc, SourceLocation from,
+                     SourceLocation to) {
+  return SourceLocation::make(to.file(),
+                              to.offset() + (loc.offset() - from.offset()));
+}
+
+void shift(Diagnostic &d, SourceLocation from, SourceLocation to) {
+  d.loc = shift(d.loc, from, to);
+  for (FixItHint &f : d.fixits) {
+    f.range = SourceRange(shift(f.range.begin(), from, to),
+                          shift(f.range.end(), from, to));
+  }
+  for (Diagnostic &n : d.notes) {
+    if (!n.is_include_from_note) {
+      shift(n, from, to);
+    }
+  }
+}
+
+/// `item` moved from a module starting at `from` to one at `to`.
+ItemDiagnostics shift(ItemDiagnostics item, SourceLocation from,
+                      SourceLocation to) {
+  for (auto *lists : {&item.walk, &item.finish}) {
+    for (std::vector<Diagnostic> &list : *lists) {
+      for (Diagnostic &d : list) {
+        shift(d, from, to);
+      }
+    }
+  }
+  return item;
+}
+
+} // namespace
+
+SemaCache::SemaCache() : impl_(std::make_unique<Impl>()) {}
+
+SemaCache::~SemaCache() = default;
+
+std::size_t SemaCache::lastHits() const noexcept { return impl_->hits; }
+
+std::size_t SemaCache::lastMisses() const noexcept { return impl_->misses; }
+
+std::size_t SemaCache::size() const noexcept { return impl_->modules.size(); }
+
+void SemaCache::clear() { impl_->modules.clear(); }
+
+void SemaCache::runConstraints(const ConstraintContext &ctx,
+                               const InterfaceIndex *interfaces) {
+  Impl &c = *impl_;
+  c.hits = 0;
+  c.misses = 0;
+  if (ctx.unit == nullptr || ctx.symbols == nullptr || ctx.diag == nullptr) {
+    runAllConstraints(ctx);
+    return;
+  }
+  const SourceManager &sm = ctx.diag->sourceManager();
+  const llvm::hash_code env = llvm::hash_combine(
+      environmentKey(ctx, sm), interfaces ? interfaces->fingerprint() : 0);
+  if (env != c.env) {
+    c.modules.clear();
+    c.env = env;
+  }
+  for (auto &kv : c.modules) {
+    kv.getValue().used = false;
+  }
+
+  const auto &items = ctx.unit->items();
+  std::vector<std::optional<ItemDiagnostics>> slots(items.size());
+  std::vector<llvm::StringRef> missed(items.size());
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (!isModule(items[i])) {
+      continue;
+    }
+    const llvm::StringRef text = itemText(*items[i], sm);
+    auto it = text.empty() ? c.modules.end() : c.modules.find(text);
+    if (it == c.modules.end()) {
+      missed[i] = text;
+      ++c.misses;
+      continue;
+    }
+    Impl::Entry &e = it->getValue();
+    e.used = true;
+    slots[i] = shift(e.diags, e.origin, items[i]->loc().begin());
+    ++c.hits;
+  }
+
+  runConstraintsByItem(ctx, slots);
+
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    const SourceRange r = isModule(items[i]) ? items[i]->loc() : SourceRange();
+    if (missed[i].empty() || !within(*slots[i], r)) {
+      continue;
+    }
+    Impl::Entry &e = c.modules[missed[i]];
+    e.origin = r.begin();
+    e.diags = std::move(*slots[i]);
+    e.used = true;
+  }
+  for (auto it = c.modules.begin(), end = c.modules.end(); it != end;) {
+    auto cur = it++;
+    if (!cur->getValue().used) {
+      c.modules.erase(cur);
+    }
+  }
+}
+
+} // namespace nsl::sema
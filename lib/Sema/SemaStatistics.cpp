@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/SemaStatistics.cpp — `SemaStatistics` reports. See Sema.h.
+//
+// JSON layout:
+//
+//   {"resolution": {"seconds": 0.0012,
+//                   "steps": [{"name": "modules", "seconds": 0.0009,
+//                              "items": 3}, ...]},
+//    "constraints": {"seconds": 0.0031,
+//                    "checks": [{"sn": 1, "seconds": 0.0001,
+//                                "diagnostics": 0}, ...]},
+//    "counters": {"symbols": 42, ...}}
+//
+// Keys are written in a fixed order; only the times vary from run to
+// run.
+
+#include "nsl/Sema/Sema.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace nsl::sema {
+
+namespace {
+
+using Counter = std::pair<llvm::StringLiteral, uint64_t>;
+
+/// Every counter with its report name, in report order.
+std::array<Counter, 10> counters(const SemaStatistics &s) {
+  return {{{"symbols", s.symbols},
+           {"duplicates", s.duplicates},
+           {"scopes", s.scopes},
+           {"lookups", s.lookups},
+           {"failed_lookups", s.failedLookups},
+           {"identifiers", s.identifiers},
+           {"resolved_exprs", s.resolvedExprs},
+           {"folded_constants", s.foldedConstants},
+           {"cached_modules", s.cachedModules},
+           {"checked_modules", s.checkedModules}}};
+}
+
+/// One report row: the time, its share of `total`, and a label.
+void writeRow(llvm::raw_ostream &os, double seconds, double total,
+              llvm::StringRef label) {
+  const double percent = total > 0 ? 100.0 * seconds / total : 0.0;
+  os << llvm::formatv("{0,12:f6}  {1,6:f1}%  ", seconds, percent) << label
+     << '\n';
+}
+
+} // namespace
+
+SemaStatistics::Constraint &SemaStatistics::constraint(unsigned sn) {
+  auto it = std::lower_bound(
+      constraints.begin(), constraints.end(), sn,
+      [](const Constraint &c, unsigned key) { return c.sn < key; });
+  if (it == constraints.end() || it->sn != sn) {
+    Constraint c;
+    c.sn = sn;
+    it = constraints.insert(it, c);
+  }
+  return *it;
+}
+
+void SemaStatistics::writeText(llvm::raw_ostream &os) const {
+  const double total = resolutionSeconds + constraintSeconds;
+  os << "===-------------------------------------------------------===\n"
+     << "                     Sema time report\n"
+     << "===-------------------------------------------------------===\n"
+     << llvm::formatv("  Total: {0:f6} seconds\n\n", total)
+     << "    Wall Time      Share  Name\n";
+  writeRow(os, resolutionSeconds, total, "resolution");
+  for (const Step &s : resolutionSteps) {
+    writeRow(os, s.seconds, total,
+             llvm::formatv("  {0} ({1} items)", s.name, s.items).str());
+  }
+  writeRow(os, constraintSeconds, total, "constraints");
+  for (const Constraint &c : constraints) {
+    writeRow(os, c.seconds, total,
+             llvm::formatv("  S{0} ({1} diagnostics)", c.sn, c.diagnostics)
+                 .str());
+  }
+
+  os << "\n  Counters:\n";
+  for (const Counter &c : counters(*this)) {
+    os << llvm::formatv("{0,12}  {1}\n", c.second, c.first);
+  }
+}
+
+void SemaStatistics::writeJSON(llvm::raw_ostream &os) const {
+  llvm::json::OStream j(os);
+  j.object([&] {
+    j.attributeObject("resolution", [&] {
+      j.attribute("seconds", resolutionSeconds);
+      j.attributeArray("steps", [&] {
+        for (const Step &s : resolutionSteps) {
+          j.object([&] {
+            j.attribute("name", s.name);
+            j.attribute("seconds", s.seconds);
+            j.attribute("items", static_cast<int64_t>(s.items));
+          });
+        }
+      });
+    });
+    j.attributeObject("constraints", [&] {
+      j.attribute("seconds", constraintSeconds);
+      j.attributeArray("checks", [&] {
+        for (const Constraint &c : constraints) {
+          j.object([&] {
+            j.attribute("sn", static_cast<int64_t>(c.sn));
+            j.attribute("seconds", c.seconds);
+            j.attribute("diagnostics", static_cast<int64_t>(c.diagnostics));
+          });
+        }
+      });
+    });
+    j.attributeObject("counters", [&] {
+      for (const Counter &c : counters(*this)) {
+        j.attribute(c.first, static_cast<int64_t>(c.second));
+      }
+    });
+  });
+}
+
+} // namespace nsl::sema
@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Sema/SemaTimer.h — private impl header for the wall-clock
+// timer behind `SemaStatistics`. NOT a public header; lives under
+// `lib/Sema/` per the `sema-api.contract.md` Invariant 1 freeze on
+// `include/nsl/Sema/`.
+//
+// Every timed region takes a `double *` accumulator that is null
+// unless the run collects statistics, so an uninstrumented run pays
+// one branch per region and never reads the clock.
+
+#ifndef NSL_SEMA_SEMA_TIMER_H
+#define NSL_SEMA_SEMA_TIMER_H
+
+#include <chrono>
+
+namespace nsl::sema {
+
+/// Adds the seconds between construction and destruction to `*total`;
+/// does nothing when `total` is null.
+class ScopedTimer {
+public:
+  explicit ScopedTimer(double *total) : total_(total) {
+    if (total_ != nullptr) {
+      start_ = Clock::now();
+    }
+  }
+  ~ScopedTimer() {
+    if (total_ != nullptr) {
+      *total_ += std::chrono::duration<double>(Clock::now() - start_).count();
+    }
+  }
+  ScopedTimer(const ScopedTimer &) = delete;
+  ScopedTimer &operator=(const ScopedTimer &) = delete;
+  ScopedTimer(ScopedTimer &&) = delete;
+  ScopedTimer &operator=(ScopedTimer &&) = delete;
+
+private:
+  using Clock = std::chrono::steady_clock;
+  double *total_;
+  Clock::time_point start_;
+};
+
+} // namespace nsl::sema
+
+#endif // NSL_SEMA_SEMA_TIMER_H
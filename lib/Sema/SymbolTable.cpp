@@ -14,6 +14,8 @@
 #include "llvm/ADT/StringRef.h"
 
 #include <cassert>
+#include <cstddef>
+#include <optional>
 #include <utility>
 
 namespace nsl::sema {
@@ -44,35 +46,37 @@ llvm::StringRef toString(SymbolKind k) {
 }
 
 // -----------------------------------------------------------------
-// Scope
+// IdentifierTable
 // -----------------------------------------------------------------
 
-Symbol *Scope::lookupLocal(ast::Identifier name) const {
-  auto it = table_.find(name);
-  if (it == table_.end()) {
-    return nullptr;
+IdentID IdentifierTable::intern(ast::Identifier name) {
+  auto [it, inserted] =
+      ids_.try_emplace(name, static_cast<IdentID>(spellings_.size()));
+  if (inserted) {
+    spellings_.push_back(it->first());
   }
   return it->second;
 }
 
-bool Scope::insert(std::unique_ptr<Symbol> sym) {
-  assert(sym && "Scope::insert given null Symbol");
-  ast::Identifier const name = sym->name();
-  if (table_.find(name) != table_.end()) {
-    // Duplicate — caller emits any "duplicate name" diagnostic;
-    // Scope::insert is silent. The caller's `unique_ptr` is
-    // *retained* (not moved) on the false path so the source
-    // location of the failed declaration is recoverable.
-    return false;
+std::optional<IdentID> IdentifierTable::find(ast::Identifier name) const {
+  auto it = ids_.find(name);
+  if (it == ids_.end()) {
+    return std::nullopt;
   }
-  // Insert raw pointer first (DenseMap), then transfer ownership
-  // into ownedSymbols_ + declOrder_. This sequencing matters
-  // because `sym` is moved-from after the std::move call.
-  Symbol *raw = sym.get();
-  table_.insert({name, raw});
-  declOrder_.push_back(raw);
-  ownedSymbols_.push_back(std::move(sym));
-  return true;
+  return it->second;
+}
+
+// -----------------------------------------------------------------
+// Scope
+// -----------------------------------------------------------------
+
+Symbol *Scope::lookupLocal(ast::Identifier name) const {
+  for (Symbol *sym : declOrder_) {
+    if (sym->name() == name) {
+      return sym;
+    }
+  }
+  return nullptr;
 }
 
 // -----------------------------------------------------------------
@@ -80,7 +84,13 @@ bool Scope::insert(std::unique_ptr<Symbol> sym) {
 // -----------------------------------------------------------------
 
 SymbolTable::SymbolTable() = default;
-SymbolTable::~SymbolTable() = default;
+
+SymbolTable::~SymbolTable() {
+  // The arena only releases memory; run the destructors it skips.
+  for (Symbol *sym : arenaSymbols_) {
+    sym->~Symbol();
+  }
+}
 
 void SymbolTable::enterScope(ScopeKind kind, Symbol *owner) {
   Scope *parent = scopes_.empty() ? nullptr : scopes_.back().get();
@@ -89,27 +99,69 @@ void SymbolTable::enterScope(ScopeKind kind, Symbol *owner) {
 
 void SymbolTable::leaveScope() {
   assert(!scopes_.empty() && "leaveScope on empty stack");
+  // Unbind the scope's names: by stack discipline each one heads its
+  // shadow chain. The most recent retirement of a name wins the
+  // post-Sema fallback, matching an innermost-first search of the
+  // retired scopes in reverse retirement order.
+  Scope &top = *scopes_.back();
+  for (std::size_t i = 0; i < top.ids_.size(); ++i) {
+    IdentID id = top.ids_[i];
+    assert(live_[id] != nullptr && live_[id]->sym == top.declOrder_[i] &&
+           "leaveScope: binding is not the head of its chain");
+    live_[id] = live_[id]->shadowed;
+    retired_[id] = top.declOrder_[i];
+  }
   // Phase 3: retire the scope rather than destroy it. The Symbols
   // declared in this scope must outlive the resolution walk so the
   // post-Sema printer (and downstream Sn walkers / tooling) can
-  // consume `Symbol*` references stored in the `ResolutionMap`
-  // side-table. The retired scope is destroyed only when the
+  // consume `Symbol*` references stored in the run's
+  // `ResolutionTable`. The retired scope is destroyed only when the
   // SymbolTable itself is destroyed.
   retiredScopes_.push_back(std::move(scopes_.back()));
   scopes_.pop_back();
 }
 
-bool SymbolTable::declare(std::unique_ptr<Symbol> sym) {
+bool SymbolTable::bind(unsigned depth, Symbol *sym) {
+  IdentID id = idents_.intern(sym->name());
+  if (id >= live_.size()) {
+    live_.resize(id + 1U, nullptr);
+    retired_.resize(id + 1U, nullptr);
+  }
+  // Find the link to splice after: skip bindings of scopes nested
+  // inside the target (only `declareInScope` gets past the head).
+  Binding **slot = &live_[id];
+  while (*slot != nullptr && (*slot)->depth > depth) {
+    slot = &(*slot)->shadowed;
+  }
+  if (*slot != nullptr && (*slot)->depth == depth) {
+    return false;
+  }
+  *slot = new (arena_.Allocate<Binding>()) Binding{sym, depth, *slot};
+  Scope &scope = *scopes_[depth];
+  scope.declOrder_.push_back(sym);
+  scope.ids_.push_back(id);
+  return true;
+}
+
+bool SymbolTable::declare(Symbol *sym) {
   assert(!scopes_.empty() &&
          "declare called before any enterScope; the ResolutionPass "
          "must enterScope(Global) first");
-  return scopes_.back()->insert(std::move(sym));
+  return bind(static_cast<unsigned>(scopes_.size() - 1U), sym);
 }
 
-bool SymbolTable::declareInScope(ScopeKind kind, std::unique_ptr<Symbol> sym) {
-  for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
-    if ((*it)->kind() == kind) {
-      return (*it)->insert(std::move(sym));
+bool SymbolTable::declare(std::unique_ptr<Symbol> sym) {
+  if (!declare(sym.get())) {
+    return false;
+  }
+  ownedSymbols_.push_back(std::move(sym));
+  return true;
+}
+
+bool SymbolTable::declareInScope(ScopeKind kind, Symbol *sym) {
+  for (std::size_t i = scopes_.size(); i-- > 0;) {
+    if (scopes_[i]->kind() == kind) {
+      return bind(static_cast<unsigned>(i), sym);
     }
   }
   // No enclosing scope of the requested kind on the active stack;
@@ -117,33 +169,35 @@ bool SymbolTable::declareInScope(ScopeKind kind, std::unique_ptr<Symbol> sym) {
   // caller treats the false return as "duplicate" but here it just
   // means "wrong scope shape"; consumers should not rely on this
   // path being silent.
-  return scopes_.back()->insert(std::move(sym));
+  return declare(sym);
+}
+
+bool SymbolTable::declareInScope(ScopeKind kind, std::unique_ptr<Symbol> sym) {
+  if (!declareInScope(kind, sym.get())) {
+    return false;
+  }
+  ownedSymbols_.push_back(std::move(sym));
+  return true;
 }
 
 Symbol *SymbolTable::lookup(ast::Identifier name) const {
-  // Walk innermost-first; the first match wins per the lexical-
+  std::optional<IdentID> id = idents_.find(name);
+  if (!id || *id >= live_.size()) {
+    return nullptr;
+  }
+  // Innermost live binding; the first match wins per the lexical-
   // scope semantics in design §6 lines 786–793.
-  for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it) {
-    if (Symbol *sym = (*it)->lookupLocal(name)) {
-      return sym;
-    }
+  if (!scopes_.empty()) {
+    return live_[*id] != nullptr ? live_[*id]->sym : nullptr;
   }
   // Post-Sema introspection path: when the active stack is empty
   // (Sema::run finished and every scope was retired into
-  // `retiredScopes_`), fall back to the retired list in reverse
-  // retirement order — most-recently-retired first approximates
-  // innermost-first. This makes `r.symbols->lookup("foo")` work
-  // after `Sema::run()` returns, satisfying the constructive-`Sn`
-  // introspection unit tests under
+  // `retiredScopes_`), fall back to the most recently retired
+  // binding, which approximates innermost-first. This makes
+  // `r.symbols->lookup("foo")` work after `Sema::run()` returns,
+  // satisfying the constructive-`Sn` introspection unit tests under
   // `test_unit/constructive_sn_test/`.
-  if (scopes_.empty()) {
-    for (auto it = retiredScopes_.rbegin(); it != retiredScopes_.rend(); ++it) {
-      if (Symbol *sym = (*it)->lookupLocal(name)) {
-        return sym;
-      }
-    }
-  }
-  return nullptr;
+  return retired_[*id];
 }
 
 Symbol *SymbolTable::lookupScoped(const ast::ScopedName &name) const {
@@ -177,4 +231,18 @@ const Scope *SymbolTable::currentScope() const noexcept {
   return scopes_.back().get();
 }
 
+const Scope *SymbolTable::globalScope() const noexcept {
+  if (!scopes_.empty()) {
+    return scopes_.front()->kind() == ScopeKind::Global ? scopes_.front().get()
+                                                        : nullptr;
+  }
+  // The root is the last scope the resolution walk leaves.
+  for (auto it = retiredScopes_.rbegin(); it != retiredScopes_.rend(); ++it) {
+    if ((*it)->kind() == ScopeKind::Global && (*it)->parent() == nullptr) {
+      return it->get();
+    }
+  }
+  return nullptr;
+}
+
 } // namespace nsl::sema
@@ -8,6 +8,12 @@
 // `SymbolTable.h`) so this TU does not need a SymbolTable.h
 // include — TypeSystem is foundational to SymbolTable, not the
 // other way around.
+//
+// `SharedTypeInterner` publishes each type exactly once: the direct
+// `bit[N]` table by compare-and-swap (a loser deletes its copy and
+// takes the winner's), the sharded maps under their shard's mutex.
+// A published type is never mutated or freed before the interner,
+// so readers need no synchronisation beyond that publication.
 
 #include "nsl/Sema/TypeSystem.h"
 
@@ -15,10 +21,15 @@
 #include "llvm/ADT/Hashing.h"
 #include "llvm/ADT/StringRef.h"
 
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 namespace llvm {
 
@@ -63,20 +74,126 @@ llvm::ArrayRef<FieldInfo> StructType::fields() const noexcept {
   return fields_;
 }
 
+// -----------------------------------------------------------------
+// SharedTypeInterner::Impl (private state)
+// -----------------------------------------------------------------
+
+struct SharedTypeInterner::Impl {
+  /// One lock's worth of the wide-`bit[N]` and memory caches.
+  struct Shard {
+    std::mutex mu;
+    llvm::DenseMap<uint64_t, std::unique_ptr<BitVectorType>> bvCache;
+    llvm::DenseMap<std::pair<uint64_t, TypeRef>, std::unique_ptr<MemoryType>>
+        memCache;
+  };
+
+  BitType bitSingleton;
+  UnresolvedType unresolvedSingleton;
+
+  /// `bit[N]` for `1 <= N <= kDirectWidths`, slot `N - 1`; null until
+  /// first interned. Owned: freed in `~Impl`.
+  std::array<std::atomic<const BitVectorType *>, kDirectWidths> direct{};
+
+  std::array<Shard, kShards> shards;
+  std::atomic<std::size_t> count{0};
+
+  Shard &shardFor(llvm::hash_code h) {
+    return shards[static_cast<std::size_t>(h) % kShards];
+  }
+
+  ~Impl() {
+    for (auto &slot : direct) {
+      delete slot.load(std::memory_order_relaxed);
+    }
+  }
+};
+
+// -----------------------------------------------------------------
+// SharedTypeInterner
+// -----------------------------------------------------------------
+
+SharedTypeInterner::SharedTypeInterner() : impl_(std::make_unique<Impl>()) {}
+SharedTypeInterner::~SharedTypeInterner() = default;
+
+SharedTypeInterner &SharedTypeInterner::global() {
+  static SharedTypeInterner interner;
+  return interner;
+}
+
+TypeRef SharedTypeInterner::bit() const noexcept {
+  return &impl_->bitSingleton;
+}
+
+TypeRef SharedTypeInterner::unresolved() const noexcept {
+  return &impl_->unresolvedSingleton;
+}
+
+TypeRef SharedTypeInterner::bitVector(uint64_t width) {
+  assert(width >= 1 && "BitVectorType width must be >= 1");
+  if (width <= kDirectWidths) {
+    std::atomic<const BitVectorType *> &slot = impl_->direct[width - 1];
+    const BitVectorType *seen = slot.load(std::memory_order_acquire);
+    if (seen != nullptr) {
+      return seen;
+    }
+    auto fresh = std::make_unique<BitVectorType>(width);
+    if (slot.compare_exchange_strong(seen, fresh.get(),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+      impl_->count.fetch_add(1, std::memory_order_relaxed);
+      return fresh.release();
+    }
+    return seen; // another thread published first; `fresh` is dropped
+  }
+  Impl::Shard &shard = impl_->shardFor(llvm::hash_value(width));
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto [it, inserted] = shard.bvCache.try_emplace(width);
+  if (inserted) {
+    it->second = std::make_unique<BitVectorType>(width);
+    impl_->count.fetch_add(1, std::memory_order_relaxed);
+  }
+  return it->second.get();
+}
+
+TypeRef SharedTypeInterner::memory(uint64_t depth, TypeRef element) {
+  std::pair<uint64_t, TypeRef> const key{depth, element};
+  Impl::Shard &shard = impl_->shardFor(llvm::hash_combine(depth, element));
+  std::lock_guard<std::mutex> lock(shard.mu);
+  auto [it, inserted] = shard.memCache.try_emplace(key);
+  if (inserted) {
+    it->second = std::make_unique<MemoryType>(depth, element);
+    impl_->count.fetch_add(1, std::memory_order_relaxed);
+  }
+  return it->second.get();
+}
+
+std::size_t SharedTypeInterner::size() const noexcept {
+  return impl_->count.load(std::memory_order_relaxed);
+}
+
 // -----------------------------------------------------------------
 // TypeSystem::Impl (private state)
 // -----------------------------------------------------------------
 
-struct TypeSystem::Impl {
-  /// Singleton 1-bit type. Allocated once at `TypeSystem`
-  /// construction and never replaced.
-  std::unique_ptr<BitType> bitSingleton;
+namespace {
+
+/// True iff `t` involves no struct type, so the shared interner may
+/// own it.
+bool isShareable(TypeRef t) noexcept {
+  switch (t->kind()) {
+  case TypeKind::Struct:
+    return false;
+  case TypeKind::Memory:
+    return isShareable(static_cast<const MemoryType *>(t)->element());
+  default:
+    return true;
+  }
+}
 
-  /// Singleton "unresolved" sentinel. Allocated once.
-  std::unique_ptr<UnresolvedType> unresolvedSingleton;
+} // namespace
 
-  /// `bit[N]` cache keyed by width (per design §6.x line 849).
-  llvm::DenseMap<uint64_t, std::unique_ptr<BitVectorType>> bvCache;
+struct TypeSystem::Impl {
+  SharedTypeInterner &shared;
 
   /// `struct` cache keyed by name. Per research §3, struct names
   /// are unique per compilation unit (the `ResolutionPass` enforces
@@ -84,40 +201,32 @@ struct TypeSystem::Impl {
   /// so the name alone is the cache key.
   llvm::DenseMap<llvm::StringRef, std::unique_ptr<StructType>> structCache;
 
-  /// `mem` cache keyed by `(depth, element)`.
-  llvm::DenseMap<std::pair<uint64_t, TypeRef>, std::unique_ptr<MemoryType>>
-      memCache;
+  /// `mem` cache keyed by `(depth, element)`: memories of structs,
+  /// which this instance owns, plus this run's view of the shared
+  /// ones so a repeat lookup takes no lock.
+  llvm::DenseMap<std::pair<uint64_t, TypeRef>, TypeRef> memCache;
+  std::vector<std::unique_ptr<MemoryType>> ownedMemories;
 
-  Impl()
-      : bitSingleton(std::make_unique<BitType>()),
-        unresolvedSingleton(std::make_unique<UnresolvedType>()) {}
+  explicit Impl(SharedTypeInterner &s) : shared(s) {}
 };
 
 // -----------------------------------------------------------------
 // TypeSystem
 // -----------------------------------------------------------------
 
-TypeSystem::TypeSystem() : impl_(std::make_unique<Impl>()) {}
+TypeSystem::TypeSystem() : TypeSystem(SharedTypeInterner::global()) {}
+TypeSystem::TypeSystem(SharedTypeInterner &shared)
+    : impl_(std::make_unique<Impl>(shared)) {}
 TypeSystem::~TypeSystem() = default;
 
-TypeRef TypeSystem::bit() const noexcept {
-  return impl_->bitSingleton.get();
-}
+TypeRef TypeSystem::bit() const noexcept { return impl_->shared.bit(); }
 
 TypeRef TypeSystem::unresolved() const noexcept {
-  return impl_->unresolvedSingleton.get();
+  return impl_->shared.unresolved();
 }
 
 TypeRef TypeSystem::bitVector(uint64_t width) {
-  assert(width >= 1 && "BitVectorType width must be >= 1");
-  auto it = impl_->bvCache.find(width);
-  if (it != impl_->bvCache.end()) {
-    return it->second.get();
-  }
-  auto fresh = std::make_unique<BitVectorType>(width);
-  TypeRef raw = fresh.get();
-  impl_->bvCache.insert({width, std::move(fresh)});
-  return raw;
+  return impl_->shared.bitVector(width);
 }
 
 TypeRef TypeSystem::structType(ast::Identifier name,
@@ -138,14 +247,18 @@ TypeRef TypeSystem::structType(ast::Identifier name,
 
 TypeRef TypeSystem::memory(uint64_t depth, TypeRef element) {
   std::pair<uint64_t, TypeRef> const key{depth, element};
-  auto it = impl_->memCache.find(key);
-  if (it != impl_->memCache.end()) {
-    return it->second.get();
+  auto [it, inserted] = impl_->memCache.try_emplace(key, nullptr);
+  if (!inserted) {
+    return it->second;
   }
-  auto fresh = std::make_unique<MemoryType>(depth, element);
-  TypeRef raw = fresh.get();
-  impl_->memCache.insert({key, std::move(fresh)});
-  return raw;
+  if (element != nullptr && isShareable(element)) {
+    it->second = impl_->shared.memory(depth, element);
+  } else {
+    impl_->ownedMemories.push_back(
+        std::make_unique<MemoryType>(depth, element));
+    it->second = impl_->ownedMemories.back().get();
+  }
+  return it->second;
 }
 
 } // namespace nsl::sema
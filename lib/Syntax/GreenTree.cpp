@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Syntax/GreenTree.cpp — trivia lexing and the hash-consing
+// `GreenCache` behind the green layer of `nsl/Syntax/SyntaxTree.h`.
+//
+// Interning uses `llvm::FoldingSet`: a token is keyed on (kind,
+// trivia split, full bytes); a node on (interned kind pointer, child
+// identities). Because children are interned before their parent,
+// child pointer identity is structural identity and a node lookup
+// costs O(#children), not O(subtree).
+
+#include "nsl/Syntax/SyntaxTree.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <new>
+
+namespace nsl::syntax {
+
+namespace {
+
+bool isHorizontalSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\f' || c == '\v';
+}
+
+/// True iff a trivia piece other than `Skipped` starts at `text[i]`.
+bool startsTrivia(llvm::StringRef text, std::size_t i) {
+  char c = text[i];
+  if (isHorizontalSpace(c) || c == '\n' || c == '\r') {
+    return true;
+  }
+  return c == '/' && i + 1 < text.size() &&
+         (text[i + 1] == '/' || text[i + 1] == '*');
+}
+
+} // namespace
+
+void lexTrivia(llvm::StringRef text, llvm::SmallVectorImpl<TriviaPiece> &out) {
+  const std::size_t n = text.size();
+  std::size_t i = 0;
+  while (i < n) {
+    char c = text[i];
+    std::size_t j = i + 1;
+    TriviaKind kind;
+    if (c == '\n') {
+      kind = TriviaKind::Newline;
+    } else if (c == '\r' && j < n && text[j] == '\n') {
+      kind = TriviaKind::Newline;
+      j = i + 2;
+    } else if (isHorizontalSpace(c) || c == '\r') {
+      // A lone `\r` folds into the surrounding whitespace run.
+      kind = TriviaKind::Whitespace;
+      while (j < n && (isHorizontalSpace(text[j]) ||
+                       (text[j] == '\r' &&
+                        !(j + 1 < n && text[j + 1] == '\n')))) {
+        ++j;
+      }
+    } else if (c == '/' && j < n && text[j] == '/') {
+      // Same extent as `CommentScanner`: up to (not including) `\n`.
+      kind = TriviaKind::LineComment;
+      while (j < n && text[j] != '\n') {
+        ++j;
+      }
+    } else if (c == '/' && j < n && text[j] == '*') {
+      kind = TriviaKind::BlockComment;
+      j = i + 2;
+      bool closed = false;
+      while (j + 1 < n) {
+        if (text[j] == '*' && text[j + 1] == '/') {
+          j += 2;
+          closed = true;
+          break;
+        }
+        ++j;
+      }
+      if (!closed) {
+        j = n; // unterminated — the lexer has already diagnosed it
+      }
+    } else {
+      kind = TriviaKind::Skipped;
+      while (j < n && !startsTrivia(text, j)) {
+        ++j;
+      }
+    }
+    out.push_back({kind, static_cast<std::uint32_t>(j - i)});
+    i = j;
+  }
+}
+
+// ---------- GreenToken / GreenNode ----------
+
+void GreenToken::Profile(llvm::FoldingSetNodeID &id) const {
+  Profile(id, kind_, full_, leadingWidth_, trailingWidth_);
+}
+
+void GreenToken::Profile(llvm::FoldingSetNodeID &id, TokenKind kind,
+                         llvm::StringRef full, std::uint32_t leadingWidth,
+                         std::uint32_t trailingWidth) {
+  id.AddInteger(static_cast<unsigned>(kind));
+  id.AddInteger(leadingWidth);
+  id.AddInteger(trailingWidth);
+  id.AddString(full);
+}
+
+void GreenNode::Profile(llvm::FoldingSetNodeID &id) const {
+  Profile(id, kind_, children_);
+}
+
+void GreenNode::Profile(llvm::FoldingSetNodeID &id, llvm::StringRef kind,
+                        llvm::ArrayRef<GreenElement> children) {
+  // `kind` is interned by the cache, so its address identifies it.
+  id.AddPointer(kind.data());
+  id.AddInteger(static_cast<unsigned>(children.size()));
+  for (GreenElement c : children) {
+    id.AddInteger(static_cast<std::uint64_t>(c.opaque()));
+  }
+}
+
+std::string GreenNode::text() const {
+  std::string out;
+  out.reserve(width_);
+  // Explicit stack — generated or adversarial input can nest deeper
+  // than the native stack comfortably recurses.
+  llvm::SmallVector<std::pair<const GreenNode *, std::size_t>, 32> stack;
+  stack.push_back({this, 0});
+  while (!stack.empty()) {
+    auto &[node, next] = stack.back();
+    if (next == node->children().size()) {
+      stack.pop_back();
+      continue;
+    }
+    GreenElement child = node->children()[next++];
+    if (const GreenToken *t = child.asToken()) {
+      out.append(t->fullText().data(), t->fullText().size());
+    } else if (const GreenNode *n = child.asNode()) {
+      stack.push_back({n, 0});
+    }
+  }
+  return out;
+}
+
+// ---------- GreenCache ----------
+
+llvm::StringRef GreenCache::internKind(llvm::StringRef kind) {
+  return kinds_.insert(kind).first->getKey();
+}
+
+const GreenToken *GreenCache::token(TokenKind kind, llvm::StringRef full,
+                                    std::uint32_t leadingWidth,
+                                    std::uint32_t trailingWidth) {
+  llvm::FoldingSetNodeID id;
+  GreenToken::Profile(id, kind, full, leadingWidth, trailingWidth);
+  void *insertPos = nullptr;
+  if (GreenToken *hit = tokens_.FindNodeOrInsertPos(id, insertPos)) {
+    ++hits_;
+    return hit;
+  }
+
+  char *bytes = arena_.Allocate<char>(full.size());
+  std::memcpy(bytes, full.data(), full.size());
+  llvm::StringRef saved(bytes, full.size());
+
+  llvm::SmallVector<TriviaPiece, 8> leading;
+  llvm::SmallVector<TriviaPiece, 8> trailing;
+  lexTrivia(saved.take_front(leadingWidth), leading);
+  lexTrivia(saved.take_back(trailingWidth), trailing);
+  auto copyPieces = [&](llvm::ArrayRef<TriviaPiece> pieces) {
+    TriviaPiece *mem = arena_.Allocate<TriviaPiece>(pieces.size());
+    std::uninitialized_copy(pieces.begin(), pieces.end(), mem);
+    return llvm::ArrayRef<TriviaPiece>(mem, pieces.size());
+  };
+
+  auto *tok = new (arena_.Allocate<GreenToken>())
+      GreenToken(kind, saved, copyPieces(leading), copyPieces(trailing),
+                 leadingWidth, trailingWidth);
+  tokens_.InsertNode(tok, insertPos);
+  ++tokenCount_;
+  return tok;
+}
+
+const GreenNode *GreenCache::node(llvm::StringRef kind,
+                                  llvm::ArrayRef<GreenElement> children) {
+  llvm::StringRef interned = internKind(kind);
+  llvm::FoldingSetNodeID id;
+  GreenNode::Profile(id, interned, children);
+  void *insertPos = nullptr;
+  if (GreenNode *hit = nodes_.FindNodeOrInsertPos(id, insertPos)) {
+    ++hits_;
+    return hit;
+  }
+
+  GreenElement *mem = arena_.Allocate<GreenElement>(children.size());
+  std::uninitialized_copy(children.begin(), children.end(), mem);
+  std::uint32_t width = 0;
+  for (GreenElement c : children) {
+    width += c.fullWidth();
+  }
+  auto *n = new (arena_.Allocate<GreenNode>()) GreenNode(
+      interned, llvm::ArrayRef<GreenElement>(mem, children.size()), width);
+  nodes_.InsertNode(n, insertPos);
+  ++nodeCount_;
+  return n;
+}
+
+const GreenNode *GreenCache::replaceChild(const GreenNode *parent,
+                                          std::size_t index,
+                                          GreenElement child) {
+  llvm::SmallVector<GreenElement, 8> children(parent->children().begin(),
+                                              parent->children().end());
+  if (index >= children.size()) {
+    return parent;
+  }
+  children[index] = child;
+  return node(parent->kind(), children);
+}
+
+} // namespace nsl::syntax
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Syntax/GreenTreeBuilder.cpp — `CSTSink` that assembles a green
+// tree from the parser's CST-mode events.
+//
+// Every `recordToken` slices the token's bytes from the source view
+// together with the trivia around it: leading trivia is everything
+// since the previous token's trailing trivia ended (`cursor_`), and
+// trailing trivia runs to the end of the token's line. Tokens are
+// interned immediately and appended to the innermost open frame;
+// `endNode` interns the frame's children as one `GreenNode`. Frame
+// locations reported by the parser are not needed — widths come from
+// the tokens, so every byte of the buffer lands in exactly one token.
+
+#include "nsl/Syntax/SyntaxTree.h"
+
+#include "nsl/Basic/SourceLocation.h"
+#include "nsl/Lex/Token.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace nsl::syntax {
+
+GreenTreeBuilder::GreenTreeBuilder(llvm::StringRef source,
+                                   std::shared_ptr<GreenCache> cache)
+    : src_(source),
+      cache_(cache ? std::move(cache) : std::make_shared<GreenCache>()) {}
+
+void GreenTreeBuilder::beginNode(llvm::StringRef kindName,
+                                 const ::nsl::SourceLocation & /*start*/) {
+  stack_.push_back(Frame{cache_->internKind(kindName), {}});
+}
+
+void GreenTreeBuilder::recordToken(const ::nsl::Token &tok) {
+  if (stack_.empty()) {
+    // Defensive: a token outside any production still has to land
+    // in the tree for the byte-for-byte invariant to hold.
+    stack_.push_back(Frame{cache_->internKind("CompilationUnit"), {}});
+  }
+  const auto size = static_cast<std::uint32_t>(src_.size());
+  // Clamp into [cursor_, size]: a token that overlaps bytes already
+  // attached (never produced by a single-buffer lex) shrinks rather
+  // than duplicating them.
+  std::uint32_t begin =
+      std::clamp(tok.range().begin().offset(), cursor_, size);
+  std::uint32_t end = std::clamp(tok.range().end().offset(), begin, size);
+  std::uint32_t trailingEnd = scanTrailing(end);
+
+  const GreenToken *green =
+      cache_->token(tok.kind(), src_.slice(cursor_, trailingEnd),
+                    begin - cursor_, trailingEnd - end);
+  stack_.back().children.push_back(green);
+  cursor_ = trailingEnd;
+}
+
+void GreenTreeBuilder::endNode(const ::nsl::SourceLocation & /*end*/) {
+  if (stack_.empty()) {
+    return;
+  }
+  if (stack_.size() == 1) {
+    appendEof();
+  }
+  closeFrame();
+}
+
+::nsl::parse::CSTCheckpoint GreenTreeBuilder::checkpoint() {
+  return {0, stack_.empty() ? 0 : stack_.back().children.size()};
+}
+
+void GreenTreeBuilder::beginNodeAt(const ::nsl::parse::CSTCheckpoint &cp,
+                                   llvm::StringRef kindName,
+                                   const ::nsl::SourceLocation &start) {
+  if (stack_.empty() || cp.nodeIndex > stack_.back().children.size()) {
+    beginNode(kindName, start);
+    return;
+  }
+  // The children appended since `cp` move into the new frame.
+  llvm::SmallVectorImpl<GreenElement> &outer = stack_.back().children;
+  Frame f{cache_->internKind(kindName), {}};
+  f.children.append(outer.begin() + cp.nodeIndex, outer.end());
+  outer.truncate(cp.nodeIndex);
+  stack_.push_back(std::move(f));
+}
+
+SyntaxTree GreenTreeBuilder::finish() {
+  if (stack_.empty() && root_ == nullptr) {
+    stack_.push_back(Frame{cache_->internKind("CompilationUnit"), {}});
+  }
+  // Error paths may leave frames open; close them innermost-first.
+  while (!stack_.empty()) {
+    if (stack_.size() == 1) {
+      appendEof();
+    }
+    closeFrame();
+  }
+  return SyntaxTree(cache_, root_);
+}
+
+std::uint32_t GreenTreeBuilder::scanTrailing(std::uint32_t from) const {
+  const auto n = static_cast<std::uint32_t>(src_.size());
+  std::uint32_t i = from;
+  while (i < n) {
+    char c = src_[i];
+    if (c == ' ' || c == '\t' || c == '\f' || c == '\v') {
+      ++i;
+      continue;
+    }
+    if (c == '\n') {
+      return i + 1;
+    }
+    if (c == '\r' && i + 1 < n && src_[i + 1] == '\n') {
+      return i + 2;
+    }
+    if (c == '/' && i + 1 < n && src_[i + 1] == '/') {
+      i += 2;
+      while (i < n && src_[i] != '\n') {
+        ++i;
+      }
+      continue;
+    }
+    if (c == '/' && i + 1 < n && src_[i + 1] == '*') {
+      std::uint32_t j = i + 2;
+      bool multiLine = false;
+      while (j + 1 < n && !(src_[j] == '*' && src_[j + 1] == '/')) {
+        multiLine |= src_[j] == '\n';
+        ++j;
+      }
+      if (multiLine || j + 1 >= n) {
+        break; // a comment spanning lines leads the next token
+      }
+      i = j + 2;
+      continue;
+    }
+    break;
+  }
+  return i;
+}
+
+void GreenTreeBuilder::appendEof() {
+  if (eofAttached_) {
+    return;
+  }
+  const auto size = static_cast<std::uint32_t>(src_.size());
+  const GreenToken *eof =
+      cache_->token(TokenKind::tk_eof, src_.substr(cursor_),
+                    size - cursor_, 0);
+  stack_.back().children.push_back(eof);
+  cursor_ = size;
+  eofAttached_ = true;
+}
+
+void GreenTreeBuilder::closeFrame() {
+  Frame f = stack_.pop_back_val();
+  const GreenNode *node = cache_->node(f.kind, f.children);
+  if (stack_.empty()) {
+    root_ = node;
+  } else {
+    stack_.back().children.push_back(node);
+  }
+}
+
+} // namespace nsl::syntax
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// lib/Syntax/SyntaxNode.cpp — the red layer (`SyntaxNode` /
+// `SyntaxToken` cursors) and `SyntaxTree`'s comment index.
+//
+// Red nodes are created on demand while walking down; each holds a
+// shared pointer to its parent's data, so a cursor keeps its whole
+// ancestor chain alive and nothing else. Offsets are computed from
+// green widths while descending — the green layer stays position-
+// free and therefore shareable between document versions.
+
+#include "nsl/Syntax/SyntaxTree.h"
+
+#include "llvm/ADT/SmallVector.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace nsl::syntax {
+
+// ---------- SyntaxNode ----------
+
+SyntaxNode SyntaxNode::makeRoot(const GreenNode *green, std::uint32_t offset) {
+  return SyntaxNode(
+      std::make_shared<const Data>(Data{green, offset, 0, nullptr}));
+}
+
+std::optional<SyntaxNode> SyntaxNode::parent() const {
+  if (!data_->parent) {
+    return std::nullopt;
+  }
+  return SyntaxNode(data_->parent);
+}
+
+std::uint32_t SyntaxNode::childOffset(std::size_t i) const noexcept {
+  std::uint32_t off = data_->offset;
+  llvm::ArrayRef<GreenElement> children = data_->green->children();
+  for (std::size_t k = 0; k < i && k < children.size(); ++k) {
+    off += children[k].fullWidth();
+  }
+  return off;
+}
+
+std::optional<SyntaxNode> SyntaxNode::childNode(std::size_t i) const {
+  if (i >= childCount()) {
+    return std::nullopt;
+  }
+  const GreenNode *n = data_->green->children()[i].asNode();
+  if (n == nullptr) {
+    return std::nullopt;
+  }
+  return SyntaxNode(
+      std::make_shared<const Data>(Data{n, childOffset(i), i, data_}));
+}
+
+std::optional<SyntaxToken> SyntaxNode::childToken(std::size_t i) const {
+  if (i >= childCount()) {
+    return std::nullopt;
+  }
+  const GreenToken *t = data_->green->children()[i].asToken();
+  if (t == nullptr) {
+    return std::nullopt;
+  }
+  return SyntaxToken(t, *this, i, childOffset(i));
+}
+
+std::vector<SyntaxNode> SyntaxNode::childNodes() const {
+  std::vector<SyntaxNode> out;
+  std::uint32_t off = data_->offset;
+  llvm::ArrayRef<GreenElement> children = data_->green->children();
+  for (std::size_t i = 0; i < children.size(); ++i) {
+    if (const GreenNode *n = children[i].asNode()) {
+      out.push_back(
+          SyntaxNode(std::make_shared<const Data>(Data{n, off, i, data_})));
+    }
+    off += children[i].fullWidth();
+  }
+  return out;
+}
+
+std::optional<SyntaxToken> SyntaxNode::firstToken() const {
+  for (std::size_t i = 0; i < childCount(); ++i) {
+    if (std::optional<SyntaxToken> t = childToken(i)) {
+      return t;
+    }
+    if (std::optional<SyntaxNode> n = childNode(i)) {
+      if (std::optional<SyntaxToken> t = n->firstToken()) {
+        return t;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<SyntaxToken> SyntaxNode::lastToken() const {
+  for (std::size_t i = childCount(); i-- > 0;) {
+    if (std::optional<SyntaxToken> t = childToken(i)) {
+      return t;
+    }
+    if (std::optional<SyntaxNode> n = childNode(i)) {
+      if (std::optional<SyntaxToken> t = n->lastToken()) {
+        return t;
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::pair<std::uint32_t, std::uint32_t> SyntaxNode::textRange() const {
+  std::optional<SyntaxToken> first = firstToken();
+  std::optional<SyntaxToken> last = lastToken();
+  if (!first || !last) {
+    return {fullOffset(), fullOffset()};
+  }
+  return {first->textRange().first, last->textRange().second};
+}
+
+std::optional<SyntaxToken>
+SyntaxNode::tokenAtOffset(std::uint32_t offset) const {
+  if (offset < fullOffset() || offset >= fullOffset() + fullWidth()) {
+    return std::nullopt;
+  }
+  SyntaxNode node = *this;
+  while (true) {
+    std::uint32_t off = node.fullOffset();
+    llvm::ArrayRef<GreenElement> children = node.green()->children();
+    std::optional<SyntaxNode> next;
+    for (std::size_t i = 0; i < children.size(); ++i) {
+      std::uint32_t w = children[i].fullWidth();
+      if (offset < off + w) {
+        if (const GreenToken *t = children[i].asToken()) {
+          return SyntaxToken(t, node, i, off);
+        }
+        next = SyntaxNode(std::make_shared<const Data>(
+            Data{children[i].asNode(), off, i, node.data_}));
+        break;
+      }
+      off += w;
+    }
+    if (!next) {
+      return std::nullopt;
+    }
+    node = std::move(*next);
+  }
+}
+
+SyntaxNode SyntaxNode::coveringNode(std::uint32_t begin,
+                                    std::uint32_t end) const {
+  SyntaxNode node = *this;
+  while (true) {
+    std::uint32_t off = node.fullOffset();
+    llvm::ArrayRef<GreenElement> children = node.green()->children();
+    std::optional<SyntaxNode> next;
+    for (std::size_t i = 0; i < children.size(); ++i) {
+      std::uint32_t w = children[i].fullWidth();
+      const GreenNode *n = children[i].asNode();
+      if (n != nullptr && w > 0 && off <= begin && end <= off + w &&
+          begin < off + w) {
+        next = SyntaxNode(
+            std::make_shared<const Data>(Data{n, off, i, node.data_}));
+        break;
+      }
+      off += w;
+    }
+    if (!next) {
+      return node;
+    }
+    node = std::move(*next);
+  }
+}
+
+const GreenNode *SyntaxNode::replaceWith(GreenCache &cache,
+                                         GreenElement replacement) const {
+  GreenElement current = replacement;
+  SyntaxNode node = *this;
+  while (std::optional<SyntaxNode> p = node.parent()) {
+    current = cache.replaceChild(p->green(), node.indexInParent(), current);
+    node = std::move(*p);
+  }
+  return current.asNode();
+}
+
+// ---------- SyntaxTree ----------
+
+SyntaxTree::SyntaxTree(std::shared_ptr<GreenCache> cache,
+                       const GreenNode *root)
+    : cache_(std::move(cache)), root_(root) {
+  // One pass over the leaves builds the comment index. Tokens are
+  // visited in source order, so the index comes out sorted.
+  std::uint32_t off = 0;
+  auto indexTrivia = [&](llvm::ArrayRef<TriviaPiece> pieces) {
+    for (const TriviaPiece &p : pieces) {
+      if (p.kind == TriviaKind::LineComment ||
+          p.kind == TriviaKind::BlockComment) {
+        comments_.push_back({p.kind, off, off + p.length});
+      }
+      off += p.length;
+    }
+  };
+  llvm::SmallVector<std::pair<const GreenNode *, std::size_t>, 32> stack;
+  stack.push_back({root_, 0});
+  while (!stack.empty()) {
+    auto &[node, next] = stack.back();
+    if (next == node->children().size()) {
+      stack.pop_back();
+      continue;
+    }
+    GreenElement child = node->children()[next++];
+    if (const GreenToken *t = child.asToken()) {
+      indexTrivia(t->leadingTrivia());
+      off += static_cast<std::uint32_t>(t->text().size());
+      indexTrivia(t->trailingTrivia());
+    } else if (const GreenNode *n = child.asNode()) {
+      stack.push_back({n, 0});
+    }
+  }
+}
+
+llvm::ArrayRef<CommentTrivia>
+SyntaxTree::commentsIn(std::uint32_t begin, std::uint32_t end) const {
+  if (begin >= end) {
+    return {};
+  }
+  auto lo = std::lower_bound(
+      comments_.begin(), comments_.end(), begin,
+      [](const CommentTrivia &c, std::uint32_t v) { return c.begin < v; });
+  auto hi = std::lower_bound(
+      lo, comments_.end(), end,
+      [](const CommentTrivia &c, std::uint32_t v) { return c.begin < v; });
+  return llvm::ArrayRef<CommentTrivia>(comments_)
+      .slice(lo - comments_.begin(), hi - lo);
+}
+
+} // namespace nsl::syntax
@@ -0,0 +1,468 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+"""scripts/gen_first_follow.py — generate the parser's FIRST/FOLLOW
+token-set tables from `docs/spec/nsl_lang.ebnf`.
+
+Invoked at build time by `lib/Parse/CMakeLists.txt`; the output is an
+X-macro table (`GrammarSets.inc`) that `lib/Parse/Recovery.h` expands
+into `static constexpr TokenSet` constants, one FIRST and one FOLLOW
+set per syntactic production of nsl_lang.ebnf §§1–12. The hand-written
+per-rule recovery sets are `static_assert`ed against these tables, so
+a grammar edit that invalidates a recovery set fails the build instead
+of silently degrading error recovery.
+
+Terminal mapping (EBNF spelling -> `TokenKind`):
+  * keyword literals   — `include/nsl/Lex/KeywordSet.def` spellings;
+  * punctuation        — `PUNCTUATION` below, mirroring Lexer.cpp;
+  * `_name` literals   — the lexer's N11 classes (system task / var);
+  * lexical rules (§13) — `LEXICAL_RULES` below: the lexer folds each
+    into a single token, so the generator never descends into them.
+
+Per Constitution Principle V (deterministic): the output depends only
+on the two input files; rows follow EBNF source order and every set is
+sorted by enumerator name. No timestamps, no hash-derived ordering.
+
+Usage:
+  python3 scripts/gen_first_follow.py --output PATH
+  python3 scripts/gen_first_follow.py            # print to stdout
+"""
+
+from __future__ import annotations
+
+import argparse
+import re
+import sys
+from dataclasses import dataclass, field
+from pathlib import Path
+
+# -----------------------------------------------------------------------------
+# Repository layout
+# -----------------------------------------------------------------------------
+
+REPO_ROOT = Path(__file__).resolve().parent.parent
+GRAMMAR = REPO_ROOT / "docs" / "spec" / "nsl_lang.ebnf"
+KEYWORD_SET_DEF = REPO_ROOT / "include" / "nsl" / "Lex" / "KeywordSet.def"
+TOKEN_H = REPO_ROOT / "include" / "nsl" / "Lex" / "Token.h"
+
+# The syntactic grammar ends where §13 (lexical elements) begins.
+LEXICAL_SECTION_MARKER = "========== 13. Lexical elements"
+
+START_RULE = "compilation_unit"
+
+# -----------------------------------------------------------------------------
+# Terminal mapping
+# -----------------------------------------------------------------------------
+
+PUNCTUATION = {
+    "(": "tk_lparen", ")": "tk_rparen",
+    "{": "tk_lbrace", "}": "tk_rbrace",
+    "[": "tk_lbracket", "]": "tk_rbracket",
+    ",": "tk_comma", ";": "tk_semicolon", ":": "tk_colon", ".": "tk_dot",
+    "=": "tk_assign", ":=": "tk_assign_seq",
+    "+": "tk_plus", "-": "tk_minus", "++": "tk_plus_plus",
+    "--": "tk_minus_minus", "*": "tk_star", "/": "tk_slash",
+    "%": "tk_percent", "&": "tk_amp", "|": "tk_pipe", "^": "tk_caret",
+    "~": "tk_tilde", "&&": "tk_logical_and", "||": "tk_logical_or",
+    "!": "tk_logical_not", "==": "tk_equal", "!=": "tk_not_equal",
+    "<": "tk_less", "<=": "tk_less_equal", ">": "tk_greater",
+    ">=": "tk_greater_equal", "<<": "tk_shift_left",
+    ">>": "tk_shift_right", "?": "tk_question", "@": "tk_at",
+    "#": "tk_hash_sign_extend", "'": "tk_apostrophe_zero_extend",
+    "#line": "tk_line_directive",
+    # The lexer has no `~&` / `~|` / `~^` tokens: reduction NAND / NOR /
+    # XNOR reach the parser as `~` followed by the reduction operator.
+    "~&": "tk_tilde", "~|": "tk_tilde", "~^": "tk_tilde",
+}
+
+# Adjacent literal pairs the lexer fuses into one token (N3: `.{`).
+FUSED_PAIRS = {(".", "{"): "tk_dot_lbrace"}
+
+# Lexer::classifyUnderscoreName (N11).
+SYSTEM_TASKS = {
+    "_display", "_monitor", "_write", "_finish", "_stop",
+    "_readmemh", "_readmemb", "_delay", "_init",
+}
+SYSTEM_VARIABLES = {"_random", "_time"}
+
+# §13 rules the lexer turns into exactly one token.
+LEXICAL_RULES = {
+    "identifier": ["tk_identifier"],
+    "string_literal": ["tk_string_lit"],
+    "decimal_integer": ["tk_decimal_lit"],
+    "number_literal": [
+        "tk_decimal_lit", "tk_hex_lit", "tk_binary_lit", "tk_octal_lit",
+    ],
+    "literal": [
+        "tk_decimal_lit", "tk_hex_lit", "tk_binary_lit", "tk_octal_lit",
+        "tk_string_lit",
+    ],
+}
+
+# References the grammar makes to productions it never defines.
+# `init_item` (§10) names `compound_statement`, the reference manual's
+# term for what §8 calls `block`.
+ALIASES = {"compound_statement": "block"}
+
+_KEYWORD_RE = re.compile(r'^KEYWORD\(\s*(\w+)\s*,\s*"([^"]+)"\s*\)')
+_ENUMERATOR_RE = re.compile(r"^\s*(tk_\w+)\s*[,=]")
+
+
+def parse_keyword_set(path: Path) -> dict[str, str]:
+    """Map each keyword spelling to its `TokenKind` enumerator."""
+    out: dict[str, str] = {}
+    for line in path.read_text(encoding="utf-8").splitlines():
+        m = _KEYWORD_RE.match(line.strip())
+        if m:
+            out[m.group(2)] = f"tk_{m.group(1)}"
+    return out
+
+
+def parse_token_kinds(token_h: Path, keywords: dict[str, str]) -> set[str]:
+    """Every `TokenKind` enumerator, for validating the mapping."""
+    kinds = set(keywords.values())
+    for line in token_h.read_text(encoding="utf-8").splitlines():
+        m = _ENUMERATOR_RE.match(line)
+        if m:
+            kinds.add(m.group(1))
+    return kinds
+
+
+# -----------------------------------------------------------------------------
+# EBNF reader
+# -----------------------------------------------------------------------------
+
+@dataclass
+class Node:
+    """EBNF expression node. `op` is one of `term`, `nonterm`, `seq`,
+    `alt`, `opt`, `rep`; `value` carries the token kinds of a `term`
+    or the name of a `nonterm`."""
+    op: str
+    value: object = None
+    kids: list["Node"] = field(default_factory=list)
+
+
+def strip_comments(text: str) -> str:
+    """Drop `(* … *)` comments (they nest in this file) while keeping
+    quoted literals intact, so `"("` never opens a comment."""
+    out: list[str] = []
+    i, depth, n = 0, 0, len(text)
+    while i < n:
+        if text.startswith("(*", i):
+            depth += 1
+            i += 2
+        elif depth and text.startswith("*)", i):
+            depth -= 1
+            i += 2
+        elif depth:
+            i += 1
+        elif text[i] in "\"'":
+            j = text.index(text[i], i + 1)
+            out.append(text[i:j + 1])
+            i = j + 1
+        else:
+            out.append(text[i])
+            i += 1
+    if depth:
+        raise RuntimeError("unterminated (* comment in grammar")
+    return "".join(out)
+
+
+_TOKEN_RE = re.compile(r"""\s*(?:("[^"]*"|'[^']*')|(\w+)|([=;|\[\]{}()]))""")
+
+
+def tokenize(text: str) -> list[tuple[str, str]]:
+    toks: list[tuple[str, str]] = []
+    pos = 0
+    while pos < len(text):
+        if text[pos:].strip() == "":
+            break
+        m = _TOKEN_RE.match(text, pos)
+        if not m:
+            raise RuntimeError(f"unexpected grammar text: {text[pos:pos + 40]!r}")
+        lit, name, punct = m.groups()
+        if lit is not None:
+            toks.append(("lit", lit[1:-1]))
+        elif name is not None:
+            toks.append(("name", name))
+        else:
+            toks.append(("punct", punct))
+        pos = m.end()
+    return toks
+
+
+class GrammarReader:
+    def __init__(self, toks: list[tuple[str, str]], keywords: dict[str, str]):
+        self.toks = toks
+        self.pos = 0
+        self.keywords = keywords
+
+    def peek(self, k: int = 0) -> tuple[str, str] | None:
+        i = self.pos + k
+        return self.toks[i] if i < len(self.toks) else None
+
+    def expect(self, kind: str, value: str) -> None:
+        tok = self.peek()
+        if tok != (kind, value):
+            raise RuntimeError(f"expected {value!r}, got {tok!r}")
+        self.pos += 1
+
+    def rules(self) -> dict[str, Node]:
+        out: dict[str, Node] = {}
+        while self.peek() is not None:
+            kind, name = self.peek()
+            if kind != "name":
+                raise RuntimeError(f"expected rule name, got {name!r}")
+            self.pos += 1
+            self.expect("punct", "=")
+            body = self.alternation()
+            self.expect("punct", ";")
+            if name in out:
+                raise RuntimeError(f"rule {name!r} defined twice")
+            out[name] = body
+        return out
+
+    def alternation(self) -> Node:
+        alts = [self.sequence()]
+        while self.peek() == ("punct", "|"):
+            self.pos += 1
+            alts.append(self.sequence())
+        return alts[0] if len(alts) == 1 else Node("alt", kids=alts)
+
+    def sequence(self) -> Node:
+        items: list[Node] = []
+        while True:
+            tok = self.peek()
+            if tok is None or tok in (("punct", "|"), ("punct", ";"),
+                                      ("punct", ")"), ("punct", "]"),
+                                      ("punct", "}")):
+                break
+            kind, value = tok
+            self.pos += 1
+            if kind == "lit":
+                nxt = self.peek()
+                fused = None
+                if nxt is not None and nxt[0] == "lit":
+                    fused = FUSED_PAIRS.get((value, nxt[1]))
+                if fused is not None:
+                    self.pos += 1
+                    items.append(Node("term", [fused]))
+                else:
+                    items.append(Node("term", [self.terminal(value)]))
+            elif kind == "name":
+                items.append(Node("nonterm", value))
+            elif value in "[{(":
+                close = {"[": "]", "{": "}", "(": ")"}[value]
+                inner = self.alternation()
+                self.expect("punct", close)
+                op = {"[": "opt", "{": "rep", "(": "seq"}[value]
+                items.append(Node(op, kids=[inner]))
+            else:
+                raise RuntimeError(f"unexpected {value!r} in grammar")
+        return items[0] if len(items) == 1 else Node("seq", kids=items)
+
+    def terminal(self, spelling: str) -> str:
+        if spelling in self.keywords:
+            return self.keywords[spelling]
+        if spelling in PUNCTUATION:
+            return PUNCTUATION[spelling]
+        if spelling in SYSTEM_TASKS:
+            return "tk_system_task"
+        if spelling in SYSTEM_VARIABLES:
+            return "tk_system_function"
+        raise RuntimeError(f"no TokenKind for grammar literal {spelling!r}")
+
+
+# -----------------------------------------------------------------------------
+# FIRST / FOLLOW
+# -----------------------------------------------------------------------------
+
+class Analysis:
+    def __init__(self, rules: dict[str, Node]):
+        self.rules = rules
+        self.nullable: dict[str, bool] = {r: False for r in rules}
+        self.first: dict[str, set[str]] = {r: set() for r in rules}
+        self.follow: dict[str, set[str]] = {r: set() for r in rules}
+
+    def resolve(self, name: str) -> tuple[str, list[str] | None]:
+        """Return (rule, None) for a syntactic rule or (name, kinds)
+        for a lexical one."""
+        name = ALIASES.get(name, name)
+        if name in LEXICAL_RULES:
+            return name, LEXICAL_RULES[name]
+        if name not in self.rules:
+            raise RuntimeError(f"reference to undefined rule {name!r}")
+        return name, None
+
+    def first_of(self, n: Node) -> tuple[set[str], bool]:
+        """FIRST set and nullability of an expression node."""
+        if n.op == "term":
+            return set(n.value), False
+        if n.op == "nonterm":
+            rule, lexical = self.resolve(n.value)
+            if lexical is not None:
+                return set(lexical), False
+            return set(self.first[rule]), self.nullable[rule]
+        if n.op == "alt":
+            out, null = set(), False
+            for k in n.kids:
+                f, nl = self.first_of(k)
+                out |= f
+                null |= nl
+            return out, null
+        if n.op in ("opt", "rep"):
+            f, _ = self.first_of(n.kids[0])
+            return f, True
+        # seq
+        out: set[str] = set()
+        for k in n.kids:
+            f, nl = self.first_of(k)
+            out |= f
+            if not nl:
+                return out, False
+        return out, True
+
+    def solve_first(self) -> None:
+        changed = True
+        while changed:
+            changed = False
+            for name, body in self.rules.items():
+                f, nl = self.first_of(body)
+                if not f <= self.first[name] or nl != self.nullable[name]:
+                    self.first[name] |= f
+                    self.nullable[name] = self.nullable[name] or nl
+                    changed = True
+
+    def add_follow(self, n: Node, after: set[str], after_null: bool,
+                   owner: str) -> bool:
+        """Propagate `after` (FIRST of what follows `n`; `after_null`
+        when that tail can vanish, so FOLLOW(owner) also follows)."""
+        changed = False
+        if n.op == "term":
+            return False
+        if n.op == "nonterm":
+            rule, lexical = self.resolve(n.value)
+            if lexical is not None:
+                return False
+            add = set(after)
+            if after_null:
+                add |= self.follow[owner]
+            if not add <= self.follow[rule]:
+                self.follow[rule] |= add
+                changed = True
+            return changed
+        if n.op == "alt":
+            for k in n.kids:
+                changed |= self.add_follow(k, after, after_null, owner)
+            return changed
+        if n.op in ("opt", "rep"):
+            inner_after, inner_null = set(after), after_null
+            if n.op == "rep":
+                f, _ = self.first_of(n.kids[0])
+                inner_after |= f
+            return self.add_follow(n.kids[0], inner_after, inner_null, owner)
+        # seq: walk right to left, accumulating the tail's FIRST.
+        tail, tail_null = set(after), after_null
+        for k in reversed(n.kids):
+            changed |= self.add_follow(k, tail, tail_null, owner)
+            f, nl = self.first_of(k)
+            if nl:
+                tail = tail | f
+            else:
+                tail, tail_null = f, False
+        return changed
+
+    def solve_follow(self) -> None:
+        self.follow[START_RULE].add("tk_eof")
+        changed = True
+        while changed:
+            changed = False
+            for name, body in self.rules.items():
+                changed |= self.add_follow(body, set(), True, name)
+
+
+# -----------------------------------------------------------------------------
+# Emission
+# -----------------------------------------------------------------------------
+
+def render_row(macro: str, rule: str, kinds: set[str]) -> str:
+    if not kinds:
+        raise RuntimeError(f"{macro}({rule}) is empty")
+    head = f"{macro}({rule},"
+    items = [f"TokenKind::{k}" for k in sorted(kinds)]
+    lines: list[str] = []
+    line = head
+    for i, item in enumerate(items):
+        piece = f" {item}" + ("," if i + 1 < len(items) else ")")
+        if len(line) + len(piece) > 80:
+            lines.append(line)
+            line = "   "
+        line += piece
+    lines.append(line)
+    return "\n".join(lines)
+
+
+def render(grammar: Path, keyword_def: Path, token_h: Path) -> str:
+    keywords = parse_keyword_set(keyword_def)
+    valid = parse_token_kinds(token_h, keywords)
+
+    text = grammar.read_text(encoding="utf-8")
+    cut = text.find(LEXICAL_SECTION_MARKER)
+    if cut < 0:
+        raise RuntimeError(f"{LEXICAL_SECTION_MARKER!r} not found")
+    syntactic = strip_comments(text[:text.rfind("(*", 0, cut)])
+    rules = GrammarReader(tokenize(syntactic), keywords).rules()
+    if START_RULE not in rules:
+        raise RuntimeError(f"start rule {START_RULE!r} not found")
+
+    analysis = Analysis(rules)
+    analysis.solve_first()
+    analysis.solve_follow()
+
+    rows: list[str] = []
+    for rule in rules:
+        for kinds in (analysis.first[rule], analysis.follow[rule]):
+            unknown = kinds - valid
+            if unknown:
+                raise RuntimeError(f"unknown TokenKind(s) {sorted(unknown)}")
+        rows.append(render_row("NSL_FIRST", rule, analysis.first[rule]))
+        rows.append(render_row("NSL_FOLLOW", rule, analysis.follow[rule]))
+
+    header = (
+        "// Generated by scripts/gen_first_follow.py from\n"
+        "// docs/spec/nsl_lang.ebnf — DO NOT EDIT.\n"
+        "//\n"
+        "// One NSL_FIRST / NSL_FOLLOW row per syntactic production\n"
+        "// (§§1–12), in grammar source order. Consumed by\n"
+        "// lib/Parse/Recovery.h.\n"
+    )
+    return header + "\n" + "\n".join(rows) + "\n"
+
+
+# -----------------------------------------------------------------------------
+# Main
+# -----------------------------------------------------------------------------
+
+def main(argv: list[str] | None = None) -> int:
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument(
+        "--output", type=Path,
+        help="Write the table here (only when the content changed, so "
+             "an unchanged grammar does not trigger a parser rebuild). "
+             "Prints to stdout when omitted.",
+    )
+    args = parser.parse_args(argv)
+
+    rendered = render(GRAMMAR, KEYWORD_SET_DEF, TOKEN_H)
+    if args.output is None:
+        sys.stdout.write(rendered)
+        return 0
+
+    if (not args.output.exists()
+            or args.output.read_text(encoding="utf-8") != rendered):
+        args.output.parent.mkdir(parents=True, exist_ok=True)
+        args.output.write_text(rendered, encoding="utf-8")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
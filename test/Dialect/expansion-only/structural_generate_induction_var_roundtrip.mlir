@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt %s | FileCheck %s
+// RUN: nsl-opt %s | nsl-opt - | FileCheck %s
+//
+// `nsl.structural_generate` whose body takes the loop variable as an
+// `index` induction variable, and an `nsl.reg` whose structured name
+// refers to it: `name_parts` mixes literals with positions into the
+// reg's index operands. Nested generates hand their induction
+// variables down, so the inner reg takes both.
+
+// CHECK-LABEL: nsl.module @GenInductionHost
+nsl.module @GenInductionHost {
+  // CHECK: nsl.structural_generate attributes {loop_var = "i", lower = 0 : i64, step = 1 : i64, upper = 4 : i64} {
+  // CHECK-NEXT: ^bb0(%[[I:.*]]: index):
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 4 : i64, step = 1 : i64, loop_var = "i"} {
+  ^bb0(%i: index):
+    // CHECK-NEXT: nsl.reg "buf_%i%" [%[[I]]] : !nsl.bits<8> = 0 {name_parts = ["buf_", 0 : i64]}
+    %r = nsl.reg "buf_%i%" [%i] : !nsl.bits<8> = 0 {name_parts = ["buf_", 0 : i64]}
+    // CHECK: ^bb0(%[[J:.*]]: index):
+    nsl.structural_generate attributes {lower = 0 : i64, upper = 2 : i64, step = 1 : i64, loop_var = "j"} {
+    ^bb0(%j: index):
+      // CHECK-NEXT: nsl.reg "cell_%i%_%j%" [%[[I]], %[[J]]] : !nsl.bits<8> {name_parts = ["cell_", 0 : i64, "_", 1 : i64]}
+      %c = nsl.reg "cell_%i%_%j%" [%i, %j] : !nsl.bits<8> {name_parts = ["cell_", 0 : i64, "_", 1 : i64]}
+    }
+  }
+  // CHECK: nsl.index_constant 3
+  %k = nsl.index_constant 3
+}
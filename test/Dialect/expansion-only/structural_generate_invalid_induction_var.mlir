@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt --verify-diagnostics --split-input-file %s
+//
+// A `nsl.structural_generate` body takes no argument or a single
+// `index` induction variable, and an `nsl.reg` structured name's
+// `name_parts` / index operands come together and agree.
+
+nsl.module @GenBadArg {
+  // expected-error@+1 {{single 'index' induction variable}}
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 4 : i64, step = 1 : i64, loop_var = "i"} {
+  ^bb0(%i: i32):
+  }
+}
+
+// -----
+
+nsl.module @GenBadPart {
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 4 : i64, step = 1 : i64, loop_var = "i"} {
+  ^bb0(%i: index):
+    // expected-error@+1 {{neither a string nor an index operand position}}
+    %r = nsl.reg "buf_%i%" [%i] : !nsl.bits<8> {name_parts = ["buf_", 1 : i64]}
+  }
+}
+
+// -----
+
+nsl.module @GenMissingParts {
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 4 : i64, step = 1 : i64, loop_var = "i"} {
+  ^bb0(%i: index):
+    // expected-error@+1 {{'name_parts' and index operands must be given together}}
+    %r = nsl.reg "buf_%i%" [%i] : !nsl.bits<8>
+  }
+}
@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt --verify-diagnostics %s
+//
+// `nsl.module` is `IsolatedFromAbove`: its body may not use an SSA
+// value defined outside it. Ports, params and structs reach the
+// body through symbols instead. The parser opens a fresh value
+// scope for the region, so the captured name is undeclared there.
+
+%c = nsl.constant 1 : !nsl.bits<8>
+nsl.module @M {
+  %w = nsl.wire "w" : !nsl.bits<8>
+  // expected-error@+1 {{use of undeclared SSA value name}}
+  nsl.transfer %w, %c : !nsl.bits<8>
+}
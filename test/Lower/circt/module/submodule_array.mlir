@@ -0,0 +1,28 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test/Lower/circt/module/submodule_array.mlir — an array-form
+// `nsl.submodule @bank : @Sub[3]` reaches the nsl→CIRCT conversion
+// unexploded (`runNSLPasses` no longer runs
+// `nsl-explode-submod-array`) and lowers to one `hw.instance` per
+// element, named `<inst>_<k>` as the standalone explode pass would
+// name them. A zero-size array lowers to no instance. Input is
+// `.mlir` for the same reason as `submodule_singleton.mlir`.
+
+// RUN: nsl-opt -nsl-to-circt %s | FileCheck %s
+
+nsl.module @Sub {
+}
+nsl.module @Top {
+  nsl.submodule @bank : @Sub[3]
+  nsl.submodule @none : @Sub[0]
+  nsl.submodule @u : @Sub
+}
+
+// CHECK-LABEL: hw.module @Sub
+// CHECK-LABEL: hw.module @Top
+// CHECK-NEXT: hw.instance "bank_0" @Sub
+// CHECK-NEXT: hw.instance "bank_1" @Sub
+// CHECK-NEXT: hw.instance "bank_2" @Sub
+// CHECK-NEXT: hw.instance "u" @Sub
+// CHECK-NOT: none
+// CHECK-NOT: nsl.
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-canonicalize %s | FileCheck %s
+//
+// `nsl-canonicalize` (slot 3b) — the `nsl.concat` / `nsl.extract`
+// canonicalization patterns. Nested concats are spliced into one and
+// zero-width operands dropped; a slice that lies inside one concat
+// operand reads that operand directly, and one that straddles two is
+// left alone.
+
+// CHECK-LABEL: nsl.module @ConcatExtract
+nsl.module @ConcatExtract {
+  // CHECK: %[[A:.*]] = nsl.wire "a" : !nsl.bits<4>
+  %a = nsl.wire "a" : !nsl.bits<4>
+  // CHECK: %[[B:.*]] = nsl.wire "b" : !nsl.bits<4>
+  %b = nsl.wire "b" : !nsl.bits<4>
+  // CHECK: %[[C:.*]] = nsl.wire "c" : !nsl.bits<8>
+  %c = nsl.wire "c" : !nsl.bits<8>
+  %e = nsl.wire "e" : !nsl.bits<0>
+  // CHECK: %[[FLAT:.*]] = nsl.concat %[[A]], %[[B]], %[[C]] : (!nsl.bits<4>, !nsl.bits<4>, !nsl.bits<8>) -> !nsl.bits<16>
+  %ab = nsl.concat %a, %e, %b : (!nsl.bits<4>, !nsl.bits<0>, !nsl.bits<4>) -> !nsl.bits<8>
+  %abc = nsl.concat %ab, %c : (!nsl.bits<8>, !nsl.bits<8>) -> !nsl.bits<16>
+  // Bits [11:8] are all of `%b`.
+  %sb = nsl.extract %abc, 8 : !nsl.bits<16> -> !nsl.bits<4>
+  // CHECK: %[[SC:.*]] = nsl.extract %[[C]], 2 : !nsl.bits<8> -> !nsl.bits<3>
+  %sc = nsl.extract %abc, 2 : !nsl.bits<16> -> !nsl.bits<3>
+  // CHECK: %[[X:.*]] = nsl.extract %[[FLAT]], 6 : !nsl.bits<16> -> !nsl.bits<4>
+  %x = nsl.extract %abc, 6 : !nsl.bits<16> -> !nsl.bits<4>
+
+  %w4 = nsl.wire "w4" : !nsl.bits<4>
+  %w3 = nsl.wire "w3" : !nsl.bits<3>
+  // CHECK: nsl.transfer %{{.*}}, %[[B]] : !nsl.bits<4>
+  nsl.transfer %w4, %sb : !nsl.bits<4>
+  // CHECK: nsl.transfer %{{.*}}, %[[SC]] : !nsl.bits<3>
+  nsl.transfer %w3, %sc : !nsl.bits<3>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<4>
+  nsl.transfer %w4, %x : !nsl.bits<4>
+}
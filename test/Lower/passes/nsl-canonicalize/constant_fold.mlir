@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-canonicalize %s | FileCheck %s
+//
+// `nsl-canonicalize` (slot 3b). Expression ops whose operands are all
+// `nsl.constant` fold to one `nsl.constant` of the result type,
+// modulo 2^N and with unsigned comparisons. The operand constants
+// lose their last use and are erased; the folded constant stands
+// where the folded op stood.
+
+// CHECK-LABEL: nsl.module @ConstantFold
+nsl.module @ConstantFold {
+  %a = nsl.constant 200 : !nsl.bits<8>
+  %b = nsl.constant 100 : !nsl.bits<8>
+  %s = nsl.constant 3 : !nsl.bits<8>
+  // CHECK-NOT: nsl.add
+  // CHECK-NOT: nsl.constant 200
+  // CHECK: %[[SUM:.*]] = nsl.constant 44 : !nsl.bits<8>
+  %sum = nsl.add %a, %b : !nsl.bits<8>
+  // CHECK: %[[DIFF:.*]] = nsl.constant 156 : !nsl.bits<8>
+  %diff = nsl.sub %b, %a : !nsl.bits<8>
+  // CHECK: %[[SHL:.*]] = nsl.constant 64 : !nsl.bits<8>
+  %shl = nsl.shl %a, %s : !nsl.bits<8>
+  // CHECK: %[[LT:.*]] = nsl.constant 0 : !nsl.bits<1>
+  %lt = nsl.lt %a, %b : !nsl.bits<8> -> !nsl.bits<1>
+  // CHECK: %[[NOT:.*]] = nsl.constant 55 : !nsl.bits<8>
+  %not = nsl.not %a : !nsl.bits<8>
+  // CHECK: %[[SEXT:.*]] = nsl.constant 65480 : !nsl.bits<16>
+  %sext = nsl.sign_extend %a : !nsl.bits<8> to !nsl.bits<16>
+  // CHECK: %[[CAT:.*]] = nsl.constant 51300 : !nsl.bits<16>
+  %cat = nsl.concat %a, %b : (!nsl.bits<8>, !nsl.bits<8>) -> !nsl.bits<16>
+  // Only `nsl.repeat` reads the slice, so it folds away with it.
+  // CHECK-NOT: nsl.extract
+  %hi = nsl.extract %a, 5 : !nsl.bits<8> -> !nsl.bits<3>
+  // CHECK: %[[REP:.*]] = nsl.constant 54 : !nsl.bits<6>
+  %rep = nsl.repeat %hi, 2 : !nsl.bits<3> -> !nsl.bits<6>
+  // CHECK: %[[RX:.*]] = nsl.constant 1 : !nsl.bits<1>
+  %rx = nsl.reduce_xor %b : !nsl.bits<8> -> !nsl.bits<1>
+  // CHECK-NOT: nsl.mux
+  %pick = nsl.mux %lt, %a, %b : !nsl.bits<1>, !nsl.bits<8>, !nsl.bits<8> -> !nsl.bits<8>
+
+  %w8 = nsl.wire "w8" : !nsl.bits<8>
+  %w1 = nsl.wire "w1" : !nsl.bits<1>
+  %w16 = nsl.wire "w16" : !nsl.bits<16>
+  %w6 = nsl.wire "w6" : !nsl.bits<6>
+  // CHECK: nsl.transfer %{{.*}}, %[[SUM]] : !nsl.bits<8>
+  nsl.transfer %w8, %sum : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[DIFF]] : !nsl.bits<8>
+  nsl.transfer %w8, %diff : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[SHL]] : !nsl.bits<8>
+  nsl.transfer %w8, %shl : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[LT]] : !nsl.bits<1>
+  nsl.transfer %w1, %lt : !nsl.bits<1>
+  // CHECK: nsl.transfer %{{.*}}, %[[NOT]] : !nsl.bits<8>
+  nsl.transfer %w8, %not : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[SEXT]] : !nsl.bits<16>
+  nsl.transfer %w16, %sext : !nsl.bits<16>
+  // CHECK: nsl.transfer %{{.*}}, %[[CAT]] : !nsl.bits<16>
+  nsl.transfer %w16, %cat : !nsl.bits<16>
+  // CHECK: nsl.transfer %{{.*}}, %[[REP]] : !nsl.bits<6>
+  nsl.transfer %w6, %rep : !nsl.bits<6>
+  // CHECK: nsl.transfer %{{.*}}, %[[RX]] : !nsl.bits<1>
+  nsl.transfer %w1, %rx : !nsl.bits<1>
+  // `lt` folded to 0, so the mux picks its else arm, `%b`.
+  // CHECK: nsl.transfer %{{.*}}, %{{.*}} : !nsl.bits<8>
+  nsl.transfer %w8, %pick : !nsl.bits<8>
+}
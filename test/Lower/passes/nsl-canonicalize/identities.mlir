@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-canonicalize %s | FileCheck %s
+//
+// `nsl-canonicalize` (slot 3b). Algebraic identities fold without
+// knowing the non-constant operand: `x + 0`, `x & ~0`, `x ^ x`,
+// `~~x`, a full-width slice, `x == x`, a mux with equal arms, and
+// extends / slices of their own kind collapse into one op.
+
+// CHECK-LABEL: nsl.module @Identities
+nsl.module @Identities {
+  // CHECK: %[[X:.*]] = nsl.wire "x" : !nsl.bits<8>
+  %x = nsl.wire "x" : !nsl.bits<8>
+  // CHECK: %[[C:.*]] = nsl.wire "c" : !nsl.bits<1>
+  %c = nsl.wire "c" : !nsl.bits<1>
+  %zero = nsl.constant 0 : !nsl.bits<8>
+  %ones = nsl.constant 255 : !nsl.bits<8>
+  %t = nsl.constant 1 : !nsl.bits<1>
+  %f = nsl.constant 0 : !nsl.bits<1>
+  // CHECK-NOT: nsl.add
+  // CHECK-NOT: nsl.and
+  // CHECK-NOT: nsl.not
+  %add = nsl.add %x, %zero : !nsl.bits<8>
+  %and = nsl.and %ones, %x : !nsl.bits<8>
+  %nn0 = nsl.not %x : !nsl.bits<8>
+  %nn = nsl.not %nn0 : !nsl.bits<8>
+  %full = nsl.extract %x, 0 : !nsl.bits<8> -> !nsl.bits<8>
+  %same = nsl.mux %c, %x, %x : !nsl.bits<1>, !nsl.bits<8>, !nsl.bits<8> -> !nsl.bits<8>
+  %sel = nsl.mux %c, %t, %f : !nsl.bits<1>, !nsl.bits<1>, !nsl.bits<1> -> !nsl.bits<1>
+  // CHECK: %[[XOR:.*]] = nsl.constant 0 : !nsl.bits<8>
+  %xor = nsl.xor %x, %x : !nsl.bits<8>
+  // CHECK: %[[EQ:.*]] = nsl.constant 1 : !nsl.bits<1>
+  %eq = nsl.eq %x, %x : !nsl.bits<8> -> !nsl.bits<1>
+  // CHECK: %[[EXT:.*]] = nsl.zero_extend %[[X]] : !nsl.bits<8> to !nsl.bits<32>
+  %ext0 = nsl.zero_extend %x : !nsl.bits<8> to !nsl.bits<16>
+  %ext = nsl.zero_extend %ext0 : !nsl.bits<16> to !nsl.bits<32>
+  // CHECK: %[[MID:.*]] = nsl.extract %[[X]], 3 : !nsl.bits<8> -> !nsl.bits<2>
+  %lo = nsl.extract %x, 1 : !nsl.bits<8> -> !nsl.bits<6>
+  %mid = nsl.extract %lo, 2 : !nsl.bits<6> -> !nsl.bits<2>
+
+  %w8 = nsl.wire "w8" : !nsl.bits<8>
+  %w1 = nsl.wire "w1" : !nsl.bits<1>
+  %w32 = nsl.wire "w32" : !nsl.bits<32>
+  %w2 = nsl.wire "w2" : !nsl.bits<2>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<8>
+  nsl.transfer %w8, %add : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<8>
+  nsl.transfer %w8, %and : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<8>
+  nsl.transfer %w8, %nn : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<8>
+  nsl.transfer %w8, %full : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[X]] : !nsl.bits<8>
+  nsl.transfer %w8, %same : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[C]] : !nsl.bits<1>
+  nsl.transfer %w1, %sel : !nsl.bits<1>
+  // CHECK: nsl.transfer %{{.*}}, %[[XOR]] : !nsl.bits<8>
+  nsl.transfer %w8, %xor : !nsl.bits<8>
+  // CHECK: nsl.transfer %{{.*}}, %[[EQ]] : !nsl.bits<1>
+  nsl.transfer %w1, %eq : !nsl.bits<1>
+  // CHECK: nsl.transfer %{{.*}}, %[[EXT]] : !nsl.bits<32>
+  nsl.transfer %w32, %ext : !nsl.bits<32>
+  // CHECK: nsl.transfer %{{.*}}, %[[MID]] : !nsl.bits<2>
+  nsl.transfer %w2, %mid : !nsl.bits<2>
+}
@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-expand-variables -nsl-canonicalize %s | FileCheck %s
+//
+// `nsl-canonicalize` (slot 3b) runs after `nsl-expand-variables`, in
+// that order, as `runNSLPasses` schedules them. `%old` reads `v`
+// before the second write and is used after it. Folding `v + 0`
+// before expansion would hand `v` itself to that use, which then
+// reads the second write (`b`). After expansion `v` is a wire
+// version, so the fold forwards the first write (`a`).
+
+// CHECK-LABEL: nsl.module @WriteBetween
+// CHECK-NOT: nsl.variable
+nsl.module @WriteBetween {
+  // CHECK: %[[A:.*]] = nsl.wire "a" : !nsl.bits<8>
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %b = nsl.wire "b" : !nsl.bits<8>
+  // CHECK: %[[Y:.*]] = nsl.wire "y" : !nsl.bits<8>
+  %y = nsl.wire "y" : !nsl.bits<8>
+  %v = nsl.variable "v" : !nsl.bits<8>
+  %zero = nsl.constant 0 : !nsl.bits<8>
+  // CHECK: %[[V0:.*]] = nsl.wire "v" : !nsl.bits<8>
+  // CHECK: nsl.transfer %[[V0]], %[[A]] : !nsl.bits<8>
+  nsl.transfer %v, %a : !nsl.bits<8>
+  // CHECK-NOT: nsl.add
+  %old = nsl.add %v, %zero : !nsl.bits<8>
+  nsl.transfer %v, %b : !nsl.bits<8>
+  // CHECK: nsl.transfer %[[Y]], %[[V0]] : !nsl.bits<8>
+  nsl.transfer %y, %old : !nsl.bits<8>
+}
@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-cse %s | FileCheck %s
+//
+// `nsl-cse` (slot 5b) — only ops without side effects are merged.
+// Repeated Pure ops and constants in one block collapse onto the
+// first; repeated transfers, clocked transfers and increments are
+// effects and all stay. Arms under `nsl.seq` are lowered by the FSM
+// conversion, so their expressions are never hoisted out.
+
+// CHECK-LABEL: nsl.module @Effects
+nsl.module @Effects {
+  // CHECK: %[[A:.*]] = nsl.wire "a"
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %c1 = nsl.wire "c1" : !nsl.bits<1>
+  %c2 = nsl.wire "c2" : !nsl.bits<1>
+  // CHECK: %[[Q:.*]] = nsl.wire "q"
+  %q = nsl.wire "q" : !nsl.bits<8>
+  // CHECK: %[[R:.*]] = nsl.reg "r"
+  %r = nsl.reg "r" : !nsl.bits<8> = 0
+
+  // CHECK: %[[K:.*]] = nsl.constant 3 : !nsl.bits<8>
+  // CHECK-NOT: nsl.constant 3
+  %k1 = nsl.constant 3 : !nsl.bits<8>
+  %k2 = nsl.constant 3 : !nsl.bits<8>
+  // CHECK: %[[SUM:.*]] = nsl.add %[[A]], %[[K]] : !nsl.bits<8>
+  // CHECK-NOT: nsl.add
+  %s1 = nsl.add %a, %k1 : !nsl.bits<8>
+  %s2 = nsl.add %a, %k2 : !nsl.bits<8>
+
+  // CHECK: nsl.transfer %[[Q]], %[[SUM]]
+  // CHECK-NEXT: nsl.transfer %[[Q]], %[[SUM]]
+  nsl.transfer %q, %s1 : !nsl.bits<8>
+  nsl.transfer %q, %s2 : !nsl.bits<8>
+  // CHECK-NEXT: nsl.clocked_transfer %[[R]], %[[SUM]]
+  // CHECK-NEXT: nsl.clocked_transfer %[[R]], %[[SUM]]
+  nsl.clocked_transfer %r, %s1 : !nsl.bits<8>
+  nsl.clocked_transfer %r, %s2 : !nsl.bits<8>
+  // CHECK-NEXT: nsl.incdec %[[R]]
+  // CHECK-NEXT: nsl.incdec %[[R]]
+  nsl.incdec %r : !nsl.bits<8> {kind = #nsl<incdec_kind pre_inc>}
+  nsl.incdec %r : !nsl.bits<8> {kind = #nsl<incdec_kind pre_inc>}
+
+  // CHECK: nsl.func @f
+  nsl.func @f {
+    nsl.seq {
+      nsl.alt {
+        // CHECK: nsl.case
+        // CHECK-NEXT: nsl.xor %[[A]], %[[SUM]]
+        nsl.case %c1 : !nsl.bits<1> {
+          %x = nsl.xor %a, %s1 : !nsl.bits<8>
+          nsl.clocked_transfer %r, %x : !nsl.bits<8>
+        }
+        // CHECK: nsl.case
+        // CHECK-NEXT: nsl.xor %[[A]], %[[SUM]]
+        nsl.case %c2 : !nsl.bits<1> {
+          %x = nsl.xor %a, %s2 : !nsl.bits<8>
+          nsl.clocked_transfer %r, %x : !nsl.bits<8>
+        }
+      }
+    }
+  }
+}
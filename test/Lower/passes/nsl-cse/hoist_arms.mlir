@@ -0,0 +1,65 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-cse %s | FileCheck %s
+//
+// `nsl-cse` (slot 5b) — an expression repeated in several arms of a
+// module-level `nsl.alt` / `nsl.if` is hoisted in front of the
+// container and shared by every arm. A user of the shared op that is
+// itself repeated is hoisted on the next round. An expression that
+// appears in one arm only stays in that arm.
+
+// CHECK-LABEL: nsl.module @HoistArms
+nsl.module @HoistArms {
+  // CHECK: %[[A:.*]] = nsl.wire "a"
+  %a = nsl.wire "a" : !nsl.bits<8>
+  // CHECK: %[[B:.*]] = nsl.wire "b"
+  %b = nsl.wire "b" : !nsl.bits<8>
+  %c1 = nsl.wire "c1" : !nsl.bits<1>
+  %c2 = nsl.wire "c2" : !nsl.bits<1>
+  // CHECK: %[[Q:.*]] = nsl.wire "q"
+  %q = nsl.wire "q" : !nsl.bits<8>
+  // CHECK: %[[R:.*]] = nsl.wire "r"
+  %r = nsl.wire "r" : !nsl.bits<4>
+
+  // CHECK: %[[SUM:.*]] = nsl.add %[[A]], %[[B]] : !nsl.bits<8>
+  // CHECK-NEXT: %[[AND:.*]] = nsl.and %[[SUM]], %[[A]] : !nsl.bits<8>
+  // CHECK-NEXT: nsl.alt
+  nsl.alt {
+    // CHECK-NEXT: nsl.case
+    // CHECK-NEXT: nsl.transfer %[[Q]], %[[AND]]
+    nsl.case %c1 : !nsl.bits<1> {
+      %s = nsl.add %a, %b : !nsl.bits<8>
+      %x = nsl.and %s, %a : !nsl.bits<8>
+      nsl.transfer %q, %x : !nsl.bits<8>
+    }
+    // CHECK: nsl.case
+    // CHECK-NEXT: %[[NOT:.*]] = nsl.not %[[AND]] : !nsl.bits<8>
+    // CHECK-NEXT: nsl.transfer %[[Q]], %[[NOT]]
+    nsl.case %c2 : !nsl.bits<1> {
+      %s = nsl.add %a, %b : !nsl.bits<8>
+      %x = nsl.and %s, %a : !nsl.bits<8>
+      %n = nsl.not %x : !nsl.bits<8>
+      nsl.transfer %q, %n : !nsl.bits<8>
+    }
+    // CHECK: nsl.default
+    // CHECK-NEXT: nsl.transfer %[[Q]], %[[SUM]]
+    nsl.default {
+      %s = nsl.add %a, %b : !nsl.bits<8>
+      nsl.transfer %q, %s : !nsl.bits<8>
+    }
+  }
+
+  // CHECK: %[[HI:.*]] = nsl.extract %[[A]], 4 : !nsl.bits<8> -> !nsl.bits<4>
+  // CHECK-NEXT: nsl.if
+  nsl.if %c1 : !nsl.bits<1> {
+    // CHECK-NEXT: nsl.transfer %[[R]], %[[HI]]
+    %hi = nsl.extract %a, 4 : !nsl.bits<8> -> !nsl.bits<4>
+    nsl.transfer %r, %hi : !nsl.bits<4>
+  } else {
+    // CHECK: } else {
+    // CHECK-NEXT: %[[NHI:.*]] = nsl.not %[[HI]] : !nsl.bits<4>
+    // CHECK-NEXT: nsl.transfer %[[R]], %[[NHI]]
+    %hi = nsl.extract %a, 4 : !nsl.bits<8> -> !nsl.bits<4>
+    %n = nsl.not %hi : !nsl.bits<4>
+    nsl.transfer %r, %n : !nsl.bits<4>
+  }
+}
@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-eliminate-dead-signals %s | FileCheck %s
+//
+// `nsl-eliminate-dead-signals` — Pure ops nothing reads are erased,
+// whole expression trees at once, including inside action arms.
+// Ops with effects stay even when their operands are otherwise
+// unused, and `nsl.mem` is never touched.
+
+// CHECK-LABEL: nsl.module @DeadOps
+nsl.module @DeadOps {
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %c = nsl.wire "c" : !nsl.bits<1>
+  // CHECK: nsl.mem "ram"
+  %ram = nsl.mem "ram" : !nsl.mem<[16 x !nsl.bits<8>]>
+  // CHECK: %[[R:.*]] = nsl.reg "r"
+  %r = nsl.reg "r" : !nsl.bits<8> = 0
+
+  // CHECK-NOT: nsl.constant
+  // CHECK-NOT: nsl.add
+  // CHECK-NOT: nsl.xor
+  %k = nsl.constant 5 : !nsl.bits<8>
+  %s = nsl.add %a, %k : !nsl.bits<8>
+  %x = nsl.xor %s, %a : !nsl.bits<8>
+  // CHECK: nsl.if
+  nsl.if %c : !nsl.bits<1> {
+    // CHECK-NOT: nsl.not
+    %n = nsl.not %a : !nsl.bits<8>
+    // CHECK: nsl.incdec %[[R]]
+    nsl.incdec %r : !nsl.bits<8> {kind = #nsl<incdec_kind pre_dec>}
+  } else {
+  }
+}
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-eliminate-dead-signals %s | FileCheck %s
+//
+// `nsl-eliminate-dead-signals` — a wire or reg that is only ever
+// written is erased with its transfers, the slices they write
+// through and the expressions that fed them. Erasing `%t`'s writes
+// leaves `%u` write-only, so it goes too. A signal read by anything,
+// including an `nsl.incdec`, stays.
+
+// CHECK-LABEL: nsl.module @WriteOnly
+nsl.module @WriteOnly {
+  // CHECK: %[[A:.*]] = nsl.wire "a"
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %c = nsl.wire "c" : !nsl.bits<1>
+  // CHECK: %[[Q:.*]] = nsl.wire "q"
+  %q = nsl.wire "q" : !nsl.bits<8>
+  // CHECK-NOT: nsl.wire "t"
+  %t = nsl.wire "t" : !nsl.bits<8>
+  // CHECK-NOT: nsl.wire "u"
+  %u = nsl.wire "u" : !nsl.bits<8>
+  // CHECK-NOT: nsl.reg "dead"
+  %dead = nsl.reg "dead" : !nsl.bits<8> = 0
+  // CHECK: %[[CNT:.*]] = nsl.reg "cnt"
+  %cnt = nsl.reg "cnt" : !nsl.bits<8> = 0
+
+  // CHECK-NOT: nsl.add
+  // CHECK-NOT: nsl.extract
+  %sum = nsl.add %u, %a : !nsl.bits<8>
+  nsl.transfer %u, %a : !nsl.bits<8>
+  %lo = nsl.extract %t, 0 : !nsl.bits<8> -> !nsl.bits<4>
+  %alo = nsl.extract %a, 0 : !nsl.bits<8> -> !nsl.bits<4>
+  nsl.if %c : !nsl.bits<1> {
+    nsl.transfer %lo, %alo : !nsl.bits<4>
+  } else {
+    nsl.transfer %t, %sum : !nsl.bits<8>
+    nsl.clocked_transfer %dead, %a : !nsl.bits<8>
+  }
+
+  // CHECK: nsl.transfer %[[Q]], %[[A]]
+  nsl.transfer %q, %a : !nsl.bits<8>
+  %q2 = nsl.not %q : !nsl.bits<8>
+  nsl.clocked_transfer %cnt, %q2 : !nsl.bits<8>
+  // CHECK: nsl.incdec %[[CNT]]
+  nsl.incdec %cnt : !nsl.bits<8> {kind = #nsl<incdec_kind post_inc>}
+}
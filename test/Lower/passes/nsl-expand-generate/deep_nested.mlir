@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt --mlir-very-unsafe-disable-verifier-on-parsing -nsl-expand-generate %s | FileCheck %s
+//
+// FR-014 — three generates nested directly inside each other
+// (2x2x2 = 8 replicas of the innermost body). The innermost body
+// names every loop var, and also only the outermost one (`tap_%i%`),
+// so the outer expansions substitute into replicas an inner
+// expansion already produced. Replicas come out in loop order with
+// nothing else between them. `tools/nsl-generate-bench` runs the
+// same shape at depth.
+
+// CHECK-LABEL: nsl.module @GenDeep
+// CHECK-NOT: nsl.structural_generate
+nsl.module @GenDeep {
+  // CHECK: nsl.reg "cell_0_0_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_0_0_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_0_1_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_0_1_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_1_0_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_1_0_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_1_1_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_1_1_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "tap_1" : !nsl.bits<8>
+  // CHECK-NOT: nsl.structural_generate
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 2 : i64, step = 1 : i64, loop_var = "i"} {
+    nsl.structural_generate attributes {lower = 0 : i64, upper = 2 : i64, step = 1 : i64, loop_var = "j"} {
+      nsl.structural_generate attributes {lower = 0 : i64, upper = 2 : i64, step = 1 : i64, loop_var = "k"} {
+        nsl.reg "cell_%i%_%j%_%k%" : !nsl.bits<8>
+        nsl.reg "tap_%i%" : !nsl.bits<8>
+      }
+    }
+  }
+}
@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt --mlir-very-unsafe-disable-verifier-on-parsing -nsl-expand-generate %s | FileCheck %s
+//
+// FR-014 with the loop variable as the body's `index` induction
+// variable (the shape `nslc` lowers `generate` to). Each replica maps
+// it to an `nsl.index_constant`; structured `nsl.reg` names are
+// rendered from `name_parts` once every index is constant, and the
+// constants then go away. Nested generates render the inner names
+// only when the outer generate is expanded.
+
+// CHECK-LABEL: nsl.module @GenInduction
+// CHECK-NOT: nsl.structural_generate
+// CHECK-NOT: nsl.index_constant
+nsl.module @GenInduction {
+  // CHECK: nsl.reg "buf_0" : !nsl.bits<8> = 0
+  // CHECK-NEXT: nsl.reg "cell_0_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_0_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "buf_2" : !nsl.bits<8> = 0
+  // CHECK-NEXT: nsl.reg "cell_2_0" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.reg "cell_2_1" : !nsl.bits<8>
+  nsl.structural_generate attributes {lower = 0 : i64, upper = 4 : i64, step = 2 : i64, loop_var = "i"} {
+  ^bb0(%i: index):
+    %r = nsl.reg "buf_%i%" [%i] : !nsl.bits<8> = 0 {name_parts = ["buf_", 0 : i64]}
+    nsl.structural_generate attributes {lower = 0 : i64, upper = 2 : i64, step = 1 : i64, loop_var = "j"} {
+    ^bb0(%j: index):
+      %c = nsl.reg "cell_%i%_%j%" [%i, %j] : !nsl.bits<8> {name_parts = ["cell_", 0 : i64, "_", 1 : i64]}
+    }
+  }
+  // CHECK-NOT: name_parts
+  // CHECK-NOT: nsl.index_constant
+}
@@ -14,11 +14,14 @@
 // `nsl.wire` ops in-place (no hoisting). The expansion mechanics
 // are unchanged — same wire-chain version remap as the module-
 // scope case (`scalar_chain_of_3.mlir`); only the scope guard
-// changed (`expandOne` admits `FuncOp` as a parent in addition
-// to `ModuleOp`).
+// changed (the renaming walk admits `FuncOp` as a parent in
+// addition to `ModuleOp`).
 //
 // Pre-amendment #5 this fixture was XFAIL on the parent-trait
 // rejection; post-amendment it's a regular round-trip GREEN.
+//
+// The func-scope wire `o` reads the variable: a version nothing
+// reads is swept away with its transfer (`dead_versions.mlir`).
 
 // CHECK-LABEL: nsl.module @CrossScope
 nsl.module @CrossScope {
@@ -28,13 +31,17 @@ nsl.module @CrossScope {
     // wire under the same `nsl.func` parent. The wire is inserted
     // immediately before the transfer (the variable's first
     // write-site) so the post-pass source order is:
-    //   constant -> wire -> transfer (variable erased).
+    //   constant -> wire -> transfer -> read (variable erased).
+    // CHECK: %[[O:.*]] = nsl.wire "o" : !nsl.bits<8>
+    %o = nsl.wire "o" : !nsl.bits<8>
     %v = nsl.variable "v" : !nsl.bits<8>
     // CHECK: %[[K:.*]] = nsl.constant 0 : !nsl.bits<8>
     %k = nsl.constant 0 : !nsl.bits<8>
     // CHECK-NEXT: %[[V:.*]] = nsl.wire "v" : !nsl.bits<8>
     // CHECK-NEXT: nsl.transfer %[[V]], %[[K]]
     nsl.transfer %v, %k : !nsl.bits<8>
+    // CHECK-NEXT: nsl.transfer %[[O]], %[[V]]
+    nsl.transfer %o, %v : !nsl.bits<8>
   }
   // CHECK-NOT: nsl.variable
 }
@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-expand-variables %s | FileCheck %s
+//
+// M5 US3 / FR-015 — `NSLExpandVariablesPass` (slot 3). Only
+// versions something reads get a wire. A variable is not a port,
+// so a write no later op reads has no observable effect: the sweep
+// erases its transfer, then the pure ops that only fed it, and
+// repeats for any earlier version that loses its last read that
+// way. Surviving versions are numbered densely in source order.
+
+// CHECK-LABEL: nsl.module @DeadVersions
+// CHECK-NOT: nsl.variable
+nsl.module @DeadVersions {
+  // CHECK: %[[A:.*]] = nsl.wire "a" : !nsl.bits<8>
+  %a = nsl.wire "a" : !nsl.bits<8>
+  // CHECK: %[[B:.*]] = nsl.wire "b" : !nsl.bits<8>
+  %b = nsl.wire "b" : !nsl.bits<8>
+  %v = nsl.variable "v" : !nsl.bits<8>
+  %u = nsl.variable "u" : !nsl.bits<8>
+  // CHECK: %[[ONE:.*]] = nsl.constant 1 : !nsl.bits<8>
+  %one = nsl.constant 1 : !nsl.bits<8>
+  %two = nsl.constant 2 : !nsl.bits<8>
+  // Overwritten before any read: no wire.
+  // CHECK-NOT: nsl.constant 2
+  // CHECK-NOT: nsl.wire
+  nsl.transfer %v, %b : !nsl.bits<8>
+  // CHECK: %[[V0:.*]] = nsl.wire "v" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[V0]], %[[A]] : !nsl.bits<8>
+  nsl.transfer %v, %a : !nsl.bits<8>
+  // CHECK-NEXT: %[[T1:.*]] = nsl.add %[[V0]], %[[ONE]] : !nsl.bits<8>
+  %t1 = nsl.add %v, %one : !nsl.bits<8>
+  // CHECK-NEXT: %[[V1:.*]] = nsl.wire "v_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[V1]], %[[T1]] : !nsl.bits<8>
+  nsl.transfer %v, %t1 : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[B]], %[[V1]] : !nsl.bits<8>
+  nsl.transfer %b, %v : !nsl.bits<8>
+  // Last write, never read: the transfer, the mul and its constant
+  // all go.
+  %t2 = nsl.mul %v, %two : !nsl.bits<8>
+  nsl.transfer %v, %t2 : !nsl.bits<8>
+  // A chain nothing outside reads: `u`'s second version reads the
+  // first, but only to feed a write that is itself dead, so the
+  // whole chain goes.
+  nsl.transfer %u, %a : !nsl.bits<8>
+  %t3 = nsl.sub %u, %one : !nsl.bits<8>
+  nsl.transfer %u, %t3 : !nsl.bits<8>
+  // CHECK-NOT: nsl.wire
+  // CHECK-NOT: nsl.mul
+  // CHECK-NOT: nsl.sub
+}
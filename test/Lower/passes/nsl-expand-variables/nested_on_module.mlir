@@ -0,0 +1,31 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt --pass-pipeline='builtin.module(nsl.module(nsl-expand-variables))' %s | FileCheck %s
+//
+// Slots 2-5 are nested on `nsl.module` by `Compilation::runNSLPasses`
+// so the pass manager can run the modules concurrently. Anchored on
+// one module, the pass expands that module's variables exactly as
+// the builtin-module run does, and each module numbers its versions
+// on its own.
+
+// CHECK-LABEL: nsl.module @A
+nsl.module @A {
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %v = nsl.variable "v" : !nsl.bits<8>
+  // CHECK: %[[V:.*]] = nsl.wire "v" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[V]], %{{.*}} : !nsl.bits<8>
+  nsl.transfer %v, %a : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %{{.*}}, %[[V]] : !nsl.bits<8>
+  nsl.transfer %a, %v : !nsl.bits<8>
+}
+
+// CHECK-LABEL: nsl.module @B
+nsl.module @B {
+  %b = nsl.wire "b" : !nsl.bits<4>
+  %v = nsl.variable "v" : !nsl.bits<4>
+  // CHECK: %[[W:.*]] = nsl.wire "v" : !nsl.bits<4>
+  // CHECK-NEXT: nsl.transfer %[[W]], %{{.*}} : !nsl.bits<4>
+  nsl.transfer %v, %b : !nsl.bits<4>
+  // CHECK-NEXT: nsl.transfer %{{.*}}, %[[W]] : !nsl.bits<4>
+  nsl.transfer %b, %v : !nsl.bits<4>
+}
+// CHECK-NOT: nsl.variable
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-inline-internal-func %s | FileCheck %s
+// RUN: nsl-opt -nsl-inline-internal-func='max-growth=0' %s \
+// RUN:   | FileCheck %s --check-prefix=NOGROWTH
+//
+// M5 FR-017 — `NSLInlineInternalFuncPass` cost model. A function
+// called `calls` times is copied `calls - 1` times, so it is inlined
+// when `size * (calls - 1) <= max-growth` (default 16). `@small` (one
+// op, two calls) adds one op and is inlined everywhere. `@big` (nine
+// ops, three calls) would add eighteen and stays out of line.
+// With `max-growth=0` only single-call functions are inlined.
+
+// CHECK-LABEL: nsl.module @CostModel
+// NOGROWTH-LABEL: nsl.module @CostModel
+nsl.module @CostModel {
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %b = nsl.wire "b" : !nsl.bits<8>
+  %q = nsl.wire "q" : !nsl.bits<8>
+  nsl.func_self "small"() : () -> ()
+  nsl.func_self "big"() : () -> ()
+  nsl.func_self "once"() : () -> ()
+  // CHECK-NOT: nsl.func @small
+  // NOGROWTH: nsl.func @small
+  nsl.func @small {
+    nsl.transfer %q, %a : !nsl.bits<8>
+  }
+  // CHECK: nsl.func @big
+  // NOGROWTH: nsl.func @big
+  nsl.func @big {
+    %0 = nsl.add %a, %b : !nsl.bits<8>
+    %1 = nsl.sub %0, %b : !nsl.bits<8>
+    %2 = nsl.xor %1, %a : !nsl.bits<8>
+    %3 = nsl.and %2, %b : !nsl.bits<8>
+    %4 = nsl.or %3, %a : !nsl.bits<8>
+    %5 = nsl.mul %4, %b : !nsl.bits<8>
+    %6 = nsl.not %5 : !nsl.bits<8>
+    %7 = nsl.neg %6 : !nsl.bits<8>
+    nsl.transfer %q, %7 : !nsl.bits<8>
+  }
+  // CHECK-NOT: nsl.func @once
+  // NOGROWTH-NOT: nsl.func @once
+  nsl.func @once {
+    nsl.transfer %q, %b : !nsl.bits<8>
+  }
+  // CHECK: nsl.parallel
+  // CHECK-NEXT: nsl.transfer %{{.*}}, %{{.*}} : !nsl.bits<8>
+  // CHECK-NEXT: nsl.call @big() : () -> ()
+  // CHECK-NEXT: nsl.transfer %{{.*}}, %{{.*}} : !nsl.bits<8>
+  // CHECK-NEXT: nsl.call @big() : () -> ()
+  // CHECK-NEXT: nsl.call @big() : () -> ()
+  // CHECK-NEXT: nsl.transfer %{{.*}}, %{{.*}} : !nsl.bits<8>
+  // NOGROWTH: nsl.parallel
+  // NOGROWTH-NEXT: nsl.call @small() : () -> ()
+  // NOGROWTH-NEXT: nsl.call @big() : () -> ()
+  // NOGROWTH-NEXT: nsl.call @small() : () -> ()
+  // NOGROWTH-NEXT: nsl.call @big() : () -> ()
+  // NOGROWTH-NEXT: nsl.call @big() : () -> ()
+  // NOGROWTH-NEXT: nsl.transfer %{{.*}}, %{{.*}} : !nsl.bits<8>
+  nsl.parallel {
+    nsl.call @small() : () -> ()
+    nsl.call @big() : () -> ()
+    nsl.call @small() : () -> ()
+    nsl.call @big() : () -> ()
+    nsl.call @big() : () -> ()
+    nsl.call @once() : () -> ()
+  }
+}
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-inline-internal-func %s | FileCheck %s
+//
+// M5 FR-017 — `NSLInlineInternalFuncPass` with func-scope wires, as
+// slot 3 leaves for a func-scope variable (`v = a; q = v;`). A wire
+// may not sit under the `nsl.if` holding the call, so it is hoisted
+// into the module body just before that `nsl.if` and renamed
+// `<f>_<name>`:
+//   - `@f` has one call and is moved. `f_v` is already a module
+//     signal, so its wire becomes `f_v_1`;
+//   - `@g` has two calls and is copied. Each copy gets its own wire,
+//     `g_t` and `g_t_1`.
+// The transfers into the wires stay at the call sites.
+
+// CHECK-LABEL: nsl.module @FuncLocalWire
+nsl.module @FuncLocalWire {
+  // CHECK: %[[A:.*]] = nsl.wire "a" : !nsl.bits<8>
+  %a = nsl.wire "a" : !nsl.bits<8>
+  // CHECK: %[[Q:.*]] = nsl.wire "q" : !nsl.bits<8>
+  %q = nsl.wire "q" : !nsl.bits<8>
+  // CHECK: %[[C:.*]] = nsl.wire "c" : !nsl.bits<1>
+  %c = nsl.wire "c" : !nsl.bits<1>
+  // CHECK: nsl.wire "f_v" : !nsl.bits<8>
+  %taken = nsl.wire "f_v" : !nsl.bits<8>
+  nsl.func_self "f"() : () -> ()
+  nsl.func_self "g"() : () -> ()
+  // CHECK-NOT: nsl.func @f
+  nsl.func @f {
+    %v = nsl.wire "v" : !nsl.bits<8>
+    nsl.transfer %v, %a : !nsl.bits<8>
+    nsl.transfer %q, %v : !nsl.bits<8>
+  }
+  // CHECK-NOT: nsl.func @g
+  nsl.func @g {
+    %t = nsl.wire "t" : !nsl.bits<8>
+    nsl.transfer %t, %a : !nsl.bits<8>
+    nsl.transfer %q, %t : !nsl.bits<8>
+  }
+  // CHECK: %[[V:.*]] = nsl.wire "f_v_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.if %[[C]]
+  // CHECK-NEXT: nsl.transfer %[[V]], %[[A]] : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[Q]], %[[V]] : !nsl.bits<8>
+  nsl.if %c : !nsl.bits<1> {
+    nsl.call @f() : () -> ()
+  } else {
+  }
+  // CHECK: %[[T0:.*]] = nsl.wire "g_t" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.if %[[C]]
+  // CHECK-NEXT: nsl.transfer %[[T0]], %[[A]] : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[Q]], %[[T0]] : !nsl.bits<8>
+  nsl.if %c : !nsl.bits<1> {
+    nsl.call @g() : () -> ()
+  } else {
+  }
+  // CHECK: %[[T1:.*]] = nsl.wire "g_t_1" : !nsl.bits<8>
+  // CHECK-NEXT: nsl.parallel
+  // CHECK-NEXT: nsl.transfer %[[T1]], %[[A]] : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[Q]], %[[T1]] : !nsl.bits<8>
+  // CHECK-NOT: nsl.call
+  nsl.parallel {
+    nsl.call @g() : () -> ()
+  }
+}
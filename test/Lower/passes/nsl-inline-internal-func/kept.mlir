@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-inline-internal-func %s | FileCheck %s
+//
+// M5 FR-017 — `NSLInlineInternalFuncPass` legality. Each function
+// below has a single call and would pass the cost model, but one of
+// its properties keeps it out of line:
+//   - `@probed`: an `nsl.fire_probe` observes its activation;
+//   - `@stepped`: its body is an `nsl.seq`, lowered to a state
+//     machine of its own;
+//   - `@inproc`: its call sits in an `nsl.proc` state;
+//   - `@inloop`: it calls itself;
+//   - `@partial`: it still declares an `nsl.variable`, as slot 3
+//     leaves one written by a partial assignment. Only func-scope
+//     wires are hoisted (`func_local_wire.mlir`).
+// A function is inlined at every call site or at none, so each is
+// left exactly as written.
+
+// CHECK-LABEL: nsl.module @Kept
+nsl.module @Kept {
+  %a = nsl.wire "a" : !nsl.bits<8>
+  %q = nsl.wire "q" : !nsl.bits<8>
+  nsl.func_self "probed"() : () -> ()
+  nsl.func_self "stepped"() : () -> ()
+  nsl.func_self "inproc"() : () -> ()
+  nsl.func_self "inloop"() : () -> ()
+  nsl.func_self "partial"() : () -> ()
+  %c = nsl.wire "c" : !nsl.bits<1>
+  // CHECK: nsl.func @probed
+  nsl.func @probed {
+    nsl.transfer %q, %a : !nsl.bits<8>
+  }
+  // CHECK: nsl.func @stepped
+  nsl.func @stepped {
+    nsl.seq {
+      nsl.transfer %q, %a : !nsl.bits<8>
+    }
+  }
+  // CHECK: nsl.func @inproc
+  nsl.func @inproc {
+    nsl.transfer %q, %a : !nsl.bits<8>
+  }
+  // CHECK: nsl.func @inloop
+  // CHECK-NEXT: nsl.call @inloop() : () -> ()
+  nsl.func @inloop {
+    nsl.call @inloop() : () -> ()
+  }
+  // CHECK: nsl.func @partial
+  // CHECK-NEXT: %[[V:.*]] = nsl.variable "v" : !nsl.bits<8>
+  // CHECK-NEXT: %[[LO:.*]] = nsl.extract %[[V]], 0
+  // CHECK-NEXT: nsl.transfer %[[LO]]
+  nsl.func @partial {
+    %v = nsl.variable "v" : !nsl.bits<8>
+    %lo = nsl.extract %v, 0 : !nsl.bits<8> -> !nsl.bits<4>
+    %a4 = nsl.extract %a, 0 : !nsl.bits<8> -> !nsl.bits<4>
+    nsl.transfer %lo, %a4 : !nsl.bits<4>
+    nsl.transfer %q, %v : !nsl.bits<8>
+  }
+  // CHECK: nsl.proc @p
+  nsl.proc @p {
+    nsl.state @s0 {
+      // CHECK: nsl.call @inproc() : () -> ()
+      nsl.call @inproc() : () -> ()
+    }
+  }
+  // CHECK: nsl.parallel
+  // CHECK-NEXT: nsl.fire_probe @probed
+  // CHECK-NEXT: nsl.call @probed() : () -> ()
+  // CHECK-NEXT: nsl.call @stepped() : () -> ()
+  nsl.parallel {
+    nsl.fire_probe @probed
+    nsl.call @probed() : () -> ()
+    nsl.call @stepped() : () -> ()
+  }
+  // CHECK: nsl.if
+  // CHECK-NEXT: nsl.call @partial() : () -> ()
+  nsl.if %c : !nsl.bits<1> {
+    nsl.call @partial() : () -> ()
+  } else {
+  }
+}
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+// RUN: nsl-opt -nsl-inline-internal-func %s | FileCheck %s
+//
+// M5 FR-017 — `NSLInlineInternalFuncPass` (slot 5). A `func_self`
+// function with one call site is moved into it. Each argument turns
+// into a transfer into the `func_self` argument value, the body
+// follows in place of the call, and the `nsl.func` is erased. The
+// `nsl.func_self` declaration stays.
+
+// CHECK-LABEL: nsl.module @SingleCall
+nsl.module @SingleCall {
+  // CHECK: %[[X:.*]] = nsl.wire "x" : !nsl.bits<8>
+  %x = nsl.wire "x" : !nsl.bits<8>
+  // CHECK: %[[Q:.*]] = nsl.wire "q" : !nsl.bits<8>
+  %q = nsl.wire "q" : !nsl.bits<8>
+  // CHECK: %[[C:.*]] = nsl.wire "c" : !nsl.bits<1>
+  %c = nsl.wire "c" : !nsl.bits<1>
+  // CHECK: %[[A:.*]] = nsl.wire "a" : !nsl.bits<8>
+  %a = nsl.wire "a" : !nsl.bits<8>
+  // CHECK: nsl.func_self "load"(%[[A]]) : (!nsl.bits<8>) -> ()
+  nsl.func_self "load"(%a) : (!nsl.bits<8>) -> ()
+  // CHECK-NOT: nsl.func @load
+  nsl.func @load {
+    nsl.transfer %q, %a : !nsl.bits<8>
+  }
+  // The body now runs only where the call did: under `c`.
+  // CHECK: nsl.if %[[C]]
+  // CHECK-NEXT: nsl.transfer %[[A]], %[[X]] : !nsl.bits<8>
+  // CHECK-NEXT: nsl.transfer %[[Q]], %[[A]] : !nsl.bits<8>
+  // CHECK-NOT: nsl.call
+  nsl.if %c : !nsl.bits<1> {
+    nsl.call @load(%x) : (!nsl.bits<8>) -> ()
+  } else {
+  }
+}
@@ -39,7 +39,9 @@ llvm::json::Object buildExpectedCapabilities() {
   // Per contract §1.2 — exact, byte-for-byte. Insertion order
   // matches `NslLSPServer::buildCapabilities()` (alphabetical).
   return llvm::json::Object{
+      {"definitionProvider", true},
       {"foldingRangeProvider", true},
+      {"hoverProvider", true},
       {"textDocumentSync",
        llvm::json::Object{
            {"change", 1},
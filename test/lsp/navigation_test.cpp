@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test/lsp/navigation_test.cpp — `textDocument/hover` and
+// `textDocument/definition` integration tests. Both answer from
+// `NslTU::symbolAt`, which analyses the document through
+// `LazySema`.
+
+#include "LspSession.h"
+
+#include "llvm/Support/JSON.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace nsl::lsp::test;
+
+namespace {
+
+// Line numbers below are zero-based, as on the wire.
+constexpr const char *kDocument = "declare alu {\n"   // 0
+                                  "  input a[8];\n"   // 1
+                                  "  output y[8];\n"  // 2
+                                  "}\n"               // 3
+                                  "module alu {\n"    // 4
+                                  "  wire t[8];\n"    // 5
+                                  "  t = a;\n"        // 6
+                                  "  y = t;\n"        // 7
+                                  "}\n";              // 8
+
+void initialize(LspSession &s) {
+  int64_t id = s.sendRequest("initialize", llvm::json::Object{});
+  ASSERT_TRUE(s.waitForResponse(id).has_value());
+  s.sendNotification("initialized", llvm::json::Object{});
+}
+
+void didOpen(LspSession &s, llvm::StringRef uri, llvm::StringRef text) {
+  s.sendNotification("textDocument/didOpen", llvm::json::Object{
+                                                 {"textDocument",
+                                                  llvm::json::Object{
+                                                      {"uri", uri.str()},
+                                                      {"languageId", "nsl"},
+                                                      {"version", 1},
+                                                      {"text", text.str()},
+                                                  }},
+                                             });
+}
+
+/// The `result` of a `method` request at (`line`, `character`).
+llvm::json::Value request(LspSession &s, llvm::StringRef method,
+                          llvm::StringRef uri, int line, int character) {
+  int64_t id = s.sendRequest(
+      method, llvm::json::Object{
+                  {"textDocument", llvm::json::Object{{"uri", uri.str()}}},
+                  {"position", llvm::json::Object{{"character", character},
+                                                  {"line", line}}},
+              });
+  auto resp = s.waitForResponse(id);
+  EXPECT_TRUE(resp.has_value());
+  if (!resp || !resp->getAsObject()) {
+    return nullptr;
+  }
+  const llvm::json::Value *r = resp->getAsObject()->get("result");
+  return r ? *r : llvm::json::Value(nullptr);
+}
+
+} // namespace
+
+TEST(NavigationSuite, HoverShowsKindNameAndType) {
+  LspSession s({.nsl_lsp_log_level = "warn"});
+  initialize(s);
+  didOpen(s, "file:///n.nsl", kDocument);
+  s.waitForDiagnostics();
+
+  // The `t` in `y = t;`.
+  llvm::json::Value r = request(s, "textDocument/hover", "file:///n.nsl", 7, 6);
+  auto *obj = r.getAsObject();
+  ASSERT_NE(obj, nullptr);
+  auto *contents = obj->getObject("contents");
+  ASSERT_NE(contents, nullptr);
+  EXPECT_EQ(contents->getString("kind").value_or(""), "plaintext");
+  EXPECT_EQ(contents->getString("value").value_or(""),
+            "Wire t : BitVector(8)");
+
+  s.doShutdownExit();
+}
+
+TEST(NavigationSuite, HoverOffANameIsNull) {
+  LspSession s({.nsl_lsp_log_level = "warn"});
+  initialize(s);
+  didOpen(s, "file:///n.nsl", kDocument);
+  s.waitForDiagnostics();
+
+  // The blank after `}` that closes the module.
+  llvm::json::Value r = request(s, "textDocument/hover", "file:///n.nsl", 8, 1);
+  EXPECT_EQ(r, llvm::json::Value(nullptr));
+
+  s.doShutdownExit();
+}
+
+TEST(NavigationSuite, DefinitionJumpsToTheDeclarePort) {
+  LspSession s({.nsl_lsp_log_level = "warn"});
+  initialize(s);
+  didOpen(s, "file:///n.nsl", kDocument);
+  s.waitForDiagnostics();
+
+  // The `a` in `t = a;` is declared in the `declare` block.
+  llvm::json::Value r =
+      request(s, "textDocument/definition", "file:///n.nsl", 6, 6);
+  auto *obj = r.getAsObject();
+  ASSERT_NE(obj, nullptr);
+  EXPECT_EQ(obj->getString("uri").value_or(""), "file:///n.nsl");
+  auto *range = obj->getObject("range");
+  ASSERT_NE(range, nullptr);
+  auto *start = range->getObject("start");
+  ASSERT_NE(start, nullptr);
+  EXPECT_EQ(start->getInteger("line").value_or(-1), 1);
+
+  s.doShutdownExit();
+}
@@ -29,6 +29,7 @@
 #include "nsl/Lex/Token.h"
 #include "nsl/Parse/Parser.h"
 
+#include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/StringRef.h"
 
 #include "gtest/gtest.h"
@@ -169,10 +170,10 @@ TEST(DirectiveSplitterTest, AllNSLFragmentNoDirectives) {
 // -----------------------------------------------------------------------------
 //
 // Per `cst-shape.contract.md` §8: serialising the recorded CST event
-// stream MUST reproduce the source byte-for-byte. For Phase 2b the
-// CSTBuilder records only top-level production + tokens (sub-
-// production wrapping arrives in Phase 3+); the source-buffer-
-// guided `serialize()` reconstructs trivia from the source view.
+// stream MUST reproduce the source byte-for-byte. The CSTBuilder
+// records one frame per parsed production plus every token; the
+// source-buffer-guided `serialize()` reconstructs trivia from the
+// source view.
 //
 // Helper: convert a C string to a vector<char> (matches the existing
 // parser-test convention from test_unit/parse_test/).
@@ -207,18 +208,96 @@ TEST(DirectiveSplitterTest, CSTRoundTrip) {
   ASSERT_NE(cu, nullptr) << "parse should succeed for well-formed input";
   EXPECT_FALSE(diag.hasError()) << "no diagnostics expected";
 
-  // The Phase 2b CST contains exactly one top-level node + every
-  // consumed token.
-  EXPECT_EQ(builder.nodeCount(), 1u)
-      << "exactly one CompilationUnit beginNode/endNode pair expected";
+  // One frame per production: the CompilationUnit root completes
+  // last, the module sits directly under it, and each of the three
+  // internal declarations is a child of the module.
+  ASSERT_GT(builder.nodeCount(), 1u)
+      << "every production should open a beginNode/endNode pair";
   EXPECT_GT(builder.tokenCount(), 0u)
       << "the parser should have consumed at least one token";
+  llvm::ArrayRef<CSTBuilder::Frame> frames = builder.completedNodes();
+  EXPECT_EQ(frames.back().kindName, "CompilationUnit");
+  EXPECT_EQ(frames.back().depth, 0u);
+  EXPECT_EQ(frames[frames.size() - 2].kindName, "ModuleBlock");
+  EXPECT_EQ(frames[frames.size() - 2].depth, 1u);
+  std::size_t internalDecls = 0;
+  for (const CSTBuilder::Frame &f : frames) {
+    if (f.kindName == "InternalDecl") {
+      ++internalDecls;
+      EXPECT_EQ(f.depth, 2u);
+      EXPECT_LT(f.firstToken, f.lastToken);
+    }
+  }
+  EXPECT_EQ(internalDecls, 3u);
 
   // Round-trip: serialize() must reproduce the source byte-for-byte
   // (cst-shape contract §8 invariant).
   EXPECT_EQ(builder.serialize(), std::string(kSource));
 }
 
+// Expressions form a tree: each binary, unary and postfix step opens
+// its own node around its operands rather than leaving one flat
+// `Expr` of leaves and operator tokens.
+TEST(DirectiveSplitterTest, CSTNestsExpressions) {
+  const char *kSource = "module m {\n"
+                        "  reg r[8] = 1 + 2 * 3 - 4;\n"
+                        "  reg s[8] = ~t[3];\n"
+                        "}\n";
+  StringRef sourceView(kSource);
+
+  nsl::SourceManager sm;
+  nsl::FileID fid =
+      sm.addBufferInMemory("/virt/cst-expr.nsl", bytesOf(kSource));
+  ASSERT_TRUE(fid.isValid());
+  nsl::DiagnosticEngine diag(sm);
+  nsl::Lexer lex(sm, fid, diag);
+
+  CSTBuilder builder(sourceView);
+  std::unique_ptr<nsl::ast::CompilationUnit> cu =
+      nsl::parse::parseCompilationUnit(lex, diag, &builder);
+  ASSERT_NE(cu, nullptr);
+  EXPECT_FALSE(diag.hasError());
+  EXPECT_EQ(builder.serialize(), std::string(kSource));
+
+  // `1 + 2 * 3 - 4` is `(1 + (2 * 3)) - 4`: three binary nodes,
+  // completed innermost first, each one level above the last and
+  // spanning 3, 5 and 7 tokens. The outermost sits directly under
+  // the initialiser's `Expr`.
+  std::vector<const CSTBuilder::Frame *> binaries;
+  const CSTBuilder::Frame *firstExpr = nullptr;
+  const CSTBuilder::Frame *unary = nullptr;
+  const CSTBuilder::Frame *slice = nullptr;
+  for (const CSTBuilder::Frame &f : builder.completedNodes()) {
+    if (f.kindName == "BinaryExpr") {
+      binaries.push_back(&f);
+    } else if (f.kindName == "Expr" && firstExpr == nullptr &&
+               binaries.size() == 3) {
+      firstExpr = &f;
+    } else if (f.kindName == "UnaryExpr") {
+      unary = &f;
+    } else if (f.kindName == "SliceExpr") {
+      slice = &f;
+    }
+  }
+  ASSERT_EQ(binaries.size(), 3u);
+  for (std::size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(binaries[i]->lastToken - binaries[i]->firstToken, 3 + 2 * i);
+  }
+  EXPECT_EQ(binaries[0]->depth, binaries[1]->depth + 1);
+  EXPECT_EQ(binaries[1]->depth, binaries[2]->depth + 1);
+  ASSERT_NE(firstExpr, nullptr);
+  EXPECT_EQ(binaries[2]->depth, firstExpr->depth + 1);
+  EXPECT_EQ(binaries[2]->firstToken, firstExpr->firstToken);
+  EXPECT_EQ(binaries[2]->lastToken, firstExpr->lastToken);
+
+  // `~t[3]`: the slice binds tighter, so it sits inside the unary.
+  ASSERT_NE(unary, nullptr);
+  ASSERT_NE(slice, nullptr);
+  EXPECT_EQ(slice->depth, unary->depth + 1);
+  EXPECT_EQ(unary->lastToken - unary->firstToken, 5u);
+  EXPECT_EQ(slice->lastToken - slice->firstToken, 4u);
+}
+
 // -----------------------------------------------------------------------------
 // T020 — CSTInvariants
 // -----------------------------------------------------------------------------
@@ -272,9 +351,17 @@ TEST(DirectiveSplitterTest, CSTInvariants) {
   // coverage check above, but we keep both for failure isolation.)
   EXPECT_EQ(builder.serialize(), std::string(kSource));
 
-  // Invariant 4 (frame bookkeeping): one completed top-level node.
-  EXPECT_EQ(builder.nodeCount(), 1u);
-  EXPECT_EQ(builder.completedNodes()[0].kindName, "CompilationUnit");
+  // Invariant 4 (frame bookkeeping): the module frame completes
+  // before the CompilationUnit root and spans the whole token stream
+  // up to (not including) EOF.
+  ASSERT_EQ(builder.nodeCount(), 2u);
+  const CSTBuilder::Frame &mod = builder.completedNodes()[0];
+  EXPECT_EQ(mod.kindName, "ModuleBlock");
+  EXPECT_EQ(mod.depth, 1u);
+  EXPECT_EQ(mod.firstToken, 0u);
+  EXPECT_EQ(mod.start.offset(), 0u);
+  EXPECT_EQ(mod.end.offset(), 16u); // one past the closing `}`
+  EXPECT_EQ(builder.completedNodes()[1].kindName, "CompilationUnit");
 }
 
 // All nine directive opcodes are recognised.
@@ -74,6 +74,7 @@
 #include <memory>
 #include <regex>
 #include <string>
+#include <utility>
 #include <vector>
 
 using nsl::FileID;
@@ -293,4 +294,120 @@ TEST(ASTPrinterDeterminism, EmptyCompilationUnitIsIdempotent) {
   EXPECT_NE(a.find("(CompilationUnit"), std::string::npos);
 }
 
+// ---- Binary dump (`dumpBinary`) ----------------------------------------
+
+std::string dumpToString(const CompilationUnit &cu, const SourceManager &sm) {
+  std::string buf;
+  llvm::raw_string_ostream os(buf);
+  nsl::ast::dumpBinary(cu, sm, os);
+  os.flush();
+  return buf;
+}
+
+// Minimal decoder for the layout documented in `Printer.h`: walks the
+// record stream, checking open / close balance, and collects the
+// node kinds and string fields in order.
+struct DecodedDump {
+  std::vector<NodeKind> kinds;
+  std::vector<std::pair<std::string, std::string>> strFields;
+  bool wellFormed = false;
+};
+
+DecodedDump decodeDump(llvm::StringRef bytes) {
+  using nsl::ast::BinaryDumpTag;
+  DecodedDump out;
+  llvm::StringRef const magic(nsl::ast::kBinaryDumpMagic);
+  if (!bytes.consume_front(magic)) {
+    return out;
+  }
+  std::vector<std::string> strings;
+  std::size_t pos = 0;
+  auto uleb = [&]() -> uint64_t {
+    uint64_t v = 0;
+    unsigned shift = 0;
+    while (pos < bytes.size()) {
+      auto const b = static_cast<uint8_t>(bytes[pos++]);
+      v |= static_cast<uint64_t>(b & 0x7f) << shift;
+      if ((b & 0x80) == 0) {
+        break;
+      }
+      shift += 7;
+    }
+    return v;
+  };
+  auto str = [&]() -> std::string {
+    uint64_t const id = uleb();
+    if (id != 0) {
+      return id <= strings.size() ? strings[id - 1] : std::string();
+    }
+    uint64_t const len = uleb();
+    strings.push_back(bytes.substr(pos, len).str());
+    pos += len;
+    return strings.back();
+  };
+
+  if (uleb() != nsl::ast::kBinaryDumpVersion) {
+    return out;
+  }
+  int depth = 0;
+  while (pos < bytes.size()) {
+    switch (static_cast<BinaryDumpTag>(bytes[pos++])) {
+    case BinaryDumpTag::End:
+      out.wellFormed = depth == 0 && pos == bytes.size();
+      return out;
+    case BinaryDumpTag::Node:
+      ++depth;
+      out.kinds.push_back(static_cast<NodeKind>(uleb()));
+      if (!str().empty()) {
+        for (int i = 0; i < 4; ++i) {
+          (void)uleb();
+        }
+      }
+      break;
+    case BinaryDumpTag::Synthetic:
+      ++depth;
+      (void)str();
+      break;
+    case BinaryDumpTag::Close:
+      --depth;
+      break;
+    case BinaryDumpTag::StrField: {
+      std::string name = str();
+      out.strFields.emplace_back(std::move(name), str());
+      break;
+    }
+    default:
+      return out;
+    }
+  }
+  return out;
+}
+
+TEST(ASTPrinterDeterminism, BinaryDumpDecodesToTheSameTree) {
+  SourceManager sm = makeSmallFixtureSM();
+  auto cu = buildSmallFixture(FileID(1));
+  std::string const bin = dumpToString(*cu, sm);
+  EXPECT_EQ(bin, dumpToString(*cu, sm));
+
+  DecodedDump const d = decodeDump(bin);
+  ASSERT_TRUE(d.wellFormed);
+  std::vector<NodeKind> const expected = {
+      NodeKind::NK_CompilationUnit, NodeKind::NK_ModuleBlock,
+      NodeKind::NK_RegDecl, NodeKind::NK_LiteralExpr,
+      NodeKind::NK_LiteralExpr};
+  EXPECT_EQ(d.kinds, expected);
+  ASSERT_GE(d.strFields.size(), 2U);
+  EXPECT_EQ(d.strFields[0], std::make_pair(std::string("name"),
+                                           std::string("hello")));
+  EXPECT_EQ(d.strFields[1],
+            std::make_pair(std::string("name"), std::string("q")));
+
+  // Interning: the path every `loc` shares is spelled out once, and
+  // the whole dump undercuts the text form.
+  std::size_t const first = bin.find("hello.nsl");
+  ASSERT_NE(first, std::string::npos);
+  EXPECT_EQ(bin.find("hello.nsl", first + 1), std::string::npos);
+  EXPECT_LT(bin.size(), renderToString(*cu, sm).size());
+}
+
 } // namespace
@@ -0,0 +1,268 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/constraint_fusion_test/fused_equivalence_test.cpp
+//
+// `runAllConstraints` drives the Sn checkers from one shared
+// traversal and replays their buffered diagnostics in Sn order. This
+// suite pins it to the reference path, `runAllConstraintsUnfused`
+// (each checker walks the unit itself), on every `.nsl` file under
+// `test/sema/`: same diagnostics, same order, same fix-its and notes,
+// whatever the number of shards the traversal is split into. The
+// per-item path behind `SemaCache` is held to the same output, cold
+// and after an edit that leaves most modules untouched.
+
+#include "ConstraintCheckRegistry.h"
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/Decl.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::Diagnostic;
+using nsl::DiagnosticEngine;
+using nsl::FixItHint;
+using nsl::SourceManager;
+using nsl::sema::ConstraintContext;
+using nsl::sema::SemaCache;
+
+std::vector<std::string> corpusFiles() {
+  std::vector<std::string> out;
+  std::error_code ec;
+  for (llvm::sys::fs::recursive_directory_iterator it(NSL_SEMA_CORPUS_DIR,
+                                                      ec),
+       end;
+       it != end && !ec; it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) == ".nsl") {
+      out.push_back(it->path());
+    }
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+/// One line per diagnostic (and per fix-it / note), in emission order.
+std::string flatten(const DiagnosticEngine &diag) {
+  std::string out;
+  for (const Diagnostic &d : diag.diagnostics()) {
+    out += std::to_string(static_cast<int>(d.severity)) + "@" +
+           std::to_string(d.loc.rawBits()) + ": " + d.message + "\n";
+    for (const FixItHint &f : d.fixits) {
+      out += "  fixit@" + std::to_string(f.range.begin().rawBits()) + "-" +
+             std::to_string(f.range.end().rawBits()) + ": " +
+             f.replacement + "\n";
+    }
+    for (const Diagnostic &n : d.notes) {
+      out += "  note@" + std::to_string(n.loc.rawBits()) + ": " +
+             n.message + "\n";
+    }
+  }
+  return out;
+}
+
+/// A parsed unit together with its Sema result.
+struct Analyzed {
+  std::unique_ptr<nsl::ast::CompilationUnit> unit;
+  nsl::sema::SemaResult result;
+};
+
+/// Parse `text` and run Sema on it; null if it does not parse clean.
+std::unique_ptr<Analyzed> analyze(SourceManager &sm, const std::string &name,
+                                  const std::string &text) {
+  DiagnosticEngine diag(sm);
+  nsl::FileID fid = sm.addBufferInMemory(
+      name, std::vector<char>(text.begin(), text.end()));
+  nsl::Lexer lex(sm, fid, diag);
+  auto out = std::make_unique<Analyzed>();
+  out->unit = nsl::parse::parseCompilationUnit(lex, diag);
+  if (!out->unit || diag.hasError()) {
+    return nullptr;
+  }
+  nsl::sema::Sema sema(diag);
+  out->result = sema.run(*out->unit);
+  return out;
+}
+
+/// Compare the reference path against the fused path at several
+/// shard counts. Returns the number of constraint diagnostics.
+std::size_t expectEquivalent(SourceManager &sm, const Analyzed &a) {
+  // Every run sees the same post-Sema state; S18 rewrites struct
+  // layouts idempotently, so the order of the runs does not matter.
+  ConstraintContext ctx{a.unit.get(), a.result.symbols.get(),
+                        a.result.types.get(), &a.result.resolutions, nullptr};
+  DiagnosticEngine unfused(sm);
+  ctx.diag = &unfused;
+  nsl::sema::runAllConstraintsUnfused(ctx);
+  const std::string expected = flatten(unfused);
+  for (unsigned threads : {1U, 2U, 3U, 8U}) {
+    SCOPED_TRACE("threads=" + std::to_string(threads));
+    DiagnosticEngine fused(sm);
+    ctx.diag = &fused;
+    nsl::sema::runAllConstraints(ctx, threads);
+    EXPECT_EQ(expected, flatten(fused));
+  }
+  {
+    SCOPED_TRACE("per item");
+    DiagnosticEngine byItem(sm);
+    ctx.diag = &byItem;
+    std::vector<std::optional<nsl::sema::ItemDiagnostics>> items;
+    nsl::sema::runConstraintsByItem(ctx, items);
+    EXPECT_EQ(expected, flatten(byItem));
+  }
+  return unfused.diagnostics().size();
+}
+
+/// Everything a full Sema run over `text` reports, flattened, using
+/// `cache` when given. Also returns the number of `module` blocks.
+std::string semaDiagnostics(const std::string &text, SemaCache *cache,
+                            std::size_t *modules = nullptr) {
+  SourceManager sm;
+  DiagnosticEngine diag(sm);
+  nsl::FileID fid = sm.addBufferInMemory(
+      "/virt/cached.nsl", std::vector<char>(text.begin(), text.end()));
+  nsl::Lexer lex(sm, fid, diag);
+  auto unit = nsl::parse::parseCompilationUnit(lex, diag);
+  if (!unit) {
+    return "<no unit>";
+  }
+  if (modules != nullptr) {
+    *modules = static_cast<std::size_t>(std::count_if(
+        unit->items().begin(), unit->items().end(), [](const auto &d) {
+          return d && d->kind() == nsl::ast::NodeKind::NK_ModuleBlock;
+        }));
+  }
+  nsl::sema::Sema sema(diag, cache);
+  sema.run(*unit);
+  return flatten(diag);
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+/// Every clean-parsing corpus file, in one unit.
+std::string concatenatedCorpus() {
+  std::string text;
+  for (const std::string &path : corpusFiles()) {
+    SourceManager probe;
+    std::string one = readFile(path);
+    if (analyze(probe, path, one)) {
+      text += one;
+      text += "\n";
+    }
+  }
+  return text;
+}
+
+TEST(ConstraintFusionTest, FusedWalkMatchesPerCheckerWalks) {
+  const std::vector<std::string> files = corpusFiles();
+  ASSERT_FALSE(files.empty()) << "no corpus under " << NSL_SEMA_CORPUS_DIR;
+
+  unsigned with_constraint_diags = 0;
+  for (const std::string &path : files) {
+    SCOPED_TRACE(path);
+    SourceManager sm;
+    auto a = analyze(sm, path, readFile(path));
+    if (a && expectEquivalent(sm, *a) != 0U) {
+      ++with_constraint_diags;
+    }
+  }
+  // The corpus carries a fail case for most Sn; make sure the
+  // comparison above was not vacuous.
+  EXPECT_GE(with_constraint_diags, 10U);
+}
+
+// One unit holding every clean-parsing corpus file, so the shards
+// each see many modules and the per-Sn merge has real work to order.
+TEST(ConstraintFusionTest, ShardedWalkMatchesOnConcatenatedCorpus) {
+  SourceManager sm;
+  auto a = analyze(sm, "/virt/corpus.nsl", concatenatedCorpus());
+  ASSERT_NE(a, nullptr);
+  EXPECT_GT(a->unit->items().size(), 20U);
+  EXPECT_GT(expectEquivalent(sm, *a), 10U);
+}
+
+TEST(ConstraintFusionTest, ColdSemaCacheMatchesUncachedRun) {
+  for (const std::string &path : corpusFiles()) {
+    SCOPED_TRACE(path);
+    const std::string text = readFile(path);
+    SemaCache cache;
+    std::size_t modules = 0;
+    EXPECT_EQ(semaDiagnostics(text, nullptr),
+              semaDiagnostics(text, &cache, &modules));
+    EXPECT_EQ(cache.lastHits(), 0U);
+    EXPECT_EQ(cache.lastMisses(), modules);
+  }
+}
+
+// Edit one module of a large unit: only that module is re-checked,
+// the others' cached diagnostics are moved to where their modules now
+// sit, and the run reports exactly what an uncached one would.
+TEST(ConstraintFusionTest, WarmSemaCacheRechecksOnlyEditedModule) {
+  std::string text = concatenatedCorpus();
+  SemaCache cache;
+  std::size_t modules = 0;
+  EXPECT_EQ(semaDiagnostics(text, nullptr),
+            semaDiagnostics(text, &cache, &modules));
+  ASSERT_GT(modules, 10U);
+  EXPECT_GT(cache.size(), 0U);
+
+  // Same text again: every module whose output could be cached is a
+  // hit (modules with identical text share one entry).
+  EXPECT_EQ(semaDiagnostics(text, nullptr), semaDiagnostics(text, &cache));
+  const std::size_t hits = cache.lastHits();
+  EXPECT_GT(hits, modules / 2);
+  EXPECT_EQ(cache.lastMisses(), modules - hits);
+
+  // Add a line inside the first module's body; everything after it
+  // moves down by one byte.
+  const std::size_t body = text.find('{', text.find("module "));
+  ASSERT_NE(body, std::string::npos);
+  text.insert(body + 1, "\n");
+  const std::string uncached = semaDiagnostics(text, nullptr);
+  EXPECT_EQ(uncached, semaDiagnostics(text, &cache));
+  EXPECT_EQ(cache.lastMisses() + cache.lastHits(), modules);
+  EXPECT_GE(cache.lastHits(), hits - 1U);
+}
+
+// A new name bound inside one module is not visible to any other, so
+// it must not drop the other modules' entries.
+TEST(ConstraintFusionTest, LocalEditKeepsOtherModulesWarm) {
+  const std::string declares = "declare a { input x[4]; output y[4]; }\n"
+                               "declare b { input x[4]; output y[4]; }\n";
+  const std::string b = "module b { y = x; }\n";
+  SemaCache cache;
+  std::size_t modules = 0;
+  semaDiagnostics(declares + "module a { y = x; }\n" + b, &cache, &modules);
+  ASSERT_EQ(modules, 2U);
+  EXPECT_EQ(cache.lastMisses(), 2U);
+
+  const std::string edited =
+      declares + "module a { wire t[4]; t = x; y = t; }\n" + b;
+  EXPECT_EQ(semaDiagnostics(edited, nullptr), semaDiagnostics(edited, &cache));
+  EXPECT_EQ(cache.lastHits(), 1U);
+  EXPECT_EQ(cache.lastMisses(), 1U);
+}
+
+} // namespace
@@ -0,0 +1,256 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/constraint_fusion_test/lazy_sema_test.cpp
+//
+// `LazySema` answers questions about part of a unit without
+// analysing the rest. Asserts:
+//   - asking about an expression resolves the items up to its own
+//     and no further, and the answer is the one `Sema::run()` gives;
+//   - an item's diagnostics resolve through that item and check it
+//     alone, and together the items' diagnostics are exactly what
+//     `Sema::run()` reports;
+//   - `exprAt()` finds the innermost expression at a location;
+//   - `finish()` reports, in order, what `Sema::run()` reports over
+//     every `test/sema/` file, whatever was asked before it.
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/ModuleBlock.h"
+#include "nsl/AST/TransferStmt.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+#include "nsl/Sema/TypeSystem.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::Diagnostic;
+using nsl::DiagnosticEngine;
+using nsl::SourceManager;
+using nsl::ast::CompilationUnit;
+using nsl::ast::NodeKind;
+using nsl::sema::LazySema;
+
+std::vector<std::string> corpusFiles() {
+  std::vector<std::string> out;
+  std::error_code ec;
+  for (llvm::sys::fs::recursive_directory_iterator it(NSL_SEMA_CORPUS_DIR,
+                                                      ec),
+       end;
+       it != end && !ec; it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) == ".nsl") {
+      out.push_back(it->path());
+    }
+  }
+  std::sort(out.begin(), out.end());
+  return out;
+}
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+std::string flatten(llvm::ArrayRef<Diagnostic> diags) {
+  std::string out;
+  for (const Diagnostic &d : diags) {
+    out += std::to_string(static_cast<int>(d.severity)) + "@" +
+           std::to_string(d.loc.rawBits()) + ": " + d.message + "\n";
+    for (const Diagnostic &n : d.notes) {
+      out += "  note@" + std::to_string(n.loc.rawBits()) + ": " +
+             n.message + "\n";
+    }
+  }
+  return out;
+}
+
+/// `text` parsed into its own SourceManager; null unit on failure.
+struct Parsed {
+  SourceManager sm;
+  DiagnosticEngine diag{sm};
+  std::unique_ptr<CompilationUnit> unit;
+
+  explicit Parsed(const std::string &text) {
+    nsl::FileID fid = sm.addBufferInMemory(
+        "/virt/lazy.nsl", std::vector<char>(text.begin(), text.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    unit = nsl::parse::parseCompilationUnit(lex, diag);
+  }
+};
+
+/// What `Sema::run()` reports over `text`, and whether it errs.
+std::string eagerDiagnostics(const std::string &text, bool *errors) {
+  Parsed p(text);
+  if (!p.unit) {
+    return "<no unit>";
+  }
+  nsl::sema::Sema sema(p.diag);
+  *errors = sema.run(*p.unit).hasErrors;
+  return flatten(p.diag.diagnostics());
+}
+
+/// Item indices of the unit's `module` blocks.
+std::vector<std::size_t> modules(const CompilationUnit &unit) {
+  std::vector<std::size_t> out;
+  for (std::size_t i = 0; i < unit.items().size(); ++i) {
+    const auto &item = unit.items()[i];
+    if (item && item->kind() == NodeKind::NK_ModuleBlock) {
+      out.push_back(i);
+    }
+  }
+  return out;
+}
+
+/// Right-hand side of the first transfer in item `index`, a module.
+const nsl::ast::Expr *firstRhs(const CompilationUnit &unit,
+                               std::size_t index) {
+  const auto &m = static_cast<const nsl::ast::ModuleBlock &>(
+      *unit.items()[index]);
+  for (const auto &a : m.actions()) {
+    if (a && a->kind() == NodeKind::NK_TransferStmt) {
+      return static_cast<const nsl::ast::TransferStmt &>(*a).rhs();
+    }
+  }
+  return nullptr;
+}
+
+constexpr const char *kThreeModules = "declare a { input i[4]; output o[4]; }\n"
+                                      "module a { o = i; }\n"
+                                      "declare b { input i[8]; output o[8]; }\n"
+                                      "module b { o = i + missing; }\n"
+                                      "declare c { input i[2]; output o[2]; }\n"
+                                      "module c { o = i; }\n";
+
+TEST(LazySemaTest, ResolvesOnlyUpToTheItemAsked) {
+  Parsed p(kThreeModules);
+  ASSERT_NE(p.unit, nullptr);
+  LazySema lazy(*p.unit, p.diag);
+  EXPECT_EQ(lazy.resolvedItems(), 0U);
+
+  const nsl::ast::Expr *rhs = firstRhs(*p.unit, 1);
+  ASSERT_NE(rhs, nullptr);
+  EXPECT_EQ(lazy.itemAt(rhs->loc().begin()), 1U);
+  EXPECT_NE(lazy.resolve(*rhs), nullptr);
+  EXPECT_EQ(lazy.resolvedItems(), 2U);
+  const nsl::sema::Type *t = lazy.typeOf(*rhs);
+  ASSERT_NE(t, nullptr);
+  ASSERT_EQ(t->kind(), nsl::sema::TypeKind::BitVector);
+  EXPECT_EQ(static_cast<const nsl::sema::BitVectorType *>(t)->width(), 4U);
+  EXPECT_EQ(lazy.resolvedItems(), 2U);
+  // Later modules are untouched, and nothing was reported yet.
+  EXPECT_EQ(firstRhs(*p.unit, 5)->inferredType(), nullptr);
+  EXPECT_EQ(lazy.checkedItems(), 0U);
+  EXPECT_TRUE(p.diag.diagnostics().empty());
+}
+
+TEST(LazySemaTest, ItemDiagnosticsPartitionTheEagerOnes) {
+  bool errors = false;
+  const std::string eager = eagerDiagnostics(kThreeModules, &errors);
+  EXPECT_TRUE(errors);
+
+  Parsed p(kThreeModules);
+  ASSERT_NE(p.unit, nullptr);
+  LazySema lazy(*p.unit, p.diag);
+  const std::vector<Diagnostic> &b = lazy.diagnosticsFor(3);
+  ASSERT_EQ(b.size(), 1U);
+  EXPECT_EQ(b[0].message, "unresolved name 'missing'");
+  EXPECT_EQ(lazy.checkedItems(), 1U);
+  EXPECT_EQ(lazy.resolvedItems(), 4U);
+  EXPECT_TRUE(lazy.diagnosticsFor(1).empty());
+  EXPECT_TRUE(lazy.diagnosticsFor(99).empty());
+  EXPECT_EQ(lazy.checkedItems(), 2U);
+
+  const nsl::sema::SemaResult result = lazy.finish();
+  EXPECT_TRUE(result.hasErrors);
+  EXPECT_EQ(flatten(p.diag.diagnostics()), eager);
+}
+
+TEST(LazySemaTest, ExprAtFindsTheInnermostName) {
+  const std::string text = kThreeModules;
+  Parsed p(text);
+  ASSERT_NE(p.unit, nullptr);
+  LazySema lazy(*p.unit, p.diag);
+  const nsl::FileID fid = p.unit->items()[3]->loc().begin().file();
+  // The `i` of `o = i + missing`, in module b.
+  const std::size_t at = text.find("i + missing");
+  ASSERT_NE(at, std::string::npos);
+  const nsl::ast::Expr *e =
+      lazy.exprAt(nsl::SourceLocation::make(fid, static_cast<uint32_t>(at)));
+  ASSERT_NE(e, nullptr);
+  EXPECT_EQ(e->kind(), NodeKind::NK_IdentifierExpr);
+  EXPECT_EQ(lazy.resolvedItems(), 4U);
+  EXPECT_NE(lazy.resolve(*e), nullptr);
+  const nsl::sema::Type *t = lazy.typeOf(*e);
+  ASSERT_NE(t, nullptr);
+  ASSERT_EQ(t->kind(), nsl::sema::TypeKind::BitVector);
+  EXPECT_EQ(static_cast<const nsl::sema::BitVectorType *>(t)->width(), 8U);
+
+  // Past the last item there is nothing to find, and nothing to walk.
+  EXPECT_EQ(lazy.exprAt(nsl::SourceLocation::make(
+                fid, static_cast<uint32_t>(text.size()))),
+            nullptr);
+  EXPECT_EQ(lazy.resolvedItems(), 4U);
+}
+
+TEST(LazySemaTest, FinishMatchesSemaRunOnCorpus) {
+  const std::vector<std::string> files = corpusFiles();
+  ASSERT_FALSE(files.empty()) << "no corpus under " << NSL_SEMA_CORPUS_DIR;
+  std::string all;
+  for (const std::string &path : files) {
+    all += readFile(path);
+    all += "\n";
+  }
+
+  std::vector<std::string> texts;
+  for (const std::string &path : files) {
+    texts.push_back(readFile(path));
+  }
+  texts.push_back(all);
+  for (const std::string &text : texts) {
+    bool errors = false;
+    const std::string eager = eagerDiagnostics(text, &errors);
+
+    // Asked nothing; asked about one module's diagnostics; asked
+    // about the last module's expression.
+    for (int mode = 0; mode < 3; ++mode) {
+      SCOPED_TRACE("mode=" + std::to_string(mode) + "\n" +
+                   text.substr(0, 200));
+      Parsed p(text);
+      if (!p.unit) {
+        continue;
+      }
+      LazySema lazy(*p.unit, p.diag);
+      const std::vector<std::size_t> mods = modules(*p.unit);
+      std::size_t itemDiags = 0;
+      if (mode == 1 && !mods.empty()) {
+        itemDiags = lazy.diagnosticsFor(mods[mods.size() / 2]).size();
+      } else if (mode == 2 && !mods.empty()) {
+        if (const nsl::ast::Expr *e = firstRhs(*p.unit, mods.back())) {
+          lazy.typeOf(*e);
+        }
+      }
+      const nsl::sema::SemaResult result = lazy.finish();
+      EXPECT_EQ(result.hasErrors, errors);
+      EXPECT_EQ(flatten(p.diag.diagnostics()), eager);
+      EXPECT_LE(itemDiags, p.diag.diagnostics().size());
+    }
+  }
+}
+
+} // namespace
@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/constraint_fusion_test/statistics_test.cpp
+//
+// `SemaStatistics` (`nslc -ftime-report`). Asserts:
+//   - every registered `Sn` gets one entry, in ascending order, and
+//     the per-`Sn` diagnostic counts are the same on the reference,
+//     fused, sharded and per-item paths and add up to what was
+//     reported;
+//   - a `Sema` run counts its declarations, duplicates, scopes and
+//     lookups, times each resolution step, and reports the modules a
+//     `SemaCache` served;
+//   - the JSON report parses and carries every section.
+
+#include "ConstraintCheckRegistry.h"
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/JSON.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::DiagnosticEngine;
+using nsl::SourceManager;
+using nsl::sema::ConstraintContext;
+using nsl::sema::SemaStatistics;
+
+std::string readFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  std::ostringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+/// Every `.nsl` file under the corpus that parses without errors,
+/// concatenated into one unit.
+std::string concatenatedCorpus() {
+  std::vector<std::string> files;
+  std::error_code ec;
+  for (llvm::sys::fs::recursive_directory_iterator it(NSL_SEMA_CORPUS_DIR,
+                                                      ec),
+       end;
+       it != end && !ec; it.increment(ec)) {
+    if (llvm::sys::path::extension(it->path()) == ".nsl") {
+      files.push_back(it->path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  std::string text;
+  for (const std::string &path : files) {
+    std::string one = readFile(path);
+    SourceManager sm;
+    DiagnosticEngine diag(sm);
+    nsl::FileID fid = sm.addBufferInMemory(
+        path, std::vector<char>(one.begin(), one.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    if (nsl::parse::parseCompilationUnit(lex, diag) && !diag.hasError()) {
+      text += one;
+      text += "\n";
+    }
+  }
+  return text;
+}
+
+/// `text` parsed and run through Sema, collecting statistics.
+struct Analyzed {
+  SourceManager sm;
+  DiagnosticEngine diag{sm};
+  std::unique_ptr<nsl::ast::CompilationUnit> unit;
+  nsl::sema::SemaResult result;
+  SemaStatistics stats;
+
+  explicit Analyzed(const std::string &text,
+                    nsl::sema::SemaCache *cache = nullptr) {
+    nsl::FileID fid = sm.addBufferInMemory(
+        "/virt/stats.nsl", std::vector<char>(text.begin(), text.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    unit = nsl::parse::parseCompilationUnit(lex, diag);
+    if (unit) {
+      nsl::sema::Sema sema(diag, cache);
+      sema.setStatistics(&stats);
+      result = sema.run(*unit);
+    }
+  }
+};
+
+/// Per-`Sn` diagnostic counts, in report order.
+std::vector<uint64_t> perSn(const SemaStatistics &stats) {
+  std::vector<uint64_t> out;
+  for (const SemaStatistics::Constraint &c : stats.constraints) {
+    out.push_back(c.diagnostics);
+  }
+  return out;
+}
+
+TEST(SemaStatisticsTest, PerSnCountsAgreeAcrossPaths) {
+  Analyzed a(concatenatedCorpus());
+  ASSERT_NE(a.unit, nullptr);
+  ConstraintContext ctx{a.unit.get(), a.result.symbols.get(),
+                        a.result.types.get(), &a.result.resolutions, nullptr};
+
+  SemaStatistics reference;
+  DiagnosticEngine unfused(a.sm);
+  ctx.diag = &unfused;
+  ctx.stats = &reference;
+  nsl::sema::runAllConstraintsUnfused(ctx);
+  ASSERT_GE(reference.constraints.size(), 29U);
+  for (std::size_t i = 1; i < reference.constraints.size(); ++i) {
+    EXPECT_LT(reference.constraints[i - 1].sn, reference.constraints[i].sn);
+  }
+  uint64_t total = 0;
+  for (uint64_t n : perSn(reference)) {
+    total += n;
+  }
+  EXPECT_EQ(total, unfused.diagnostics().size());
+  EXPECT_GT(total, 10U);
+
+  for (unsigned threads : {1U, 4U}) {
+    SCOPED_TRACE("threads=" + std::to_string(threads));
+    SemaStatistics fused;
+    DiagnosticEngine out(a.sm);
+    ctx.diag = &out;
+    ctx.stats = &fused;
+    nsl::sema::runAllConstraints(ctx, threads);
+    EXPECT_EQ(perSn(fused), perSn(reference));
+  }
+
+  SemaStatistics byItem;
+  DiagnosticEngine out(a.sm);
+  ctx.diag = &out;
+  ctx.stats = &byItem;
+  std::vector<std::optional<nsl::sema::ItemDiagnostics>> items;
+  nsl::sema::runConstraintsByItem(ctx, items);
+  EXPECT_EQ(perSn(byItem), perSn(reference));
+}
+
+TEST(SemaStatisticsTest, SemaRunCountsResolutionWork) {
+  Analyzed a("declare top {\n"
+             "  input a[8];\n"
+             "  output y[8];\n"
+             "}\n"
+             "module top {\n"
+             "  reg r[8];\n"
+             "  reg r[8];\n"
+             "  y = a & missing;\n"
+             "}\n");
+  ASSERT_NE(a.unit, nullptr);
+  const SemaStatistics &s = a.stats;
+  EXPECT_GE(s.symbols, 4U);
+  EXPECT_EQ(s.duplicates, 1U);
+  EXPECT_GE(s.scopes, 3U);
+  EXPECT_GE(s.lookups, 2U);
+  EXPECT_EQ(s.failedLookups, 1U);
+  EXPECT_GT(s.resolvedExprs, 0U);
+  EXPECT_GT(s.foldedConstants, 0U);
+  EXPECT_EQ(s.cachedModules + s.checkedModules, 0U);
+
+  ASSERT_FALSE(s.resolutionSteps.empty());
+  EXPECT_EQ(s.resolutionSteps.front().name, "declare index");
+  uint64_t modules = 0;
+  for (const SemaStatistics::Step &step : s.resolutionSteps) {
+    if (step.name == "modules") {
+      modules = step.items;
+    }
+  }
+  EXPECT_EQ(modules, 1U);
+  EXPECT_GE(s.resolutionSeconds, 0.0);
+  EXPECT_GE(s.constraintSeconds, 0.0);
+}
+
+TEST(SemaStatisticsTest, CacheHitsAreReported) {
+  const std::string text = "declare a { output y; }\n"
+                           "module a { y = 1'b1; }\n"
+                           "declare b { output y; }\n"
+                           "module b { y = 1'b0; }\n";
+  nsl::sema::SemaCache cache;
+  Analyzed cold(text, &cache);
+  EXPECT_EQ(cold.stats.cachedModules, 0U);
+  EXPECT_EQ(cold.stats.checkedModules, 2U);
+  Analyzed warm(text, &cache);
+  EXPECT_EQ(warm.stats.cachedModules, 2U);
+  EXPECT_EQ(warm.stats.checkedModules, 0U);
+  EXPECT_EQ(perSn(warm.stats), perSn(cold.stats));
+}
+
+TEST(SemaStatisticsTest, JSONReportParses) {
+  Analyzed a("declare top { output y; }\n"
+             "module top { y = 1'b1; }\n");
+  ASSERT_NE(a.unit, nullptr);
+  std::string text;
+  llvm::raw_string_ostream os(text);
+  a.stats.writeJSON(os);
+  auto parsed = llvm::json::parse(os.str());
+  ASSERT_TRUE(static_cast<bool>(parsed)) << llvm::toString(parsed.takeError());
+  const llvm::json::Object *root = parsed->getAsObject();
+  ASSERT_NE(root, nullptr);
+  ASSERT_NE(root->getObject("resolution"), nullptr);
+  const llvm::json::Object *constraints = root->getObject("constraints");
+  ASSERT_NE(constraints, nullptr);
+  const llvm::json::Array *checks = constraints->getArray("checks");
+  ASSERT_NE(checks, nullptr);
+  EXPECT_EQ(checks->size(), a.stats.constraints.size());
+  const llvm::json::Object *counters = root->getObject("counters");
+  ASSERT_NE(counters, nullptr);
+  auto symbols = counters->getInteger("symbols");
+  ASSERT_TRUE(static_cast<bool>(symbols));
+  EXPECT_EQ(static_cast<uint64_t>(*symbols), a.stats.symbols);
+
+  std::string report;
+  llvm::raw_string_ostream tos(report);
+  a.stats.writeText(tos);
+  EXPECT_NE(tos.str().find("Sema time report"), std::string::npos);
+  EXPECT_NE(tos.str().find("S29"), std::string::npos);
+}
+
+} // namespace
@@ -50,6 +50,7 @@
 
 #include "gtest/gtest.h"
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace {
@@ -144,4 +145,35 @@ TEST(ParserSmokeTest, ParsesEmptyCompilationUnit) {
   EXPECT_EQ(cu->items().size(), 0U);
 }
 
+// Adversarial nesting (found by `nsl-fuzz-replay --synthetic`): an
+// initializer nested far past `kMaxNestingDepth` MUST produce a
+// single "nesting exceeds" error instead of overflowing the native
+// stack, and the enclosing module MUST still parse.
+TEST(ParserSmokeTest, RejectsExpressionNestedPastDepthLimit) {
+  constexpr int kDepth = 20000;
+  std::string src = "module deep {\n  reg q[8] = ";
+  src.append(kDepth, '(');
+  src += "1";
+  src.append(kDepth, ')');
+  src += ";\n}\n";
+
+  nsl::SourceManager sm;
+  nsl::FileID const fid = sm.addBufferInMemory(
+      "/virt/deep.nsl", std::vector<char>(src.begin(), src.end()));
+  ASSERT_TRUE(fid.isValid());
+
+  nsl::DiagnosticEngine diag(sm);
+  nsl::Lexer lex(sm, fid, diag);
+
+  std::unique_ptr<nsl::ast::CompilationUnit> cu =
+      nsl::parse::parseCompilationUnit(lex, diag);
+
+  ASSERT_NE(cu, nullptr);
+  ASSERT_EQ(diag.numErrors(), 1U);
+  EXPECT_NE(diag.diagnostics()[0].message.find("nesting exceeds"),
+            std::string::npos);
+  ASSERT_EQ(cu->items().size(), 1U);
+  EXPECT_EQ(cu->items()[0]->kind(), nsl::ast::NodeKind::NK_ModuleBlock);
+}
+
 } // namespace
@@ -67,6 +67,7 @@
 #include "ParserImpl.h"
 
 #include "gtest/gtest.h"
+#include <cstddef>
 #include <vector>
 
 using nsl::TokenKind;
@@ -339,4 +340,66 @@ TEST(RecoverySet, SkipUntilActiveRecoveryUsesGuardSet) {
   EXPECT_EQ(p.peekKind(), TokenKind::tk_semicolon);
 }
 
+// (12) The stack is a running OR: every level sees the union of all
+// enclosing sets, and each pop restores the enclosing level exactly —
+// including after the inner levels re-added tokens it already had.
+TEST(RecoverySet, RunningUnionRestoresEachLevelOnPop) {
+  nsl::SourceManager sm;
+  nsl::FileID const fid =
+      sm.addBufferInMemory("/virt/guard-running.nsl", bytesOf(""));
+  nsl::DiagnosticEngine diag(sm);
+  nsl::Lexer lex(sm, fid, diag);
+  Parser p(lex, diag);
+
+  static constexpr TokenKind kKinds[] = {
+      TokenKind::tk_module, TokenKind::tk_semicolon, TokenKind::tk_rbrace,
+      TokenKind::tk_module, TokenKind::tk_reg};
+  constexpr std::size_t kLevels = sizeof(kKinds) / sizeof(kKinds[0]);
+
+  // Recurse so each level's guard lives on its own frame.
+  auto nest = [&](auto &self, std::size_t level) -> void {
+    if (level == kLevels) {
+      return;
+    }
+    TokenSet const before = p.currentRecoverySet();
+    {
+      RecoveryGuard guard(p, TokenSet({kKinds[level]}));
+      for (std::size_t i = 0; i <= level; ++i) {
+        EXPECT_TRUE(p.currentRecoverySet().contains(kKinds[i]));
+      }
+      EXPECT_TRUE(before.isSubsetOf(p.currentRecoverySet()));
+      self(self, level + 1);
+    }
+    EXPECT_TRUE(p.currentRecoverySet() == before)
+        << "pop at level " << level << " must restore the enclosing set";
+  };
+  nest(nest, 0);
+  EXPECT_TRUE(p.currentRecoverySet() == TokenSet{});
+}
+
+// (13) The build-time FIRST/FOLLOW tables generated from
+// `docs/spec/nsl_lang.ebnf` (scripts/gen_first_follow.py).
+TEST(RecoverySet, GrammarSetsMatchTheSpec) {
+  namespace first = nsl::parse::grammar::first;
+  namespace follow = nsl::parse::grammar::follow;
+
+  EXPECT_TRUE(first::module_block == TokenSet({TokenKind::tk_module}));
+  EXPECT_TRUE(follow::compilation_unit == TokenSet({TokenKind::tk_eof}));
+
+  // `action_statement` starts statements, blocks and the empty `;`.
+  EXPECT_TRUE(first::action_statement.contains(TokenKind::tk_if_));
+  EXPECT_TRUE(first::action_statement.contains(TokenKind::tk_seq));
+  EXPECT_TRUE(first::action_statement.contains(TokenKind::tk_semicolon));
+  EXPECT_TRUE(first::action_statement.contains(TokenKind::tk_system_task));
+  EXPECT_FALSE(first::action_statement.contains(TokenKind::tk_module));
+
+  // `.{` is lexed as one token (N3) and so starts a concat lvalue.
+  EXPECT_TRUE(first::concat_lvalue == TokenSet({TokenKind::tk_dot_lbrace}));
+
+  // Items of a brace-delimited list are followed by the closing `}`.
+  EXPECT_TRUE(follow::struct_member.contains(TokenKind::tk_rbrace));
+  EXPECT_TRUE(follow::module_item.contains(TokenKind::tk_rbrace));
+  EXPECT_TRUE(follow::declare_item.contains(TokenKind::tk_rbrace));
+}
+
 } // namespace
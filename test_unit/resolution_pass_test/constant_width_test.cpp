@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/resolution_pass_test/constant_width_test.cpp
+//
+// `ResolutionPass` folds width-shaped expressions through
+// `ConstantEvaluator` and records them in the run's `ConstantTable`,
+// which lowering reads instead of re-parsing the AST. Asserts:
+//   - `param_int` references, arithmetic, shifts, conditionals and
+//     every literal base fold to the expected width;
+//   - intermediate values wider than 64 bits do not overflow;
+//   - a width that names a non-param, goes negative, divides by zero
+//     or holds a Z/X/U digit does not fold (and falls back to 1 bit);
+//   - a `param_int` initialiser only sees earlier names.
+
+#include "ResolutionPass.h"
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/DeclareBlock.h"
+#include "nsl/AST/MemDecl.h"
+#include "nsl/AST/ModuleBlock.h"
+#include "nsl/AST/PortDecl.h"
+#include "nsl/AST/RegDecl.h"
+#include "nsl/AST/SliceExpr.h"
+#include "nsl/AST/TransferStmt.h"
+#include "nsl/AST/WireDecl.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+#include "nsl/Sema/SymbolTable.h"
+#include "nsl/Sema/TypeSystem.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::DiagnosticEngine;
+using nsl::SourceManager;
+using nsl::ast::CompilationUnit;
+using nsl::ast::Expr;
+using nsl::ast::NodeKind;
+using nsl::sema::BitVectorType;
+using nsl::sema::ConstantTable;
+using nsl::sema::runResolutionPassImpl;
+using nsl::sema::SymbolTable;
+using nsl::sema::TypeKind;
+using nsl::sema::TypeSystem;
+
+/// `text` parsed and run through the resolution pass.
+struct Resolved {
+  SourceManager sm;
+  std::unique_ptr<CompilationUnit> unit;
+  SymbolTable symbols;
+  TypeSystem types;
+  ConstantTable constants;
+
+  explicit Resolved(const std::string &text) {
+    DiagnosticEngine diag(sm);
+    nsl::FileID fid = sm.addBufferInMemory(
+        "/virt/widths.nsl", std::vector<char>(text.begin(), text.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    unit = nsl::parse::parseCompilationUnit(lex, diag);
+    EXPECT_FALSE(diag.hasError());
+    if (unit) {
+      runResolutionPassImpl(*unit, symbols, types, diag, &constants);
+    }
+  }
+
+  /// The first `module` block, or null.
+  const nsl::ast::ModuleBlock *module() const {
+    for (const auto &item : unit->items()) {
+      if (item->kind() == NodeKind::NK_ModuleBlock) {
+        return static_cast<const nsl::ast::ModuleBlock *>(item.get());
+      }
+    }
+    return nullptr;
+  }
+
+  /// Width expression of the module's reg or wire named `name`.
+  const Expr *internalWidth(const char *name) const {
+    for (const auto &d : module()->internals()) {
+      if (d->kind() == NodeKind::NK_RegDecl) {
+        const auto &r = static_cast<const nsl::ast::RegDecl &>(*d);
+        if (r.name() == name) {
+          return r.width();
+        }
+      } else if (d->kind() == NodeKind::NK_WireDecl) {
+        const auto &w = static_cast<const nsl::ast::WireDecl &>(*d);
+        if (w.name() == name) {
+          return w.width();
+        }
+      }
+    }
+    ADD_FAILURE() << "no reg/wire '" << name << "'";
+    return nullptr;
+  }
+
+  std::optional<uint64_t> width(const char *name) const {
+    return constants.width(internalWidth(name));
+  }
+};
+
+/// Width of `e`'s inferred BitVector type; 0 when it is not one.
+uint64_t inferredWidth(const Expr *e) {
+  const nsl::sema::Type *t = e ? e->inferredType() : nullptr;
+  if (t == nullptr || t->kind() != TypeKind::BitVector) {
+    return 0;
+  }
+  return static_cast<const BitVectorType *>(t)->width();
+}
+
+TEST(ConstantWidthTest, ParamAndArithmeticWidthsFold) {
+  Resolved r("param_int W = 4;\n"
+             "declare m {\n"
+             "  input a[W * 2];\n"
+             "  output y[W];\n"
+             "}\n"
+             "module m {\n"
+             "  reg r[(W << 1) + 0x8] = 0;\n"
+             "  reg s[8'd3 * 2];\n"
+             "  mem ram[W + 12][W];\n"
+             "  wire w[W > 2 ? W : 1];\n"
+             "  y = r[W - 1:0];\n"
+             "}\n");
+  ASSERT_NE(r.unit, nullptr);
+  ASSERT_NE(r.module(), nullptr);
+
+  const auto *declare =
+      static_cast<const nsl::ast::DeclareBlock *>(r.unit->items()[1].get());
+  ASSERT_EQ(declare->kind(), NodeKind::NK_DeclareBlock);
+  ASSERT_EQ(declare->ports().size(), 2U);
+  EXPECT_EQ(r.constants.width(declare->ports()[0]->width()), 8U);
+  EXPECT_EQ(r.constants.width(declare->ports()[1]->width()), 4U);
+
+  EXPECT_EQ(r.width("r"), 16U);
+  EXPECT_EQ(r.width("s"), 6U);
+  EXPECT_EQ(r.width("w"), 4U);
+  for (const auto &d : r.module()->internals()) {
+    if (d->kind() == NodeKind::NK_MemDecl) {
+      const auto &m = static_cast<const nsl::ast::MemDecl &>(*d);
+      EXPECT_EQ(r.constants.width(m.depth()), 16U);
+      EXPECT_EQ(r.constants.width(m.width()), 4U);
+    }
+  }
+
+  // `r[W - 1:0]` is four bits wide.
+  ASSERT_EQ(r.module()->actions().size(), 1U);
+  const auto &t =
+      static_cast<const nsl::ast::TransferStmt &>(*r.module()->actions()[0]);
+  ASSERT_EQ(t.rhs()->kind(), NodeKind::NK_SliceExpr);
+  EXPECT_EQ(inferredWidth(t.rhs()), 4U);
+}
+
+TEST(ConstantWidthTest, WideIntermediatesDoNotOverflow) {
+  Resolved r("module m {\n"
+             "  reg a[(1 << 70) >> 66];\n"
+             "  reg b[18446744073709551616 / 4294967296 / 4294967280];\n"
+             "  reg c[0b1_0000];\n"
+             "  reg d[4'hFF];\n"
+             "}\n");
+  ASSERT_NE(r.unit, nullptr);
+  ASSERT_NE(r.module(), nullptr);
+  EXPECT_EQ(r.width("a"), 16U);
+  EXPECT_EQ(r.width("b"), 1U);
+  EXPECT_EQ(r.width("c"), 16U);
+  EXPECT_EQ(r.width("d"), 15U); // truncated to its four bits
+}
+
+TEST(ConstantWidthTest, NonConstantWidthsDoNotFold) {
+  Resolved r("module m {\n"
+             "  reg q[4];\n"
+             "  reg byReg[q];\n"
+             "  reg negative[4 - 8];\n"
+             "  reg byZero[8 / 0];\n"
+             "  reg unknown[4'b1z00];\n"
+             "  reg zero[0];\n"
+             "}\n");
+  ASSERT_NE(r.unit, nullptr);
+  ASSERT_NE(r.module(), nullptr);
+  EXPECT_EQ(r.width("q"), 4U);
+  for (const char *name : {"byReg", "negative", "byZero", "unknown", "zero"}) {
+    SCOPED_TRACE(name);
+    EXPECT_EQ(r.width(name), std::nullopt);
+  }
+}
+
+TEST(ConstantWidthTest, ParamSeesOnlyEarlierNames) {
+  Resolved r("param_int A = B + 1;\n"
+             "param_int B = 4;\n"
+             "param_int C = B * B;\n"
+             "module m {\n"
+             "  reg a[A];\n"
+             "  reg c[C];\n"
+             "}\n");
+  ASSERT_NE(r.unit, nullptr);
+  ASSERT_NE(r.module(), nullptr);
+  EXPECT_EQ(r.width("a"), std::nullopt);
+  EXPECT_EQ(r.width("c"), 16U);
+}
+
+} // namespace
@@ -7,7 +7,7 @@
 // `reg q[8] = 0;` plus a transfer `q := q + 1;` inside a `func`
 // body, run the resolution pass, and assert that:
 //   - the IdentifierExpr nodes referencing `q` are recorded in the
-//     ResolutionMap with a non-null Symbol* of kind `Reg`;
+//     run's ResolutionTable with a non-null Symbol* of kind `Reg`;
 //   - the `inferredType` slot on the IdentifierExpr is non-null
 //     (a bit-vector or similar).
 //
@@ -56,7 +56,7 @@ using nsl::ast::RegDecl;
 using nsl::ast::ScopedName;
 using nsl::ast::Stmt;
 using nsl::ast::TransferStmt;
-using nsl::sema::ResolutionMap;
+using nsl::sema::ResolutionTable;
 using nsl::sema::runResolutionPassImpl;
 using nsl::sema::Symbol;
 using nsl::sema::SymbolKind;
@@ -124,21 +124,25 @@ TEST(ResolutionPassIdentResolutionTest, RegInTransferResolves) {
 
   SymbolTable table;
   TypeSystem types;
-  ResolutionMap rmap = runResolutionPassImpl(*cu, table, types, diag);
+  ResolutionTable rmap = runResolutionPassImpl(*cu, table, types, diag);
 
   EXPECT_FALSE(diag.hasError());
 
   // Both identifier-expr references resolve to a RegSymbol.
-  auto lit = rmap.exprToSymbol.find(lhs_ptr);
-  ASSERT_NE(lit, rmap.exprToSymbol.end());
-  EXPECT_NE(lit->second, nullptr);
-  EXPECT_EQ(lit->second->kind(), SymbolKind::SK_Reg);
-  EXPECT_EQ(lit->second->name(), Identifier("q"));
-
-  auto rit = rmap.exprToSymbol.find(rhs_ptr);
-  ASSERT_NE(rit, rmap.exprToSymbol.end());
-  EXPECT_NE(rit->second, nullptr);
-  EXPECT_EQ(rit->second->kind(), SymbolKind::SK_Reg);
+  const Symbol *lsym = rmap.lookup(*lhs_ptr);
+  ASSERT_NE(lsym, nullptr);
+  EXPECT_EQ(lsym->kind(), SymbolKind::SK_Reg);
+  EXPECT_EQ(lsym->name(), Identifier("q"));
+
+  const Symbol *rsym = rmap.lookup(*rhs_ptr);
+  ASSERT_NE(rsym, nullptr);
+  EXPECT_EQ(rsym->kind(), SymbolKind::SK_Reg);
+
+  // The AST was built by hand, so the pass numbered the two
+  // references itself: distinct slots past the unit's parsed range.
+  EXPECT_NE(lhs_ptr->ordinal(), rhs_ptr->ordinal());
+  EXPECT_GE(lhs_ptr->ordinal(), cu->numExprOrdinals());
+  EXPECT_EQ(rmap.numResolved(), 2U);
 }
 
 TEST(ResolutionPassIdentResolutionTest, UnresolvedNameEmitsDiagnostic) {
@@ -0,0 +1,236 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/resolution_pass_test/interface_index_test.cpp
+//
+// `InterfaceIndex` stands in for `declare` blocks defined in other
+// files. Asserts:
+//   - a summary records every terminal with its folded width, the
+//     control terminals' dummy args and return terminal, the
+//     `interface` clock/reset and the header parameters;
+//   - `writeJSON` / `readJSON` round-trip byte for byte, and a
+//     malformed document is rejected without touching the index;
+//   - a `module` whose `declare` is only in the index resolves its
+//     ports, and `SUB.port` on a `submodule` of it gets the port's
+//     width;
+//   - a `declare` in the unit wins over the index.
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/AST/ModuleBlock.h"
+#include "nsl/AST/TransferStmt.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+#include "nsl/Sema/TypeSystem.h"
+
+#include "llvm/Support/raw_ostream.h"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::DiagnosticEngine;
+using nsl::SourceManager;
+using nsl::ast::CompilationUnit;
+using nsl::ast::NodeKind;
+using nsl::sema::BitVectorType;
+using nsl::sema::InterfaceIndex;
+using nsl::sema::InterfaceSummary;
+using nsl::sema::TypeKind;
+
+constexpr const char *kAluDeclare =
+    "declare interface(clock=clk, reset=rst) alu {\n"
+    "  param_int N;\n"
+    "  input clk;\n"
+    "  input rst;\n"
+    "  input a[8];\n"
+    "  output y[4 * 2];\n"
+    "  func_in go(a) : y;\n"
+    "}\n";
+
+/// `text` parsed and run through Sema against `interfaces`.
+struct Analyzed {
+  SourceManager sm;
+  DiagnosticEngine diag{sm};
+  std::unique_ptr<CompilationUnit> unit;
+  nsl::sema::SemaResult result;
+
+  explicit Analyzed(const std::string &text,
+                    const InterfaceIndex *interfaces = nullptr) {
+    nsl::FileID fid = sm.addBufferInMemory(
+        "/virt/iface.nsl", std::vector<char>(text.begin(), text.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    unit = nsl::parse::parseCompilationUnit(lex, diag);
+    EXPECT_FALSE(diag.hasError());
+    if (unit) {
+      nsl::sema::Sema sema(diag, nullptr, interfaces);
+      result = sema.run(*unit);
+    }
+  }
+
+  /// The last `module` block, or null.
+  const nsl::ast::ModuleBlock *lastModule() const {
+    const nsl::ast::ModuleBlock *out = nullptr;
+    for (const auto &item : unit->items()) {
+      if (item->kind() == NodeKind::NK_ModuleBlock) {
+        out = static_cast<const nsl::ast::ModuleBlock *>(item.get());
+      }
+    }
+    return out;
+  }
+};
+
+std::string toJSON(const InterfaceIndex &index) {
+  std::string out;
+  llvm::raw_string_ostream os(out);
+  index.writeJSON(os);
+  return os.str();
+}
+
+/// Width of `e`'s inferred BitVector type; 0 when it is not one.
+uint64_t inferredWidth(const nsl::ast::Expr *e) {
+  const nsl::sema::Type *t = e ? e->inferredType() : nullptr;
+  if (t == nullptr || t->kind() != TypeKind::BitVector) {
+    return 0;
+  }
+  return static_cast<const BitVectorType *>(t)->width();
+}
+
+TEST(InterfaceIndexTest, SummaryRecordsTerminalsAndParams) {
+  Analyzed a(kAluDeclare);
+  ASSERT_NE(a.unit, nullptr);
+  ASSERT_EQ(a.result.interfaces.size(), 1U);
+  const InterfaceSummary *s = a.result.interfaces.lookup("alu");
+  ASSERT_NE(s, nullptr);
+  EXPECT_EQ(s->modifier, InterfaceSummary::Modifier::Interface);
+  EXPECT_EQ(s->clock, "clk");
+  EXPECT_EQ(s->reset, "rst");
+  ASSERT_EQ(s->params.size(), 1U);
+  EXPECT_EQ(s->params[0].name, "N");
+  EXPECT_FALSE(s->params[0].isString);
+  EXPECT_TRUE(s->params[0].value.empty());
+
+  ASSERT_EQ(s->ports.size(), 5U);
+  EXPECT_EQ(s->port("clk")->width, 0U);
+  EXPECT_EQ(s->port("a")->width, 8U);
+  EXPECT_EQ(s->port("y")->width, 8U);
+  EXPECT_EQ(s->port("y")->direction, InterfaceSummary::Direction::Output);
+  const InterfaceSummary::Port *go = s->port("go");
+  ASSERT_NE(go, nullptr);
+  EXPECT_EQ(go->direction, InterfaceSummary::Direction::FuncIn);
+  EXPECT_EQ(go->dummyArgs, std::vector<std::string>{"a"});
+  EXPECT_EQ(go->returnTerminal, "y");
+  EXPECT_EQ(s->port("missing"), nullptr);
+}
+
+TEST(InterfaceIndexTest, JSONRoundTrips) {
+  Analyzed a(std::string(kAluDeclare) + "declare top {\n"
+                                        "  input b[3];\n"
+                                        "  func_out done();\n"
+                                        "}\n");
+  ASSERT_EQ(a.result.interfaces.size(), 2U);
+  const std::string json = toJSON(a.result.interfaces);
+
+  InterfaceIndex back;
+  std::string error;
+  ASSERT_TRUE(back.readJSON(json, error)) << error;
+  EXPECT_EQ(back.size(), 2U);
+  EXPECT_EQ(toJSON(back), json);
+  EXPECT_EQ(back.fingerprint(), a.result.interfaces.fingerprint());
+  EXPECT_EQ(back.lookup("top")->port("b")->width, 3U);
+}
+
+TEST(InterfaceIndexTest, MalformedDocumentsAreRejected) {
+  InterfaceIndex index;
+  std::string error;
+  ASSERT_TRUE(index.readJSON(
+      R"({"version":1,"interfaces":[{"name":"keep"}]})", error));
+  const std::size_t before = index.fingerprint();
+
+  for (const char *bad : {
+           "not json",
+           R"([])",
+           R"({"version":2,"interfaces":[]})",
+           R"({"version":1})",
+           R"({"version":1,"interfaces":[{"ports":[]}]})",
+           R"({"version":1,"interfaces":[{"name":"m","modifier":"x"}]})",
+           R"({"version":1,"interfaces":[{"name":"m","ports":)"
+           R"([{"name":"p","direction":"input","width":-1}]}]})",
+           R"({"version":1,"interfaces":[{"name":"ok"},{"name":"m",)"
+           R"("params":[{"name":"P","kind":"real"}]}]})",
+       }) {
+    SCOPED_TRACE(bad);
+    error.clear();
+    EXPECT_FALSE(index.readJSON(bad, error));
+    EXPECT_FALSE(error.empty());
+  }
+  EXPECT_EQ(index.size(), 1U);
+  EXPECT_EQ(index.lookup("ok"), nullptr);
+  EXPECT_EQ(index.fingerprint(), before);
+}
+
+TEST(InterfaceIndexTest, ModuleAndSubmoduleResolveThroughIndex) {
+  Analyzed decl(kAluDeclare);
+  const std::string text = "module alu {\n"
+                           "  y = a;\n"
+                           "}\n"
+                           "declare top {\n"
+                           "  output z[8];\n"
+                           "}\n"
+                           "module top {\n"
+                           "  alu u;\n"
+                           "  z = u.y;\n"
+                           "}\n";
+
+  // Without the index every port name of `alu` is unresolved.
+  Analyzed alone(text);
+  EXPECT_TRUE(alone.result.hasErrors);
+
+  Analyzed a(text, &decl.result.interfaces);
+  ASSERT_NE(a.unit, nullptr);
+  EXPECT_FALSE(a.result.hasErrors);
+  // The module's own interfaces are only those declared in it.
+  EXPECT_EQ(a.result.interfaces.size(), 1U);
+  EXPECT_NE(a.result.interfaces.lookup("top"), nullptr);
+
+  const auto *top = a.lastModule();
+  ASSERT_NE(top, nullptr);
+  ASSERT_EQ(top->actions().size(), 1U);
+  const auto &t =
+      static_cast<const nsl::ast::TransferStmt &>(*top->actions()[0]);
+  ASSERT_EQ(t.rhs()->kind(), NodeKind::NK_FieldAccessExpr);
+  EXPECT_EQ(inferredWidth(t.rhs()), 8U);
+}
+
+TEST(InterfaceIndexTest, DeclareInUnitWinsOverIndex) {
+  InterfaceIndex index;
+  std::string error;
+  ASSERT_TRUE(index.readJSON(
+      R"({"version":1,"interfaces":[{"name":"alu","ports":)"
+      R"([{"name":"y","direction":"output","width":32}]}]})",
+      error))
+      << error;
+  Analyzed a("declare alu {\n"
+             "  output y[4];\n"
+             "}\n"
+             "declare top {\n"
+             "  output z[4];\n"
+             "}\n"
+             "module top {\n"
+             "  alu u;\n"
+             "  z = u.y;\n"
+             "}\n",
+             &index);
+  ASSERT_NE(a.unit, nullptr);
+  EXPECT_FALSE(a.result.hasErrors);
+  EXPECT_EQ(a.result.interfaces.lookup("alu")->port("y")->width, 4U);
+  const auto &t = static_cast<const nsl::ast::TransferStmt &>(
+      *a.lastModule()->actions()[0]);
+  EXPECT_EQ(inferredWidth(t.rhs()), 4U);
+}
+
+} // namespace
@@ -22,13 +22,18 @@
 
 #include "nsl/AST/CompilationUnit.h"
 #include "nsl/AST/Decl.h"
+#include "nsl/AST/ModuleBlock.h"
+#include "nsl/AST/TransferStmt.h"
 #include "nsl/Basic/Diagnostic.h"
 #include "nsl/Basic/SourceLocation.h"
 #include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
 #include "nsl/Sema/Sema.h"
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -40,6 +45,8 @@ using nsl::SourceManager;
 using nsl::SourceRange;
 using nsl::ast::CompilationUnit;
 using nsl::ast::Decl;
+using nsl::ast::ModuleBlock;
+using nsl::ast::TransferStmt;
 using nsl::sema::Sema;
 using nsl::sema::SemaResult;
 
@@ -127,4 +134,62 @@ TEST(SemaLifecycleTest, FirstRunTransfersOwnership) {
   EXPECT_NE(other.types, nullptr);
 }
 
+// ---------------------------------------------------------------
+// (d) Each run owns its name resolutions in `SemaResult`. Two runs
+//     on one thread coexist: the second does not disturb the first,
+//     and each table answers only for its own unit's expressions.
+// ---------------------------------------------------------------
+
+/// Parse `text`; the unit's single module holds one `y = a;`.
+std::unique_ptr<CompilationUnit> parseUnit(SourceManager &sm,
+                                           DiagnosticEngine &diag,
+                                           const std::string &text) {
+  auto fid = sm.addBufferInMemory(
+      "run.nsl", std::vector<char>(text.begin(), text.end()));
+  nsl::Lexer lex(sm, fid, diag);
+  return nsl::parse::parseCompilationUnit(lex, diag);
+}
+
+const TransferStmt &onlyTransfer(const CompilationUnit &cu) {
+  const auto &mod = static_cast<const ModuleBlock &>(*cu.items().back());
+  return static_cast<const TransferStmt &>(*mod.actions().front());
+}
+
+TEST(SemaLifecycleTest, ResolutionsAreOwnedPerRun) {
+  SourceManager sm;
+  DiagnosticEngine diag(sm);
+  auto cu1 = parseUnit(sm, diag,
+                       "declare m { input a[8]; output y[8]; }\n"
+                       "module m { y = a; }\n");
+  auto cu2 = parseUnit(sm, diag,
+                       "declare n { input b[4]; input a[4]; output y[4]; }\n"
+                       "module n { y = a; }\n");
+  ASSERT_NE(cu1, nullptr);
+  ASSERT_NE(cu2, nullptr);
+  ASSERT_FALSE(diag.hasError());
+
+  Sema sema1(diag);
+  SemaResult r1 = sema1.run(*cu1);
+  Sema sema2(diag);
+  SemaResult r2 = sema2.run(*cu2);
+
+  const TransferStmt &t1 = onlyTransfer(*cu1);
+  const TransferStmt &t2 = onlyTransfer(*cu2);
+  // Parsed expressions arrive numbered, inside the unit's range.
+  EXPECT_NE(t1.rhs()->ordinal(), nsl::ast::Expr::kNoOrdinal);
+  EXPECT_LT(t1.rhs()->ordinal(), cu1->numExprOrdinals());
+
+  const nsl::sema::Symbol *a1 = r1.resolutions.lookup(*t1.rhs());
+  const nsl::sema::Symbol *a2 = r2.resolutions.lookup(*t2.rhs());
+  ASSERT_NE(a1, nullptr);
+  ASSERT_NE(a2, nullptr);
+  EXPECT_NE(a1, a2);
+  // `a` is declared at a different offset in each unit; each table
+  // reports its own declaration.
+  EXPECT_NE(r1.resolutions.declLoc(t1.rhs()).begin().rawBits(),
+            r2.resolutions.declLoc(t2.rhs()).begin().rawBits());
+  EXPECT_EQ(r1.resolutions.numResolved(), 2U);
+  EXPECT_EQ(r2.resolutions.numResolved(), 2U);
+}
+
 } // namespace
@@ -102,6 +102,21 @@ TEST_F(SourceManagerTest, GetLineReturnsLineSlice) {
   EXPECT_EQ(last.str(), "hij");
 }
 
+TEST_F(SourceManagerTest, BuildLineTablesMatchesLazyQueries) {
+  FileID const a = sm.addBufferInMemory("/virt/a.nsl", bytesOf("ab\ncd\n"));
+  FileID const b = sm.addBufferInMemory("/virt/b.nsl", bytesOf("x\n\ny"));
+  sm.buildLineTables();
+  auto pa = sm.getLineCol(SourceLocation::make(a, 4));
+  EXPECT_EQ(pa.first, 2U);
+  EXPECT_EQ(pa.second, 2U);
+  auto pb = sm.getLineCol(SourceLocation::make(b, 3));
+  EXPECT_EQ(pb.first, 3U);
+  EXPECT_EQ(pb.second, 1U);
+  // Buffers added afterwards still build their table on demand.
+  FileID const c = sm.addBufferInMemory("/virt/c.nsl", bytesOf("p\nq"));
+  EXPECT_EQ(sm.getLineCol(SourceLocation::make(c, 2)).first, 2U);
+}
+
 TEST_F(SourceManagerTest, AddLineDirectiveAndResolveVirtual) {
   FileID const fid = sm.addBufferInMemory(
       "/virt/a.nsl", bytesOf("line1\nline2\nline3\nline4\n"));
@@ -234,4 +234,70 @@ TEST(SymbolTableScopeStackTest, CurrentScopeAndModule) {
   table.leaveScope();
 }
 
+// ---------------------------------------------------------------
+// (g) shadow chains: arena symbols, shadowing, lifted declarations
+// ---------------------------------------------------------------
+
+TEST(SymbolTableScopeStackTest, ShadowingUnwindsInnermostFirst) {
+  SymbolTable table;
+  table.enterScope(ScopeKind::Global);
+  Symbol *g = table.create<RegSymbol>(Identifier("x"), makeRange());
+  ASSERT_TRUE(table.declare(g));
+  table.enterScope(ScopeKind::Module);
+  table.enterScope(ScopeKind::Proc);
+  Symbol *p = table.create<WireSymbol>(Identifier("x"), makeRange());
+  ASSERT_TRUE(table.declare(p));
+  // A same-scope redeclaration is rejected; shadowing is not.
+  EXPECT_FALSE(
+      table.declare(table.create<RegSymbol>(Identifier("x"), makeRange())));
+  EXPECT_EQ(table.lookup(Identifier("x")), p);
+  EXPECT_EQ(table.currentScope()->lookupLocal(Identifier("x")), p);
+
+  table.leaveScope();
+  EXPECT_EQ(table.lookup(Identifier("x")), g);
+  table.leaveScope();
+  table.leaveScope();
+  // Post-Sema fallback: the most recently retired binding wins.
+  EXPECT_EQ(table.lookup(Identifier("x")), g);
+}
+
+TEST(SymbolTableScopeStackTest, DeclareInScopeSplicesUnderInnerBindings) {
+  SymbolTable table;
+  table.enterScope(ScopeKind::Module);
+  table.enterScope(ScopeKind::Proc);
+  Symbol *inner = table.create<RegSymbol>(Identifier("s"), makeRange());
+  ASSERT_TRUE(table.declare(inner));
+  Symbol *lifted = table.create<WireSymbol>(Identifier("s"), makeRange());
+  ASSERT_TRUE(table.declareInScope(ScopeKind::Module, lifted));
+  EXPECT_FALSE(table.declareInScope(
+      ScopeKind::Module,
+      table.create<WireSymbol>(Identifier("s"), makeRange())));
+  // The proc-local binding still shadows the lifted one.
+  EXPECT_EQ(table.lookup(Identifier("s")), inner);
+  table.leaveScope();
+  EXPECT_EQ(table.lookup(Identifier("s")), lifted);
+  table.leaveScope();
+}
+
+TEST(SymbolTableScopeStackTest, IdentifiersInternToDenseIds) {
+  SymbolTable table;
+  table.enterScope(ScopeKind::Global);
+  ASSERT_TRUE(
+      table.declare(table.create<RegSymbol>(Identifier("a"), makeRange())));
+  ASSERT_TRUE(
+      table.declare(table.create<RegSymbol>(Identifier("b"), makeRange())));
+  table.enterScope(ScopeKind::Module);
+  ASSERT_TRUE(
+      table.declare(table.create<RegSymbol>(Identifier("a"), makeRange())));
+  const auto &ids = table.identifiers();
+  EXPECT_EQ(ids.size(), 2U);
+  ASSERT_TRUE(ids.find(Identifier("a")).has_value());
+  EXPECT_EQ(*ids.find(Identifier("a")), 0U);
+  EXPECT_EQ(*ids.find(Identifier("b")), 1U);
+  EXPECT_EQ(ids.spelling(1U), Identifier("b"));
+  EXPECT_FALSE(ids.find(Identifier("c")).has_value());
+  table.leaveScope();
+  table.leaveScope();
+}
+
 } // namespace
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// test_unit/syntax_tree_test/syntax_tree_test.cpp
+//
+// Fixtures for the shared lossless syntax tree
+// (`include/nsl/Syntax/SyntaxTree.h`), built from the parser's
+// CST-mode event stream through `GreenTreeBuilder`.
+//
+// **Specification anchors**:
+//   - `cst-shape.contract.md` §3 / §8 — no-byte-loss: `text()`
+//     reproduces the source, including on recovered parse errors.
+//   - §4 — trivia attachment: trailing trivia runs to end of line,
+//     the rest leads the next token.
+//   - Green interning: identical subtrees are one object; an edit
+//     rebuilds only the spine and shares every sibling.
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Lex/Token.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Syntax/SyntaxTree.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include "gtest/gtest.h"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+using nsl::syntax::GreenElement;
+using nsl::syntax::GreenNode;
+using nsl::syntax::GreenTreeBuilder;
+using nsl::syntax::SyntaxNode;
+using nsl::syntax::SyntaxToken;
+using nsl::syntax::SyntaxTree;
+using nsl::syntax::TriviaKind;
+
+/// Parse `src` in CST mode and return its syntax tree. `hadError`
+/// reports whether the parser diagnosed anything.
+SyntaxTree parseTree(llvm::StringRef src, bool *hadError = nullptr) {
+  nsl::SourceManager sm;
+  nsl::FileID fid = sm.addBufferInMemory(
+      "/virt/syntax-tree.nsl", std::vector<char>(src.begin(), src.end()));
+  nsl::DiagnosticEngine diag(sm);
+  nsl::Lexer lex(sm, fid, diag);
+  GreenTreeBuilder builder(src);
+  (void)nsl::parse::parseCompilationUnit(lex, diag, &builder);
+  if (hadError != nullptr) {
+    *hadError = diag.hasError();
+  }
+  return builder.finish();
+}
+
+std::uint32_t offsetOf(llvm::StringRef src, llvm::StringRef needle) {
+  return static_cast<std::uint32_t>(src.find(needle));
+}
+
+TEST(SyntaxTreeTest, RoundTripKeepsEveryByte) {
+  const char *kSource = "// header comment\n"
+                        "module m {\n"
+                        "  reg r[8] = 0; /* same line */\n"
+                        "\n"
+                        "  /* spans\n"
+                        "     lines */\n"
+                        "  wire w[16];   // trailing\n"
+                        "}\n"
+                        "// tail\n";
+  bool hadError = true;
+  SyntaxTree tree = parseTree(kSource, &hadError);
+  EXPECT_FALSE(hadError);
+  EXPECT_EQ(tree.text(), std::string(kSource));
+  EXPECT_EQ(tree.root().kind(), "CompilationUnit");
+  EXPECT_EQ(tree.root().fullWidth(), llvm::StringRef(kSource).size());
+}
+
+TEST(SyntaxTreeTest, RoundTripSurvivesRecoveredErrors) {
+  const char *kSource = "module m {\n"
+                        "  reg ;\n"
+                        "  wire w;\n"
+                        "}\n";
+  bool hadError = false;
+  SyntaxTree tree = parseTree(kSource, &hadError);
+  EXPECT_TRUE(hadError);
+  EXPECT_EQ(tree.text(), std::string(kSource));
+}
+
+TEST(SyntaxTreeTest, TriviaAttachesTrailingToLineAndRestToNextToken) {
+  llvm::StringRef src = "module m {\n"
+                        "  reg r[8]; // note\n"
+                        "  // about w\n"
+                        "  wire w;\n"
+                        "}\n";
+  SyntaxTree tree = parseTree(src);
+
+  std::optional<SyntaxToken> semi =
+      tree.root().tokenAtOffset(offsetOf(src, "; // note"));
+  ASSERT_TRUE(semi.has_value());
+  EXPECT_EQ(semi->text(), ";");
+  EXPECT_EQ(semi->green()->trailingText(), " // note\n");
+  ASSERT_EQ(semi->green()->trailingTrivia().size(), 3u);
+  EXPECT_EQ(semi->green()->trailingTrivia()[1].kind, TriviaKind::LineComment);
+  EXPECT_EQ(semi->green()->trailingTrivia()[2].kind, TriviaKind::Newline);
+
+  std::optional<SyntaxToken> wire =
+      tree.root().tokenAtOffset(offsetOf(src, "wire"));
+  ASSERT_TRUE(wire.has_value());
+  EXPECT_EQ(wire->text(), "wire");
+  EXPECT_EQ(wire->green()->leadingText(), "  // about w\n  ");
+  EXPECT_EQ(wire->textRange().first, offsetOf(src, "wire"));
+}
+
+TEST(SyntaxTreeTest, CommentIndexAnswersRangeQueries) {
+  llvm::StringRef src = "module m { // a\n"
+                        "  /* b */ wire w;\n"
+                        "}\n"
+                        "// c\n";
+  SyntaxTree tree = parseTree(src);
+  ASSERT_EQ(tree.comments().size(), 3u);
+  EXPECT_EQ(tree.comments()[0].kind, TriviaKind::LineComment);
+  EXPECT_EQ(tree.comments()[0].begin, offsetOf(src, "// a"));
+  EXPECT_EQ(tree.comments()[1].kind, TriviaKind::BlockComment);
+  EXPECT_EQ(tree.comments()[1].end, offsetOf(src, " wire"));
+
+  auto inModule = tree.commentsIn(0, offsetOf(src, "}"));
+  EXPECT_EQ(inModule.size(), 2u);
+  EXPECT_TRUE(tree.commentsIn(offsetOf(src, "wire"), offsetOf(src, "}"))
+                  .empty());
+}
+
+TEST(SyntaxTreeTest, IdenticalSubtreesAreInterned) {
+  llvm::StringRef src = "module m {\n"
+                        "  wire a;\n"
+                        "  wire a;\n"
+                        "}\n";
+  SyntaxTree tree = parseTree(src);
+  std::uint32_t firstWire = offsetOf(src, "wire");
+  SyntaxNode first = tree.root().coveringNode(firstWire, firstWire + 4);
+  SyntaxNode second = tree.root().coveringNode(
+      src.rfind("wire"), static_cast<std::uint32_t>(src.rfind("wire")) + 4);
+  ASSERT_EQ(first.kind(), "InternalDecl");
+  ASSERT_EQ(second.kind(), "InternalDecl");
+  EXPECT_NE(first.fullOffset(), second.fullOffset());
+  EXPECT_EQ(first.green(), second.green()) << "equal subtrees share storage";
+  EXPECT_GT(tree.cache()->hitCount(), 0u);
+}
+
+TEST(SyntaxTreeTest, EditSharesUntouchedSubtrees) {
+  llvm::StringRef src = "module m {\n"
+                        "  wire a;\n"
+                        "  wire b;\n"
+                        "}\n";
+  SyntaxTree tree = parseTree(src);
+  SyntaxNode declA =
+      tree.root().coveringNode(offsetOf(src, "wire a"), offsetOf(src, "a;"));
+  SyntaxNode declB =
+      tree.root().coveringNode(offsetOf(src, "wire b"), offsetOf(src, "b;"));
+  ASSERT_EQ(declA.kind(), "InternalDecl");
+  ASSERT_EQ(declB.kind(), "InternalDecl");
+
+  // Replace `wire a;` with the (identical-trivia) `wire b;` subtree.
+  const GreenNode *newRoot =
+      declA.replaceWith(*tree.cache(), GreenElement(declB.green()));
+  ASSERT_NE(newRoot, nullptr);
+  EXPECT_NE(newRoot, tree.greenRoot());
+  EXPECT_EQ(newRoot->text(), "module m {\n  wire b;\n  wire b;\n}\n");
+  // The old tree is immutable.
+  EXPECT_EQ(tree.text(), src.str());
+
+  // The sibling off the spine is the very same green node.
+  SyntaxNode edited = SyntaxNode::makeRoot(newRoot);
+  SyntaxNode newDeclB = edited.coveringNode(offsetOf(src, "wire b"),
+                                            offsetOf(src, "b;"));
+  EXPECT_EQ(newDeclB.green(), declB.green());
+}
+
+TEST(SyntaxTreeTest, RedCursorsCarryParentsAndOffsets) {
+  llvm::StringRef src = "module m {\n"
+                        "  reg r[8];\n"
+                        "}\n";
+  SyntaxTree tree = parseTree(src);
+  std::optional<SyntaxToken> r = tree.root().tokenAtOffset(offsetOf(src, "r["));
+  ASSERT_TRUE(r.has_value());
+  EXPECT_EQ(r->kind(), nsl::TokenKind::tk_identifier);
+  EXPECT_EQ(r->textRange().first, offsetOf(src, "r["));
+
+  std::vector<std::string> kinds;
+  for (std::optional<SyntaxNode> n = r->parent(); n; n = n->parent()) {
+    kinds.push_back(n->kind().str());
+  }
+  ASSERT_GE(kinds.size(), 3u);
+  EXPECT_EQ(kinds[0], "InternalDecl");
+  EXPECT_EQ(kinds[kinds.size() - 2], "ModuleBlock");
+  EXPECT_EQ(kinds.back(), "CompilationUnit");
+
+  SyntaxNode module = tree.root().childNodes().front();
+  EXPECT_EQ(module.kind(), "ModuleBlock");
+  EXPECT_EQ(module.textRange().first, 0u);
+  EXPECT_EQ(module.textRange().second, offsetOf(src, "}\n") + 1);
+}
+
+TEST(SyntaxTreeTest, ExpressionsNestAsBinaryNodes) {
+  llvm::StringRef src = "module m {\n"
+                        "  reg r[8] = 1 + 2 * 3;\n"
+                        "}\n";
+  SyntaxTree tree = parseTree(src);
+  EXPECT_EQ(tree.text(), src.str());
+  // `2`'s ancestors: its primary, `2 * 3`, `1 + 2 * 3`, the `Expr`.
+  std::optional<SyntaxToken> two =
+      tree.root().tokenAtOffset(offsetOf(src, "2 *"));
+  ASSERT_TRUE(two.has_value());
+  std::vector<std::string> kinds;
+  for (std::optional<SyntaxNode> n = two->parent(); n; n = n->parent()) {
+    kinds.push_back(n->kind().str());
+  }
+  ASSERT_GE(kinds.size(), 4u);
+  EXPECT_EQ(kinds[0], "PrimaryExpr");
+  EXPECT_EQ(kinds[1], "BinaryExpr");
+  EXPECT_EQ(kinds[2], "BinaryExpr");
+  EXPECT_EQ(kinds[3], "Expr");
+}
+
+} // namespace
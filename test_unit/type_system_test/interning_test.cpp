@@ -25,12 +25,14 @@
 #include "nsl/Sema/TypeSystem.h"
 
 #include <gtest/gtest.h>
+#include <thread>
 #include <vector>
 
 namespace {
 
 using nsl::ast::Identifier;
 using nsl::sema::FieldInfo;
+using nsl::sema::SharedTypeInterner;
 using nsl::sema::TypeRef;
 using nsl::sema::TypeSystem;
 
@@ -153,4 +155,82 @@ TEST(TypeSystemInterningTest, MemoryInternedByDepthAndElement) {
   EXPECT_NE(m1, m4);
 }
 
+// ---------------------------------------------------------------
+// (h) TypeSystems sharing an interner hand out the same bit /
+//     bit[N] / memory-of-bit[N] TypeRefs; structs (and memories of
+//     them) stay per instance.
+// ---------------------------------------------------------------
+
+TEST(TypeSystemInterningTest, SharedTypesAreSharedAcrossInstances) {
+  SharedTypeInterner shared;
+  TypeSystem a(shared);
+  TypeSystem b(shared);
+  EXPECT_EQ(a.bit(), b.bit());
+  EXPECT_EQ(a.unresolved(), b.unresolved());
+  EXPECT_EQ(a.bitVector(8), b.bitVector(8));
+  // Past the lock-free table, through the sharded maps.
+  EXPECT_EQ(a.bitVector(4096), b.bitVector(4096));
+  EXPECT_EQ(a.memory(256, a.bitVector(8)), b.memory(256, b.bitVector(8)));
+  EXPECT_EQ(shared.size(), 3U);
+
+  std::vector<FieldInfo> fields;
+  fields.push_back({Identifier("v"), 8U, 0U});
+  TypeRef sa = a.structType(Identifier("word_t"), fields, 8U);
+  TypeRef sb = b.structType(Identifier("word_t"), fields, 8U);
+  EXPECT_NE(sa, sb);
+  EXPECT_NE(a.memory(4, sa), b.memory(4, sb));
+  EXPECT_EQ(a.memory(4, sa), a.memory(4, sa));
+  EXPECT_EQ(shared.size(), 3U);
+
+  // A separate interner is a separate universe.
+  SharedTypeInterner other;
+  TypeSystem c(other);
+  EXPECT_NE(a.bitVector(8), c.bitVector(8));
+}
+
+TEST(TypeSystemInterningTest, DefaultInstancesShareTheGlobalInterner) {
+  TypeSystem a;
+  TypeSystem b;
+  EXPECT_EQ(a.bitVector(13), b.bitVector(13));
+  EXPECT_EQ(a.bitVector(13), SharedTypeInterner::global().bitVector(13));
+}
+
+// ---------------------------------------------------------------
+// (i) Concurrent runs interning the same widths agree on one
+//     TypeRef per width and allocate each once.
+// ---------------------------------------------------------------
+
+TEST(TypeSystemInterningTest, ConcurrentInterningAgrees) {
+  SharedTypeInterner shared;
+  constexpr unsigned kThreads = 8;
+  constexpr uint64_t kWidths = 1100; // spans direct table and shards
+  std::vector<std::vector<TypeRef>> seen(kThreads);
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < kThreads; ++t) {
+    workers.emplace_back([&shared, &seen, t] {
+      TypeSystem ts(shared);
+      for (uint64_t w = 1; w <= kWidths; ++w) {
+        // Each thread walks the widths from a different start.
+        uint64_t const width = ((w + t * 131U) % kWidths) + 1U;
+        TypeRef bv = ts.bitVector(width);
+        seen[t].push_back(bv);
+        seen[t].push_back(ts.memory(width, bv));
+      }
+    });
+  }
+  for (std::thread &w : workers) {
+    w.join();
+  }
+  EXPECT_EQ(shared.size(), 2U * kWidths);
+  TypeSystem ts(shared);
+  for (unsigned t = 0; t < kThreads; ++t) {
+    for (uint64_t w = 1; w <= kWidths; ++w) {
+      uint64_t const width = ((w + t * 131U) % kWidths) + 1U;
+      EXPECT_EQ(seen[t][2 * (w - 1)], ts.bitVector(width));
+      EXPECT_EQ(seen[t][2 * (w - 1) + 1],
+                ts.memory(width, ts.bitVector(width)));
+    }
+  }
+}
+
 } // namespace
@@ -0,0 +1,27 @@
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+#
+# tools/nsl-fuzz/CollectCorpus.cmake — `cmake -P` script behind the
+# `nsl-fuzz-corpus` target. Copies every `.nsl` source under
+# `examples/` and `test/`, plus the lit `.test` fixtures (NSL text
+# with `// RUN:` comment headers), into one flat directory, the layout
+# libFuzzer expects for a seed corpus. Each file is named after its
+# source-relative path (`/` -> `__`) so seeds never collide and a
+# crashing seed is easy to trace back.
+#
+# Inputs: NSL_SOURCE_DIR, NSL_CORPUS_DIR.
+
+file(GLOB_RECURSE _seeds
+  RELATIVE ${NSL_SOURCE_DIR}
+  ${NSL_SOURCE_DIR}/examples/*.nsl
+  ${NSL_SOURCE_DIR}/test/*.nsl
+  ${NSL_SOURCE_DIR}/test/*.test)
+list(SORT _seeds)
+
+file(MAKE_DIRECTORY ${NSL_CORPUS_DIR})
+foreach(_seed IN LISTS _seeds)
+  string(REPLACE "/" "__" _flat ${_seed})
+  configure_file(${NSL_SOURCE_DIR}/${_seed} ${NSL_CORPUS_DIR}/${_flat}
+                 COPYONLY)
+endforeach()
+list(LENGTH _seeds _count)
+message(STATUS "nsl-fuzz-corpus: ${_count} seeds in ${NSL_CORPUS_DIR}")
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-fuzz/FuzzStages.cpp — stage entry points shared by the
+// libFuzzer targets and the corpus-replay benchmark.
+
+#include "FuzzStages.h"
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Lex/Token.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Preprocess/Preprocessor.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nsl::fuzz {
+
+namespace {
+
+constexpr Stage kStages[] = {Stage::Lex, Stage::Preprocess, Stage::Parse};
+
+// Fixed virtual path — diagnostics are never rendered, and a stable
+// name keeps every run byte-identical (Principle V).
+constexpr const char *kInputPath = "/virt/fuzz-input.nsl";
+
+FileID addInput(SourceManager &sm, llvm::StringRef input) {
+  return sm.addBufferInMemory(kInputPath,
+                              std::vector<char>(input.begin(), input.end()));
+}
+
+void runLex(llvm::StringRef input) {
+  SourceManager sm;
+  DiagnosticEngine diag(sm);
+  Lexer lex(sm, addInput(sm, input), diag);
+  while (lex.next().kind() != TokenKind::tk_eof) {
+  }
+}
+
+void runPreprocess(llvm::StringRef input) {
+  SourceManager sm;
+  DiagnosticEngine diag(sm);
+  preprocess::IncludeSearchPath search;
+  preprocess::Preprocessor pp(sm, diag, search, {});
+  (void)pp.run(addInput(sm, input));
+}
+
+void runParse(llvm::StringRef input) {
+  SourceManager sm;
+  DiagnosticEngine diag(sm);
+  Lexer lex(sm, addInput(sm, input), diag);
+  (void)parse::parseCompilationUnit(lex, diag);
+}
+
+} // namespace
+
+llvm::ArrayRef<Stage> allStages() { return kStages; }
+
+llvm::StringRef stageName(Stage s) {
+  switch (s) {
+  case Stage::Lex:
+    return "lex";
+  case Stage::Preprocess:
+    return "preprocess";
+  case Stage::Parse:
+    return "parse";
+  }
+  return "unknown";
+}
+
+std::optional<Stage> stageFromName(llvm::StringRef name) {
+  for (Stage s : kStages) {
+    if (stageName(s) == name) {
+      return s;
+    }
+  }
+  return std::nullopt;
+}
+
+void runStage(Stage s, llvm::StringRef input) {
+  switch (s) {
+  case Stage::Lex:
+    runLex(input);
+    return;
+  case Stage::Preprocess:
+    runPreprocess(input);
+    return;
+  case Stage::Parse:
+    runParse(input);
+    return;
+  }
+}
+
+} // namespace nsl::fuzz
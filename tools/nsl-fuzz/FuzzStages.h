@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-fuzz/FuzzStages.h — the front-end stages the fuzz
+// targets and `nsl-fuzz-replay` drive, one entry point per stage.
+//
+// Each `runStage` call is self-contained: it builds a fresh
+// `SourceManager` / `DiagnosticEngine`, registers the input as an
+// in-memory buffer and runs the stage to completion, discarding the
+// result. Malformed input is the expected case — diagnostics are
+// collected and dropped; only a crash, a sanitizer report or a hang
+// is a finding.
+//
+//   Lex         — `Lexer::next()` until `tk_eof`.
+//   Preprocess  — `Preprocessor::run()` with no include paths and no
+//                 predefined macros (`#include` resolves nowhere).
+//   Parse       — `parseCompilationUnit()` over the raw input, i.e.
+//                 without preprocessing, so the parser sees every
+//                 byte the fuzzer mutates.
+
+#ifndef NSL_TOOLS_NSL_FUZZ_FUZZSTAGES_H
+#define NSL_TOOLS_NSL_FUZZ_FUZZSTAGES_H
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/StringRef.h"
+
+#include <optional>
+
+namespace nsl::fuzz {
+
+enum class Stage { Lex, Preprocess, Parse };
+
+/// Every stage, in pipeline order.
+llvm::ArrayRef<Stage> allStages();
+
+/// `lex` / `preprocess` / `parse`.
+llvm::StringRef stageName(Stage s);
+
+/// Inverse of `stageName`; `std::nullopt` for an unknown name.
+std::optional<Stage> stageFromName(llvm::StringRef name);
+
+/// Run `s` over `input`. Never throws; returns once the stage has
+/// consumed the whole input.
+void runStage(Stage s, llvm::StringRef input);
+
+} // namespace nsl::fuzz
+
+#endif // NSL_TOOLS_NSL_FUZZ_FUZZSTAGES_H
@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-fuzz/preprocess_fuzzer.cpp — libFuzzer entry point for the
+// `preprocess` stage (see FuzzStages.h). Built only with
+// `-DNSL_BUILD_FUZZERS=ON` and a Clang toolchain.
+
+#include "FuzzStages.h"
+
+#include "llvm/ADT/StringRef.h"
+
+#include <cstddef>
+#include <cstdint>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t *data,
+                                      std::size_t size) {
+  nsl::fuzz::runStage(
+      nsl::fuzz::Stage::Preprocess,
+      llvm::StringRef(reinterpret_cast<const char *>(data), size));
+  return 0;
+}
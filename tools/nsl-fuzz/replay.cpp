@@ -0,0 +1,379 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-fuzz/replay.cpp — `nsl-fuzz-replay`, the corpus-replay
+// benchmark for the fuzzed front-end stages.
+//
+// Replays every input of one or more corpora (files, or directories
+// walked recursively in sorted order) through each selected stage and
+// reports, per stage, throughput and the slowest input seen. Each
+// measurement is the minimum over `--repeat` runs.
+//
+// Linearity check: an input of n bytes is also timed on its first n/2
+// bytes. For a linear stage the growth t(n) / t(n/2) is ~2; above
+// `--max-growth` (default 3, i.e. worse than ~n^1.6) the input is
+// flagged as non-linear. Timings under `--floor-us` are too noisy to
+// judge and are never flagged. `--synthetic` additionally grows the
+// adversarial shapes a corpus rarely reaches — deeply nested `seq` /
+// `alt`, huge concatenations, long `%X%` splice runs — by doubling up
+// to `--max-bytes` and applies the same growth test between steps.
+//
+// Exit status: 0, or 1 with `--fail-on-nonlinear` when anything was
+// flagged; 2 on a usage or I/O error. The argv parser is hand-rolled
+// (matches `tools/nslc/main.cpp`'s convention).
+
+#include "FuzzStages.h"
+
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+
+using nsl::fuzz::Stage;
+
+constexpr const char *kUsage =
+    "usage: nsl-fuzz-replay [--stage=lex|preprocess|parse]...\n"
+    "                       [--repeat=N] [--max-growth=X] "
+    "[--floor-us=N]\n"
+    "                       [--synthetic] [--max-bytes=N]\n"
+    "                       [--fail-on-nonlinear] [<path>...]\n"
+    "\n"
+    "Replay fuzz corpora (files or directories) through the NSL\n"
+    "front-end stages; report throughput, the slowest input per stage\n"
+    "and any input whose time grows faster than linearly with size.\n";
+
+struct Options {
+  std::vector<Stage> stages;
+  std::vector<std::string> paths;
+  unsigned repeat = 3;
+  double maxGrowth = 3.0;
+  double floorUs = 500.0;
+  bool synthetic = false;
+  std::size_t maxBytes = 64 * 1024;
+  bool failOnNonlinear = false;
+};
+
+struct Input {
+  std::string name;
+  std::string bytes;
+};
+
+/// Minimum wall time of `repeat` runs of `s` over `text`, in µs.
+double timeStage(Stage s, llvm::StringRef text, unsigned repeat) {
+  double best = std::numeric_limits<double>::infinity();
+  for (unsigned i = 0; i < repeat; ++i) {
+    auto t0 = std::chrono::steady_clock::now();
+    nsl::fuzz::runStage(s, text);
+    auto t1 = std::chrono::steady_clock::now();
+    best = std::min(
+        best, std::chrono::duration<double, std::micro>(t1 - t0).count());
+  }
+  return best;
+}
+
+/// True when the doubling step from `halfUs` to `fullUs` is both
+/// measurable and steeper than `opts.maxGrowth`.
+bool isNonlinear(double halfUs, double fullUs, const Options &opts) {
+  if (fullUs < opts.floorUs || halfUs <= 0.0) {
+    return false;
+  }
+  return fullUs / halfUs > opts.maxGrowth;
+}
+
+bool parseUnsigned(llvm::StringRef text, std::size_t &out) {
+  unsigned long long v = 0;
+  if (text.getAsInteger(10, v)) {
+    return false;
+  }
+  out = static_cast<std::size_t>(v);
+  return true;
+}
+
+/// Returns the exit code to use on failure, or `std::nullopt`.
+std::optional<int> parseArgs(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; ++i) {
+    llvm::StringRef arg(argv[i]);
+    std::size_t n = 0;
+    if (arg == "--help" || arg == "-h") {
+      llvm::outs() << kUsage;
+      return 0;
+    }
+    if (arg.consume_front("--stage=")) {
+      std::optional<Stage> s = nsl::fuzz::stageFromName(arg);
+      if (!s) {
+        llvm::errs() << "error: unknown stage '" << arg << "'\n" << kUsage;
+        return 2;
+      }
+      opts.stages.push_back(*s);
+    } else if (arg.consume_front("--repeat=")) {
+      if (!parseUnsigned(arg, n) || n == 0) {
+        llvm::errs() << "error: --repeat expects a positive integer\n";
+        return 2;
+      }
+      opts.repeat = static_cast<unsigned>(n);
+    } else if (arg.consume_front("--max-growth=")) {
+      if (arg.getAsDouble(opts.maxGrowth) || opts.maxGrowth <= 1.0) {
+        llvm::errs() << "error: --max-growth expects a number > 1\n";
+        return 2;
+      }
+    } else if (arg.consume_front("--floor-us=")) {
+      if (!parseUnsigned(arg, n)) {
+        llvm::errs() << "error: --floor-us expects an integer\n";
+        return 2;
+      }
+      opts.floorUs = static_cast<double>(n);
+    } else if (arg.consume_front("--max-bytes=")) {
+      if (!parseUnsigned(arg, n) || n < 1024) {
+        llvm::errs() << "error: --max-bytes expects an integer >= 1024\n";
+        return 2;
+      }
+      opts.maxBytes = n;
+    } else if (arg == "--synthetic") {
+      opts.synthetic = true;
+    } else if (arg == "--fail-on-nonlinear") {
+      opts.failOnNonlinear = true;
+    } else if (!arg.empty() && arg.front() == '-') {
+      llvm::errs() << "error: unknown option '" << arg << "'\n" << kUsage;
+      return 2;
+    } else {
+      opts.paths.push_back(arg.str());
+    }
+  }
+  if (opts.stages.empty()) {
+    opts.stages.assign(nsl::fuzz::allStages().begin(),
+                       nsl::fuzz::allStages().end());
+  }
+  if (opts.paths.empty() && !opts.synthetic) {
+    llvm::errs() << "error: no corpus given (pass <path>... and/or "
+                    "--synthetic)\n"
+                 << kUsage;
+    return 2;
+  }
+  return std::nullopt;
+}
+
+/// Load every regular file under `paths`, directories walked
+/// recursively; sorted by path so reports are stable across runs.
+bool loadCorpus(const std::vector<std::string> &paths,
+                std::vector<Input> &out) {
+  namespace fs = std::filesystem;
+  std::vector<std::string> files;
+  for (const std::string &p : paths) {
+    std::error_code ec;
+    if (fs::is_directory(p, ec)) {
+      for (fs::recursive_directory_iterator it(p, ec), end; !ec && it != end;
+           it.increment(ec)) {
+        if (it->is_regular_file(ec)) {
+          files.push_back(it->path().string());
+        }
+      }
+    } else {
+      files.push_back(p);
+    }
+    if (ec) {
+      llvm::errs() << "error: " << p << ": " << ec.message() << "\n";
+      return false;
+    }
+  }
+  llvm::sort(files);
+  for (const std::string &f : files) {
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buf =
+        llvm::MemoryBuffer::getFile(f, /*IsText=*/false,
+                                    /*RequiresNullTerminator=*/false);
+    if (!buf) {
+      llvm::errs() << "error: " << f << ": " << buf.getError().message()
+                   << "\n";
+      return false;
+    }
+    out.push_back({f, (*buf)->getBuffer().str()});
+  }
+  return true;
+}
+
+// ---------- Synthetic adversarial shapes ----------
+
+struct Family {
+  const char *name;
+  Stage stage;
+  /// Build an input of roughly `bytes` bytes.
+  std::string (*build)(std::size_t bytes);
+};
+
+std::string repeatUntil(llvm::StringRef head, llvm::StringRef open,
+                        llvm::StringRef middle, llvm::StringRef close,
+                        llvm::StringRef tail, std::size_t bytes) {
+  std::size_t unit = open.size() + close.size();
+  std::size_t fixed = head.size() + middle.size() + tail.size();
+  std::size_t n = bytes > fixed ? (bytes - fixed) / unit : 1;
+  std::string out;
+  out.reserve(fixed + n * unit);
+  out += head;
+  for (std::size_t i = 0; i < n; ++i) {
+    out += open;
+  }
+  out += middle;
+  for (std::size_t i = 0; i < n; ++i) {
+    out += close;
+  }
+  out += tail;
+  return out;
+}
+
+std::string nestedSeq(std::size_t bytes) {
+  return repeatUntil("module m {\n  func f ", "seq { ", "x := 1; ", "} ",
+                     "\n}\n", bytes);
+}
+
+std::string nestedAlt(std::size_t bytes) {
+  return repeatUntil("module m {\n  func f ", "alt { c: ", "x = 1; ", "} ",
+                     "\n}\n", bytes);
+}
+
+std::string wideConcat(std::size_t bytes) {
+  return repeatUntil("module m {\n  func f { x = {a", ", a", "", "",
+                     "}; }\n}\n", bytes);
+}
+
+std::string spliceRun(std::size_t bytes) {
+  return repeatUntil("#define X a\nmodule m {\n  wire w", "%X%_", "", "",
+                     ";\n}\n", bytes);
+}
+
+constexpr Family kFamilies[] = {
+    {"nested-seq", Stage::Parse, nestedSeq},
+    {"nested-alt", Stage::Parse, nestedAlt},
+    {"wide-concat", Stage::Parse, wideConcat},
+    {"splice-run", Stage::Preprocess, spliceRun},
+};
+
+// ---------- Report ----------
+
+struct Flag {
+  std::string what;
+  llvm::StringRef stage;
+  std::size_t bytes;
+  double growth;
+};
+
+void replayCorpus(const std::vector<Input> &corpus, const Options &opts,
+                  std::vector<Flag> &flags) {
+  llvm::raw_ostream &os = llvm::outs();
+  os << llvm::formatv("{0,-11} {1,7} {2,10} {3,10} {4,9}  {5}\n", "stage",
+                      "inputs", "bytes", "total-ms", "MB/s", "slowest");
+  for (Stage s : opts.stages) {
+    std::size_t totalBytes = 0;
+    double totalUs = 0.0;
+    const Input *slowest = nullptr;
+    double slowestUs = -1.0;
+    for (const Input &in : corpus) {
+      double us = timeStage(s, in.bytes, opts.repeat);
+      totalBytes += in.bytes.size();
+      totalUs += us;
+      if (us > slowestUs) {
+        slowestUs = us;
+        slowest = &in;
+      }
+      if (in.bytes.size() >= 2 && us >= opts.floorUs) {
+        llvm::StringRef half =
+            llvm::StringRef(in.bytes).take_front(in.bytes.size() / 2);
+        double halfUs = timeStage(s, half, opts.repeat);
+        if (isNonlinear(halfUs, us, opts)) {
+          flags.push_back(
+              {in.name, nsl::fuzz::stageName(s), in.bytes.size(), us / halfUs});
+        }
+      }
+    }
+    double mbps = totalUs > 0.0 ? static_cast<double>(totalBytes) / totalUs
+                                : 0.0;
+    os << llvm::format("%-11s %7zu %10zu %10.3f %9.2f  ",
+                       nsl::fuzz::stageName(s).str().c_str(), corpus.size(),
+                       totalBytes, totalUs / 1000.0, mbps);
+    if (slowest != nullptr) {
+      os << slowest->name
+         << llvm::format(" (%zu B, %.3f ms)", slowest->bytes.size(),
+                         slowestUs / 1000.0);
+    } else {
+      os << "-";
+    }
+    os << "\n";
+  }
+}
+
+void replaySynthetic(const Options &opts, std::vector<Flag> &flags) {
+  llvm::raw_ostream &os = llvm::outs();
+  os << llvm::formatv("\n{0,-12} {1,-11} {2,10} {3,10} {4,8}\n", "family",
+                      "stage", "bytes", "ms", "growth");
+  for (const Family &f : kFamilies) {
+    if (!llvm::is_contained(opts.stages, f.stage)) {
+      continue;
+    }
+    double prevUs = 0.0;
+    for (std::size_t bytes = 1024; bytes <= opts.maxBytes; bytes *= 2) {
+      std::string text = f.build(bytes);
+      double us = timeStage(f.stage, text, opts.repeat);
+      double growth = prevUs > 0.0 ? us / prevUs : 0.0;
+      os << llvm::format("%-12s %-11s %10zu %10.3f ", f.name,
+                         nsl::fuzz::stageName(f.stage).str().c_str(),
+                         text.size(), us / 1000.0);
+      if (prevUs > 0.0) {
+        os << llvm::format("%8.2f", growth);
+      } else {
+        os << llvm::formatv("{0,8}", "-");
+      }
+      os << "\n";
+      if (prevUs > 0.0 && isNonlinear(prevUs, us, opts)) {
+        flags.push_back({std::string("synthetic:") + f.name,
+                         nsl::fuzz::stageName(f.stage), text.size(), growth});
+      }
+      prevUs = us;
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (std::optional<int> rc = parseArgs(argc, argv, opts)) {
+    return *rc;
+  }
+
+  std::vector<Input> corpus;
+  if (!loadCorpus(opts.paths, corpus)) {
+    return 2;
+  }
+
+  std::vector<Flag> flags;
+  if (!opts.paths.empty()) {
+    replayCorpus(corpus, opts, flags);
+  }
+  if (opts.synthetic) {
+    replaySynthetic(opts, flags);
+  }
+
+  llvm::raw_ostream &os = llvm::outs();
+  if (flags.empty()) {
+    os << "\nnon-linear: none\n";
+    return 0;
+  }
+  os << "\nnon-linear: " << flags.size() << "\n";
+  for (const Flag &f : flags) {
+    os << llvm::format("  %-11s %s (%zu B, growth %.2f on doubling)\n",
+                       f.stage.str().c_str(), f.what.c_str(), f.bytes,
+                       f.growth);
+  }
+  return opts.failOnNonlinear ? 1 : 0;
+}
@@ -0,0 +1,188 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-generate-bench/main.cpp — `nsl-generate-bench`, wall time
+// of `nsl-expand-generate` against generate nesting depth.
+//
+// Builds one `nsl.module` holding `--filler` plain registers and a
+// chain of `d` nested `nsl.structural_generate` ops, each iterating
+// `--width` times, whose innermost body declares two registers named
+// after every enclosing induction variable. `d` grows from 1 up to
+// `--max-depth`, so the expansion emits 2 * width^d registers.
+//
+// Each figure is the minimum over `--repeat` runs of the pass alone
+// (the module is rebuilt for every run). The expanded module must
+// hold no generate and exactly the expected register count; a
+// mismatch or a pass failure exits 1. Exit 2 on a usage error. The
+// argv parser is hand-rolled (matches `tools/nslc/main.cpp`'s
+// convention).
+
+#include "mlir/IR/Builders.h"
+#include "mlir/IR/BuiltinOps.h"
+#include "mlir/IR/MLIRContext.h"
+#include "mlir/IR/OwningOpRef.h"
+#include "mlir/Pass/PassManager.h"
+#include "nsl/Dialect/NSL/IR/NSLDialect.h"
+#include "nsl/Lower/Lower.h"
+
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+namespace {
+
+constexpr const char *kUsage =
+    "usage: nsl-generate-bench [--repeat=N] [--max-depth=N] [--width=N]\n"
+    "                          [--filler=N]\n"
+    "\n"
+    "Time nsl-expand-generate on a module of filler registers plus\n"
+    "generates nested 1..max-depth deep, each iterating width times.\n";
+
+struct Options {
+  unsigned repeat = 5;
+  unsigned maxDepth = 6;
+  unsigned width = 4;
+  unsigned filler = 256;
+};
+
+/// The benchmark module: `filler` registers, then `depth` nested
+/// generates over `v0`, `v1`, ... whose innermost body declares
+/// `cell_%v0%_..._%v<d-1>%` and `next_<same suffix>` with structured
+/// names.
+mlir::OwningOpRef<mlir::ModuleOp>
+synthesize(mlir::MLIRContext &ctx, const Options &opts, unsigned depth) {
+  mlir::OpBuilder builder(&ctx);
+  auto loc = builder.getUnknownLoc();
+  mlir::OwningOpRef<mlir::ModuleOp> top = mlir::ModuleOp::create(loc);
+  builder.setInsertionPointToEnd(top->getBody());
+
+  auto module_op = nsl::dialect::ModuleOp::create(
+      builder, loc, builder.getStringAttr("GenBench"));
+  builder.setInsertionPointToStart(&module_op.getBody().emplaceBlock());
+  auto bits_ty = nsl::dialect::BitsType::get(&ctx, 8);
+  for (unsigned i = 0; i < opts.filler; ++i) {
+    (void)nsl::dialect::RegOp::create(
+        builder, loc, bits_ty,
+        builder.getStringAttr("filler_" + std::to_string(i)),
+        mlir::IntegerAttr());
+  }
+
+  std::string suffix;
+  llvm::SmallVector<mlir::Value, 8> ivs;
+  llvm::SmallVector<mlir::Attribute, 16> suffixParts;
+  for (unsigned d = 0; d < depth; ++d) {
+    const std::string var = "v" + std::to_string(d);
+    auto gen_op = nsl::dialect::StructuralGenerateOp::create(
+        builder, loc, builder.getI64IntegerAttr(0),
+        builder.getI64IntegerAttr(opts.width), builder.getI64IntegerAttr(1),
+        builder.getStringAttr(var));
+    mlir::Block &body = gen_op.getBody().emplaceBlock();
+    ivs.push_back(body.addArgument(builder.getIndexType(), loc));
+    builder.setInsertionPointToStart(&body);
+    suffix += "_%" + var + "%";
+    suffixParts.push_back(builder.getStringAttr("_"));
+    suffixParts.push_back(builder.getI64IntegerAttr(d));
+  }
+  // Structured names, as `nslc` lowers `reg cell_%v0%_..._%vN%`.
+  for (const char *prefix : {"cell", "next"}) {
+    llvm::SmallVector<mlir::Attribute, 16> parts{builder.getStringAttr(prefix)};
+    parts.append(suffixParts.begin(), suffixParts.end());
+    (void)nsl::dialect::RegOp::create(
+        builder, loc, bits_ty, builder.getStringAttr(prefix + suffix),
+        mlir::IntegerAttr(), ivs, builder.getArrayAttr(parts));
+  }
+  return top;
+}
+
+bool parseUnsigned(llvm::StringRef text, unsigned &out) {
+  return !text.getAsInteger(10, out) && out != 0U;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    llvm::StringRef arg = argv[i];
+    if (arg == "-h" || arg == "--help") {
+      llvm::outs() << kUsage;
+      return 0;
+    }
+    unsigned *slot = nullptr;
+    if (arg.consume_front("--repeat=")) {
+      slot = &opts.repeat;
+    } else if (arg.consume_front("--max-depth=")) {
+      slot = &opts.maxDepth;
+    } else if (arg.consume_front("--width=")) {
+      slot = &opts.width;
+    } else if (arg.consume_front("--filler=")) {
+      slot = &opts.filler;
+    } else {
+      llvm::errs() << "nsl-generate-bench: unknown argument '" << arg
+                   << "'\n"
+                   << kUsage;
+      return 2;
+    }
+    if (!parseUnsigned(arg, *slot)) {
+      llvm::errs() << "nsl-generate-bench: bad value '" << arg << "'\n"
+                   << kUsage;
+      return 2;
+    }
+  }
+
+  mlir::MLIRContext ctx;
+  ctx.loadDialect<nsl::dialect::NSLDialect>();
+
+  llvm::outs() << llvm::formatv("{0,6} {1,12} {2,12} {3,14}\n", "depth",
+                                "registers", "expand-us", "ns/register");
+  uint64_t replicas = 1;
+  for (unsigned depth = 1; depth <= opts.maxDepth; ++depth) {
+    replicas *= opts.width;
+    const uint64_t expected = opts.filler + 2 * replicas;
+    double best = std::numeric_limits<double>::infinity();
+    for (unsigned r = 0; r < opts.repeat; ++r) {
+      mlir::OwningOpRef<mlir::ModuleOp> top = synthesize(ctx, opts, depth);
+      mlir::PassManager pm(&ctx, mlir::ModuleOp::getOperationName());
+      pm.addPass(nsl::lower::createNSLExpandGeneratePass());
+      auto t0 = std::chrono::steady_clock::now();
+      const bool ok = mlir::succeeded(pm.run(*top));
+      auto t1 = std::chrono::steady_clock::now();
+      if (!ok) {
+        llvm::errs() << llvm::formatv(
+            "nsl-generate-bench: depth {0}: expansion failed\n", depth);
+        return 1;
+      }
+      double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+      if (us < best) {
+        best = us;
+      }
+
+      uint64_t regs = 0;
+      uint64_t generates = 0;
+      top->walk([&](mlir::Operation *op) {
+        if (mlir::isa<nsl::dialect::RegOp>(op)) {
+          ++regs;
+        } else if (mlir::isa<nsl::dialect::StructuralGenerateOp>(op)) {
+          ++generates;
+        }
+      });
+      if (regs != expected || generates != 0) {
+        llvm::errs() << llvm::formatv(
+            "nsl-generate-bench: depth {0}: {1} register(s) and {2} "
+            "generate(s) left, expected {3} and 0\n",
+            depth, regs, generates, expected);
+        return 1;
+      }
+    }
+    llvm::outs() << llvm::formatv("{0,6} {1,12} {2,12:f1} {3,14:f1}\n",
+                                  depth, expected, best,
+                                  1000.0 * best / expected);
+  }
+  return 0;
+}
@@ -24,6 +24,9 @@
 //   - `-nsl-resolve-params`        - `-nsl-explode-submod-array`
 //   - `-nsl-expand-generate`       - `-nsl-inline-internal-func`
 //   - `-nsl-expand-variables`      - `-nsl-check-semantics`
+// plus `-nsl-canonicalize` (slot 3b, the `nsl` folders and patterns),
+// `-nsl-cse` (slot 5b) and `-nsl-eliminate-dead-signals` (run by
+// `lowerToCIRCT` ahead of the CIRCT conversion).
 // At M4 zero passes were registered; the `--<pass-name>` flag space
 // was empty beyond MLIR's built-in canonicalize / cse / etc. passes.
 
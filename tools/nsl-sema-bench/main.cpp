@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+//
+// tools/nsl-sema-bench/main.cpp — `nsl-sema-bench`, wall time of the
+// Sn constraint checks against design size.
+//
+// Synthesizes a design of `n` declare/module pairs (regs, wires, a
+// func, a proc with a `seq`, a top-level `alt`), doubling `n` from 1
+// up to `--max-modules`. Each design is lexed, parsed and run through
+// `Sema` once; the constraint stage alone is then timed three ways:
+//
+//   unfused — `runAllConstraintsUnfused`, one walk per checker;
+//   fused   — `runAllConstraints` on one thread, one shared traversal;
+//   sharded — `runAllConstraints` over `--threads` workers (default:
+//             hardware concurrency).
+//
+// Each figure is the minimum over `--repeat` runs. All paths must
+// report the same number of diagnostics; a mismatch exits 1. Exit 2
+// on a usage error. The argv parser is hand-rolled (matches
+// `tools/nslc/main.cpp`'s convention).
+
+#include "ConstraintCheckRegistry.h"
+
+#include "nsl/AST/CompilationUnit.h"
+#include "nsl/Basic/Diagnostic.h"
+#include "nsl/Basic/SourceManager.h"
+#include "nsl/Lex/Lexer.h"
+#include "nsl/Parse/Parser.h"
+#include "nsl/Sema/Sema.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FormatVariadic.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr const char *kUsage =
+    "usage: nsl-sema-bench [--repeat=N] [--max-modules=N] [--threads=N]\n"
+    "\n"
+    "Time the Sema constraint checks, per-checker walks vs the fused\n"
+    "traversal (one thread, then sharded), on synthetic designs of\n"
+    "doubling size.\n";
+
+struct Options {
+  unsigned repeat = 5;
+  unsigned maxModules = 1024;
+  unsigned threads = 0;
+};
+
+/// `n` independent declare/module pairs touching most of the node
+/// kinds the Sn checkers look at.
+std::string synthesize(unsigned n) {
+  std::string out;
+  for (unsigned i = 0; i < n; ++i) {
+    const std::string m = "m" + std::to_string(i);
+    out += "declare " + m +
+           " {\n"
+           "  input a[8];\n"
+           "  output y[8];\n"
+           "  func_in go(a);\n"
+           "}\n"
+           "module " +
+           m +
+           " {\n"
+           "  reg r[8] = 0;\n"
+           "  wire w[8];\n"
+           "  reg cnt[4];\n"
+           "  proc_name p(cnt);\n"
+           "  func go {\n"
+           "    w = a + r;\n"
+           "    if (w[0]) r := w;\n"
+           "    else r := a;\n"
+           "    y = w[7:0];\n"
+           "  }\n"
+           "  proc p {\n"
+           "    seq {\n"
+           "      cnt := cnt + 1;\n"
+           "      finish;\n"
+           "    }\n"
+           "  }\n"
+           "  alt {\n"
+           "    a == 0: r := 0;\n"
+           "    else: r := r;\n"
+           "  }\n"
+           "}\n";
+  }
+  return out;
+}
+
+struct Sample {
+  double us = std::numeric_limits<double>::infinity();
+  std::size_t diagnostics = 0;
+};
+
+template <typename RunFn>
+Sample timeConstraints(nsl::SourceManager &sm,
+                       nsl::sema::ConstraintContext ctx, unsigned repeat,
+                       RunFn run) {
+  Sample s;
+  for (unsigned i = 0; i < repeat; ++i) {
+    nsl::DiagnosticEngine diag(sm);
+    ctx.diag = &diag;
+    auto t0 = std::chrono::steady_clock::now();
+    run(ctx);
+    auto t1 = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    if (us < s.us) {
+      s.us = us;
+    }
+    s.diagnostics = diag.diagnostics().size();
+  }
+  return s;
+}
+
+bool parseUnsigned(llvm::StringRef text, unsigned &out) {
+  return !text.getAsInteger(10, out) && out != 0U;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  for (int i = 1; i < argc; ++i) {
+    llvm::StringRef arg = argv[i];
+    if (arg == "-h" || arg == "--help") {
+      llvm::outs() << kUsage;
+      return 0;
+    }
+    if (arg.consume_front("--repeat=")) {
+      if (!parseUnsigned(arg, opts.repeat)) {
+        llvm::errs() << "nsl-sema-bench: bad --repeat\n" << kUsage;
+        return 2;
+      }
+    } else if (arg.consume_front("--threads=")) {
+      if (!parseUnsigned(arg, opts.threads)) {
+        llvm::errs() << "nsl-sema-bench: bad --threads\n" << kUsage;
+        return 2;
+      }
+    } else if (arg.consume_front("--max-modules=")) {
+      if (!parseUnsigned(arg, opts.maxModules)) {
+        llvm::errs() << "nsl-sema-bench: bad --max-modules\n" << kUsage;
+        return 2;
+      }
+    } else {
+      llvm::errs() << "nsl-sema-bench: unknown argument '" << arg << "'\n"
+                   << kUsage;
+      return 2;
+    }
+  }
+
+  llvm::outs() << llvm::formatv("{0,8} {1,10} {2,12} {3,12} {4,12} {5,8}\n",
+                                "modules", "bytes", "unfused-us", "fused-us",
+                                "sharded-us", "speedup");
+  for (unsigned n = 1; n <= opts.maxModules; n *= 2) {
+    const std::string text = synthesize(n);
+    nsl::SourceManager sm;
+    nsl::DiagnosticEngine diag(sm);
+    nsl::FileID fid = sm.addBufferInMemory(
+        "/virt/sema-bench.nsl", std::vector<char>(text.begin(), text.end()));
+    nsl::Lexer lex(sm, fid, diag);
+    auto unit = nsl::parse::parseCompilationUnit(lex, diag);
+    if (!unit || diag.hasError()) {
+      llvm::errs() << "nsl-sema-bench: synthetic design failed to parse\n";
+      return 1;
+    }
+    nsl::sema::Sema sema(diag);
+    nsl::sema::SemaResult result = sema.run(*unit);
+
+    const nsl::sema::ConstraintContext ctx{
+        unit.get(), result.symbols.get(), result.types.get(),
+        &result.resolutions, nullptr};
+    Sample unfused =
+        timeConstraints(sm, ctx, opts.repeat, [](const auto &c) {
+          nsl::sema::runAllConstraintsUnfused(c);
+        });
+    Sample fused = timeConstraints(sm, ctx, opts.repeat, [](const auto &c) {
+      nsl::sema::runAllConstraints(c, 1U);
+    });
+    Sample sharded =
+        timeConstraints(sm, ctx, opts.repeat, [&](const auto &c) {
+          nsl::sema::runAllConstraints(c, opts.threads);
+        });
+    if (unfused.diagnostics != fused.diagnostics ||
+        unfused.diagnostics != sharded.diagnostics) {
+      llvm::errs() << llvm::formatv(
+          "nsl-sema-bench: {0} modules: unfused path reported {1} "
+          "diagnostic(s), fused {2}, sharded {3}\n",
+          n, unfused.diagnostics, fused.diagnostics, sharded.diagnostics);
+      return 1;
+    }
+    llvm::outs() << llvm::formatv(
+        "{0,8} {1,10} {2,12:f1} {3,12:f1} {4,12:f1} {5,7:f2}x\n", n,
+        text.size(), unfused.us, fused.us, sharded.us,
+        unfused.us / sharded.us);
+  }
+  return 0;
+}
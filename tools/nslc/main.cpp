@@ -41,14 +41,24 @@
 namespace {
 constexpr const char *kUsage =
     "usage: nslc [--version] [-I <dir>]... [-D NAME=value]... "
-    "[--diagnostic-format=text|json] -emit=<stage> <input>\n"
+    "[--diagnostic-format=text|json] [--interface-index=<file>]... "
+    "[-ftime-report[=text|json]] [-mlir-timing] [-mlir-pass-statistics] "
+    "[-mlir-op-counts] -emit=<stage> <input>\n"
     "  -emit=<stage>   Stop after stage. Stages:\n"
     "                    tokens   M1 lex output\n"
     "                    ast      M2/M3 AST snapshot\n"
+    "                    ast-bin  AST snapshot, compact binary encoding\n"
+    "                    interface  declare-block summaries (JSON), for\n"
+    "                             --interface-index in other files\n"
     "                    mlir     M5 nsl::* MLIR (post-structural-expansion)\n"
     "                    hw       M6 CIRCT MLIR (hw/comb/seq/fsm/sv;\n"
     "                             also accepts -emit=circt as an alias)\n"
-    "                    verilog  (M7+) — not yet implemented\n";
+    "                    verilog  (M7+) — not yet implemented\n"
+    "  -ftime-report   Print Sema's per-stage and per-Sn timings and its\n"
+    "                  counters to stderr (=json for one JSON line)\n"
+    "  -mlir-timing    Print per-pass MLIR timings to stderr (mlir, hw)\n"
+    "  -mlir-pass-statistics  Print each pass's statistics to stderr\n"
+    "  -mlir-op-counts Print the op count after each pass to stderr\n";
 bool starts(const char *s, const char *p) {
   return std::strncmp(s, p, std::strlen(p)) == 0;
 }
@@ -159,6 +169,21 @@ int main(int argc, char **argv) {
       opts.diagnostic_json = true;
     } else if (std::strcmp(a, "--diagnostic-format=text") == 0) {
       opts.diagnostic_json = false;
+    } else if (starts(a, "--interface-index=") && a[18] != '\0') {
+      opts.interface_indexes.emplace_back(a + 18);
+    } else if (std::strcmp(a, "-ftime-report") == 0 ||
+               std::strcmp(a, "-ftime-report=text") == 0) {
+      opts.time_report = true;
+      opts.time_report_json = false;
+    } else if (std::strcmp(a, "-ftime-report=json") == 0) {
+      opts.time_report = true;
+      opts.time_report_json = true;
+    } else if (std::strcmp(a, "-mlir-timing") == 0) {
+      opts.mlir_timing = true;
+    } else if (std::strcmp(a, "-mlir-pass-statistics") == 0) {
+      opts.mlir_pass_statistics = true;
+    } else if (std::strcmp(a, "-mlir-op-counts") == 0) {
+      opts.mlir_op_counts = true;
     } else if (std::strcmp(a, "-") == 0 && input.empty()) {
       // Stdin marker — recognized for every -emit=<stage>. The
       // actual stdin slurping happens after arg parsing finishes
@@ -191,6 +216,14 @@ int main(int argc, char **argv) {
   if (stage == "ast") {
     return nsl::driver::emitAST(input, opts, llvm::outs(), llvm::errs());
   }
+  if (stage == "ast-bin") {
+    return nsl::driver::emitAST(input, opts, llvm::outs(), llvm::errs(),
+                                nsl::driver::ASTFormat::Binary);
+  }
+  if (stage == "interface") {
+    return nsl::driver::emitAST(input, opts, llvm::outs(), llvm::errs(),
+                                nsl::driver::ASTFormat::Interface);
+  }
   if (stage == "mlir") {
     return nsl::driver::emitMLIR(input, opts, llvm::outs(), llvm::errs());
   }